@@ -0,0 +1,143 @@
+#include "Benchmark.h"
+
+Benchmark &Benchmark::Instance()
+{
+    static Benchmark benchmark;
+    return benchmark;
+}
+
+Benchmark::Benchmark()
+{
+    this->controller = &this->simulation.AddController("Benchmark");
+    this->simulation.Setup();
+    if (!this->simulation.RunUntilConnected())
+    {
+        fprintf(stderr, "Benchmark controller did not connect to the broker\n");
+        abort();
+    }
+    this->simulation.Run(2000000); // Subscriptions, retained commands and the first republish
+
+    HostNodeScope scope(this->controller->getNode());
+    this->webSocketMain = AsyncWebSocket::Find(&this->controller->getNode(), "/ws/main");
+    if (this->webSocketMain == nullptr)
+    {
+        fprintf(stderr, "Benchmark controller has no main websocket\n");
+        abort();
+    }
+    this->webSocketClientId = this->webSocketMain->HostConnect();
+}
+
+// ================================ LED DRIVER ================================ //
+void Benchmark::StepRefreshCycle()
+{
+    LedDriver &ledDriver = this->controller->getFirmware().getLedDriver();
+    this->controller->getClock().AdvanceMillis(ledDriver.getRefreshInterval());
+    this->controller->getNode().micros = this->controller->getClock().getElapsedMicros();
+    ledDriver.StartRefreshCycle(this->controller->getClock().Millis());
+}
+
+bool Benchmark::FadeToColor(uint8_t stripID, const LowLevelLEDStripData &command)
+{
+    HostNodeScope scope(this->controller->getNode());
+    return this->controller->getFirmware().getLedDriver().FadeToColor(stripID, command);
+}
+
+void Benchmark::UpdateLEDStrip(uint8_t stripID)
+{
+    HostNodeScope scope(this->controller->getNode());
+    this->controller->getFirmware().getLedDriver().UpdateLEDStrip(stripID);
+}
+
+LowLevelLEDStripData Benchmark::CreateCommand(FadeCurve curve, uint8_t colorValue, uint16_t brightnessValue)
+{
+    LowLevelLEDStripData data = {};
+    const uint16_t fadeTime = 1000;
+    uint8_t *colorValues[] = {&data.redColorValue, &data.greenColorValue, &data.blueColorValue, &data.cwColorValue, &data.wwColorValue};
+    uint16_t *colorFadeTimes[] = {&data.redColorFadeTime, &data.greenColorFadeTime, &data.blueColorFadeTime, &data.cwColorFadeTime, &data.wwColorFadeTime};
+    FadeCurve *colorFadeCurves[] = {&data.redColorFadeCurve, &data.greenColorFadeCurve, &data.blueColorFadeCurve, &data.cwColorFadeCurve, &data.wwColorFadeCurve};
+    uint16_t *brightnessValues[] = {&data.redBrightnessValue, &data.greenBrightnessValue, &data.blueBrightnessValue, &data.cwBrightnessValue, &data.wwBrightnessValue};
+    uint16_t *brightnessFadeTimes[] = {&data.redBrightnessFadeTime, &data.greenBrightnessFadeTime, &data.blueBrightnessFadeTime, &data.cwBrightnessFadeTime, &data.wwBrightnessFadeTime};
+    FadeCurve *brightnessFadeCurves[] = {&data.redBrightnessFadeCurve, &data.greenBrightnessFadeCurve, &data.blueBrightnessFadeCurve, &data.cwBrightnessFadeCurve, &data.wwBrightnessFadeCurve};
+    for (uint8_t i = 0; i < 5; i++)
+    {
+        *colorValues[i] = colorValue;
+        *colorFadeTimes[i] = fadeTime;
+        *colorFadeCurves[i] = curve;
+        *brightnessValues[i] = brightnessValue;
+        *brightnessFadeTimes[i] = fadeTime;
+        *brightnessFadeCurves[i] = curve;
+    }
+    return data;
+}
+
+// ================================ NETWORK ================================ //
+std::string Benchmark::getTopic(NetworkTopic topic)
+{
+    for (uint8_t i = 0; i < MQTT_TOPIC_COUNT; i++)
+    {
+        const NetworkTopicDefinition &definition = Network::getTopicDefinition(i);
+        if (definition.topic == topic)
+        {
+            return std::string("LEDController/") + (definition.isGlobal ? "Global" : this->controller->getClientName().c_str()) + "/" + definition.suffix;
+        }
+    }
+    return "LEDController/" + this->controller->getClientName() + "/Unknown/command";
+}
+
+void Benchmark::MqttCallback(const std::string &topic, const char *payload)
+{
+    // Fresh copies like the client buffer => The callback may modify both
+    HostNodeScope scope(this->controller->getNode());
+    size_t length = strlen(payload);
+    memcpy(this->topicBuffer, topic.c_str(), topic.size() + 1);
+    memcpy(this->payloadBuffer, payload, length + 1);
+    this->controller->getNetwork().MqttCallback(this->topicBuffer, (byte *)this->payloadBuffer, length);
+}
+
+NetworkTopic Benchmark::LookupTopic(const std::string &topic)
+{
+    HostNodeScope scope(this->controller->getNode());
+    return this->controller->getNetwork().LookupTopic(topic.c_str());
+}
+
+NetworkTopic Benchmark::CompareTopicStrings(const std::string &topic)
+{
+    HostNodeScope scope(this->controller->getNode());
+    FilesystemConfigurationData configurationData = this->controller->getFirmware().getFilesystem().getConfigurationData();
+    for (uint8_t i = 0; i < MQTT_TOPIC_COUNT; i++)
+    {
+        const NetworkTopicDefinition &definition = Network::getTopicDefinition(i);
+        String candidate = definition.isGlobal ? String("LEDController/Global/") + definition.suffix
+                                               : String("LEDController/" + configurationData.MQTTClientName + "/" + definition.suffix);
+        if (candidate.equals(topic.c_str()))
+        {
+            return definition.topic;
+        }
+    }
+    return NetworkTopic::Unknown;
+}
+
+void Benchmark::FlushPublishQueue()
+{
+    HostNodeScope scope(this->controller->getNode());
+    this->controller->getNetwork().HandlePublishQueue();
+}
+
+uint32_t Benchmark::getPublishQueueDroppedCount()
+{
+    return this->controller->getNetwork().getPublishQueueDroppedCount();
+}
+
+// ================================ WEBSERVER ================================ //
+void Benchmark::WebSocketText(const char *message)
+{
+    HostNodeScope scope(this->controller->getNode());
+    this->webSocketMain->HostText(this->webSocketClientId, message);
+}
+
+// ================================ PARAMETERHANDLER ================================ //
+void Benchmark::UpdateLEDStripParameter(uint8_t stripID, const NetworkLEDStripData &data)
+{
+    HostNodeScope scope(this->controller->getNode());
+    this->controller->getParameterhandler().updateLEDStripParameter(stripID, data);
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+// Access to the hot paths of one booted controller for the host benchmarks
+
+#include <Simulation.h>
+#include <string>
+
+class Benchmark
+{
+public:
+    static Benchmark &Instance(); // Boots the controller and connects it to the broker on first use
+
+    // ---- LED driver
+    void StepRefreshCycle(); // Moves the time by one refresh cycle like LedDriver::Run does before a fade step
+    bool FadeToColor(uint8_t stripID, const LowLevelLEDStripData &command);
+    void UpdateLEDStrip(uint8_t stripID);
+    static LowLevelLEDStripData CreateCommand(FadeCurve curve, uint8_t colorValue, uint16_t brightnessValue);
+
+    // ---- Network
+    std::string getTopic(NetworkTopic topic); // Full topic of the controller for an entry of the dispatch table
+    void MqttCallback(const std::string &topic, const char *payload);
+    NetworkTopic LookupTopic(const std::string &topic);        // Dispatch through the hash table
+    NetworkTopic CompareTopicStrings(const std::string &topic); // Dispatch like before the hash table: One String per candidate
+    void FlushPublishQueue();
+    uint32_t getPublishQueueDroppedCount();
+
+    // ---- Webserver
+    void WebSocketText(const char *message); // One text frame of a client of the main page
+
+    // ---- Parameterhandler
+    void UpdateLEDStripParameter(uint8_t stripID, const NetworkLEDStripData &data);
+
+private:
+    Benchmark();
+
+    Simulation simulation;
+    SimulatedController *controller = nullptr;
+    AsyncWebSocket *webSocketMain = nullptr;
+    uint32_t webSocketClientId = 0;
+    char topicBuffer[MQTT_TOPIC_LENGTH]{0};
+    char payloadBuffer[512]{0}; // JSON commands are longer than the state payloads
+};
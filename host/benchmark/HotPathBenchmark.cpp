@@ -0,0 +1,149 @@
+// Hot paths of the led driver, the command dispatch and the parameter handling on one booted controller.
+// baseline.json is the committed reference run => Compare a new run against it with compare.py of Google Benchmark
+
+#include <benchmark/benchmark.h> // Before the firmware => The firmware defines a macro called Name
+#include "Benchmark.h"
+
+/**
+ * @brief Reports the heap allocations per iteration => Every allocation on the ESP8266 fragments the 52 KB heap
+ */
+static void CountAllocations(benchmark::State &state, uint64_t allocationsBefore)
+{
+    state.counters["allocations"] = benchmark::Counter((double)(HostHeap::getAllocationCount() - allocationsBefore), benchmark::Counter::kAvgIterations);
+}
+
+// ================================ LED DRIVER ================================ //
+static void BM_FadeToColor(benchmark::State &state, FadeCurve curve)
+{
+    Benchmark &bench = Benchmark::Instance();
+    LowLevelLEDStripData commandOn = Benchmark::CreateCommand(curve, 255, 4095);
+    LowLevelLEDStripData commandOff = Benchmark::CreateCommand(curve, 0, 0);
+    bool fadeOn = true;
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        // One refresh cycle of a fade of all channels. The direction changes when a fade finished
+        bench.StepRefreshCycle();
+        if (bench.FadeToColor(1, fadeOn ? commandOn : commandOff))
+        {
+            fadeOn = !fadeOn;
+        }
+    }
+    CountAllocations(state, allocationsBefore);
+}
+BENCHMARK_CAPTURE(BM_FadeToColor, None, FadeCurve::None);
+BENCHMARK_CAPTURE(BM_FadeToColor, Linear, FadeCurve::Linear);
+BENCHMARK_CAPTURE(BM_FadeToColor, EaseIn, FadeCurve::EaseIn);
+BENCHMARK_CAPTURE(BM_FadeToColor, EaseOut, FadeCurve::EaseOut);
+BENCHMARK_CAPTURE(BM_FadeToColor, EaseInOut, FadeCurve::EaseInOut);
+
+static void BM_UpdateLEDStrip(benchmark::State &state)
+{
+    Benchmark &bench = Benchmark::Instance();
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        bench.UpdateLEDStrip(1);
+    }
+    CountAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_UpdateLEDStrip);
+
+// ================================ NETWORK ================================ //
+/**
+ * @brief Dispatches two alternating commands of one topic. The publish queue gets flushed outside of the measurement
+ * every few commands like the network component does once per loop
+ */
+static void BM_MqttCallback(benchmark::State &state, NetworkTopic topic, const char *firstPayload, const char *secondPayload)
+{
+    Benchmark &bench = Benchmark::Instance();
+    std::string fullTopic = bench.getTopic(topic);
+    uint64_t iteration = 0;
+    uint32_t droppedBefore = bench.getPublishQueueDroppedCount();
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        bench.MqttCallback(fullTopic, iteration % 2 == 0 ? firstPayload : secondPayload);
+        if (++iteration % 8 == 0)
+        {
+            state.PauseTiming();
+            uint64_t allocationsBeforeFlush = HostHeap::getAllocationCount();
+            bench.FlushPublishQueue();
+            allocationsBefore += HostHeap::getAllocationCount() - allocationsBeforeFlush; // Only the dispatch counts
+            state.ResumeTiming();
+        }
+    }
+    CountAllocations(state, allocationsBefore);
+    state.counters["dropped"] = bench.getPublishQueueDroppedCount() - droppedBefore;
+    bench.FlushPublishQueue();
+}
+BENCHMARK_CAPTURE(BM_MqttCallback, Strip1Power, NetworkTopic::HomeAssistantStrip1Power, "1", "0");
+BENCHMARK_CAPTURE(BM_MqttCallback, Strip1RGB, NetworkTopic::HomeAssistantStrip1RGB, "255,127,0", "0,127,255");
+BENCHMARK_CAPTURE(BM_MqttCallback, Strip1RGBBrightness, NetworkTopic::HomeAssistantStrip1RGBBrightness, "2048", "4095");
+BENCHMARK_CAPTURE(BM_MqttCallback, Strip1Effect, NetworkTopic::HomeAssistantStrip1Effect, "Rainbow", "None");
+BENCHMARK_CAPTURE(BM_MqttCallback, Alarm, NetworkTopic::HomeAssistantAlarm, "1", "0");
+BENCHMARK_CAPTURE(BM_MqttCallback, JSONStrip1, NetworkTopic::JSONStrip1,
+                  "{\"Power\":1,\"Red\":255,\"Green\":127,\"Blue\":0,\"ColorBrightness\":2048,\"ColorFadeCurve\":\"Linear\"}",
+                  "{\"Power\":1,\"Red\":0,\"Green\":127,\"Blue\":255,\"ColorBrightness\":4095,\"ColorFadeCurve\":\"EaseInOut\"}");
+BENCHMARK_CAPTURE(BM_MqttCallback, Unknown, NetworkTopic::Unknown, "1", "0");
+
+/**
+ * @brief Resolves one topic per iteration. items_per_second is the number of messages the dispatch handles per second.
+ * CompareTopicStrings is the String chain the callback used before the hash table
+ */
+static void BM_MqttTopicDispatch(benchmark::State &state, bool hashTable, NetworkTopic topic)
+{
+    Benchmark &bench = Benchmark::Instance();
+    std::string fullTopic = bench.getTopic(topic);
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        NetworkTopic result = hashTable ? bench.LookupTopic(fullTopic) : bench.CompareTopicStrings(fullTopic);
+        benchmark::DoNotOptimize(result);
+    }
+    state.SetItemsProcessed(state.iterations());
+    CountAllocations(state, allocationsBefore);
+}
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, StringCompare/Sun, false, NetworkTopic::HomeAssistantSun);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, StringCompare/Strip2RGBBrightness, false, NetworkTopic::HomeAssistantStrip2RGBBrightness);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, StringCompare/ProfilerReset, false, NetworkTopic::ProfilerReset);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, StringCompare/Unknown, false, NetworkTopic::Unknown);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, HashTable/Sun, true, NetworkTopic::HomeAssistantSun);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, HashTable/Strip2RGBBrightness, true, NetworkTopic::HomeAssistantStrip2RGBBrightness);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, HashTable/ProfilerReset, true, NetworkTopic::ProfilerReset);
+BENCHMARK_CAPTURE(BM_MqttTopicDispatch, HashTable/Unknown, true, NetworkTopic::Unknown);
+
+// ================================ WEBSERVER ================================ //
+static void BM_WebSocketEventMain(benchmark::State &state, const char *firstMessage, const char *secondMessage)
+{
+    Benchmark &bench = Benchmark::Instance();
+    uint64_t iteration = 0;
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        bench.WebSocketText(iteration++ % 2 == 0 ? firstMessage : secondMessage);
+    }
+    CountAllocations(state, allocationsBefore);
+}
+BENCHMARK_CAPTURE(BM_WebSocketEventMain, Power, "Power#1#1", "Power#1#0");
+BENCHMARK_CAPTURE(BM_WebSocketEventMain, RedValue, "RedValue#1#255", "RedValue#1#0");
+BENCHMARK_CAPTURE(BM_WebSocketEventMain, Unknown, "Unknown#1#1", "Unknown#1#0");
+
+// ================================ PARAMETERHANDLER ================================ //
+static void BM_UpdateLEDStripParameter(benchmark::State &state)
+{
+    Benchmark &bench = Benchmark::Instance();
+    NetworkLEDStripData data = {};
+    data.Power = true;
+    data.ColorFadeTime = 1000;
+    data.ColorFadeCurve = FadeCurve::Linear;
+    uint64_t iteration = 0;
+    uint64_t allocationsBefore = HostHeap::getAllocationCount();
+    for (auto _ : state)
+    {
+        data.ColorBrightness = 51 + (iteration++ * 37) % 4045;
+        bench.UpdateLEDStripParameter(0, data);
+    }
+    CountAllocations(state, allocationsBefore);
+}
+BENCHMARK(BM_UpdateLEDStripParameter);
@@ -0,0 +1,57 @@
+// Runs the command patterns of a Home Assistant installation against a fleet of simulated controllers and reports
+// throughput, drops, heap high-water marks and the latency from the command to the PCA9685 registers
+//
+// Usage: controller_load [controllers] [seconds per pattern]
+
+#include "LoadGenerator.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv)
+{
+    uint32_t controllerCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 4;
+    uint32_t seconds = argc > 2 ? (uint32_t)atoi(argv[2]) : 10;
+
+    Serial.setEcho(false);
+    Simulation simulation;
+    for (uint32_t i = 0; i < controllerCount; i++)
+    {
+        std::string clientName = "LEDController" + std::to_string(i + 1);
+        simulation.AddController(clientName.c_str());
+    }
+    simulation.Setup();
+    if (!simulation.RunUntilConnected())
+    {
+        fprintf(stderr, "Not every controller connected to the broker\n");
+        return 1;
+    }
+    simulation.Run(2000000); // Subscriptions and the first republish
+
+    LoadGenerator generator(simulation);
+    printf("%u controllers, %us per pattern\n", controllerCount, seconds);
+    printf("%-14s %9s %9s %10s %6s %10s %7s %9s %8s %8s %8s %10s %10s\n",
+           "pattern", "sent", "applied", "superseded", "lost", "states/s", "drops", "coalesced",
+           "p50 ms", "p95 ms", "max ms", "peak heap", "min free");
+
+    const LoadPattern patterns[] = {LoadPattern::SliderStorm, LoadPattern::EffectToggle, LoadPattern::AlarmFanOut};
+    for (LoadPattern pattern : patterns)
+    {
+        LoadResult result = generator.Run(pattern, (uint64_t)seconds * 1000000);
+        double elapsedSeconds = result.micros / 1000000.0;
+        printf("%-14s %9u %9u %10u %6u %10.1f %7u %9u %8.1f %8.1f %8.1f %10llu %10lld\n",
+               LoadGenerator::PatternToString(pattern),
+               result.commandsSent,
+               result.commandsApplied,
+               result.commandsSuperseded,
+               result.commandsLost,
+               result.statePublishes / elapsedSeconds,
+               result.publishQueueDropped,
+               result.publishQueueCoalesced,
+               result.latencyP50Micros / 1000.0,
+               result.latencyP95Micros / 1000.0,
+               result.latencyMaxMicros / 1000.0,
+               (unsigned long long)result.peakHeapBytes,
+               (long long)result.minFreeHeapBytes);
+    }
+    return 0;
+}
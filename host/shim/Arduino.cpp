@@ -0,0 +1,340 @@
+#include "Arduino.h"
+#include "HostEnvironment.h"
+
+HardwareSerial Serial;
+
+// ================================ TIME ================================ //
+unsigned long millis()
+{
+    return (unsigned long)(HostTime::getMicros() / 1000);
+}
+
+unsigned long micros()
+{
+    return (unsigned long)HostTime::getMicros();
+}
+
+void delay(unsigned long ms)
+{
+    HostTime::Advance((uint64_t)ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us)
+{
+    HostTime::Advance(us);
+}
+
+void yield()
+{
+}
+
+// ================================ GPIO ================================ //
+void pinMode(uint8_t pin, uint8_t mode)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        HostNode::Current().pinModes[pin] = mode;
+    }
+}
+
+int digitalRead(uint8_t pin)
+{
+    return pin < HOST_PIN_COUNT ? HostNode::Current().pinLevels[pin] : LOW;
+}
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+    if (pin < HOST_PIN_COUNT)
+    {
+        HostNode::Current().pinLevels[pin] = value ? HIGH : LOW;
+    }
+}
+
+int analogRead(uint8_t pin)
+{
+    (void)pin;
+    return 0;
+}
+
+// ================================ MATH ================================ //
+long map(long x, long inMin, long inMax, long outMin, long outMax)
+{
+    if (inMax == inMin)
+    {
+        return outMin;
+    }
+    return (x - inMin) * (outMax - outMin) / (inMax - inMin) + outMin;
+}
+
+/**
+ * @brief xorshift32 per node => Every simulated controller gets the same sequence in every run
+ */
+static uint32_t NextRandom()
+{
+    uint32_t &state = HostNode::Current().randomState;
+    if (state == 0)
+    {
+        state = 1;
+    }
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+long random(long max)
+{
+    return max > 0 ? (long)(NextRandom() % (uint32_t)max) : 0;
+}
+
+long random(long min, long max)
+{
+    return max > min ? min + random(max - min) : min;
+}
+
+void randomSeed(unsigned long seed)
+{
+    HostNode::Current().randomState = (uint32_t)seed;
+}
+
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer)
+{
+    sprintf(buffer, "%*.*f", width, precision, value);
+    return buffer;
+}
+
+// ================================ STRING ================================ //
+std::string String::FromSigned(long long value, unsigned char base)
+{
+    if (base == 10 || value >= 0)
+    {
+        return base == 10 ? std::to_string(value) : FromUnsigned((unsigned long long)value, base);
+    }
+    return FromUnsigned((unsigned long)value, base); // Arduino prints negative numbers in other bases as two's complement
+}
+
+std::string String::FromUnsigned(unsigned long long value, unsigned char base)
+{
+    if (base < 2 || base > 36)
+    {
+        base = 10;
+    }
+    std::string text;
+    do
+    {
+        uint8_t digit = value % base;
+        text.insert(text.begin(), (char)(digit < 10 ? '0' + digit : 'A' + digit - 10));
+        value /= base;
+    } while (value > 0);
+    return text;
+}
+
+std::string String::FromDouble(double value, unsigned char decimalPlaces)
+{
+    char buffer[64];
+    snprintf(buffer, sizeof(buffer), "%.*f", decimalPlaces, value);
+    return buffer;
+}
+
+bool String::equalsIgnoreCase(const String &other) const
+{
+    if (this->text.size() != other.text.size())
+    {
+        return false;
+    }
+    for (size_t i = 0; i < this->text.size(); i++)
+    {
+        if (tolower((unsigned char)this->text[i]) != tolower((unsigned char)other.text[i]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool String::endsWith(const String &suffix) const
+{
+    return this->text.size() >= suffix.text.size() &&
+           this->text.compare(this->text.size() - suffix.text.size(), suffix.text.size(), suffix.text) == 0;
+}
+
+String String::substring(unsigned int from, unsigned int to) const
+{
+    if (from > to)
+    {
+        unsigned int swap = from;
+        from = to;
+        to = swap;
+    }
+    if (from >= this->text.size())
+    {
+        return String();
+    }
+    return this->text.substr(from, to - from);
+}
+
+void String::toCharArray(char *buffer, unsigned int size, unsigned int index) const
+{
+    if (size == 0)
+    {
+        return;
+    }
+    size_t count = 0;
+    if (index < this->text.size())
+    {
+        count = this->text.size() - index;
+        if (count > size - 1)
+        {
+            count = size - 1;
+        }
+        memcpy(buffer, this->text.data() + index, count);
+    }
+    buffer[count] = '\0';
+}
+
+void String::replace(const String &find, const String &replace)
+{
+    if (find.text.empty())
+    {
+        return;
+    }
+    size_t position = 0;
+    while ((position = this->text.find(find.text, position)) != std::string::npos)
+    {
+        this->text.replace(position, find.text.size(), replace.text);
+        position += replace.text.size();
+    }
+}
+
+void String::trim()
+{
+    size_t first = this->text.find_first_not_of(" \t\r\n");
+    size_t last = this->text.find_last_not_of(" \t\r\n");
+    this->text = first == std::string::npos ? std::string() : this->text.substr(first, last - first + 1);
+}
+
+void String::toLowerCase()
+{
+    for (char &c : this->text)
+    {
+        c = tolower((unsigned char)c);
+    }
+}
+
+void String::toUpperCase()
+{
+    for (char &c : this->text)
+    {
+        c = toupper((unsigned char)c);
+    }
+}
+
+String operator+(const String &left, const String &right) { return String(left.str() + right.str()); }
+String operator+(const String &left, const char *right) { return String(left.str() + (right != nullptr ? right : "")); }
+String operator+(const char *left, const String &right) { return String(std::string(left != nullptr ? left : "") + right.str()); }
+String operator+(const String &left, char right) { return String(left.str() + right); }
+String operator+(const String &left, int right) { return left + String(right); }
+String operator+(const String &left, unsigned int right) { return left + String(right); }
+String operator+(const String &left, long right) { return left + String(right); }
+String operator+(const String &left, unsigned long right) { return left + String(right); }
+String operator+(const String &left, double right) { return left + String(right); }
+
+// ================================ PRINT ================================ //
+size_t Print::write(const uint8_t *buffer, size_t size)
+{
+    size_t written = 0;
+    for (size_t i = 0; i < size; i++)
+    {
+        written += this->write(buffer[i]);
+    }
+    return written;
+}
+
+size_t Print::printf(const char *format, ...)
+{
+    char buffer[256];
+    va_list arguments;
+    va_start(arguments, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, arguments);
+    va_end(arguments);
+    if (length < 0)
+    {
+        return 0;
+    }
+    if ((size_t)length < sizeof(buffer))
+    {
+        return this->write((const uint8_t *)buffer, length);
+    }
+
+    std::string text(length, '\0');
+    va_start(arguments, format);
+    vsnprintf(&text[0], length + 1, format, arguments);
+    va_end(arguments);
+    return this->write((const uint8_t *)text.data(), length);
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+    if (this->echo)
+    {
+        fputc(c, stdout);
+    }
+    return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size)
+{
+    if (this->echo)
+    {
+        fwrite(buffer, 1, size, stdout);
+    }
+    return size;
+}
+
+// ================================ IPADDRESS ================================ //
+bool IPAddress::fromString(const char *address)
+{
+    uint8_t parsed[4]{0};
+    uint8_t index = 0;
+    uint16_t value = 0;
+    bool digit = false;
+    for (const char *c = address; *c != '\0'; c++)
+    {
+        if (*c >= '0' && *c <= '9')
+        {
+            value = value * 10 + (*c - '0');
+            if (value > 255)
+            {
+                return false;
+            }
+            digit = true;
+        }
+        else if (*c == '.' && digit && index < 3)
+        {
+            parsed[index++] = value;
+            value = 0;
+            digit = false;
+        }
+        else
+        {
+            return false;
+        }
+    }
+    if (!digit || index != 3)
+    {
+        return false;
+    }
+    parsed[3] = value;
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        this->bytes[i] = parsed[i];
+    }
+    return true;
+}
+
+String IPAddress::toString() const
+{
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%u.%u.%u.%u", this->bytes[0], this->bytes[1], this->bytes[2], this->bytes[3]);
+    return String(buffer);
+}
@@ -0,0 +1,306 @@
+#pragma once
+
+// Host shim of the ESP8266 Arduino core. Only covers what the firmware in src/ uses.
+// Time, pins and random numbers come from the simulated node => See HostEnvironment.h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <math.h>
+#include <string>
+#include <functional>
+#include <memory>
+#include <vector>
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+// ================================ PINS ================================ //
+#define HIGH 0x1
+#define LOW 0x0
+#define INPUT 0x00
+#define INPUT_PULLUP 0x02
+#define OUTPUT 0x01
+#define OUTPUT_OPEN_DRAIN 0x03
+
+#define D0 16
+#define D1 5
+#define D2 4
+#define D3 0
+#define D4 2
+#define D5 14
+#define D6 12
+#define D7 13
+#define D8 15
+#define SDA 4
+#define SCL 5
+#define LED_BUILTIN 2
+#define HOST_PIN_COUNT 17
+
+// ================================ PRINT ================================ //
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+// ================================ FLASH ================================ //
+class __FlashStringHelper;
+#define F(string_literal) (reinterpret_cast<const __FlashStringHelper *>(string_literal))
+#define FPSTR(pstr_pointer) (reinterpret_cast<const __FlashStringHelper *>(pstr_pointer))
+#define PSTR(s) (s)
+#define PROGMEM
+#define ICACHE_RAM_ATTR
+#define IRAM_ATTR
+#define strncpy_P strncpy
+#define strcpy_P strcpy
+#define strlen_P strlen
+#define memcpy_P memcpy
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t *)(addr))
+
+// ================================ MATH ================================ //
+#define lowByte(w) ((uint8_t)((w) & 0xff))
+#define highByte(w) ((uint8_t)((w) >> 8))
+#define bitRead(value, bit) (((value) >> (bit)) & 0x01)
+#define bitSet(value, bit) ((value) |= (1UL << (bit)))
+#define bitClear(value, bit) ((value) &= ~(1UL << (bit)))
+
+template <class T, class L, class H>
+T constrain(T x, L low, H high)
+{
+    return x < (T)low ? (T)low : (x > (T)high ? (T)high : x);
+}
+long map(long x, long inMin, long inMax, long outMin, long outMax);
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// ================================ TIME ================================ //
+unsigned long millis();
+unsigned long micros();
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield();
+
+// ================================ GPIO ================================ //
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+int analogRead(uint8_t pin);
+
+// ================================ STRING ================================ //
+/**
+ * @brief Arduino String on top of std::string
+ *
+ */
+class String
+{
+public:
+    String() {}
+    String(const char *text) : text(text != nullptr ? text : "") {}
+    String(const __FlashStringHelper *text) : text(text != nullptr ? (const char *)text : "") {}
+    String(const std::string &text) : text(text) {}
+    String(char c) : text(1, c) {}
+    String(unsigned char value, unsigned char base = 10) : text(FromUnsigned(value, base)) {}
+    String(int value, unsigned char base = 10) : text(FromSigned(value, base)) {}
+    String(unsigned int value, unsigned char base = 10) : text(FromUnsigned(value, base)) {}
+    String(long value, unsigned char base = 10) : text(FromSigned(value, base)) {}
+    String(unsigned long value, unsigned char base = 10) : text(FromUnsigned(value, base)) {}
+    String(long long value, unsigned char base = 10) : text(FromSigned(value, base)) {}
+    String(unsigned long long value, unsigned char base = 10) : text(FromUnsigned(value, base)) {}
+    String(float value, unsigned char decimalPlaces = 2) : text(FromDouble(value, decimalPlaces)) {}
+    String(double value, unsigned char decimalPlaces = 2) : text(FromDouble(value, decimalPlaces)) {}
+
+    const char *c_str() const { return this->text.c_str(); }
+    unsigned int length() const { return this->text.size(); }
+    bool isEmpty() const { return this->text.empty(); }
+    bool reserve(unsigned int size)
+    {
+        this->text.reserve(size);
+        return true;
+    }
+
+    bool equals(const String &other) const { return this->text == other.text; }
+    bool equals(const char *other) const { return this->text == (other != nullptr ? other : ""); }
+    bool equalsIgnoreCase(const String &other) const;
+    bool startsWith(const String &prefix) const { return this->text.compare(0, prefix.text.size(), prefix.text) == 0; }
+    bool endsWith(const String &suffix) const;
+    int compareTo(const String &other) const { return this->text.compare(other.text); }
+
+    long toInt() const { return atol(this->text.c_str()); }
+    float toFloat() const { return atof(this->text.c_str()); }
+    double toDouble() const { return atof(this->text.c_str()); }
+
+    char charAt(unsigned int index) const { return index < this->text.size() ? this->text[index] : 0; }
+    void setCharAt(unsigned int index, char c)
+    {
+        if (index < this->text.size())
+        {
+            this->text[index] = c;
+        }
+    }
+    char operator[](unsigned int index) const { return this->charAt(index); }
+    int indexOf(char c, unsigned int from = 0) const { return Position(this->text.find(c, from)); }
+    int indexOf(const String &other, unsigned int from = 0) const { return Position(this->text.find(other.text, from)); }
+    int lastIndexOf(char c) const { return Position(this->text.rfind(c)); }
+    String substring(unsigned int from) const { return from < this->text.size() ? this->text.substr(from) : std::string(); }
+    String substring(unsigned int from, unsigned int to) const;
+    void toCharArray(char *buffer, unsigned int size, unsigned int index = 0) const;
+    void getBytes(unsigned char *buffer, unsigned int size, unsigned int index = 0) const { this->toCharArray((char *)buffer, size, index); }
+
+    void replace(const String &find, const String &replace);
+    void remove(unsigned int index) { this->text.erase(index < this->text.size() ? index : this->text.size()); }
+    void remove(unsigned int index, unsigned int count) { this->text.erase(index, count); }
+    void trim();
+    void toLowerCase();
+    void toUpperCase();
+
+    bool concat(const String &other)
+    {
+        this->text += other.text;
+        return true;
+    }
+    String &operator+=(const String &other)
+    {
+        this->text += other.text;
+        return *this;
+    }
+    String &operator+=(const char *other)
+    {
+        this->text += other != nullptr ? other : "";
+        return *this;
+    }
+    String &operator+=(char c)
+    {
+        this->text += c;
+        return *this;
+    }
+    String &operator+=(int value) { return *this += String(value); }
+    String &operator+=(unsigned int value) { return *this += String(value); }
+    String &operator+=(long value) { return *this += String(value); }
+    String &operator+=(unsigned long value) { return *this += String(value); }
+
+    bool operator==(const String &other) const { return this->text == other.text; }
+    bool operator==(const char *other) const { return this->equals(other); }
+    bool operator!=(const String &other) const { return this->text != other.text; }
+    bool operator!=(const char *other) const { return !this->equals(other); }
+    bool operator<(const String &other) const { return this->text < other.text; }
+
+    // Same as the Arduino String => Only false if the buffer is missing, never for an empty string
+    explicit operator bool() const { return true; }
+
+    const std::string &str() const { return this->text; }
+
+private:
+    std::string text;
+
+    static int Position(size_t position) { return position == std::string::npos ? -1 : (int)position; }
+    static std::string FromSigned(long long value, unsigned char base);
+    static std::string FromUnsigned(unsigned long long value, unsigned char base);
+    static std::string FromDouble(double value, unsigned char decimalPlaces);
+};
+
+String operator+(const String &left, const String &right);
+String operator+(const String &left, const char *right);
+String operator+(const char *left, const String &right);
+String operator+(const String &left, char right);
+String operator+(const String &left, int right);
+String operator+(const String &left, unsigned int right);
+String operator+(const String &left, long right);
+String operator+(const String &left, unsigned long right);
+String operator+(const String &left, double right);
+
+// ================================ PRINT ================================ //
+/**
+ * @brief Same formatting as the Arduino Print class. Derived classes only implement write
+ *
+ */
+class Print
+{
+public:
+    virtual ~Print() {}
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    size_t write(const char *text) { return text != nullptr ? this->write((const uint8_t *)text, strlen(text)) : 0; }
+    size_t write(const char *buffer, size_t size) { return this->write((const uint8_t *)buffer, size); }
+
+    size_t print(const __FlashStringHelper *text) { return this->write((const char *)text); }
+    size_t print(const String &text) { return this->write((const uint8_t *)text.c_str(), text.length()); }
+    size_t print(const char *text) { return this->write(text); }
+    size_t print(char c) { return this->write((uint8_t)c); }
+    size_t print(unsigned char value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(int value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(unsigned int value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(long value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(unsigned long value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(long long value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(unsigned long long value, int base = DEC) { return this->print(String(value, base)); }
+    size_t print(double value, int decimalPlaces = 2) { return this->print(String(value, decimalPlaces)); }
+    size_t print(bool value) { return this->print(String((int)value)); }
+
+    size_t println() { return this->write("\r\n"); }
+    template <class T>
+    size_t println(const T &value)
+    {
+        size_t length = this->print(value);
+        return length + this->println();
+    }
+    template <class T>
+    size_t println(const T &value, int format)
+    {
+        size_t length = this->print(value, format);
+        return length + this->println();
+    }
+
+    size_t printf(const char *format, ...);
+};
+
+/**
+ * @brief Readable byte stream
+ *
+ */
+class Stream : public Print
+{
+public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() { return -1; }
+    virtual void flush() {}
+    void setTimeout(unsigned long timeout) { this->timeout = timeout; }
+
+protected:
+    unsigned long timeout = 1000;
+};
+
+/**
+ * @brief The serial console. Writes to stdout while echo is enabled
+ *
+ */
+class HardwareSerial : public Stream
+{
+public:
+    void begin(unsigned long baudrate) { (void)baudrate; }
+    void end() {}
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    virtual int available() { return 0; }
+    virtual int read() { return -1; }
+    operator bool() const { return true; }
+
+    void setEcho(bool echo) { this->echo = echo; }
+    bool isEcho() const { return this->echo; }
+
+private:
+    bool echo = false;
+};
+
+extern HardwareSerial Serial;
+
+char *dtostrf(double value, signed char width, unsigned char precision, char *buffer);
+
+#include "IPAddress.h"
@@ -0,0 +1,571 @@
+#include "ArduinoJson.h"
+#include <ctype.h>
+#include <errno.h>
+
+#define JSON_NESTING_LIMIT 10
+
+const char *DeserializationError::c_str() const
+{
+    switch (this->errorCode)
+    {
+    case Ok:
+        return "Ok";
+    case EmptyInput:
+        return "EmptyInput";
+    case IncompleteInput:
+        return "IncompleteInput";
+    case InvalidInput:
+        return "InvalidInput";
+    case NoMemory:
+        return "NoMemory";
+    default:
+        return "TooDeep";
+    }
+}
+
+// ================================ PROXY ================================ //
+JsonMemberProxy::operator JsonVariant() const
+{
+    return JsonVariant(this->document.Find(this->key));
+}
+
+JsonMemberProxy &JsonMemberProxy::operator=(const char *value)
+{
+    JsonSlot slot;
+    if (value != nullptr)
+    {
+        slot.kind = JsonSlot::String;
+        slot.asString = value; // Not copied like in the library => Literals and strings that outlive the document
+    }
+    this->Set(slot);
+    return *this;
+}
+
+JsonMemberProxy &JsonMemberProxy::operator=(const String &value)
+{
+    JsonSlot slot;
+    slot.asString = this->document.CopyString(value.c_str());
+    slot.kind = slot.asString != nullptr ? JsonSlot::String : JsonSlot::Null;
+    this->Set(slot);
+    return *this;
+}
+
+void JsonMemberProxy::Set(JsonSlot slot)
+{
+    this->document.isObject = true;
+    JsonSlot *target = (JsonSlot *)this->document.Find(this->key);
+    if (target == nullptr)
+    {
+        target = this->document.AddSlot();
+        if (target == nullptr)
+        {
+            return;
+        }
+    }
+    slot.key = this->key;
+    *target = slot;
+}
+
+// ================================ DOCUMENT ================================ //
+void JsonDocument::clear()
+{
+    this->slotCount = 0;
+    this->stringsUsed = 0;
+    this->isObject = false;
+    this->overflow = false;
+}
+
+const JsonSlot *JsonDocument::Find(const char *key) const
+{
+    for (size_t i = 0; i < this->slotCount; i++)
+    {
+        if (strcmp(this->slots[i].key, key) == 0)
+        {
+            return &this->slots[i];
+        }
+    }
+    return nullptr;
+}
+
+JsonSlot *JsonDocument::AddSlot()
+{
+    if (this->memoryUsage() + 16 > this->poolCapacity)
+    {
+        this->overflow = true;
+        return nullptr;
+    }
+    JsonSlot *slot = &this->slots[this->slotCount++];
+    *slot = JsonSlot();
+    return slot;
+}
+
+const char *JsonDocument::CopyString(const char *text)
+{
+    size_t length = strlen(text) + 1;
+    if (this->memoryUsage() + length > this->poolCapacity)
+    {
+        this->overflow = true;
+        return nullptr;
+    }
+    char *copy = this->strings + this->stringsUsed;
+    memcpy(copy, text, length);
+    this->stringsUsed += length;
+    return copy;
+}
+
+// ================================ DESERIALIZE ================================ //
+/**
+ * @brief Recursive descent parser over the mutable input. Strings get unescaped in place
+ */
+class JsonParser
+{
+public:
+    JsonParser(char *input) : position(input) {}
+
+    DeserializationError ParseDocument(JsonDocument &document, bool &isObject)
+    {
+        this->SkipSpace();
+        if (*this->position == '\0')
+        {
+            return DeserializationError::EmptyInput;
+        }
+        if (*this->position != '{')
+        {
+            // Valid but not an object => Only checked, nothing stored
+            JsonSlot ignored;
+            return this->ParseValue(ignored, 0);
+        }
+        isObject = true;
+        this->position++;
+        this->SkipSpace();
+        if (*this->position == '}')
+        {
+            this->position++;
+            return DeserializationError::Ok;
+        }
+        while (true)
+        {
+            char *key;
+            DeserializationError error = this->ParseMember(key);
+            if (error)
+            {
+                return error;
+            }
+            JsonSlot value;
+            error = this->ParseValue(value, 1);
+            if (error)
+            {
+                return error;
+            }
+            JsonSlot *slot = document.AddSlot();
+            if (slot == nullptr)
+            {
+                return DeserializationError::NoMemory;
+            }
+            *slot = value;
+            slot->key = key;
+
+            this->SkipSpace();
+            if (*this->position == ',')
+            {
+                this->position++;
+                continue;
+            }
+            if (*this->position == '}')
+            {
+                this->position++;
+                return DeserializationError::Ok;
+            }
+            return *this->position == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        }
+    }
+
+private:
+    char *position;
+
+    void SkipSpace()
+    {
+        while (*this->position == ' ' || *this->position == '\t' || *this->position == '\r' || *this->position == '\n')
+        {
+            this->position++;
+        }
+    }
+
+    DeserializationError ParseMember(char *&key)
+    {
+        this->SkipSpace();
+        if (*this->position != '"')
+        {
+            return *this->position == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        }
+        DeserializationError error = this->ParseString(key);
+        if (error)
+        {
+            return error;
+        }
+        this->SkipSpace();
+        if (*this->position != ':')
+        {
+            return *this->position == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        }
+        this->position++;
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError ParseString(char *&text)
+    {
+        char quote = *this->position++;
+        char *write = this->position;
+        text = write;
+        while (*this->position != quote)
+        {
+            char c = *this->position++;
+            if (c == '\0')
+            {
+                return DeserializationError::IncompleteInput;
+            }
+            if (c == '\\')
+            {
+                c = *this->position++;
+                switch (c)
+                {
+                case 'n':
+                    c = '\n';
+                    break;
+                case 'r':
+                    c = '\r';
+                    break;
+                case 't':
+                    c = '\t';
+                    break;
+                case 'b':
+                    c = '\b';
+                    break;
+                case 'f':
+                    c = '\f';
+                    break;
+                case '"':
+                case '\\':
+                case '/':
+                    break;
+                case 'u':
+                {
+                    unsigned int code = 0;
+                    for (uint8_t i = 0; i < 4; i++)
+                    {
+                        char h = *this->position++;
+                        if (!isxdigit((unsigned char)h))
+                        {
+                            return h == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+                        }
+                        code = code * 16 + (isdigit((unsigned char)h) ? h - '0' : (tolower((unsigned char)h) - 'a' + 10));
+                    }
+                    // UTF-8 => The unescaped text is never longer than the escape sequence
+                    if (code < 0x80)
+                    {
+                        c = (char)code;
+                    }
+                    else if (code < 0x800)
+                    {
+                        *write++ = (char)(0xC0 | (code >> 6));
+                        c = (char)(0x80 | (code & 0x3F));
+                    }
+                    else
+                    {
+                        *write++ = (char)(0xE0 | (code >> 12));
+                        *write++ = (char)(0x80 | ((code >> 6) & 0x3F));
+                        c = (char)(0x80 | (code & 0x3F));
+                    }
+                    break;
+                }
+                case '\0':
+                    return DeserializationError::IncompleteInput;
+                default:
+                    return DeserializationError::InvalidInput;
+                }
+            }
+            *write++ = c;
+        }
+        this->position++;
+        *write = '\0';
+        return DeserializationError::Ok;
+    }
+
+    DeserializationError ParseValue(JsonSlot &slot, uint8_t depth)
+    {
+        this->SkipSpace();
+        char c = *this->position;
+        if (c == '\0')
+        {
+            return DeserializationError::IncompleteInput;
+        }
+        if (c == '"' || c == '\'')
+        {
+            char *text;
+            DeserializationError error = this->ParseString(text);
+            slot.kind = JsonSlot::String;
+            slot.asString = text;
+            return error;
+        }
+        if (c == '{' || c == '[')
+        {
+            slot.kind = c == '{' ? JsonSlot::Object : JsonSlot::Array;
+            return this->SkipNested(depth + 1);
+        }
+        if (this->Match("true"))
+        {
+            slot.kind = JsonSlot::Bool;
+            slot.asBool = true;
+            return DeserializationError::Ok;
+        }
+        if (this->Match("false"))
+        {
+            slot.kind = JsonSlot::Bool;
+            slot.asBool = false;
+            return DeserializationError::Ok;
+        }
+        if (this->Match("null"))
+        {
+            slot.kind = JsonSlot::Null;
+            return DeserializationError::Ok;
+        }
+        return this->ParseNumber(slot);
+    }
+
+    DeserializationError ParseNumber(JsonSlot &slot)
+    {
+        char *start = this->position;
+        bool isFloat = false;
+        if (*this->position == '-' || *this->position == '+')
+        {
+            this->position++;
+        }
+        if (!isdigit((unsigned char)*this->position) && *this->position != '.')
+        {
+            return *this->position == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        }
+        while (isdigit((unsigned char)*this->position) || *this->position == '.' || *this->position == 'e' || *this->position == 'E' ||
+               ((*this->position == '-' || *this->position == '+') && (this->position[-1] == 'e' || this->position[-1] == 'E')))
+        {
+            isFloat = isFloat || !isdigit((unsigned char)*this->position);
+            this->position++;
+        }
+        char end = *this->position;
+        *this->position = '\0';
+        if (isFloat)
+        {
+            slot.kind = JsonSlot::Float;
+            slot.asFloat = strtod(start, nullptr);
+        }
+        else
+        {
+            errno = 0;
+            long long value = strtoll(start, nullptr, 10);
+            if (errno == ERANGE || value > INT32_MAX || value < INT32_MIN)
+            {
+                // Does not fit the 32 bit long of the controller => Stored as float like the library does
+                slot.kind = JsonSlot::Float;
+                slot.asFloat = strtod(start, nullptr);
+            }
+            else
+            {
+                slot.kind = JsonSlot::Integer;
+                slot.asInteger = (long)value;
+            }
+        }
+        *this->position = end;
+        return DeserializationError::Ok;
+    }
+
+    bool Match(const char *word)
+    {
+        size_t length = strlen(word);
+        if (strncmp(this->position, word, length) != 0)
+        {
+            return false;
+        }
+        this->position += length;
+        return true;
+    }
+
+    DeserializationError SkipNested(uint8_t depth)
+    {
+        if (depth >= JSON_NESTING_LIMIT)
+        {
+            return DeserializationError::TooDeep;
+        }
+        bool isObject = *this->position == '{';
+        char close = isObject ? '}' : ']';
+        this->position++;
+        this->SkipSpace();
+        if (*this->position == close)
+        {
+            this->position++;
+            return DeserializationError::Ok;
+        }
+        while (true)
+        {
+            if (isObject)
+            {
+                char *key;
+                DeserializationError error = this->ParseMember(key);
+                if (error)
+                {
+                    return error;
+                }
+            }
+            JsonSlot ignored;
+            DeserializationError error = this->ParseValue(ignored, depth);
+            if (error)
+            {
+                return error;
+            }
+            this->SkipSpace();
+            if (*this->position == ',')
+            {
+                this->position++;
+                continue;
+            }
+            if (*this->position == close)
+            {
+                this->position++;
+                return DeserializationError::Ok;
+            }
+            return *this->position == '\0' ? DeserializationError::IncompleteInput : DeserializationError::InvalidInput;
+        }
+    }
+};
+
+DeserializationError deserializeJson(JsonDocument &document, char *input)
+{
+    document.clear();
+    if (input == nullptr)
+    {
+        return DeserializationError::EmptyInput;
+    }
+    JsonParser parser(input);
+    bool isObject = false;
+    DeserializationError error = parser.ParseDocument(document, isObject);
+    if (error)
+    {
+        document.clear();
+        return error;
+    }
+    document.isObject = isObject;
+    return error;
+}
+
+// ================================ SERIALIZE ================================ //
+/**
+ * @brief Appends to a fixed buffer. Stops at the end, the text stays null terminated
+ */
+class JsonWriter
+{
+public:
+    JsonWriter(char *output, size_t size) : output(output), size(size) {}
+
+    void Write(char c)
+    {
+        if (this->length + 1 < this->size)
+        {
+            this->output[this->length++] = c;
+        }
+    }
+    void Write(const char *text)
+    {
+        while (*text != '\0')
+        {
+            this->Write(*text++);
+        }
+    }
+    void WriteString(const char *text)
+    {
+        this->Write('"');
+        for (; *text != '\0'; text++)
+        {
+            switch (*text)
+            {
+            case '"':
+                this->Write("\\\"");
+                break;
+            case '\\':
+                this->Write("\\\\");
+                break;
+            case '\n':
+                this->Write("\\n");
+                break;
+            case '\r':
+                this->Write("\\r");
+                break;
+            case '\t':
+                this->Write("\\t");
+                break;
+            default:
+                this->Write(*text);
+            }
+        }
+        this->Write('"');
+    }
+    size_t Finish()
+    {
+        if (this->size > 0)
+        {
+            this->output[this->length] = '\0';
+        }
+        return this->length;
+    }
+
+private:
+    char *output;
+    size_t size;
+    size_t length = 0;
+};
+
+size_t serializeJson(const JsonDocument &document, char *output, size_t size)
+{
+    JsonWriter writer(output, size);
+    if (!document.isObject)
+    {
+        writer.Write("null");
+        return writer.Finish();
+    }
+    writer.Write('{');
+    for (size_t i = 0; i < document.slotCount; i++)
+    {
+        const JsonSlot &slot = document.slots[i];
+        if (i > 0)
+        {
+            writer.Write(',');
+        }
+        writer.WriteString(slot.key);
+        writer.Write(':');
+        char number[32];
+        switch (slot.kind)
+        {
+        case JsonSlot::Bool:
+            writer.Write(slot.asBool ? "true" : "false");
+            break;
+        case JsonSlot::Integer:
+            snprintf(number, sizeof(number), "%ld", slot.asInteger);
+            writer.Write(number);
+            break;
+        case JsonSlot::Float:
+            snprintf(number, sizeof(number), "%.9g", slot.asFloat);
+            writer.Write(number);
+            break;
+        case JsonSlot::String:
+            writer.WriteString(slot.asString);
+            break;
+        case JsonSlot::Object:
+            writer.Write("{}");
+            break;
+        case JsonSlot::Array:
+            writer.Write("[]");
+            break;
+        default:
+            writer.Write("null");
+        }
+    }
+    writer.Write('}');
+    return writer.Finish();
+}
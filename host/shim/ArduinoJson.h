@@ -0,0 +1,239 @@
+#pragma once
+
+// Host shim of the ArduinoJson 6 subset the firmware uses: Flat objects with bool, integer, float and string members.
+// Same as the library the document has a fixed capacity, parsing is zero-copy (strings get unescaped in the input)
+// and nested objects / arrays are accepted but not readable
+
+#include <Arduino.h>
+#include <type_traits>
+
+class JsonDocument;
+class JsonObject
+{
+};
+class JsonArray
+{
+};
+
+/**
+ * @brief Result of deserializeJson. False if there was no error
+ *
+ */
+class DeserializationError
+{
+public:
+    enum Code
+    {
+        Ok,
+        EmptyInput,
+        IncompleteInput,
+        InvalidInput,
+        NoMemory,
+        TooDeep
+    };
+
+    DeserializationError(Code code = Ok) : errorCode(code) {}
+    Code code() const { return this->errorCode; }
+    const char *c_str() const;
+    explicit operator bool() const { return this->errorCode != Ok; }
+    bool operator==(Code code) const { return this->errorCode == code; }
+    bool operator!=(Code code) const { return this->errorCode != code; }
+
+private:
+    Code errorCode;
+};
+
+/**
+ * @brief One value of the document
+ *
+ */
+struct JsonSlot
+{
+    enum Kind : uint8_t
+    {
+        Null,
+        Bool,
+        Integer,
+        Float,
+        String,
+        Object,
+        Array
+    };
+
+    const char *key = nullptr;
+    Kind kind = Null;
+    union
+    {
+        bool asBool;
+        long asInteger;
+        double asFloat;
+        const char *asString;
+    };
+};
+
+/**
+ * @brief Read access to one member. Null if the member does not exist
+ *
+ */
+class JsonVariant
+{
+public:
+    JsonVariant(const JsonSlot *slot = nullptr) : slot(slot) {}
+
+    bool isNull() const { return this->slot == nullptr || this->slot->kind == JsonSlot::Null; }
+    template <class T>
+    bool is() const;
+    template <class T>
+    T as() const;
+
+private:
+    const JsonSlot *slot;
+};
+
+/**
+ * @brief Result of doc[key]. Reads like a JsonVariant, assigning adds or replaces the member
+ *
+ */
+class JsonMemberProxy
+{
+public:
+    JsonMemberProxy(JsonDocument &document, const char *key) : document(document), key(key) {}
+
+    operator JsonVariant() const;
+    bool isNull() const { return JsonVariant(*this).isNull(); }
+    template <class T>
+    bool is() const { return JsonVariant(*this).is<T>(); }
+    template <class T>
+    T as() const { return JsonVariant(*this).as<T>(); }
+
+    JsonMemberProxy &operator=(const char *value);
+    JsonMemberProxy &operator=(const String &value);
+    template <class T, typename std::enable_if<std::is_arithmetic<T>::value, int>::type = 0>
+    JsonMemberProxy &operator=(T value)
+    {
+        JsonSlot slot;
+        if (std::is_same<T, bool>::value)
+        {
+            slot.kind = JsonSlot::Bool;
+            slot.asBool = value;
+        }
+        else if (std::is_integral<T>::value)
+        {
+            slot.kind = JsonSlot::Integer;
+            slot.asInteger = (long)value;
+        }
+        else
+        {
+            slot.kind = JsonSlot::Float;
+            slot.asFloat = (double)value;
+        }
+        this->Set(slot);
+        return *this;
+    }
+
+private:
+    JsonDocument &document;
+    const char *key;
+
+    void Set(JsonSlot slot);
+};
+
+/**
+ * @brief Document with a fixed memory pool. A slot costs 16 bytes like on the 32 bit controller, copied strings their length + 1
+ *
+ */
+class JsonDocument
+{
+public:
+    void clear();
+    size_t capacity() const { return this->poolCapacity; }
+    size_t memoryUsage() const { return this->slotCount * 16 + this->stringsUsed; }
+    bool overflowed() const { return this->overflow; }
+    template <class T>
+    bool is() const;
+
+    JsonMemberProxy operator[](const char *key) { return JsonMemberProxy(*this, key); }
+    JsonVariant operator[](const char *key) const { return JsonVariant(this->Find(key)); }
+
+protected:
+    JsonDocument(JsonSlot *slots, char *strings, size_t capacity) : slots(slots), strings(strings), poolCapacity(capacity) {}
+
+private:
+    friend class JsonMemberProxy;
+    friend class JsonParser;
+    friend DeserializationError deserializeJson(JsonDocument &document, char *input);
+    friend size_t serializeJson(const JsonDocument &document, char *output, size_t size);
+
+    JsonSlot *slots;
+    char *strings;
+    size_t poolCapacity;
+    size_t slotCount = 0;
+    size_t stringsUsed = 0;
+    bool isObject = false;
+    bool overflow = false;
+
+    const JsonSlot *Find(const char *key) const;
+    JsonSlot *AddSlot();
+    const char *CopyString(const char *text);
+};
+
+template <size_t N>
+class StaticJsonDocument : public JsonDocument
+{
+public:
+    StaticJsonDocument() : JsonDocument(this->slotBuffer, this->stringBuffer, N) {}
+
+private:
+    JsonSlot slotBuffer[N / 16 + 1];
+    char stringBuffer[N + 1];
+};
+
+DeserializationError deserializeJson(JsonDocument &document, char *input);
+size_t serializeJson(const JsonDocument &document, char *output, size_t size);
+
+// ================================ TEMPLATES ================================ //
+template <>
+inline bool JsonDocument::is<JsonObject>() const { return this->isObject; }
+
+template <>
+inline bool JsonVariant::is<bool>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::Bool; }
+template <>
+inline bool JsonVariant::is<long>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::Integer; }
+template <>
+inline bool JsonVariant::is<int>() const { return this->is<long>(); }
+template <>
+inline bool JsonVariant::is<double>() const { return this->slot != nullptr && (this->slot->kind == JsonSlot::Float || this->slot->kind == JsonSlot::Integer); }
+template <>
+inline bool JsonVariant::is<const char *>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::String; }
+template <>
+inline bool JsonVariant::is<JsonObject>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::Object; }
+template <>
+inline bool JsonVariant::is<JsonArray>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::Array; }
+
+template <>
+inline long JsonVariant::as<long>() const
+{
+    if (this->slot == nullptr)
+    {
+        return 0;
+    }
+    switch (this->slot->kind)
+    {
+    case JsonSlot::Bool:
+        return this->slot->asBool;
+    case JsonSlot::Integer:
+        return this->slot->asInteger;
+    case JsonSlot::Float:
+        return (long)this->slot->asFloat;
+    default:
+        return 0;
+    }
+}
+template <>
+inline int JsonVariant::as<int>() const { return (int)this->as<long>(); }
+template <>
+inline bool JsonVariant::as<bool>() const { return this->as<long>() != 0; }
+template <>
+inline double JsonVariant::as<double>() const { return this->slot != nullptr && this->slot->kind == JsonSlot::Float ? this->slot->asFloat : (double)this->as<long>(); }
+template <>
+inline const char *JsonVariant::as<const char *>() const { return this->is<const char *>() ? this->slot->asString : nullptr; }
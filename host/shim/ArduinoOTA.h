@@ -0,0 +1,43 @@
+#pragma once
+
+// Host shim of ArduinoOTA. There are no updates on the host => The callbacks only get stored
+
+#include <Arduino.h>
+
+#define U_FLASH 0
+#define U_FS 100
+
+typedef enum
+{
+    OTA_AUTH_ERROR,
+    OTA_BEGIN_ERROR,
+    OTA_CONNECT_ERROR,
+    OTA_RECEIVE_ERROR,
+    OTA_END_ERROR
+} ota_error_t;
+
+class ArduinoOTAClass
+{
+public:
+    typedef std::function<void(void)> THandlerFunction;
+    typedef std::function<void(ota_error_t)> THandlerFunction_Error;
+    typedef std::function<void(unsigned int, unsigned int)> THandlerFunction_Progress;
+
+    void setHostname(const char *hostname) { (void)hostname; }
+    void setPassword(const char *password) { (void)password; }
+    void onStart(THandlerFunction callback) { this->startCallback = callback; }
+    void onEnd(THandlerFunction callback) { this->endCallback = callback; }
+    void onError(THandlerFunction_Error callback) { this->errorCallback = callback; }
+    void onProgress(THandlerFunction_Progress callback) { this->progressCallback = callback; }
+    void begin(bool useMDNS = true) { (void)useMDNS; }
+    void handle() {}
+    int getCommand() { return U_FLASH; }
+
+private:
+    THandlerFunction startCallback;
+    THandlerFunction endCallback;
+    THandlerFunction_Error errorCallback;
+    THandlerFunction_Progress progressCallback;
+};
+
+extern ArduinoOTAClass ArduinoOTA;
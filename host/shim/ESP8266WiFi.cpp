@@ -0,0 +1,135 @@
+#include "ESP8266WiFi.h"
+#include "HostEnvironment.h"
+#include "HostNetwork.h"
+
+ESP8266WiFiClass WiFi;
+EspClass ESP;
+
+// ================================ STATION ================================ //
+bool ESP8266WiFiClass::mode(WiFiMode_t mode)
+{
+    if (mode == WIFI_OFF)
+    {
+        HostNode::Current().wifiStarted = false;
+    }
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::begin(const String &ssid, const String &passphrase)
+{
+    (void)ssid;
+    (void)passphrase;
+    HostNode::Current().wifiStarted = true;
+    return this->status();
+}
+
+bool ESP8266WiFiClass::disconnect(bool wifioff)
+{
+    (void)wifioff;
+    HostNode::Current().wifiStarted = false;
+    return true;
+}
+
+wl_status_t ESP8266WiFiClass::status()
+{
+    HostNode &node = HostNode::Current();
+    if (node.isWiFiConnected())
+    {
+        return WL_CONNECTED;
+    }
+    return node.wifiStarted ? WL_NO_SSID_AVAIL : WL_DISCONNECTED;
+}
+
+IPAddress ESP8266WiFiClass::localIP()
+{
+    return this->isConnected() ? HostNode::Current().ipAddress : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::subnetMask()
+{
+    return this->isConnected() ? HostNode::Current().subnetMask : IPAddress();
+}
+
+IPAddress ESP8266WiFiClass::gatewayIP()
+{
+    return this->isConnected() ? HostNode::Current().gatewayIpAddress : IPAddress();
+}
+
+String ESP8266WiFiClass::macAddress()
+{
+    uint8_t *mac = HostNode::Current().macAddress;
+    char text[18];
+    snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X", mac[0], mac[1], mac[2], mac[3], mac[4], mac[5]);
+    return String(text);
+}
+
+uint8_t *ESP8266WiFiClass::macAddress(uint8_t *mac)
+{
+    memcpy(mac, HostNode::Current().macAddress, 6);
+    return mac;
+}
+
+String ESP8266WiFiClass::hostname()
+{
+    return String(HostNode::Current().hostname);
+}
+
+bool ESP8266WiFiClass::hostname(const char *name)
+{
+    HostNode::Current().hostname = name;
+    return true;
+}
+
+int ESP8266WiFiClass::hostByName(const char *name, IPAddress &ipAddress, uint32_t timeout)
+{
+    if (HostNetwork::Resolve(name, ipAddress))
+    {
+        return 1;
+    }
+    // Unknown name => The lookup blocks until the timeout like on the controller
+    delay(timeout);
+    return 0;
+}
+
+// ================================ ACCESS POINT ================================ //
+bool ESP8266WiFiClass::softAPConfig(IPAddress localIP, IPAddress gateway, IPAddress subnet)
+{
+    (void)localIP;
+    (void)gateway;
+    (void)subnet;
+    return true;
+}
+
+bool ESP8266WiFiClass::softAP(const char *ssid, const char *passphrase, int channel, int hidden, int maxConnection)
+{
+    (void)ssid;
+    (void)passphrase;
+    (void)channel;
+    (void)hidden;
+    (void)maxConnection;
+    return true;
+}
+
+bool ESP8266WiFiClass::softAPdisconnect(bool wifioff)
+{
+    (void)wifioff;
+    return true;
+}
+
+IPAddress ESP8266WiFiClass::softAPIP()
+{
+    return IPAddress(192, 168, 4, 1);
+}
+
+// ================================ ESP ================================ //
+uint32_t EspClass::getChipId()
+{
+    return HostNode::Current().chipId;
+}
+
+uint32_t EspClass::getFreeHeap()
+{
+    HostNode &node = HostNode::Current();
+    uint64_t used = node.getHeapBytesInUse();
+    return used < node.heapSize ? (uint32_t)(node.heapSize - used) : 0;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+// Host shim of the ESP8266WiFi library. Acts on the selected HostNode
+
+#include <Arduino.h>
+#include <WiFiClient.h>
+#include <WiFiUdp.h>
+
+typedef enum WiFiMode
+{
+    WIFI_OFF = 0,
+    WIFI_STA = 1,
+    WIFI_AP = 2,
+    WIFI_AP_STA = 3
+} WiFiMode_t;
+
+typedef enum
+{
+    WL_NO_SHIELD = 255,
+    WL_IDLE_STATUS = 0,
+    WL_NO_SSID_AVAIL = 1,
+    WL_SCAN_COMPLETED = 2,
+    WL_CONNECTED = 3,
+    WL_CONNECT_FAILED = 4,
+    WL_CONNECTION_LOST = 5,
+    WL_WRONG_PASSWORD = 6,
+    WL_DISCONNECTED = 7
+} wl_status_t;
+
+class ESP8266WiFiClass
+{
+public:
+    // ---- Station
+    bool mode(WiFiMode_t mode);
+    wl_status_t begin(const String &ssid, const String &passphrase = String());
+    bool disconnect(bool wifioff = false);
+    wl_status_t status();
+    bool isConnected() { return this->status() == WL_CONNECTED; }
+    IPAddress localIP();
+    IPAddress subnetMask();
+    IPAddress gatewayIP();
+    String macAddress();
+    uint8_t *macAddress(uint8_t *mac);
+    String hostname();
+    bool hostname(const char *name);
+    bool hostname(const String &name) { return this->hostname(name.c_str()); }
+    int hostByName(const char *name, IPAddress &ipAddress, uint32_t timeout = 10000);
+    int32_t RSSI() { return -60; }
+
+    // ---- Access point
+    bool softAPConfig(IPAddress localIP, IPAddress gateway, IPAddress subnet);
+    bool softAP(const char *ssid, const char *passphrase = nullptr, int channel = 1, int hidden = 0, int maxConnection = 4);
+    bool softAP(const String &ssid, const String &passphrase = String(), int channel = 1, int hidden = 0, int maxConnection = 4)
+    {
+        return this->softAP(ssid.c_str(), passphrase.c_str(), channel, hidden, maxConnection);
+    }
+    bool softAPdisconnect(bool wifioff = false);
+    uint8_t softAPgetStationNum() { return 0; }
+    IPAddress softAPIP();
+};
+
+extern ESP8266WiFiClass WiFi;
+
+class EspClass
+{
+public:
+    uint32_t getChipId();
+    uint32_t getFreeHeap();
+    uint32_t getMaxFreeBlockSize() { return this->getFreeHeap(); }
+    uint8_t getHeapFragmentation() { return 0; }
+    void restart() {}
+};
+
+extern EspClass ESP;
@@ -0,0 +1,26 @@
+#pragma once
+
+// Host shim of the mDNS responder. Nothing gets announced on the host
+
+#include <Arduino.h>
+
+class MDNSResponder
+{
+public:
+    bool begin(const String &hostname)
+    {
+        (void)hostname;
+        return true;
+    }
+    bool close() { return true; }
+    bool update() { return true; }
+    bool addService(const char *service, const char *protocol, uint16_t port)
+    {
+        (void)service;
+        (void)protocol;
+        (void)port;
+        return true;
+    }
+};
+
+extern MDNSResponder MDNS;
@@ -0,0 +1,150 @@
+#include "ESPAsyncTCP.h"
+#include "HostEnvironment.h"
+
+AsyncClient::AsyncClient() : node(&HostNode::Current())
+{
+    HostNetwork::Register(this);
+}
+
+AsyncClient::~AsyncClient()
+{
+    HostNetwork::Unregister(this);
+    if (this->socket)
+    {
+        this->socket->Close();
+    }
+}
+
+bool AsyncClient::connect(IPAddress ip, uint16_t port)
+{
+    if (this->socket || this->pendingConnect)
+    {
+        return false;
+    }
+    this->node = &HostNode::Current();
+    this->socket = HostNetwork::Connect(this->node, ip, port);
+    this->pendingConnect = true; // Refused connects get reported from the pump as disconnect
+    this->pendingDisconnect = !this->socket;
+    return true;
+}
+
+void AsyncClient::close(bool now)
+{
+    (void)now;
+    if (this->socket)
+    {
+        this->socket->Close();
+        this->pendingDisconnect = true;
+    }
+    this->sendBuffer.clear();
+}
+
+bool AsyncClient::connected() const
+{
+    return this->socket && this->socket->isOpen() && !this->pendingConnect;
+}
+
+size_t AsyncClient::space() const
+{
+    return this->connected() ? ASYNC_SEND_BUFFER_SIZE - this->sendBuffer.size() : 0;
+}
+
+size_t AsyncClient::add(const char *data, size_t size, uint8_t apiflags)
+{
+    (void)apiflags;
+    size_t free = this->space();
+    if (size > free)
+    {
+        size = free;
+    }
+    this->sendBuffer.insert(this->sendBuffer.end(), data, data + size);
+    return size;
+}
+
+bool AsyncClient::send()
+{
+    if (!this->connected())
+    {
+        return false;
+    }
+    // Acknowledged instantly => The send buffer is free again after every send
+    this->socket->Write(this->sendBuffer.data(), this->sendBuffer.size());
+    this->sendBuffer.clear();
+    return true;
+}
+
+IPAddress AsyncClient::remoteIP() const
+{
+    return this->socket ? this->socket->remoteIP : IPAddress();
+}
+
+uint16_t AsyncClient::remotePort() const
+{
+    return this->socket ? this->socket->remotePort : 0;
+}
+
+void AsyncClient::onConnect(AcConnectHandler callback, void *arg)
+{
+    this->connectCallback = callback;
+    this->connectArg = arg;
+}
+
+void AsyncClient::onDisconnect(AcConnectHandler callback, void *arg)
+{
+    this->disconnectCallback = callback;
+    this->disconnectArg = arg;
+}
+
+void AsyncClient::onData(AcDataHandler callback, void *arg)
+{
+    this->dataCallback = callback;
+    this->dataArg = arg;
+}
+
+void AsyncClient::onError(AcErrorHandler callback, void *arg)
+{
+    this->errorCallback = callback;
+    this->errorArg = arg;
+}
+
+void AsyncClient::Pump()
+{
+    HostNode &previous = HostNode::Current();
+    this->node->Select();
+
+    if (this->pendingConnect && this->socket && this->socket->isOpen())
+    {
+        this->pendingConnect = false;
+        if (this->connectCallback)
+        {
+            this->connectCallback(this->connectArg, this);
+        }
+    }
+
+    // Everything the peer sent so far, cut into segments like lwIP hands them over
+    uint8_t segment[ASYNC_MAX_SEGMENT_SIZE];
+    while (this->socket && !this->socket->received.empty())
+    {
+        size_t length = this->socket->Read(segment, sizeof(segment));
+        if (this->dataCallback)
+        {
+            this->dataCallback(this->dataArg, this, segment, length);
+        }
+    }
+
+    // Closed by either side or refused => Reported once as disconnect
+    bool lost = this->socket && (!this->socket->isOpen() || this->pendingDisconnect);
+    if (lost || (!this->socket && this->pendingDisconnect))
+    {
+        this->socket.reset();
+        this->pendingConnect = false;
+        this->pendingDisconnect = false;
+        this->sendBuffer.clear();
+        if (this->disconnectCallback)
+        {
+            this->disconnectCallback(this->disconnectArg, this);
+        }
+    }
+
+    previous.Select();
+}
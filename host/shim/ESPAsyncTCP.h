@@ -0,0 +1,70 @@
+#pragma once
+
+// Host shim of ESPAsyncTCP. Connect results, received data and disconnects arrive as callbacks from HostNetwork::Pump()
+// => Same as on the controller they never run inside a call of the firmware
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+#include "HostNetwork.h"
+
+#define ASYNC_WRITE_FLAG_COPY 0x01
+#define ASYNC_WRITE_FLAG_MORE 0x02
+#define ASYNC_MAX_SEGMENT_SIZE 1460 // TCP MSS of lwIP on the ESP8266
+#define ASYNC_SEND_BUFFER_SIZE 5744 // TCP_SND_BUF => 4 * MSS
+
+class AsyncClient;
+
+typedef std::function<void(void *, AsyncClient *)> AcConnectHandler;
+typedef std::function<void(void *, AsyncClient *, void *data, size_t len)> AcDataHandler;
+typedef std::function<void(void *, AsyncClient *, int8_t error)> AcErrorHandler;
+
+class AsyncClient : public HostPumped
+{
+public:
+    AsyncClient();
+    ~AsyncClient();
+
+    bool connect(IPAddress ip, uint16_t port);
+    void close(bool now = false);
+    bool connected() const;
+    bool connecting() const { return this->pendingConnect; }
+    bool freeable() const { return !this->connected() && !this->pendingConnect; }
+
+    size_t space() const;
+    size_t add(const char *data, size_t size, uint8_t apiflags = ASYNC_WRITE_FLAG_COPY);
+    bool send();
+    size_t write(const char *data, size_t size)
+    {
+        size_t written = this->add(data, size);
+        this->send();
+        return written;
+    }
+
+    void setNoDelay(bool noDelay) { (void)noDelay; }
+    IPAddress remoteIP() const;
+    uint16_t remotePort() const;
+
+    void onConnect(AcConnectHandler callback, void *arg = nullptr);
+    void onDisconnect(AcConnectHandler callback, void *arg = nullptr);
+    void onData(AcDataHandler callback, void *arg = nullptr);
+    void onError(AcErrorHandler callback, void *arg = nullptr);
+
+    virtual void Pump();
+
+private:
+    HostNode *node;
+    std::shared_ptr<HostTcpSocket> socket;
+    std::vector<uint8_t> sendBuffer;
+    bool pendingConnect = false;
+    bool pendingDisconnect = false;
+
+    AcConnectHandler connectCallback;
+    void *connectArg = nullptr;
+    AcConnectHandler disconnectCallback;
+    void *disconnectArg = nullptr;
+    AcDataHandler dataCallback;
+    void *dataArg = nullptr;
+    AcErrorHandler errorCallback;
+    void *errorArg = nullptr;
+};
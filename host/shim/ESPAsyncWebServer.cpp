@@ -0,0 +1,216 @@
+#include "ESPAsyncWebServer.h"
+#include "HostEnvironment.h"
+#include <algorithm>
+
+static std::vector<AsyncWebSocket *> &WebSockets()
+{
+    static std::vector<AsyncWebSocket *> sockets;
+    return sockets;
+}
+
+static std::vector<AsyncWebServer *> &WebServers()
+{
+    static std::vector<AsyncWebServer *> servers;
+    return servers;
+}
+
+// ================================ REQUEST ================================ //
+String AsyncWebServerRequest::arg(const char *name) const
+{
+    auto argument = this->arguments.find(name);
+    return argument != this->arguments.end() ? String(argument->second) : String();
+}
+
+void AsyncWebServerRequest::send(int code, const char *contentType, const String &content)
+{
+    this->responseCode = code;
+    this->responseContentType = contentType;
+    this->responseContent = content;
+}
+
+// ================================ WEBSOCKET ================================ //
+void AsyncWebSocketClient::text(const String &message)
+{
+    this->server->text(this->clientId, message);
+}
+
+AsyncWebSocket::AsyncWebSocket(const String &url) : node(&HostNode::Current()), socketUrl(url)
+{
+    WebSockets().push_back(this);
+}
+
+AsyncWebSocket::AsyncWebSocket(const AsyncWebSocket &other) : node(other.node), socketUrl(other.socketUrl)
+{
+    WebSockets().push_back(this);
+}
+
+AsyncWebSocket::~AsyncWebSocket()
+{
+    std::vector<AsyncWebSocket *> &sockets = WebSockets();
+    sockets.erase(std::remove(sockets.begin(), sockets.end(), this), sockets.end());
+}
+
+void AsyncWebSocket::closeAll(uint16_t code, const char *message)
+{
+    (void)code;
+    (void)message;
+    while (!this->clients.empty())
+    {
+        this->HostDisconnect(this->clients.front().id());
+    }
+}
+
+void AsyncWebSocket::text(uint32_t id, const String &message)
+{
+    if (this->onHostText)
+    {
+        this->onHostText(id, message);
+    }
+}
+
+void AsyncWebSocket::textAll(const String &message)
+{
+    if (this->onHostText && !this->clients.empty())
+    {
+        this->onHostText(0, message);
+    }
+}
+
+AsyncWebSocket *AsyncWebSocket::Find(HostNode *node, const char *url)
+{
+    for (AsyncWebSocket *socket : WebSockets())
+    {
+        if (socket->node == node && strcmp(socket->url(), url) == 0)
+        {
+            return socket;
+        }
+    }
+    return nullptr;
+}
+
+uint32_t AsyncWebSocket::HostConnect()
+{
+    uint32_t id = this->nextClientId++;
+    this->clients.emplace_back(this, id);
+    if (this->eventHandler)
+    {
+        this->eventHandler(this, &this->clients.back(), WS_EVT_CONNECT, nullptr, nullptr, 0);
+    }
+    return id;
+}
+
+void AsyncWebSocket::HostDisconnect(uint32_t id)
+{
+    auto client = std::find_if(this->clients.begin(), this->clients.end(), [id](const AsyncWebSocketClient &client)
+                               { return client.id() == id; });
+    if (client == this->clients.end())
+    {
+        return;
+    }
+    AsyncWebSocketClient disconnected = *client;
+    this->clients.erase(client);
+    if (this->eventHandler)
+    {
+        this->eventHandler(this, &disconnected, WS_EVT_DISCONNECT, nullptr, nullptr, 0);
+    }
+}
+
+void AsyncWebSocket::HostText(uint32_t id, const char *message)
+{
+    auto client = std::find_if(this->clients.begin(), this->clients.end(), [id](const AsyncWebSocketClient &client)
+                               { return client.id() == id; });
+    if (client == this->clients.end() || !this->eventHandler)
+    {
+        return;
+    }
+    size_t length = strlen(message);
+    // One byte more like the library => The handler may terminate the text in place
+    this->frame.assign(message, message + length);
+    this->frame.push_back(0);
+
+    AwsFrameInfo info = {};
+    info.message_opcode = WS_TEXT;
+    info.final = 1;
+    info.opcode = WS_TEXT;
+    info.len = length;
+    info.index = 0;
+    this->eventHandler(this, &*client, WS_EVT_DATA, &info, this->frame.data(), length);
+}
+
+// ================================ SERVER ================================ //
+AsyncWebServer::AsyncWebServer(uint16_t port) : node(&HostNode::Current()), port(port)
+{
+    WebServers().push_back(this);
+}
+
+AsyncWebServer::AsyncWebServer(const AsyncWebServer &other) : node(other.node), port(other.port)
+{
+    WebServers().push_back(this);
+}
+
+AsyncWebServer::~AsyncWebServer()
+{
+    std::vector<AsyncWebServer *> &servers = WebServers();
+    servers.erase(std::remove(servers.begin(), servers.end(), this), servers.end());
+}
+
+AsyncCallbackWebHandler &AsyncWebServer::on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest)
+{
+    this->ownHandlers.emplace_back(new AsyncCallbackWebHandler(uri, method, onRequest));
+    this->handlers.push_back(this->ownHandlers.back().get());
+    return *this->ownHandlers.back();
+}
+
+AsyncWebHandler &AsyncWebServer::addHandler(AsyncWebHandler *handler)
+{
+    this->handlers.push_back(handler);
+    return *handler;
+}
+
+bool AsyncWebServer::removeHandler(AsyncWebHandler *handler)
+{
+    auto found = std::find(this->handlers.begin(), this->handlers.end(), handler);
+    if (found == this->handlers.end())
+    {
+        return false;
+    }
+    this->handlers.erase(found);
+    this->ownHandlers.erase(std::remove_if(this->ownHandlers.begin(), this->ownHandlers.end(), [handler](const std::unique_ptr<AsyncCallbackWebHandler> &own)
+                                           { return own.get() == handler; }),
+                            this->ownHandlers.end());
+    return true;
+}
+
+AsyncWebServer *AsyncWebServer::Find(HostNode *node, uint16_t port)
+{
+    for (AsyncWebServer *server : WebServers())
+    {
+        if (server->node == node && server->port == port)
+        {
+            return server;
+        }
+    }
+    return nullptr;
+}
+
+AsyncWebServerRequest AsyncWebServer::HostRequest(WebRequestMethod method, const char *url, const std::map<std::string, std::string> &arguments)
+{
+    AsyncWebServerRequest request(method, url, arguments);
+    for (AsyncWebHandler *handler : this->handlers)
+    {
+        if (handler->canHandle(&request))
+        {
+            handler->handleRequest(&request);
+            return request;
+        }
+    }
+    if (this->notFound)
+    {
+        this->notFound(&request);
+    }
+    else
+    {
+        request.send(404);
+    }
+    return request;
+}
@@ -0,0 +1,181 @@
+#pragma once
+
+// Host shim of ESPAsyncWebServer. Requests and websocket frames get injected by the host
+// through the registry of the selected node => See AsyncWebSocket::Find and AsyncWebServer::Find
+
+#include <Arduino.h>
+#include <ESPAsyncTCP.h>
+#include <map>
+#include <vector>
+
+typedef enum
+{
+    HTTP_GET = 0b00000001,
+    HTTP_POST = 0b00000010,
+    HTTP_DELETE = 0b00000100,
+    HTTP_PUT = 0b00001000,
+    HTTP_PATCH = 0b00010000,
+    HTTP_HEAD = 0b00100000,
+    HTTP_OPTIONS = 0b01000000,
+    HTTP_ANY = 0b01111111,
+} WebRequestMethod;
+typedef uint8_t WebRequestMethodComposite;
+
+typedef enum
+{
+    WS_EVT_CONNECT,
+    WS_EVT_DISCONNECT,
+    WS_EVT_PONG,
+    WS_EVT_ERROR,
+    WS_EVT_DATA
+} AwsEventType;
+
+typedef enum
+{
+    WS_CONTINUATION,
+    WS_TEXT,
+    WS_BINARY,
+    WS_DISCONNECT = 0x08,
+    WS_PING,
+    WS_PONG
+} AwsFrameType;
+
+typedef struct
+{
+    uint8_t message_opcode;
+    uint32_t num;
+    uint8_t final;
+    uint8_t masked;
+    uint8_t opcode;
+    uint64_t len;
+    uint8_t mask[4];
+    uint64_t index;
+} AwsFrameInfo;
+
+class AsyncWebServerRequest
+{
+public:
+    AsyncWebServerRequest(WebRequestMethod method, const String &url, const std::map<std::string, std::string> &arguments) : method(method), requestUrl(url), arguments(arguments) {}
+
+    WebRequestMethod methodToString() const { return this->method; }
+    const String &url() const { return this->requestUrl; }
+    bool hasArg(const char *name) const { return this->arguments.find(name) != this->arguments.end(); }
+    String arg(const char *name) const;
+    void send(int code, const char *contentType = "", const String &content = String());
+    void send_P(int code, const char *contentType, const char *content) { this->send(code, contentType, String(content)); }
+
+    // ---- Response for the host
+    int responseCode = 0;
+    String responseContentType;
+    String responseContent;
+
+private:
+    WebRequestMethod method;
+    String requestUrl;
+    std::map<std::string, std::string> arguments;
+};
+
+typedef std::function<void(AsyncWebServerRequest *request)> ArRequestHandlerFunction;
+
+class AsyncWebHandler
+{
+public:
+    virtual ~AsyncWebHandler() {}
+    virtual bool canHandle(AsyncWebServerRequest *request) { return false; }
+    virtual void handleRequest(AsyncWebServerRequest *request) {}
+};
+
+class AsyncCallbackWebHandler : public AsyncWebHandler
+{
+public:
+    AsyncCallbackWebHandler(const String &uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest) : uri(uri), method(method), onRequest(onRequest) {}
+    virtual bool canHandle(AsyncWebServerRequest *request) { return (request->methodToString() & this->method) && request->url() == this->uri; }
+    virtual void handleRequest(AsyncWebServerRequest *request)
+    {
+        if (this->onRequest)
+        {
+            this->onRequest(request);
+        }
+    }
+
+private:
+    String uri;
+    WebRequestMethodComposite method;
+    ArRequestHandlerFunction onRequest;
+};
+
+class AsyncWebSocket;
+
+class AsyncWebSocketClient
+{
+public:
+    AsyncWebSocketClient(AsyncWebSocket *server, uint32_t id) : server(server), clientId(id) {}
+    uint32_t id() const { return this->clientId; }
+    void text(const String &message);
+
+private:
+    AsyncWebSocket *server;
+    uint32_t clientId;
+};
+
+typedef std::function<void(AsyncWebSocket *server, AsyncWebSocketClient *client, AwsEventType type, void *arg, uint8_t *data, size_t len)> AwsEventHandler;
+
+class AsyncWebSocket : public AsyncWebHandler
+{
+public:
+    AsyncWebSocket(const String &url);
+    AsyncWebSocket(const AsyncWebSocket &other);
+    ~AsyncWebSocket();
+
+    const char *url() const { return this->socketUrl.c_str(); }
+    void onEvent(AwsEventHandler handler) { this->eventHandler = handler; }
+    size_t count() const { return this->clients.size(); }
+    void cleanupClients(uint16_t maxClients = 8) { (void)maxClients; }
+    void closeAll(uint16_t code = 0, const char *message = nullptr);
+    void text(uint32_t id, const char *message) { this->text(id, String(message)); }
+    void text(uint32_t id, const String &message);
+    void textAll(const char *message) { this->textAll(String(message)); }
+    void textAll(const String &message);
+
+    // ---- Host side
+    static AsyncWebSocket *Find(HostNode *node, const char *url);
+    uint32_t HostConnect();
+    void HostDisconnect(uint32_t id);
+    void HostText(uint32_t id, const char *message); // One final text frame from the client
+    std::function<void(uint32_t id, const String &message)> onHostText; // Every message the controller sends. id 0 => All clients
+
+private:
+    HostNode *node;
+    String socketUrl;
+    AwsEventHandler eventHandler;
+    std::vector<AsyncWebSocketClient> clients;
+    uint32_t nextClientId = 1;
+    std::vector<uint8_t> frame;
+};
+
+class AsyncWebServer
+{
+public:
+    AsyncWebServer(uint16_t port);
+    AsyncWebServer(const AsyncWebServer &other);
+    ~AsyncWebServer();
+
+    void begin() { this->started = true; }
+    void end() { this->started = false; }
+    AsyncCallbackWebHandler &on(const char *uri, WebRequestMethodComposite method, ArRequestHandlerFunction onRequest);
+    AsyncWebHandler &addHandler(AsyncWebHandler *handler);
+    bool removeHandler(AsyncWebHandler *handler);
+    void onNotFound(ArRequestHandlerFunction onRequest) { this->notFound = onRequest; }
+
+    // ---- Host side
+    static AsyncWebServer *Find(HostNode *node, uint16_t port);
+    AsyncWebServerRequest HostRequest(WebRequestMethod method, const char *url, const std::map<std::string, std::string> &arguments = {});
+
+private:
+    HostNode *node;
+    uint16_t port;
+    bool started = false;
+    std::vector<AsyncWebHandler *> handlers;
+    std::vector<std::unique_ptr<AsyncCallbackWebHandler>> ownHandlers;
+    ArRequestHandlerFunction notFound;
+};
@@ -0,0 +1,3 @@
+#pragma once
+
+// Host shim of the ESP8266 Hash library. Only included by the webserver, nothing of it is used
@@ -0,0 +1,226 @@
+#include "HostEnvironment.h"
+#include <new>
+
+// ================================ HEAP ================================ //
+// Plain globals => Zero initialized before any constructor runs and allocates
+#define HOST_HEAP_SLOT_COUNT 32
+static uint8_t currentHeapSlot = 0;
+static uint64_t allocationCount = 0;
+static uint64_t bytesInUse[HOST_HEAP_SLOT_COUNT];
+static uint64_t peakBytesInUse[HOST_HEAP_SLOT_COUNT];
+static bool slotTaken[HOST_HEAP_SLOT_COUNT];
+
+struct HeapHeader
+{
+    size_t size;
+    uint8_t slot;
+};
+static const size_t HEAP_HEADER_SIZE = 16; // Keeps the allocation aligned like malloc
+static_assert(sizeof(HeapHeader) <= HEAP_HEADER_SIZE, "Heap header must fit in front of the allocation");
+
+static void *Allocate(size_t size)
+{
+    uint8_t *block = (uint8_t *)malloc(size + HEAP_HEADER_SIZE);
+    if (block == nullptr)
+    {
+        throw std::bad_alloc();
+    }
+    HeapHeader *header = (HeapHeader *)block;
+    header->size = size;
+    header->slot = currentHeapSlot;
+    allocationCount++;
+    bytesInUse[header->slot] += size;
+    if (bytesInUse[header->slot] > peakBytesInUse[header->slot])
+    {
+        peakBytesInUse[header->slot] = bytesInUse[header->slot];
+    }
+    return block + HEAP_HEADER_SIZE;
+}
+
+static void Release(void *pointer)
+{
+    if (pointer == nullptr)
+    {
+        return;
+    }
+    uint8_t *block = (uint8_t *)pointer - HEAP_HEADER_SIZE;
+    HeapHeader *header = (HeapHeader *)block;
+    bytesInUse[header->slot] -= header->size;
+    free(block);
+}
+
+void *operator new(size_t size) { return Allocate(size); }
+void *operator new[](size_t size) { return Allocate(size); }
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    try
+    {
+        return Allocate(size);
+    }
+    catch (...)
+    {
+        return nullptr;
+    }
+}
+void *operator new[](size_t size, const std::nothrow_t &tag) noexcept { return operator new(size, tag); }
+void operator delete(void *pointer) noexcept { Release(pointer); }
+void operator delete[](void *pointer) noexcept { Release(pointer); }
+void operator delete(void *pointer, size_t) noexcept { Release(pointer); }
+void operator delete[](void *pointer, size_t) noexcept { Release(pointer); }
+
+uint64_t HostHeap::getAllocationCount()
+{
+    return allocationCount;
+}
+
+uint64_t HostHeap::getBytesInUse()
+{
+    uint64_t total = 0;
+    for (uint8_t i = 0; i < HOST_HEAP_SLOT_COUNT; i++)
+    {
+        total += bytesInUse[i];
+    }
+    return total;
+}
+
+uint64_t HostHeap::getPeakBytesInUse()
+{
+    uint64_t total = 0;
+    for (uint8_t i = 0; i < HOST_HEAP_SLOT_COUNT; i++)
+    {
+        total += peakBytesInUse[i];
+    }
+    return total;
+}
+
+void HostHeap::ResetPeak()
+{
+    for (uint8_t i = 0; i < HOST_HEAP_SLOT_COUNT; i++)
+    {
+        peakBytesInUse[i] = bytesInUse[i];
+    }
+}
+
+// ================================ NODE ================================ //
+static HostNode *currentNode = nullptr;
+
+HostNode::HostNode()
+{
+    // Slot 0 collects everything the host itself allocates, nodes get their own slot as long as one is free
+    for (uint8_t i = 1; i < HOST_HEAP_SLOT_COUNT; i++)
+    {
+        if (!slotTaken[i])
+        {
+            slotTaken[i] = true;
+            this->heapSlot = i;
+            break;
+        }
+    }
+    bytesInUse[this->heapSlot] = 0;
+    peakBytesInUse[this->heapSlot] = 0;
+    this->pinLevels[0] = HIGH; // The flash button pulls GPIO0 low => Released by default
+}
+
+HostNode::HostNode(uint32_t chipId, IPAddress ipAddress) : HostNode()
+{
+    this->chipId = chipId;
+    this->ipAddress = ipAddress;
+    this->macAddress[3] = (chipId >> 16) & 0xFF;
+    this->macAddress[4] = (chipId >> 8) & 0xFF;
+    this->macAddress[5] = chipId & 0xFF;
+    this->randomState = chipId != 0 ? chipId : 1;
+}
+
+HostNode::~HostNode()
+{
+    if (currentNode == this)
+    {
+        currentNode = nullptr;
+        currentHeapSlot = 0;
+    }
+    if (this->heapSlot != 0)
+    {
+        slotTaken[this->heapSlot] = false;
+    }
+}
+
+HostNode &HostNode::Current()
+{
+    return currentNode != nullptr ? *currentNode : Host();
+}
+
+HostNode &HostNode::Host()
+{
+    static HostNode node;
+    if (node.heapSlot != 0)
+    {
+        // The host counts in slot 0 like the allocations made before any node existed
+        slotTaken[node.heapSlot] = false;
+        node.heapSlot = 0;
+    }
+    return node;
+}
+
+void HostNode::Select()
+{
+    currentNode = this;
+    currentHeapSlot = this->heapSlot;
+}
+
+// ================================ TIME ================================ //
+uint64_t HostTime::getMicros()
+{
+    return HostNode::Current().micros;
+}
+
+void HostTime::Advance(uint64_t micros)
+{
+    HostNode::Current().micros += micros;
+}
+
+uint64_t HostNode::getHeapBytesInUse() const
+{
+    return bytesInUse[this->heapSlot];
+}
+
+uint64_t HostNode::getHeapPeakBytesInUse() const
+{
+    return peakBytesInUse[this->heapSlot];
+}
+
+void HostNode::ResetHeapPeak()
+{
+    peakBytesInUse[this->heapSlot] = bytesInUse[this->heapSlot];
+}
+
+void HostNode::WriteFile(const std::string &path, const std::string &content)
+{
+    this->files[path] = std::vector<uint8_t>(content.begin(), content.end());
+}
+
+std::string HostNode::ReadFile(const std::string &path) const
+{
+    auto file = this->files.find(path);
+    return file != this->files.end() ? std::string(file->second.begin(), file->second.end()) : std::string();
+}
+
+void HostNode::WriteConfiguration(const char *wifiSSID,
+                                  const char *wifiPassword,
+                                  const char *brokerIpAddress,
+                                  uint16_t brokerPort,
+                                  const char *brokerUsername,
+                                  const char *brokerPassword,
+                                  const char *clientName)
+{
+    // Same layout Filesystem::saveConfigurationData writes => One println per value
+    std::string content;
+    content += std::string(wifiSSID) + "\r\n";
+    content += std::string(wifiPassword) + "\r\n";
+    content += std::string(brokerIpAddress) + "\r\n";
+    content += std::to_string(brokerPort) + "\r\n";
+    content += std::string(brokerUsername) + "\r\n";
+    content += std::string(brokerPassword) + "\r\n";
+    content += std::string(clientName) + "\r\n";
+    content += "1\r\n";
+    this->WriteFile("/ConfigurationData.dat", content);
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Simulated hardware behind the host shims. Not part of the Arduino API => Only used by the host tools and tests
+
+#include <Arduino.h>
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The simulated time of the selected node. Starts at 0 and only moves when the host advances it or the firmware blocks in delay().
+ * Every node has its own time => A controller blocked in a delay falls behind the host and catches up in the following steps
+ *
+ */
+class HostTime
+{
+public:
+    static uint64_t getMicros();
+    static void Advance(uint64_t micros);
+};
+
+/**
+ * @brief The hardware of one simulated controller. The Arduino globals (WiFi, ESP, LittleFS, pins, random) act on the selected node.
+ * Every simulated controller owns one node and selects it before its code runs
+ *
+ */
+class HostNode
+{
+public:
+    HostNode();
+    HostNode(uint32_t chipId, IPAddress ipAddress);
+    ~HostNode();
+
+    // ---- Selection
+    static HostNode &Current();
+    static HostNode &Host(); // Selected while no controller runs => Its time is the time of the host side services
+    void Select();
+
+    // ---- Time
+    uint64_t micros = 0;
+
+    // ---- Identity
+    uint32_t chipId = 0x00A1B2C3;
+    IPAddress ipAddress = IPAddress(192, 168, 0, 100);
+    IPAddress subnetMask = IPAddress(255, 255, 255, 0);
+    IPAddress gatewayIpAddress = IPAddress(192, 168, 0, 1);
+    uint8_t macAddress[6] = {0x5C, 0xCF, 0x7F, 0x00, 0x00, 0x01};
+
+    // ---- WiFi
+    bool accessPointInRange = true; // False simulates a lost WiFi. The station reconnects once it is back
+    bool wifiStarted = false;
+    std::string hostname = "";
+
+    // ---- Flash
+    std::map<std::string, std::vector<uint8_t>> files;
+    std::map<std::string, uint32_t> fileWriteCounts; // Opens for writing per file => Flash wear
+    bool filesystemMountable = true;
+
+    // ---- GPIO
+    uint8_t pinModes[HOST_PIN_COUNT]{0};
+    uint8_t pinLevels[HOST_PIN_COUNT]{0}; // Inputs get driven by the host, outputs by the firmware
+
+    // ---- Heap
+    uint32_t heapSize = 52000; // Free heap of the ESP8266 after the core started
+    uint64_t getHeapBytesInUse() const;
+    uint64_t getHeapPeakBytesInUse() const;
+    void ResetHeapPeak();
+
+    // ---- Random
+    uint32_t randomState = 1;
+
+    // ---- Helpers
+    uint8_t getHeapSlot() const { return this->heapSlot; }
+    bool isWiFiConnected() const { return this->wifiStarted && this->accessPointInRange; }
+    void WriteFile(const std::string &path, const std::string &content);
+    std::string ReadFile(const std::string &path) const;
+    void WriteConfiguration(const char *wifiSSID,
+                            const char *wifiPassword,
+                            const char *brokerIpAddress,
+                            uint16_t brokerPort,
+                            const char *brokerUsername,
+                            const char *brokerPassword,
+                            const char *clientName);
+
+private:
+    uint8_t heapSlot = 0; // Allocations made while the node is selected get counted in this slot
+};
+
+/**
+ * @brief Counts the heap allocations of the host process. Allocations get attributed to the node that was selected when they were made,
+ * the ESP.getFreeHeap() shim reports the heap size of the node minus its bytes in use
+ *
+ */
+class HostHeap
+{
+public:
+    static uint64_t getAllocationCount();
+    static uint64_t getBytesInUse();
+    static uint64_t getPeakBytesInUse();
+    static void ResetPeak();
+};
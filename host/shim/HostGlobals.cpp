@@ -0,0 +1,8 @@
+#include <Wire.h>
+#include <ESP8266mDNS.h>
+#include <ArduinoOTA.h>
+
+// Globals of the header only shims
+TwoWire Wire;
+MDNSResponder MDNS;
+ArduinoOTAClass ArduinoOTA;
@@ -0,0 +1,272 @@
+#include "HostNetwork.h"
+#include "HostEnvironment.h"
+#include <algorithm>
+
+struct HostNetworkState
+{
+    std::map<std::pair<uint32_t, uint16_t>, HostNetwork::AcceptHandler> listeners;
+    std::vector<std::weak_ptr<HostUdpSocket>> udpSockets;
+    std::map<std::string, IPAddress> hosts;
+    std::vector<HostPumped *> pumped;
+    uint32_t udpLatency = 0;
+    uint32_t udpJitter = 0;
+    uint8_t udpLoss = 0;
+    uint32_t randomState = 1;
+    uint16_t nextEphemeralPort = 49152;
+};
+
+static HostNetworkState &State()
+{
+    static HostNetworkState state;
+    return state;
+}
+
+static uint32_t NextRandom()
+{
+    uint32_t &state = State().randomState;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+// ================================ TCP SOCKET ================================ //
+size_t HostTcpSocket::Write(const uint8_t *data, size_t length)
+{
+    std::shared_ptr<HostTcpSocket> peer = this->peer.lock();
+    if (!this->open || !peer || !peer->open)
+    {
+        return 0;
+    }
+    peer->received.insert(peer->received.end(), data, data + length);
+    if (peer->onReceive)
+    {
+        peer->onReceive(*peer);
+    }
+    return length;
+}
+
+size_t HostTcpSocket::Read(uint8_t *data, size_t length)
+{
+    size_t count = std::min(length, this->received.size());
+    std::copy(this->received.begin(), this->received.begin() + count, data);
+    this->received.erase(this->received.begin(), this->received.begin() + count);
+    return count;
+}
+
+void HostTcpSocket::Close()
+{
+    if (!this->open)
+    {
+        return;
+    }
+    this->open = false;
+    std::shared_ptr<HostTcpSocket> peer = this->peer.lock();
+    if (peer && peer->open)
+    {
+        peer->open = false;
+        if (peer->onClose)
+        {
+            peer->onClose(*peer);
+        }
+    }
+}
+
+// ================================ TCP ================================ //
+void HostNetwork::Listen(IPAddress ipAddress, uint16_t port, AcceptHandler onAccept)
+{
+    State().listeners[{(uint32_t)ipAddress, port}] = onAccept;
+}
+
+void HostNetwork::StopListening(IPAddress ipAddress, uint16_t port)
+{
+    State().listeners.erase({(uint32_t)ipAddress, port});
+}
+
+std::shared_ptr<HostTcpSocket> HostNetwork::Connect(HostNode *node, IPAddress ipAddress, uint16_t port)
+{
+    HostNetworkState &state = State();
+    if (node != nullptr && !node->isWiFiConnected())
+    {
+        return nullptr;
+    }
+    auto listener = state.listeners.find({(uint32_t)ipAddress, port});
+    if (listener == state.listeners.end())
+    {
+        return nullptr; // Connection refused
+    }
+
+    std::shared_ptr<HostTcpSocket> client = std::make_shared<HostTcpSocket>();
+    std::shared_ptr<HostTcpSocket> server = std::make_shared<HostTcpSocket>();
+    client->node = node;
+    client->localIP = node != nullptr ? node->ipAddress : IPAddress(127, 0, 0, 1);
+    client->localPort = state.nextEphemeralPort++;
+    client->remoteIP = ipAddress;
+    client->remotePort = port;
+    server->localIP = ipAddress;
+    server->localPort = port;
+    server->remoteIP = client->localIP;
+    server->remotePort = client->localPort;
+    client->open = true;
+    server->open = true;
+    client->peer = server;
+    server->peer = client;
+    if (state.nextEphemeralPort == 0)
+    {
+        state.nextEphemeralPort = 49152;
+    }
+
+    listener->second(server);
+    return client;
+}
+
+// ================================ UDP ================================ //
+std::shared_ptr<HostUdpSocket> HostNetwork::Bind(HostNode *node, uint16_t port)
+{
+    std::shared_ptr<HostUdpSocket> socket = std::make_shared<HostUdpSocket>();
+    socket->node = node;
+    socket->localPort = port;
+    State().udpSockets.push_back(socket);
+    return socket;
+}
+
+void HostNetwork::Unbind(const std::shared_ptr<HostUdpSocket> &socket)
+{
+    std::vector<std::weak_ptr<HostUdpSocket>> &sockets = State().udpSockets;
+    sockets.erase(std::remove_if(sockets.begin(), sockets.end(), [&socket](const std::weak_ptr<HostUdpSocket> &bound)
+                                 { return bound.expired() || bound.lock() == socket; }),
+                  sockets.end());
+}
+
+/**
+ * @brief Checks if a bound socket receives a datagram to the destination
+ */
+static bool isReceiver(const HostUdpSocket &socket, HostNode *sender, IPAddress destinationIP, uint16_t destinationPort)
+{
+    if (socket.localPort != destinationPort || (sender != nullptr && socket.node == sender))
+    {
+        return false;
+    }
+    if (socket.node == nullptr)
+    {
+        return true;
+    }
+    if (!socket.node->isWiFiConnected())
+    {
+        return false;
+    }
+    if (destinationIP.isMulticast())
+    {
+        return std::find(socket.multicastGroups.begin(), socket.multicastGroups.end(), destinationIP) != socket.multicastGroups.end();
+    }
+    uint32_t mask = socket.node->subnetMask;
+    bool broadcast = destinationIP == IPAddress(255, 255, 255, 255) ||
+                     (((uint32_t)destinationIP & mask) == ((uint32_t)socket.node->ipAddress & mask) && ((uint32_t)destinationIP | mask) == 0xFFFFFFFF);
+    return broadcast || destinationIP == socket.node->ipAddress;
+}
+
+void HostNetwork::Send(HostNode *node, IPAddress sourceIP, uint16_t sourcePort, IPAddress destinationIP, uint16_t destinationPort, const uint8_t *data, size_t length)
+{
+    HostNetworkState &state = State();
+    if (node != nullptr && !node->isWiFiConnected())
+    {
+        return;
+    }
+    for (std::weak_ptr<HostUdpSocket> &bound : state.udpSockets)
+    {
+        std::shared_ptr<HostUdpSocket> socket = bound.lock();
+        if (!socket || !isReceiver(*socket, node, destinationIP, destinationPort))
+        {
+            continue;
+        }
+        if (state.udpLoss > 0 && NextRandom() % 100 < state.udpLoss)
+        {
+            continue;
+        }
+        HostDatagram datagram;
+        datagram.deliverAt = HostTime::getMicros() + state.udpLatency + (state.udpJitter > 0 ? NextRandom() % (state.udpJitter + 1) : 0);
+        datagram.sourceIP = sourceIP;
+        datagram.sourcePort = sourcePort;
+        datagram.destinationIP = destinationIP;
+        datagram.data.assign(data, data + length);
+
+        // Keep the queue sorted by delivery time => Jitter can reorder datagrams like a real network
+        auto position = std::upper_bound(socket->received.begin(), socket->received.end(), datagram.deliverAt, [](uint64_t deliverAt, const HostDatagram &queued)
+                                         { return deliverAt < queued.deliverAt; });
+        socket->received.insert(position, datagram);
+    }
+    state.udpSockets.erase(std::remove_if(state.udpSockets.begin(), state.udpSockets.end(), [](const std::weak_ptr<HostUdpSocket> &bound)
+                                          { return bound.expired(); }),
+                           state.udpSockets.end());
+}
+
+void HostNetwork::SetUdpLatency(uint32_t latencyMicros, uint32_t jitterMicros, uint32_t seed)
+{
+    State().udpLatency = latencyMicros;
+    State().udpJitter = jitterMicros;
+    State().randomState = seed != 0 ? seed : 1;
+}
+
+void HostNetwork::SetUdpLoss(uint8_t lossPercent)
+{
+    State().udpLoss = lossPercent;
+}
+
+// ================================ DNS ================================ //
+void HostNetwork::AddHost(const char *name, IPAddress ipAddress)
+{
+    State().hosts[name] = ipAddress;
+}
+
+bool HostNetwork::Resolve(const char *name, IPAddress &ipAddress)
+{
+    if (ipAddress.fromString(name))
+    {
+        return true;
+    }
+    auto host = State().hosts.find(name);
+    if (host == State().hosts.end())
+    {
+        return false;
+    }
+    ipAddress = host->second;
+    return true;
+}
+
+// ================================ PUMP ================================ //
+void HostNetwork::Register(HostPumped *pumped)
+{
+    State().pumped.push_back(pumped);
+}
+
+void HostNetwork::Unregister(HostPumped *pumped)
+{
+    std::vector<HostPumped *> &list = State().pumped;
+    list.erase(std::remove(list.begin(), list.end(), pumped), list.end());
+}
+
+void HostNetwork::Pump()
+{
+    // Copy => A callback may create or destroy clients
+    std::vector<HostPumped *> list = State().pumped;
+    for (HostPumped *pumped : list)
+    {
+        std::vector<HostPumped *> &current = State().pumped;
+        if (std::find(current.begin(), current.end(), pumped) != current.end())
+        {
+            pumped->Pump();
+        }
+    }
+}
+
+void HostNetwork::Reset()
+{
+    HostNetworkState &state = State();
+    state.listeners.clear();
+    state.udpSockets.clear();
+    state.hosts.clear();
+    state.udpLatency = 0;
+    state.udpJitter = 0;
+    state.udpLoss = 0;
+    state.randomState = 1;
+}
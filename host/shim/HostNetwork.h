@@ -0,0 +1,106 @@
+#pragma once
+
+// Simulated LAN between the host nodes and the host side services (broker, sequencer, ...).
+// TCP sockets are byte streams without loss, UDP datagrams get a configurable latency and jitter
+
+#include <Arduino.h>
+#include <deque>
+#include <map>
+#include <memory>
+#include <vector>
+
+class HostNode;
+
+/**
+ * @brief One end of a TCP connection. Writes land in the receive queue of the peer.
+ * Host side services get onReceive called synchronously, nodes poll or get pumped
+ *
+ */
+class HostTcpSocket
+{
+public:
+    HostNode *node = nullptr; // nullptr => Host side service
+    IPAddress localIP;
+    uint16_t localPort = 0;
+    IPAddress remoteIP;
+    uint16_t remotePort = 0;
+
+    std::deque<uint8_t> received;
+    std::function<void(HostTcpSocket &socket)> onReceive;
+    std::function<void(HostTcpSocket &socket)> onClose;
+
+    bool isOpen() const { return this->open; }
+    size_t Write(const uint8_t *data, size_t length);
+    size_t Read(uint8_t *data, size_t length);
+    void Close();
+
+private:
+    friend class HostNetwork;
+    bool open = false;
+    std::weak_ptr<HostTcpSocket> peer;
+};
+
+/**
+ * @brief One received UDP datagram
+ *
+ */
+struct HostDatagram
+{
+    uint64_t deliverAt;
+    IPAddress sourceIP;
+    uint16_t sourcePort;
+    IPAddress destinationIP;
+    std::vector<uint8_t> data;
+};
+
+/**
+ * @brief Bound UDP port of a node or the host
+ *
+ */
+class HostUdpSocket
+{
+public:
+    HostNode *node = nullptr; // nullptr => Host side service, receives on every address
+    uint16_t localPort = 0;
+    std::vector<IPAddress> multicastGroups;
+    std::deque<HostDatagram> received;
+};
+
+/**
+ * @brief Pumped by the network on behalf of the async shims (AsyncClient) => Callbacks run under the node of the client
+ *
+ */
+class HostPumped
+{
+public:
+    virtual ~HostPumped() {}
+    virtual void Pump() = 0;
+};
+
+class HostNetwork
+{
+public:
+    // ---- TCP
+    typedef std::function<void(std::shared_ptr<HostTcpSocket> socket)> AcceptHandler;
+    static void Listen(IPAddress ipAddress, uint16_t port, AcceptHandler onAccept);
+    static void StopListening(IPAddress ipAddress, uint16_t port);
+    static std::shared_ptr<HostTcpSocket> Connect(HostNode *node, IPAddress ipAddress, uint16_t port);
+
+    // ---- UDP
+    static std::shared_ptr<HostUdpSocket> Bind(HostNode *node, uint16_t port);
+    static void Unbind(const std::shared_ptr<HostUdpSocket> &socket);
+    static void Send(HostNode *node, IPAddress sourceIP, uint16_t sourcePort, IPAddress destinationIP, uint16_t destinationPort, const uint8_t *data, size_t length);
+    static void SetUdpLatency(uint32_t latencyMicros, uint32_t jitterMicros, uint32_t seed = 1);
+    static void SetUdpLoss(uint8_t lossPercent);
+
+    // ---- DNS
+    static void AddHost(const char *name, IPAddress ipAddress);
+    static bool Resolve(const char *name, IPAddress &ipAddress);
+
+    // ---- Async callbacks
+    static void Register(HostPumped *pumped);
+    static void Unregister(HostPumped *pumped);
+    static void Pump();
+
+    static void Reset();
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <stdint.h>
+
+class String;
+
+/**
+ * @brief IPv4 address. Stored in network order like the ESP8266 core
+ *
+ */
+class IPAddress
+{
+public:
+    IPAddress() {}
+    IPAddress(uint8_t first, uint8_t second, uint8_t third, uint8_t fourth)
+    {
+        this->bytes[0] = first;
+        this->bytes[1] = second;
+        this->bytes[2] = third;
+        this->bytes[3] = fourth;
+    }
+    IPAddress(uint32_t address)
+    {
+        for (uint8_t i = 0; i < 4; i++)
+        {
+            this->bytes[i] = (address >> (8 * i)) & 0xFF;
+        }
+    }
+
+    bool fromString(const char *address);
+    String toString() const;
+    bool isSet() const { return (uint32_t) * this != 0; }
+    bool isMulticast() const { return this->bytes[0] >= 224 && this->bytes[0] <= 239; }
+
+    operator uint32_t() const
+    {
+        return (uint32_t)this->bytes[0] | ((uint32_t)this->bytes[1] << 8) | ((uint32_t)this->bytes[2] << 16) | ((uint32_t)this->bytes[3] << 24);
+    }
+    bool operator==(const IPAddress &other) const { return (uint32_t) * this == (uint32_t)other; }
+    bool operator!=(const IPAddress &other) const { return !(*this == other); }
+    uint8_t operator[](int index) const { return this->bytes[index]; }
+    uint8_t &operator[](int index) { return this->bytes[index]; }
+
+private:
+    uint8_t bytes[4]{0};
+};
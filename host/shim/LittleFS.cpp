@@ -0,0 +1,223 @@
+#include "LittleFS.h"
+#include "HostEnvironment.h"
+
+FS LittleFS;
+
+static const size_t FLASH_SIZE = 2072576; // 2 MB LittleFS partition of the 4 MB flash layout
+static const size_t FLASH_BLOCK_SIZE = 8192;
+
+// ================================ FILE ================================ //
+File::File(HostNode *node, const std::string &path, size_t position) : node(node), path(path), cursor(std::make_shared<size_t>(position))
+{
+}
+
+std::vector<uint8_t> *File::getData() const
+{
+    if (this->node == nullptr)
+    {
+        return nullptr;
+    }
+    auto file = this->node->files.find(this->path);
+    return file != this->node->files.end() ? &file->second : nullptr;
+}
+
+size_t File::write(uint8_t c)
+{
+    return this->write(&c, 1);
+}
+
+size_t File::write(const uint8_t *buffer, size_t size)
+{
+    std::vector<uint8_t> *data = this->getData();
+    if (data == nullptr)
+    {
+        return 0;
+    }
+    size_t &position = *this->cursor;
+    if (data->size() < position + size)
+    {
+        data->resize(position + size);
+    }
+    memcpy(data->data() + position, buffer, size);
+    position += size;
+    return size;
+}
+
+int File::available()
+{
+    std::vector<uint8_t> *data = this->getData();
+    return data != nullptr && *this->cursor < data->size() ? (int)(data->size() - *this->cursor) : 0;
+}
+
+int File::read()
+{
+    uint8_t c;
+    return this->read(&c, 1) == 1 ? c : -1;
+}
+
+int File::peek()
+{
+    std::vector<uint8_t> *data = this->getData();
+    return data != nullptr && *this->cursor < data->size() ? (*data)[*this->cursor] : -1;
+}
+
+size_t File::read(uint8_t *buffer, size_t size)
+{
+    size_t count = (size_t)this->available();
+    if (count > size)
+    {
+        count = size;
+    }
+    if (count > 0)
+    {
+        memcpy(buffer, this->getData()->data() + *this->cursor, count);
+        *this->cursor += count;
+    }
+    return count;
+}
+
+size_t File::size() const
+{
+    std::vector<uint8_t> *data = this->getData();
+    return data != nullptr ? data->size() : 0;
+}
+
+size_t File::position() const
+{
+    return this->cursor ? *this->cursor : 0;
+}
+
+bool File::seek(size_t position)
+{
+    if (this->node == nullptr || position > this->size())
+    {
+        return false;
+    }
+    *this->cursor = position;
+    return true;
+}
+
+void File::close()
+{
+    this->node = nullptr;
+}
+
+// ================================ DIR ================================ //
+bool Dir::next()
+{
+    if (this->node == nullptr)
+    {
+        return false;
+    }
+    auto file = this->started ? this->node->files.upper_bound(this->current) : this->node->files.lower_bound(this->path);
+    this->started = true;
+    if (file == this->node->files.end() || file->first.compare(0, this->path.size(), this->path) != 0)
+    {
+        this->node = nullptr;
+        return false;
+    }
+    this->current = file->first;
+    return true;
+}
+
+String Dir::fileName() const
+{
+    return String(this->current.substr(this->path.size()));
+}
+
+size_t Dir::fileSize() const
+{
+    if (this->node == nullptr)
+    {
+        return 0;
+    }
+    auto file = this->node->files.find(this->current);
+    return file != this->node->files.end() ? file->second.size() : 0;
+}
+
+File Dir::openFile(const char *mode) const
+{
+    return this->node != nullptr ? LittleFS.open(this->current, mode) : File();
+}
+
+// ================================ FS ================================ //
+std::string FS::Normalize(const String &path)
+{
+    return path.startsWith("/") ? path.str() : "/" + path.str();
+}
+
+bool FS::begin()
+{
+    return HostNode::Current().filesystemMountable;
+}
+
+bool FS::format()
+{
+    HostNode::Current().files.clear();
+    return true;
+}
+
+bool FS::info(FSInfo &info)
+{
+    size_t used = 0;
+    for (auto &file : HostNode::Current().files)
+    {
+        used += (file.second.size() / FLASH_BLOCK_SIZE + 1) * FLASH_BLOCK_SIZE;
+    }
+    info.totalBytes = FLASH_SIZE;
+    info.usedBytes = used;
+    info.blockSize = FLASH_BLOCK_SIZE;
+    info.pageSize = 256;
+    info.maxOpenFiles = 5;
+    info.maxPathLength = 32;
+    return true;
+}
+
+File FS::open(const String &path, const char *mode)
+{
+    HostNode &node = HostNode::Current();
+    std::string name = Normalize(path);
+    auto file = node.files.find(name);
+
+    if (mode[0] == 'r' && mode[1] != '+')
+    {
+        return file != node.files.end() ? File(&node, name, 0) : File();
+    }
+    if (mode[0] != 'r' || mode[1] == '+')
+    {
+        node.fileWriteCounts[name]++;
+    }
+    if (mode[0] == 'a')
+    {
+        std::vector<uint8_t> &data = node.files[name];
+        return File(&node, name, data.size());
+    }
+    if (mode[0] == 'w')
+    {
+        node.files[name].clear();
+        return File(&node, name, 0);
+    }
+    // r+ => Keeps the content, fails if the file is missing
+    return file != node.files.end() ? File(&node, name, 0) : File();
+}
+
+bool FS::exists(const String &path)
+{
+    HostNode &node = HostNode::Current();
+    return node.files.find(Normalize(path)) != node.files.end();
+}
+
+bool FS::remove(const String &path)
+{
+    return HostNode::Current().files.erase(Normalize(path)) > 0;
+}
+
+Dir FS::openDir(const String &path)
+{
+    std::string name = Normalize(path);
+    if (name.back() != '/')
+    {
+        name += "/";
+    }
+    return Dir(&HostNode::Current(), name);
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+// Host shim of LittleFS. The files live in the selected HostNode => Every simulated controller has its own flash
+
+#include <Arduino.h>
+
+class HostNode;
+
+struct FSInfo
+{
+    size_t totalBytes;
+    size_t usedBytes;
+    size_t blockSize;
+    size_t pageSize;
+    size_t maxOpenFiles;
+    size_t maxPathLength;
+};
+
+/**
+ * @brief Open file of a node. Copies share the position like the handle of the ESP8266 core
+ *
+ */
+class File : public Stream
+{
+public:
+    File() {}
+    File(HostNode *node, const std::string &path, size_t position);
+
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    virtual int available();
+    virtual int read();
+    virtual int peek();
+    size_t read(uint8_t *buffer, size_t size);
+    size_t size() const;
+    size_t position() const;
+    bool seek(size_t position);
+    const char *name() const { return this->path.c_str(); }
+    void close();
+    operator bool() const { return this->node != nullptr; }
+
+private:
+    HostNode *node = nullptr;
+    std::string path;
+    std::shared_ptr<size_t> cursor;
+
+    std::vector<uint8_t> *getData() const;
+};
+
+/**
+ * @brief Iterates over the files of a node
+ *
+ */
+class Dir
+{
+public:
+    Dir() {}
+    Dir(HostNode *node, const std::string &path) : node(node), path(path) {}
+
+    bool next();
+    String fileName() const;
+    size_t fileSize() const;
+    File openFile(const char *mode) const;
+
+private:
+    HostNode *node = nullptr;
+    std::string path;
+    std::string current;
+    bool started = false;
+};
+
+class FS
+{
+public:
+    bool begin();
+    void end() {}
+    bool format();
+    bool info(FSInfo &info);
+    File open(const String &path, const char *mode);
+    bool exists(const String &path);
+    bool remove(const String &path);
+    Dir openDir(const String &path);
+
+    static std::string Normalize(const String &path);
+};
+
+extern FS LittleFS;
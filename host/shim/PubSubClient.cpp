@@ -0,0 +1,510 @@
+#include "PubSubClient.h"
+
+#define CHECK_STRING_LENGTH(l, s)                                   \
+    if (l + 2 + strnlen(s, this->bufferSize) > this->bufferSize)   \
+    {                                                               \
+        this->client->stop();                                       \
+        return false;                                               \
+    }
+
+PubSubClient &PubSubClient::setServer(IPAddress ip, uint16_t port)
+{
+    this->ip = ip;
+    this->domain = nullptr;
+    this->port = port;
+    return *this;
+}
+
+PubSubClient &PubSubClient::setServer(const char *domain, uint16_t port)
+{
+    this->domain = domain;
+    this->port = port;
+    return *this;
+}
+
+PubSubClient &PubSubClient::setCallback(MQTT_CALLBACK_SIGNATURE)
+{
+    this->callback = callback;
+    return *this;
+}
+
+PubSubClient &PubSubClient::setClient(Client &client)
+{
+    this->client = &client;
+    return *this;
+}
+
+PubSubClient &PubSubClient::setKeepAlive(uint16_t keepAlive)
+{
+    this->keepAlive = keepAlive;
+    return *this;
+}
+
+PubSubClient &PubSubClient::setSocketTimeout(uint16_t timeout)
+{
+    this->socketTimeout = timeout;
+    return *this;
+}
+
+bool PubSubClient::setBufferSize(uint16_t size)
+{
+    if (size == 0)
+    {
+        return false;
+    }
+    uint8_t *newBuffer = (uint8_t *)realloc(this->buffer, size);
+    if (newBuffer == nullptr)
+    {
+        return false;
+    }
+    this->buffer = newBuffer;
+    this->bufferSize = size;
+    return true;
+}
+
+bool PubSubClient::connect(const char *id, const char *user, const char *pass, const char *willTopic, uint8_t willQos, bool willRetain, const char *willMessage, bool cleanSession)
+{
+    if (this->connected())
+    {
+        return true;
+    }
+    if (this->buffer == nullptr && !this->setBufferSize(MQTT_MAX_PACKET_SIZE))
+    {
+        return false;
+    }
+
+    int result = 1;
+    if (!this->client->connected())
+    {
+        result = this->domain != nullptr ? this->client->connect(this->domain, this->port) : this->client->connect(this->ip, this->port);
+    }
+    if (result != 1)
+    {
+        this->_state = MQTT_CONNECT_FAILED;
+        return false;
+    }
+
+    this->nextMsgId = 1;
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    const uint8_t d[7] = {0x00, 0x04, 'M', 'Q', 'T', 'T', MQTT_VERSION};
+    memcpy(this->buffer + length, d, sizeof(d));
+    length += sizeof(d);
+
+    uint8_t v;
+    if (willTopic)
+    {
+        v = 0x04 | (willQos << 3) | (willRetain << 5);
+    }
+    else
+    {
+        v = 0x00;
+    }
+    if (cleanSession)
+    {
+        v = v | 0x02;
+    }
+    if (user != nullptr)
+    {
+        v = v | 0x80;
+        if (pass != nullptr)
+        {
+            v = v | (0x80 >> 1);
+        }
+    }
+    this->buffer[length++] = v;
+    this->buffer[length++] = ((this->keepAlive) >> 8);
+    this->buffer[length++] = ((this->keepAlive) & 0xFF);
+
+    CHECK_STRING_LENGTH(length, id)
+    length = this->writeString(id, this->buffer, length);
+    if (willTopic)
+    {
+        CHECK_STRING_LENGTH(length, willTopic)
+        length = this->writeString(willTopic, this->buffer, length);
+        CHECK_STRING_LENGTH(length, willMessage)
+        length = this->writeString(willMessage, this->buffer, length);
+    }
+    if (user != nullptr)
+    {
+        CHECK_STRING_LENGTH(length, user)
+        length = this->writeString(user, this->buffer, length);
+        if (pass != nullptr)
+        {
+            CHECK_STRING_LENGTH(length, pass)
+            length = this->writeString(pass, this->buffer, length);
+        }
+    }
+
+    this->write(MQTTCONNECT, this->buffer, length - MQTT_MAX_HEADER_SIZE);
+
+    this->lastInActivity = this->lastOutActivity = millis();
+    while (!this->client->available())
+    {
+        unsigned long t = millis();
+        if (t - this->lastInActivity >= ((int32_t)this->socketTimeout * 1000UL))
+        {
+            this->_state = MQTT_CONNECTION_TIMEOUT;
+            this->client->stop();
+            return false;
+        }
+        delay(1); // yield() on the controller. The broker answers in simulated time
+    }
+    uint8_t llen;
+    uint32_t len = this->readPacket(&llen);
+    if (len == 4)
+    {
+        if (this->buffer[3] == 0)
+        {
+            this->lastInActivity = millis();
+            this->pingOutstanding = false;
+            this->_state = MQTT_CONNECTED;
+            return true;
+        }
+        this->_state = this->buffer[3];
+    }
+    this->client->stop();
+    return false;
+}
+
+bool PubSubClient::readByte(uint8_t *result)
+{
+    unsigned long previousMillis = millis();
+    while (!this->client->available())
+    {
+        delay(1);
+        unsigned long currentMillis = millis();
+        if (currentMillis - previousMillis >= ((int32_t)this->socketTimeout * 1000))
+        {
+            return false;
+        }
+    }
+    *result = this->client->read();
+    return true;
+}
+
+bool PubSubClient::readByte(uint8_t *result, uint16_t *index)
+{
+    uint16_t current_index = *index;
+    uint8_t *write_address = &(result[current_index]);
+    if (this->readByte(write_address))
+    {
+        *index = current_index + 1;
+        return true;
+    }
+    return false;
+}
+
+uint32_t PubSubClient::readPacket(uint8_t *lengthLength)
+{
+    uint16_t len = 0;
+    if (!this->readByte(this->buffer, &len))
+    {
+        return 0;
+    }
+    bool isPublish = (this->buffer[0] & 0xF0) == MQTTPUBLISH;
+    uint32_t multiplier = 1;
+    uint32_t length = 0;
+    uint8_t digit = 0;
+    uint16_t skip = 0;
+    uint32_t start = 0;
+
+    do
+    {
+        if (len == 5)
+        {
+            // Invalid remaining length encoding - kill the connection
+            this->_state = MQTT_DISCONNECTED;
+            this->client->stop();
+            return 0;
+        }
+        if (!this->readByte(&digit))
+        {
+            return 0;
+        }
+        this->buffer[len++] = digit;
+        length += (digit & 127) * multiplier;
+        multiplier <<= 7;
+    } while ((digit & 128) != 0);
+    *lengthLength = len - 1;
+
+    if (isPublish)
+    {
+        // Read in topic length to calculate bytes to skip over for Stream writing
+        if (!this->readByte(this->buffer, &len))
+        {
+            return 0;
+        }
+        if (!this->readByte(this->buffer, &len))
+        {
+            return 0;
+        }
+        skip = (this->buffer[*lengthLength + 1] << 8) + this->buffer[*lengthLength + 2];
+        start = 2;
+        if (this->buffer[0] & MQTTQOS1)
+        {
+            // Skip message id
+            skip += 2;
+        }
+    }
+    uint32_t idx = len;
+
+    for (uint32_t i = start; i < length; i++)
+    {
+        if (!this->readByte(&digit))
+        {
+            return 0;
+        }
+        if (len < this->bufferSize)
+        {
+            this->buffer[len] = digit;
+            len++;
+        }
+        idx++;
+    }
+
+    if (idx > this->bufferSize)
+    {
+        len = 0; // This will cause the packet to be ignored.
+    }
+    return len;
+}
+
+bool PubSubClient::loop()
+{
+    if (!this->connected())
+    {
+        return false;
+    }
+    unsigned long t = millis();
+    if ((t - this->lastInActivity > this->keepAlive * 1000UL) || (t - this->lastOutActivity > this->keepAlive * 1000UL))
+    {
+        if (this->pingOutstanding)
+        {
+            this->_state = MQTT_CONNECTION_TIMEOUT;
+            this->client->stop();
+            return false;
+        }
+        this->buffer[0] = MQTTPINGREQ;
+        this->buffer[1] = 0;
+        this->client->write(this->buffer, 2);
+        this->lastOutActivity = t;
+        this->lastInActivity = t;
+        this->pingOutstanding = true;
+    }
+    if (this->client->available())
+    {
+        uint8_t llen;
+        uint16_t len = this->readPacket(&llen);
+        uint16_t msgId = 0;
+        uint8_t *payload;
+        if (len > 0)
+        {
+            this->lastInActivity = t;
+            uint8_t type = this->buffer[0] & 0xF0;
+            if (type == MQTTPUBLISH)
+            {
+                if (this->callback)
+                {
+                    uint16_t tl = (this->buffer[llen + 1] << 8) + this->buffer[llen + 2];
+                    memmove(this->buffer + llen + 2, this->buffer + llen + 3, tl); // Move topic inside buffer 1 byte to front
+                    this->buffer[llen + 2 + tl] = 0;                                // End the topic as a 'C' string with \x00
+                    char *topic = (char *)this->buffer + llen + 2;
+                    if ((this->buffer[0] & 0x06) == MQTTQOS1)
+                    {
+                        msgId = (this->buffer[llen + 3 + tl] << 8) + this->buffer[llen + 3 + tl + 1];
+                        payload = this->buffer + llen + 3 + tl + 2;
+                        this->callback(topic, payload, len - llen - 3 - tl - 2);
+
+                        this->buffer[0] = MQTTPUBACK;
+                        this->buffer[1] = 2;
+                        this->buffer[2] = (msgId >> 8);
+                        this->buffer[3] = (msgId & 0xFF);
+                        this->client->write(this->buffer, 4);
+                        this->lastOutActivity = t;
+                    }
+                    else
+                    {
+                        payload = this->buffer + llen + 3 + tl;
+                        this->callback(topic, payload, len - llen - 3 - tl);
+                    }
+                }
+            }
+            else if (type == MQTTPINGREQ)
+            {
+                this->buffer[0] = MQTTPINGRESP;
+                this->buffer[1] = 0;
+                this->client->write(this->buffer, 2);
+            }
+            else if (type == MQTTPINGRESP)
+            {
+                this->pingOutstanding = false;
+            }
+        }
+        else if (!this->connected())
+        {
+            // readPacket has closed the connection
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PubSubClient::publish(const char *topic, const char *payload, bool retained)
+{
+    return this->publish(topic, (const uint8_t *)payload, payload ? strnlen(payload, this->bufferSize) : 0, retained);
+}
+
+bool PubSubClient::publish(const char *topic, const uint8_t *payload, unsigned int plength, bool retained)
+{
+    if (!this->connected())
+    {
+        return false;
+    }
+    if (this->bufferSize < MQTT_MAX_HEADER_SIZE + 2 + strnlen(topic, this->bufferSize) + plength)
+    {
+        // Too long
+        return false;
+    }
+    uint16_t length = this->writeString(topic, this->buffer, MQTT_MAX_HEADER_SIZE);
+    for (unsigned int i = 0; i < plength; i++)
+    {
+        this->buffer[length++] = payload[i];
+    }
+    uint8_t header = MQTTPUBLISH;
+    if (retained)
+    {
+        header |= 1;
+    }
+    return this->write(header, this->buffer, length - MQTT_MAX_HEADER_SIZE);
+}
+
+size_t PubSubClient::buildHeader(uint8_t header, uint8_t *buf, uint16_t length)
+{
+    uint8_t lenBuf[4];
+    uint8_t llen = 0;
+    uint8_t digit;
+    uint8_t pos = 0;
+    uint16_t len = length;
+    do
+    {
+        digit = len & 127;
+        len >>= 7;
+        if (len > 0)
+        {
+            digit |= 0x80;
+        }
+        lenBuf[pos++] = digit;
+        llen++;
+    } while (len > 0);
+
+    buf[4 - llen] = header;
+    for (int i = 0; i < llen; i++)
+    {
+        buf[MQTT_MAX_HEADER_SIZE - llen + i] = lenBuf[i];
+    }
+    return llen + 1; // Full header size is variable length bit plus the 1-byte fixed header
+}
+
+bool PubSubClient::write(uint8_t header, uint8_t *buf, uint16_t length)
+{
+    uint16_t hlen = this->buildHeader(header, buf, length);
+    size_t rc = this->client->write(buf + (MQTT_MAX_HEADER_SIZE - hlen), length + hlen);
+    this->lastOutActivity = millis();
+    return (rc == hlen + length);
+}
+
+bool PubSubClient::subscribe(const char *topic, uint8_t qos)
+{
+    size_t topicLength = strnlen(topic, this->bufferSize);
+    if (topic == nullptr || qos > 1 || this->bufferSize < 9 + topicLength)
+    {
+        return false;
+    }
+    if (!this->connected())
+    {
+        return false;
+    }
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    this->nextMsgId++;
+    if (this->nextMsgId == 0)
+    {
+        this->nextMsgId = 1;
+    }
+    this->buffer[length++] = (this->nextMsgId >> 8);
+    this->buffer[length++] = (this->nextMsgId & 0xFF);
+    length = this->writeString(topic, this->buffer, length);
+    this->buffer[length++] = qos;
+    return this->write(MQTTSUBSCRIBE | MQTTQOS1, this->buffer, length - MQTT_MAX_HEADER_SIZE);
+}
+
+bool PubSubClient::unsubscribe(const char *topic)
+{
+    size_t topicLength = strnlen(topic, this->bufferSize);
+    if (topic == nullptr || this->bufferSize < 9 + topicLength)
+    {
+        return false;
+    }
+    if (!this->connected())
+    {
+        return false;
+    }
+    uint16_t length = MQTT_MAX_HEADER_SIZE;
+    this->nextMsgId++;
+    if (this->nextMsgId == 0)
+    {
+        this->nextMsgId = 1;
+    }
+    this->buffer[length++] = (this->nextMsgId >> 8);
+    this->buffer[length++] = (this->nextMsgId & 0xFF);
+    length = this->writeString(topic, this->buffer, length);
+    return this->write(MQTTUNSUBSCRIBE | MQTTQOS1, this->buffer, length - MQTT_MAX_HEADER_SIZE);
+}
+
+void PubSubClient::disconnect()
+{
+    if (this->buffer != nullptr && this->client != nullptr)
+    {
+        this->buffer[0] = MQTTDISCONNECT;
+        this->buffer[1] = 0;
+        this->client->write(this->buffer, 2);
+        this->client->flush();
+        this->client->stop();
+    }
+    this->_state = MQTT_DISCONNECTED;
+    this->lastInActivity = this->lastOutActivity = millis();
+}
+
+uint16_t PubSubClient::writeString(const char *string, uint8_t *buf, uint16_t pos)
+{
+    const char *idp = string;
+    uint16_t i = 0;
+    pos += 2;
+    while (*idp)
+    {
+        buf[pos++] = *idp++;
+        i++;
+    }
+    buf[pos - i - 2] = (i >> 8);
+    buf[pos - i - 1] = (i & 0xFF);
+    return pos;
+}
+
+bool PubSubClient::connected()
+{
+    if (this->client == nullptr)
+    {
+        return false;
+    }
+    bool rc = (int)this->client->connected();
+    if (!rc)
+    {
+        if (this->_state == MQTT_CONNECTED)
+        {
+            this->_state = MQTT_CONNECTION_LOST;
+            this->client->flush();
+            this->client->stop();
+        }
+        return false;
+    }
+    return this->_state == MQTT_CONNECTED;
+}
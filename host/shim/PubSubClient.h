@@ -0,0 +1,95 @@
+#pragma once
+
+// Host shim of PubSubClient 2.8. Same packet handling, timeouts and state codes as the library
+// => The firmware sees the same blocking connect and the same skipping of packets that do not fit the buffer
+
+#include <Arduino.h>
+#include <Client.h>
+
+#define MQTT_VERSION_3_1_1 4
+#define MQTT_VERSION MQTT_VERSION_3_1_1
+#define MQTT_MAX_PACKET_SIZE 256
+#define MQTT_KEEPALIVE 15
+#define MQTT_SOCKET_TIMEOUT 15
+#define MQTT_MAX_HEADER_SIZE 5
+
+#define MQTT_CONNECTION_TIMEOUT -4
+#define MQTT_CONNECTION_LOST -3
+#define MQTT_CONNECT_FAILED -2
+#define MQTT_DISCONNECTED -1
+#define MQTT_CONNECTED 0
+#define MQTT_CONNECT_BAD_PROTOCOL 1
+#define MQTT_CONNECT_BAD_CLIENT_ID 2
+#define MQTT_CONNECT_UNAVAILABLE 3
+#define MQTT_CONNECT_BAD_CREDENTIALS 4
+#define MQTT_CONNECT_UNAUTHORIZED 5
+
+#define MQTTCONNECT 1 << 4
+#define MQTTCONNACK 2 << 4
+#define MQTTPUBLISH 3 << 4
+#define MQTTPUBACK 4 << 4
+#define MQTTSUBSCRIBE 8 << 4
+#define MQTTSUBACK 9 << 4
+#define MQTTUNSUBSCRIBE 10 << 4
+#define MQTTUNSUBACK 11 << 4
+#define MQTTPINGREQ 12 << 4
+#define MQTTPINGRESP 13 << 4
+#define MQTTDISCONNECT 14 << 4
+
+#define MQTTQOS0 (0 << 1)
+#define MQTTQOS1 (1 << 1)
+
+#define MQTT_CALLBACK_SIGNATURE std::function<void(char *, uint8_t *, unsigned int)> callback
+
+class PubSubClient
+{
+public:
+    PubSubClient() {}
+    PubSubClient(Client &client) { this->setClient(client); }
+    ~PubSubClient() { free(this->buffer); }
+
+    PubSubClient &setServer(IPAddress ip, uint16_t port);
+    PubSubClient &setServer(const char *domain, uint16_t port);
+    PubSubClient &setCallback(MQTT_CALLBACK_SIGNATURE);
+    PubSubClient &setClient(Client &client);
+    PubSubClient &setKeepAlive(uint16_t keepAlive);
+    PubSubClient &setSocketTimeout(uint16_t timeout);
+    bool setBufferSize(uint16_t size);
+    uint16_t getBufferSize() { return this->bufferSize; }
+
+    bool connect(const char *id, const char *user, const char *pass, const char *willTopic, uint8_t willQos, bool willRetain, const char *willMessage, bool cleanSession);
+    bool connect(const char *id) { return this->connect(id, nullptr, nullptr, nullptr, 0, false, nullptr, true); }
+    bool connect(const char *id, const char *user, const char *pass) { return this->connect(id, user, pass, nullptr, 0, false, nullptr, true); }
+    bool connect(const char *id, const char *willTopic, uint8_t willQos, bool willRetain, const char *willMessage) { return this->connect(id, nullptr, nullptr, willTopic, willQos, willRetain, willMessage, true); }
+    void disconnect();
+    bool publish(const char *topic, const char *payload, bool retained = false);
+    bool publish(const char *topic, const uint8_t *payload, unsigned int length, bool retained = false);
+    bool subscribe(const char *topic, uint8_t qos = 0);
+    bool unsubscribe(const char *topic);
+    bool loop();
+    bool connected();
+    int state() { return this->_state; }
+
+private:
+    Client *client = nullptr;
+    uint8_t *buffer = nullptr;
+    uint16_t bufferSize = 0;
+    uint16_t keepAlive = MQTT_KEEPALIVE;
+    uint16_t socketTimeout = MQTT_SOCKET_TIMEOUT;
+    uint16_t nextMsgId = 0;
+    unsigned long lastOutActivity = 0;
+    unsigned long lastInActivity = 0;
+    bool pingOutstanding = false;
+    MQTT_CALLBACK_SIGNATURE;
+    IPAddress ip;
+    const char *domain = nullptr; // Same as the library only the pointer gets kept => Has to live until connect()
+    uint16_t port = 0;
+    int _state = MQTT_DISCONNECTED;
+
+    uint32_t readPacket(uint8_t *lengthLength);
+    bool readByte(uint8_t *result);
+    bool readByte(uint8_t *result, uint16_t *index);
+    bool write(uint8_t header, uint8_t *buf, uint16_t length);
+    uint16_t writeString(const char *string, uint8_t *buf, uint16_t pos);
+    size_t buildHeader(uint8_t header, uint8_t *buf, uint16_t length);
+};
@@ -0,0 +1,72 @@
+#include "WiFiClient.h"
+#include "HostEnvironment.h"
+#include "HostNetwork.h"
+
+int WiFiClient::connect(IPAddress ip, uint16_t port)
+{
+    this->stop();
+    this->socket = HostNetwork::Connect(&HostNode::Current(), ip, port);
+    if (!this->socket)
+    {
+        // Nobody listens => lwIP gives up after the connect timeout
+        delay(this->timeout);
+        return 0;
+    }
+    return 1;
+}
+
+int WiFiClient::connect(const char *host, uint16_t port)
+{
+    IPAddress ip;
+    if (!HostNetwork::Resolve(host, ip))
+    {
+        return 0;
+    }
+    return this->connect(ip, port);
+}
+
+size_t WiFiClient::write(uint8_t c)
+{
+    return this->write(&c, 1);
+}
+
+size_t WiFiClient::write(const uint8_t *buffer, size_t size)
+{
+    return this->socket ? this->socket->Write(buffer, size) : 0;
+}
+
+int WiFiClient::available()
+{
+    return this->socket ? (int)this->socket->received.size() : 0;
+}
+
+int WiFiClient::read()
+{
+    uint8_t c;
+    return this->read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiClient::read(uint8_t *buffer, size_t size)
+{
+    return this->socket ? (int)this->socket->Read(buffer, size) : -1;
+}
+
+int WiFiClient::peek()
+{
+    return this->socket && !this->socket->received.empty() ? this->socket->received.front() : -1;
+}
+
+void WiFiClient::stop()
+{
+    if (this->socket)
+    {
+        this->socket->Close();
+        this->socket.reset();
+    }
+}
+
+uint8_t WiFiClient::connected()
+{
+    // Same as the core => Still connected as long as there is unread data
+    return this->socket && (this->socket->isOpen() || !this->socket->received.empty());
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+// Host shim of the blocking WiFiClient. Connects to the listeners of the HostNetwork
+
+#include <Client.h>
+#include <memory>
+
+class HostTcpSocket;
+class HostNode;
+
+class WiFiClient : public Client
+{
+public:
+    WiFiClient() {}
+
+    virtual int connect(IPAddress ip, uint16_t port);
+    virtual int connect(const char *host, uint16_t port);
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    virtual int available();
+    virtual int read();
+    virtual int read(uint8_t *buffer, size_t size);
+    virtual int peek();
+    virtual void flush() {}
+    virtual void stop();
+    virtual uint8_t connected();
+    virtual operator bool() { return this->connected(); }
+    void setNoDelay(bool noDelay) { (void)noDelay; }
+
+private:
+    std::shared_ptr<HostTcpSocket> socket;
+};
@@ -0,0 +1,147 @@
+#include "WiFiUdp.h"
+#include "HostEnvironment.h"
+#include "HostNetwork.h"
+
+static uint16_t nextLocalPort = 2390;
+
+uint8_t WiFiUDP::begin(uint16_t port)
+{
+    this->stop();
+    this->socket = HostNetwork::Bind(&HostNode::Current(), port);
+    this->localPort = port;
+    return 1;
+}
+
+uint8_t WiFiUDP::beginMulticast(IPAddress interfaceAddress, IPAddress multicast, uint16_t port)
+{
+    (void)interfaceAddress;
+    this->begin(port);
+    this->socket->multicastGroups.push_back(multicast);
+    return 1;
+}
+
+void WiFiUDP::stop()
+{
+    if (this->socket)
+    {
+        HostNetwork::Unbind(this->socket);
+        this->socket.reset();
+    }
+    this->packet.clear();
+    this->packetPosition = 0;
+    this->sending = false;
+}
+
+// ================================ SEND ================================ //
+int WiFiUDP::beginPacket(IPAddress ip, uint16_t port)
+{
+    this->sending = true;
+    this->sendAddress = ip;
+    this->sendPort = port;
+    this->sendBuffer.clear();
+    return 1;
+}
+
+int WiFiUDP::beginPacket(const char *host, uint16_t port)
+{
+    IPAddress ip;
+    if (!HostNetwork::Resolve(host, ip))
+    {
+        return 0;
+    }
+    return this->beginPacket(ip, port);
+}
+
+int WiFiUDP::beginPacketMulticast(IPAddress multicastAddress, uint16_t port, IPAddress interfaceAddress, int ttl)
+{
+    (void)interfaceAddress;
+    (void)ttl;
+    return this->beginPacket(multicastAddress, port);
+}
+
+size_t WiFiUDP::write(uint8_t c)
+{
+    return this->write(&c, 1);
+}
+
+size_t WiFiUDP::write(const uint8_t *buffer, size_t size)
+{
+    if (!this->sending)
+    {
+        return 0;
+    }
+    this->sendBuffer.insert(this->sendBuffer.end(), buffer, buffer + size);
+    return size;
+}
+
+int WiFiUDP::endPacket()
+{
+    if (!this->sending)
+    {
+        return 0;
+    }
+    this->sending = false;
+    HostNode &node = HostNode::Current();
+    if (!node.isWiFiConnected())
+    {
+        return 0;
+    }
+    if (this->localPort == 0)
+    {
+        this->localPort = nextLocalPort++;
+    }
+    HostNetwork::Send(&node, node.ipAddress, this->localPort, this->sendAddress, this->sendPort, this->sendBuffer.data(), this->sendBuffer.size());
+    return 1;
+}
+
+// ================================ RECEIVE ================================ //
+int WiFiUDP::parsePacket()
+{
+    // The rest of the current packet gets dropped
+    this->packet.clear();
+    this->packetPosition = 0;
+    if (!this->socket || this->socket->received.empty() || this->socket->received.front().deliverAt > HostTime::getMicros())
+    {
+        return 0;
+    }
+    HostDatagram &datagram = this->socket->received.front();
+    this->packet.swap(datagram.data);
+    this->remoteAddress = datagram.sourceIP;
+    this->remotePortNumber = datagram.sourcePort;
+    this->destinationAddress = datagram.destinationIP;
+    this->socket->received.pop_front();
+    return (int)this->packet.size();
+}
+
+int WiFiUDP::available()
+{
+    return (int)(this->packet.size() - this->packetPosition);
+}
+
+int WiFiUDP::read()
+{
+    unsigned char c;
+    return this->read(&c, 1) == 1 ? c : -1;
+}
+
+int WiFiUDP::read(unsigned char *buffer, size_t length)
+{
+    size_t count = this->packet.size() - this->packetPosition;
+    if (count > length)
+    {
+        count = length;
+    }
+    memcpy(buffer, this->packet.data() + this->packetPosition, count);
+    this->packetPosition += count;
+    return (int)count;
+}
+
+int WiFiUDP::peek()
+{
+    return this->packetPosition < this->packet.size() ? this->packet[this->packetPosition] : -1;
+}
+
+void WiFiUDP::flush()
+{
+    this->endPacket();
+}
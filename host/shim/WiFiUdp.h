@@ -0,0 +1,56 @@
+#pragma once
+
+// Host shim of WiFiUDP. Datagrams travel through the HostNetwork
+
+#include <Arduino.h>
+#include <memory>
+#include <vector>
+
+class HostUdpSocket;
+
+class WiFiUDP : public Stream
+{
+public:
+    WiFiUDP() {}
+    ~WiFiUDP() { this->stop(); }
+
+    uint8_t begin(uint16_t port);
+    uint8_t beginMulticast(IPAddress interfaceAddress, IPAddress multicast, uint16_t port);
+    void stop();
+
+    // ---- Send
+    int beginPacket(IPAddress ip, uint16_t port);
+    int beginPacket(const char *host, uint16_t port);
+    int beginPacketMulticast(IPAddress multicastAddress, uint16_t port, IPAddress interfaceAddress, int ttl = 1);
+    virtual size_t write(uint8_t c);
+    virtual size_t write(const uint8_t *buffer, size_t size);
+    using Print::write;
+    int endPacket();
+
+    // ---- Receive
+    int parsePacket();
+    virtual int available();
+    virtual int read();
+    int read(unsigned char *buffer, size_t length);
+    int read(char *buffer, size_t length) { return this->read((unsigned char *)buffer, length); }
+    virtual int peek();
+    virtual void flush(); // Same as the ESP8266 core => Sends the pending packet
+    IPAddress remoteIP() const { return this->remoteAddress; }
+    uint16_t remotePort() const { return this->remotePortNumber; }
+    IPAddress destinationIP() const { return this->destinationAddress; }
+
+private:
+    std::shared_ptr<HostUdpSocket> socket;
+    uint16_t localPort = 0;
+
+    bool sending = false;
+    IPAddress sendAddress;
+    uint16_t sendPort = 0;
+    std::vector<uint8_t> sendBuffer;
+
+    std::vector<uint8_t> packet;
+    size_t packetPosition = 0;
+    IPAddress remoteAddress;
+    uint16_t remotePortNumber = 0;
+    IPAddress destinationAddress;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+// Host shim of the Wire library. There is no hardware bus on the host => Every address NACKs.
+// The simulator and the tests talk to the MockBus instead
+
+#include <Arduino.h>
+
+class TwoWire
+{
+public:
+    void begin() {}
+    void begin(int sda, int scl)
+    {
+        (void)sda;
+        (void)scl;
+    }
+    void setClock(uint32_t frequency) { (void)frequency; }
+    void beginTransmission(uint8_t address) { (void)address; }
+    size_t write(uint8_t data)
+    {
+        (void)data;
+        return 1;
+    }
+    size_t write(const uint8_t *data, size_t length)
+    {
+        (void)data;
+        return length;
+    }
+    uint8_t endTransmission(bool sendStop = true)
+    {
+        (void)sendStop;
+        return 2; // Address NACK
+    }
+    uint8_t requestFrom(uint8_t address, uint8_t length)
+    {
+        (void)address;
+        (void)length;
+        return 0;
+    }
+    int available() { return 0; }
+    int read() { return -1; }
+};
+
+extern TwoWire Wire;
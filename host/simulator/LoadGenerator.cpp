@@ -0,0 +1,307 @@
+#include "LoadGenerator.h"
+#include <algorithm>
+
+LoadGenerator::LoadGenerator(Simulation &simulation) : simulation(simulation)
+{
+    this->simulation.getBroker().Observe("LEDController/#", [this](const MqttBrokerMessage &message)
+                                         {
+                                             if (!message.senderClientId.empty())
+                                             {
+                                                 this->statePublishes++;
+                                             } });
+}
+
+LoadGenerator::~LoadGenerator()
+{
+    this->simulation.getBroker().ClearObservers();
+}
+
+const char *LoadGenerator::PatternToString(LoadPattern pattern)
+{
+    switch (pattern)
+    {
+    case LoadPattern::SliderStorm:
+        return "slider storm";
+    case LoadPattern::EffectToggle:
+        return "effect toggle";
+    case LoadPattern::AlarmFanOut:
+        return "alarm fan-out";
+    }
+    return "";
+}
+
+uint32_t LoadGenerator::getDefaultIntervalMillis(LoadPattern pattern)
+{
+    switch (pattern)
+    {
+    case LoadPattern::SliderStorm:
+        return 20; // Home Assistant sends a slider drag as fast as the browser produces input events
+    case LoadPattern::EffectToggle:
+        return 300;
+    case LoadPattern::AlarmFanOut:
+        return 500;
+    }
+    return 100;
+}
+
+LoadResult LoadGenerator::Run(LoadPattern pattern, uint64_t micros, uint32_t intervalMillis)
+{
+    if (intervalMillis == 0)
+    {
+        intervalMillis = getDefaultIntervalMillis(pattern);
+    }
+
+    this->Prepare();
+
+    this->result = LoadResult();
+    this->result.pattern = pattern;
+    this->pendingCommands.clear();
+    this->latencies.clear();
+    this->statePublishes = 0;
+
+    size_t controllerCount = this->simulation.getControllerCount();
+    std::vector<uint32_t> droppedStart(controllerCount);
+    std::vector<uint32_t> coalescedStart(controllerCount);
+    for (size_t i = 0; i < controllerCount; i++)
+    {
+        SimulatedController &controller = this->simulation.getController(i);
+        controller.getNode().ResetHeapPeak();
+        droppedStart[i] = controller.getNetwork().getPublishQueueDroppedCount();
+        coalescedStart[i] = controller.getNetwork().getPublishQueueCoalescedCount();
+    }
+
+    uint64_t start = this->simulation.getMicros();
+    uint64_t nextCommand = start;
+    uint32_t commandIndex = 0;
+    char payload[16];
+    while (this->simulation.getMicros() < start + micros)
+    {
+        if (this->simulation.getMicros() >= nextCommand)
+        {
+            switch (pattern)
+            {
+            case LoadPattern::SliderStorm:
+                // Every command moves the brightness => No command matches the state of the one before
+                for (size_t i = 0; i < controllerCount; i++)
+                {
+                    uint8_t stripIndex = commandIndex % 2;
+                    uint16_t brightness = 200 + (commandIndex * 397 + i * 131) % 3800;
+                    Parameterhandler &parameterhandler = this->simulation.getController(i).getParameterhandler();
+                    snprintf(payload, sizeof(payload), "%u", brightness);
+                    this->Send(i,
+                               stripIndex,
+                               this->getTopic(i, stripIndex == 0 ? "HomeAssistant/Strip1/RGB/Brightness/command" : "HomeAssistant/Strip2/RGB/Brightness/command"),
+                               payload,
+                               [&parameterhandler, stripIndex, brightness]()
+                               { return parameterhandler.getLEDStripParameter(stripIndex).ColorBrightness == brightness; });
+                }
+                break;
+            case LoadPattern::EffectToggle:
+                for (size_t i = 0; i < controllerCount; i++)
+                {
+                    SingleLEDEffect effect = commandIndex % 2 == 0 ? SingleLEDEffect::Rainbow : SingleLEDEffect::None;
+                    Parameterhandler &parameterhandler = this->simulation.getController(i).getParameterhandler();
+                    this->Send(i,
+                               0,
+                               this->getTopic(i, "HomeAssistant/Strip1/Effect/command"),
+                               effect == SingleLEDEffect::Rainbow ? "Rainbow" : "None",
+                               [&parameterhandler, effect]()
+                               { return parameterhandler.getLEDStripParameter(0).Effect == effect; });
+                }
+                break;
+            case LoadPattern::AlarmFanOut:
+                // One publish, every controller tracks its own copy
+                for (size_t i = 0; i < controllerCount; i++)
+                {
+                    bool alarmActive = commandIndex % 2 == 0;
+                    Network &network = this->simulation.getController(i).getNetwork();
+                    this->Send(i,
+                               0,
+                               i == 0 ? "LEDController/Global/HomeAssistant/Effect/Alarm/command" : "",
+                               alarmActive ? "1" : "0",
+                               [&network, alarmActive]()
+                               { return network.isAlarm(1) == alarmActive; });
+                }
+                break;
+            }
+            commandIndex++;
+            nextCommand += (uint64_t)intervalMillis * 1000;
+        }
+        this->Step();
+    }
+
+    // Let the last commands arrive before they count as lost
+    uint64_t drainEnd = this->simulation.getMicros() + LOAD_COMMAND_TIMEOUT;
+    while (!this->pendingCommands.empty() && this->simulation.getMicros() < drainEnd)
+    {
+        this->Step();
+    }
+    this->result.commandsLost += this->pendingCommands.size();
+    this->pendingCommands.clear();
+
+    this->result.micros = this->simulation.getMicros() - start;
+    this->result.statePublishes = this->statePublishes;
+    this->result.minFreeHeapBytes = INT64_MAX;
+    for (size_t i = 0; i < controllerCount; i++)
+    {
+        SimulatedController &controller = this->simulation.getController(i);
+        uint64_t peak = controller.getNode().getHeapPeakBytesInUse();
+        this->result.publishQueueDropped += controller.getNetwork().getPublishQueueDroppedCount() - droppedStart[i];
+        this->result.publishQueueCoalesced += controller.getNetwork().getPublishQueueCoalescedCount() - coalescedStart[i];
+        this->result.peakHeapBytes = std::max(this->result.peakHeapBytes, peak);
+        this->result.minFreeHeapBytes = std::min(this->result.minFreeHeapBytes, (int64_t)controller.getNode().heapSize - (int64_t)peak);
+    }
+
+    if (!this->latencies.empty())
+    {
+        std::sort(this->latencies.begin(), this->latencies.end());
+        this->result.latencyP50Micros = this->latencies[this->latencies.size() / 2];
+        this->result.latencyP95Micros = this->latencies[std::min(this->latencies.size() - 1, this->latencies.size() * 95 / 100)];
+        this->result.latencyMaxMicros = this->latencies.back();
+    }
+    return this->result;
+}
+
+/**
+ * @brief Brings every strip into the same state: Master at home, on, white, no effect, no alarm. Waits until the fades settled
+ *
+ */
+void LoadGenerator::Prepare()
+{
+    const char *stripCommand = "{\"Power\":1,\"Red\":255,\"Green\":255,\"Blue\":255,\"ColorBrightness\":2048,\"Effect\":\"None\"}";
+    this->simulation.getBroker().Publish("LEDController/Global/HomeAssistant/MasterPresent/command", "home");
+    this->simulation.getBroker().Publish("LEDController/Global/HomeAssistant/Effect/Alarm/command", "0");
+    for (size_t i = 0; i < this->simulation.getControllerCount(); i++)
+    {
+        this->simulation.getBroker().Publish(this->getTopic(i, "JSON/Strip1/command").c_str(), stripCommand);
+        this->simulation.getBroker().Publish(this->getTopic(i, "JSON/Strip2/command").c_str(), stripCommand);
+    }
+    this->simulation.Run(3000000);
+
+    this->stripWrites.assign(this->simulation.getControllerCount(), std::vector<uint64_t>(2, 0));
+    this->busTransactionCounts.assign(this->simulation.getControllerCount(), 0);
+    for (size_t i = 0; i < this->simulation.getControllerCount(); i++)
+    {
+        this->busTransactionCounts[i] = this->simulation.getController(i).getBus().getTransactionCount();
+    }
+}
+
+/**
+ * @brief Publishes a command and waits for it to reach the registers
+ *
+ * @parameter controllerIndex Controller that tracks the command
+ * @parameter stripIndex      Strip whose registers show the command. Starts with 0
+ * @parameter topic           Full topic. Empty => Counted only, a global command got published for an other controller already
+ * @parameter payload         Payload of the command
+ * @parameter isApplied       True once the controller holds the command in the parameters its led driver reads
+ */
+void LoadGenerator::Send(size_t controllerIndex, uint8_t stripIndex, const std::string &topic, const char *payload, std::function<bool()> isApplied)
+{
+    this->result.commandsSent++;
+    this->pendingCommands.push_back({controllerIndex, stripIndex, this->simulation.getMicros(), isApplied, false, 0});
+    if (!topic.empty())
+    {
+        this->simulation.getBroker().Publish(topic.c_str(), payload);
+    }
+}
+
+/**
+ * @brief Steps the simulation and resolves the commands. A command counts as applied at the first write of its strip registers
+ * in a later step than the one that applied its parameters => The latency is exact to one led frame plus one step
+ *
+ */
+void LoadGenerator::Step()
+{
+    this->simulation.Step();
+    for (size_t i = 0; i < this->simulation.getControllerCount(); i++)
+    {
+        this->ScanBus(i);
+    }
+
+    uint64_t now = this->simulation.getMicros();
+    for (size_t index = 0; index < this->pendingCommands.size();)
+    {
+        PendingCommand &command = this->pendingCommands[index];
+        uint64_t writes = this->stripWrites[command.controllerIndex][command.stripIndex];
+        if (command.applied && writes > command.stripWritesAtApply)
+        {
+            uint64_t nodeMicros = this->simulation.getController(command.controllerIndex).getNode().micros;
+            this->latencies.push_back((uint32_t)(nodeMicros - command.publishMicros));
+            this->result.commandsApplied++;
+
+            // Older commands of the strip still waiting never show => The newer one replaced them
+            size_t controllerIndex = command.controllerIndex;
+            uint8_t stripIndex = command.stripIndex;
+            uint64_t publishMicros = command.publishMicros;
+            this->pendingCommands.erase(this->pendingCommands.begin() + index);
+            for (size_t older = 0; older < this->pendingCommands.size();)
+            {
+                PendingCommand &other = this->pendingCommands[older];
+                if (other.controllerIndex == controllerIndex && other.stripIndex == stripIndex && other.publishMicros < publishMicros)
+                {
+                    this->result.commandsSuperseded++;
+                    this->pendingCommands.erase(this->pendingCommands.begin() + older);
+                    if (older < index)
+                    {
+                        index--;
+                    }
+                }
+                else
+                {
+                    older++;
+                }
+            }
+            continue;
+        }
+        if (now - command.publishMicros > LOAD_COMMAND_TIMEOUT)
+        {
+            this->result.commandsLost++;
+            this->pendingCommands.erase(this->pendingCommands.begin() + index);
+            continue;
+        }
+        if (!command.applied && command.isApplied())
+        {
+            command.applied = true;
+            command.stripWritesAtApply = writes;
+        }
+        index++;
+    }
+}
+
+/**
+ * @brief Counts the writes to the strip registers of the PCA9685 since the last scan
+ *
+ */
+void LoadGenerator::ScanBus(size_t controllerIndex)
+{
+    MockBus &bus = this->simulation.getController(controllerIndex).getBus();
+    uint32_t count = bus.getTransactionCount();
+    uint32_t index = this->busTransactionCounts[controllerIndex];
+    if (count - index > MOCK_BUS_RECORD_SIZE)
+    {
+        index = count - MOCK_BUS_RECORD_SIZE; // Older ones are gone from the recorder
+    }
+    for (; index < count; index++)
+    {
+        I2CBusTransaction transaction = bus.getTransaction(index);
+        if (transaction.i2cAddress != SIMULATED_PCA9685_ADDRESS || transaction.isRead || transaction.length < 2 || transaction.result != 0)
+        {
+            continue;
+        }
+        uint8_t regAddress = transaction.data[0];
+        if (regAddress >= LED3_ON_L && regAddress <= LED7_OFF_H)
+        {
+            this->stripWrites[controllerIndex][0]++;
+        }
+        else if (regAddress >= LED8_ON_L && regAddress <= LED12_OFF_H)
+        {
+            this->stripWrites[controllerIndex][1]++;
+        }
+    }
+    this->busTransactionCounts[controllerIndex] = count;
+}
+
+std::string LoadGenerator::getTopic(size_t controllerIndex, const char *suffix)
+{
+    return "LEDController/" + this->simulation.getController(controllerIndex).getClientName() + "/" + suffix;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+// Drives the controllers of a simulation with Home Assistant like command patterns through the broker stand-in
+// and measures how the fleet keeps up. Used by the load tool and its smoke test
+
+#include "Simulation.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+enum class LoadPattern
+{
+    SliderStorm,  // Brightness slider dragged on both strips of every controller
+    EffectToggle, // Effect of strip 1 switched on and off on every controller
+    AlarmFanOut   // Global alarm switched on and off => One command reaches every controller
+};
+
+/**
+ * @brief Result of one pattern over all controllers
+ *
+ */
+struct LoadResult
+{
+    LoadPattern pattern = LoadPattern::SliderStorm;
+    uint64_t micros = 0;              // Host time the pattern ran
+    uint32_t commandsSent = 0;        // Per controller => A global command counts once per controller
+    uint32_t commandsApplied = 0;     // Reached the PCA9685 registers
+    uint32_t commandsSuperseded = 0;  // Overwritten by a newer command of the same strip before they got applied
+    uint32_t commandsLost = 0;        // Not applied within LOAD_COMMAND_TIMEOUT
+    uint64_t statePublishes = 0;      // State messages of the controllers the broker received
+    uint32_t publishQueueDropped = 0; // Sum over the controllers
+    uint32_t publishQueueCoalesced = 0;
+    uint32_t latencyP50Micros = 0; // Host publish to the first write of the strip registers after the command got applied
+    uint32_t latencyP95Micros = 0;
+    uint32_t latencyMaxMicros = 0;
+    uint64_t peakHeapBytes = 0;   // Highest peak of a single controller
+    int64_t minFreeHeapBytes = 0; // Lowest free heap of a single controller at its peak
+};
+
+#define LOAD_COMMAND_TIMEOUT 2000000 // µs until a command that did not reach the registers counts as lost
+
+class LoadGenerator
+{
+public:
+    explicit LoadGenerator(Simulation &simulation);
+    ~LoadGenerator();
+
+    /**
+     * @brief Brings every strip into the same state, then runs the pattern
+     *
+     * @parameter pattern        Command pattern
+     * @parameter micros         Host time the pattern runs
+     * @parameter intervalMillis Time between two commands of one controller. 0 => Default of the pattern
+     */
+    LoadResult Run(LoadPattern pattern, uint64_t micros, uint32_t intervalMillis = 0);
+
+    static const char *PatternToString(LoadPattern pattern);
+    static uint32_t getDefaultIntervalMillis(LoadPattern pattern);
+
+private:
+    struct PendingCommand
+    {
+        size_t controllerIndex;
+        uint8_t stripIndex;
+        uint64_t publishMicros;
+        std::function<bool()> isApplied; // True once the parameters the led driver reads hold the command
+        bool applied;
+        uint64_t stripWritesAtApply; // Writes of the strip registers up to the step the command got applied in
+    };
+
+    Simulation &simulation;
+    std::vector<PendingCommand> pendingCommands;
+    std::vector<std::vector<uint64_t>> stripWrites; // Per controller and strip
+    std::vector<uint32_t> busTransactionCounts;     // Per controller, transactions already scanned
+    std::vector<uint32_t> latencies;
+    LoadResult result;
+    uint64_t statePublishes = 0;
+
+    void Prepare();
+    void Send(size_t controllerIndex, uint8_t stripIndex, const std::string &topic, const char *payload, std::function<bool()> isApplied);
+    void Step();
+    void ScanBus(size_t controllerIndex);
+    std::string getTopic(size_t controllerIndex, const char *suffix);
+};
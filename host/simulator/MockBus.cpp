@@ -0,0 +1,360 @@
+#include "MockBus.h"
+
+/**
+ * Empty constructor
+ */
+MockBus::MockBus()
+{
+};
+
+/**
+ * Starts the emulated bus
+ */
+void MockBus::Begin()
+{
+    this->stuckBus = false;
+};
+
+/**
+ * Sets the clock frequency used for the virtual timestamps
+ * 
+ * @parameter frequency The clock frequency in Hz
+ */
+void MockBus::SetClock(uint32_t frequency)
+{
+    if (frequency > 0)
+    {
+        this->frequency = frequency;
+    }
+};
+
+/**
+ * Sends data to an emulated device. The first byte sets the register pointer,
+ * all following bytes get written to the register file with auto increment
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * @parameter data          Pointer to the data to send
+ * @parameter length        The number of bytes to send
+ * 
+ * @return 0 if successfull, otherwise the error code of Wire.endTransmission()
+ */
+uint8_t MockBus::Transmit(uint8_t i2cAddress,
+                          const uint8_t *data,
+                          uint8_t length)
+{
+    uint8_t result = 0;
+    MockI2CDevice *device = getDevice(i2cAddress);
+
+    if (this->stuckBus)
+    {
+        result = 4;
+    }
+    else if (this->faultCount > 0)
+    {
+        this->faultCount--;
+        result = this->faultResult;
+    }
+    else if (device == nullptr)
+    {
+        result = 2;
+    }
+    else if (length > 0)
+    {
+        device->registerPointer = data[0];
+
+        switch (device->type)
+        {
+        case I2CDeviceType::PCA9685:
+            for (uint8_t i = 1; i < length; i++)
+            {
+                device->register8[device->registerPointer] = data[i];
+                device->registerPointer++;
+            }
+            break;
+
+        case I2CDeviceType::INA219:
+            if (length >= 3 && device->registerPointer <= CALIBRATION)
+            {
+                device->register16[device->registerPointer] = ((uint16_t)data[1] << 8) | data[2];
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    Record(i2cAddress, false, data, length, result);
+    return result;
+};
+
+/**
+ * Reads data from the register pointer of an emulated device
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * @parameter data          Pointer to the buffer for the received data
+ * @parameter length        The number of bytes to request
+ * 
+ * @return The number of bytes received
+ */
+uint8_t MockBus::Receive(uint8_t i2cAddress,
+                         uint8_t *data,
+                         uint8_t length)
+{
+    uint8_t received = 0;
+    MockI2CDevice *device = getDevice(i2cAddress);
+
+    if (!this->stuckBus && device != nullptr)
+    {
+        switch (device->type)
+        {
+        case I2CDeviceType::PCA9685:
+            for (received = 0; received < length; received++)
+            {
+                data[received] = device->register8[device->registerPointer];
+                device->registerPointer++;
+            }
+            break;
+
+        case I2CDeviceType::INA219:
+            if (length >= 2 && device->registerPointer <= CALIBRATION)
+            {
+                data[0] = highByte(device->register16[device->registerPointer]);
+                data[1] = lowByte(device->register16[device->registerPointer]);
+                received = 2;
+            }
+            break;
+
+        default:
+            break;
+        }
+    }
+
+    Record(i2cAddress, true, data, received, received == length ? 0 : 4);
+    return received;
+};
+
+/**
+ * Releases a stuck bus
+ */
+void MockBus::Recover()
+{
+    this->recoverCount++;
+    this->stuckBus = false;
+};
+
+/**
+ * @return True while the emulated device holds SDA low
+ */
+bool MockBus::isStuck()
+{
+    return this->stuckBus;
+};
+
+/**
+ * Adds an emulated device with its power on register values to the bus
+ * 
+ * @parameter type          The type of the device
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * 
+ * @return True if the device got added, false if no device slot is left
+ */
+bool MockBus::AddDevice(I2CDeviceType type,
+                        uint8_t i2cAddress)
+{
+    if (this->deviceCount >= MOCK_BUS_DEVICE_COUNT)
+    {
+        return false;
+    }
+
+    MockI2CDevice device = {};
+    device.type = type;
+    device.i2cAddress = i2cAddress;
+
+    switch (type)
+    {
+    case I2CDeviceType::PCA9685:
+        device.register8[MODE1] = 0x11;
+        device.register8[MODE2] = 0x04;
+        device.register8[ALLCALLADR] = 0xE0;
+        device.register8[PRE_SCALE] = 0x1E;
+        break;
+
+    case I2CDeviceType::INA219:
+        device.register16[CONFIG] = 0x399F;
+        break;
+
+    default:
+        break;
+    }
+
+    this->devices[this->deviceCount] = device;
+    this->deviceCount++;
+
+    return true;
+};
+
+/**
+ * @return The value of a 8 bit register of an emulated device, or 0 if the device does not exist
+ */
+uint8_t MockBus::getRegister8(uint8_t i2cAddress,
+                              uint8_t regAddress)
+{
+    MockI2CDevice *device = getDevice(i2cAddress);
+    if (device != nullptr)
+    {
+        return device->register8[regAddress];
+    }
+
+    return 0;
+};
+
+/**
+ * @return The value of a 16 bit register of an emulated device, or 0 if the device or register does not exist
+ */
+uint16_t MockBus::getRegister16(uint8_t i2cAddress,
+                                uint8_t regAddress)
+{
+    MockI2CDevice *device = getDevice(i2cAddress);
+    if (device != nullptr && regAddress <= CALIBRATION)
+    {
+        return device->register16[regAddress];
+    }
+
+    return 0;
+};
+
+/**
+ * Sets a 16 bit register of an emulated device. Used to feed measurement values
+ */
+void MockBus::setRegister16(uint8_t i2cAddress,
+                            uint8_t regAddress,
+                            uint16_t data)
+{
+    MockI2CDevice *device = getDevice(i2cAddress);
+    if (device != nullptr && regAddress <= CALIBRATION)
+    {
+        device->register16[regAddress] = data;
+    }
+};
+
+/**
+ * @return The number of transactions since the last clear. Only the last MOCK_BUS_RECORD_SIZE are kept
+ */
+uint32_t MockBus::getTransactionCount()
+{
+    return this->transactionCount;
+};
+
+/**
+ * @parameter index The index of the transaction since the last clear
+ * 
+ * @return The recorded transaction, or an empty one if it is no longer kept
+ */
+I2CBusTransaction MockBus::getTransaction(uint32_t index)
+{
+    I2CBusTransaction transaction = {};
+    if (index < this->transactionCount && this->transactionCount - index <= MOCK_BUS_RECORD_SIZE)
+    {
+        transaction = this->transactions[index % MOCK_BUS_RECORD_SIZE];
+    }
+
+    return transaction;
+};
+
+/**
+ * Clears all recorded transactions
+ */
+void MockBus::ClearRecord()
+{
+    this->transactionCount = 0;
+};
+
+/**
+ * @return The virtual bus time in micro seconds
+ */
+unsigned long MockBus::getVirtualMicros()
+{
+    return this->virtualMicros;
+};
+
+/**
+ * Advances the virtual bus time. Used to emulate time between transactions
+ */
+void MockBus::AdvanceVirtualMicros(unsigned long micros)
+{
+    this->virtualMicros += micros;
+};
+
+/**
+ * Lets the next transactions fail with the given error code
+ * 
+ * @parameter result    The error code of Wire.endTransmission() to return
+ * @parameter count     The number of transactions to fail
+ */
+void MockBus::InjectFault(uint8_t result,
+                          uint32_t count)
+{
+    this->faultResult = result;
+    this->faultCount = count;
+};
+
+/**
+ * Emulates a device that holds SDA low. All transactions fail until the bus gets recovered
+ */
+void MockBus::setStuckBus(bool stuck)
+{
+    this->stuckBus = stuck;
+};
+
+/**
+ * @return The number of bus recoveries
+ */
+uint32_t MockBus::getRecoverCount()
+{
+    return this->recoverCount;
+};
+
+/**
+ * @return Pointer to the emulated device with the given address, or nullptr if there is none
+ */
+MockI2CDevice *MockBus::getDevice(uint8_t i2cAddress)
+{
+    for (uint8_t i = 0; i < this->deviceCount; i++)
+    {
+        if (this->devices[i].i2cAddress == i2cAddress)
+        {
+            return &this->devices[i];
+        }
+    }
+
+    return nullptr;
+};
+
+/**
+ * Records a transaction and advances the virtual time by its duration on the bus
+ */
+void MockBus::Record(uint8_t i2cAddress,
+                     bool isRead,
+                     const uint8_t *data,
+                     uint8_t length,
+                     uint8_t result)
+{
+    // START + address byte + data bytes + STOP, every byte with ACK bit
+    uint32_t bits = 1 + 9 * (1 + (uint32_t)length) + 1;
+    this->virtualMicros += (bits * 1000000UL) / this->frequency;
+
+    I2CBusTransaction transaction = {};
+    transaction.timestamp = this->virtualMicros;
+    transaction.i2cAddress = i2cAddress;
+    transaction.isRead = isRead;
+    transaction.length = length;
+    for (uint8_t i = 0; i < length && i < sizeof(transaction.data); i++)
+    {
+        transaction.data[i] = data[i];
+    }
+    transaction.result = result;
+
+    this->transactions[this->transactionCount % MOCK_BUS_RECORD_SIZE] = transaction;
+    this->transactionCount++;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+// Emulated I2C bus of the simulated controllers. Host only => The 256 entry recorder stays out of the firmware
+
+// Includes
+#include <Arduino.h>
+#include <Enums/Enums.h>
+#include <Register/PCA9685_LED_Reg.h>
+#include <Register/INA219AIDR_Reg.h>
+
+// Interface
+#include <Interface/II2CBus.h>
+
+const uint16_t MOCK_BUS_RECORD_SIZE = 256; // Transactions kept by the mock bus recorder
+const uint8_t MOCK_BUS_DEVICE_COUNT = 4;   // Devices the mock bus can emulate
+
+/**
+ * @brief A single transaction recorded by the mock bus
+ * 
+ */
+struct I2CBusTransaction
+{
+    unsigned long timestamp = 0; // Virtual time in micro seconds at the end of the transaction
+    uint8_t i2cAddress = 0;
+    bool isRead = false;
+    uint8_t length = 0;
+    uint8_t data[4]{0}; // The first bytes of the transaction
+    uint8_t result = 0; // 0 if successfull, otherwise the error code of Wire.endTransmission()
+};
+
+/**
+ * @brief The register file of a device emulated by the mock bus
+ * 
+ */
+struct MockI2CDevice
+{
+    I2CDeviceType type = I2CDeviceType::Unknown;
+    uint8_t i2cAddress = 0;
+    uint8_t registerPointer = 0;
+    uint8_t register8[256]{0}; // PCA9685 registers
+    uint16_t register16[6]{0}; // INA219 registers
+};
+
+// Classes
+/**
+ * @brief The MockBus Class replaces the hardware bus of the simulated controllers.
+ * Emulates the register files of the PCA9685 and INA219 and records every transaction
+ * with a virtual timestamp based on the bus clock
+ * 
+ */
+class MockBus : public II2CBus
+{
+    // ## Constructor / Important ## //
+public:
+    MockBus();
+
+    // ## Interface ## //
+private:
+public:
+    virtual void Begin();
+    virtual void SetClock(uint32_t frequency);
+    virtual uint8_t Transmit(uint8_t i2cAddress, const uint8_t *data, uint8_t length);
+    virtual uint8_t Receive(uint8_t i2cAddress, uint8_t *data, uint8_t length);
+    virtual void Recover();
+    virtual bool isStuck();
+
+    // ## Data ## //
+private:
+    uint32_t frequency = 100000;    // Hz
+    unsigned long virtualMicros = 0; // Virtual bus time
+
+    // ---- Devices
+    MockI2CDevice devices[MOCK_BUS_DEVICE_COUNT]{};
+    uint8_t deviceCount = 0;
+
+    // ---- Recorder
+    I2CBusTransaction transactions[MOCK_BUS_RECORD_SIZE]{};
+    uint32_t transactionCount = 0;
+
+    // ---- Fault injection
+    uint8_t faultResult = 0;
+    uint32_t faultCount = 0;
+    bool stuckBus = false;
+    uint32_t recoverCount = 0;
+
+    // ## Functions ## //
+private:
+    MockI2CDevice *getDevice(uint8_t i2cAddress);
+    void Record(uint8_t i2cAddress,
+                bool isRead,
+                const uint8_t *data,
+                uint8_t length,
+                uint8_t result);
+
+public:
+    // ---- Devices
+    bool AddDevice(I2CDeviceType type, uint8_t i2cAddress);
+    uint8_t getRegister8(uint8_t i2cAddress, uint8_t regAddress);
+    uint16_t getRegister16(uint8_t i2cAddress, uint8_t regAddress);
+    void setRegister16(uint8_t i2cAddress, uint8_t regAddress, uint16_t data);
+
+    // ---- Recorder
+    uint32_t getTransactionCount();
+    I2CBusTransaction getTransaction(uint32_t index);
+    void ClearRecord();
+    unsigned long getVirtualMicros();
+    void AdvanceVirtualMicros(unsigned long micros);
+
+    // ---- Fault injection
+    void InjectFault(uint8_t result, uint32_t count);
+    void setStuckBus(bool stuck);
+    uint32_t getRecoverCount();
+};
@@ -0,0 +1,646 @@
+#include "MqttBroker.h"
+#include <HostEnvironment.h>
+#include <algorithm>
+
+#define MQTT_PACKET_CONNECT 1
+#define MQTT_PACKET_CONNACK 2
+#define MQTT_PACKET_PUBLISH 3
+#define MQTT_PACKET_PUBACK 4
+#define MQTT_PACKET_SUBSCRIBE 8
+#define MQTT_PACKET_SUBACK 9
+#define MQTT_PACKET_UNSUBSCRIBE 10
+#define MQTT_PACKET_UNSUBACK 11
+#define MQTT_PACKET_PINGREQ 12
+#define MQTT_PACKET_PINGRESP 13
+#define MQTT_PACKET_DISCONNECT 14
+
+#define MQTT_OFFLINE_QUEUE_SIZE 100 // Messages kept per offline persistent session. Older ones get dropped like max_queued_messages of mosquitto
+
+/**
+ * @brief Reads a length prefixed string of a packet
+ */
+static bool ReadString(const uint8_t *data, size_t length, size_t &position, std::string &text)
+{
+    if (position + 2 > length)
+    {
+        return false;
+    }
+    size_t textLength = ((size_t)data[position] << 8) | data[position + 1];
+    position += 2;
+    if (position + textLength > length)
+    {
+        return false;
+    }
+    text.assign((const char *)data + position, textLength);
+    position += textLength;
+    return true;
+}
+
+static void WriteString(std::vector<uint8_t> &body, const std::string &text)
+{
+    body.push_back((text.size() >> 8) & 0xFF);
+    body.push_back(text.size() & 0xFF);
+    body.insert(body.end(), text.begin(), text.end());
+}
+
+MqttBroker::MqttBroker(IPAddress ipAddress, uint16_t port) : ipAddress(ipAddress), port(port)
+{
+}
+
+MqttBroker::~MqttBroker()
+{
+    if (this->running)
+    {
+        this->Kill();
+    }
+}
+
+// ================================ LIFETIME ================================ //
+void MqttBroker::Start()
+{
+    this->running = true;
+    HostNetwork::Listen(this->ipAddress, this->port, [this](std::shared_ptr<HostTcpSocket> socket)
+                        { this->Accept(socket); });
+}
+
+void MqttBroker::Kill()
+{
+    this->running = false;
+    HostNetwork::StopListening(this->ipAddress, this->port);
+    std::vector<std::shared_ptr<Connection>> dropped = this->connections;
+    for (const std::shared_ptr<Connection> &connection : dropped)
+    {
+        this->Drop(connection, false);
+    }
+}
+
+void MqttBroker::Restore()
+{
+    if (!this->running)
+    {
+        this->Start();
+    }
+}
+
+void MqttBroker::Loop()
+{
+    uint64_t now = HostTime::getMicros();
+    std::vector<std::shared_ptr<Connection>> current = this->connections;
+    for (const std::shared_ptr<Connection> &connection : current)
+    {
+        // 1.5 times the keep alive without a packet => The client is gone
+        if (connection->connected && connection->keepAlive > 0 && now > connection->lastActivity &&
+            now - connection->lastActivity > (uint64_t)connection->keepAlive * 1500000)
+        {
+            this->statistics.keepAliveTimeouts++;
+            this->Drop(connection, true);
+        }
+    }
+}
+
+// ================================ HOST CLIENT ================================ //
+void MqttBroker::Publish(const char *topic, const char *payload, bool retained, uint8_t qos)
+{
+    MqttBrokerMessage message;
+    message.topic = topic;
+    message.payload = payload;
+    message.qos = qos;
+    message.retained = retained;
+    message.micros = HostTime::getMicros();
+    this->statistics.publishesReceived++;
+    this->Route(message);
+}
+
+void MqttBroker::Observe(const char *topicFilter, Observer observer)
+{
+    this->observers.emplace_back(topicFilter, observer);
+}
+
+void MqttBroker::ClearObservers()
+{
+    this->observers.clear();
+}
+
+// ================================ INSPECTION ================================ //
+bool MqttBroker::isClientConnected(const std::string &clientId) const
+{
+    return this->FindConnection(clientId) != nullptr;
+}
+
+uint32_t MqttBroker::getConnectedClientCount() const
+{
+    uint32_t count = 0;
+    for (const std::shared_ptr<Connection> &connection : this->connections)
+    {
+        count += connection->connected ? 1 : 0;
+    }
+    return count;
+}
+
+std::vector<std::string> MqttBroker::getSubscriptions(const std::string &clientId) const
+{
+    std::vector<std::string> topicFilters;
+    auto session = this->sessions.find(clientId);
+    if (session != this->sessions.end())
+    {
+        for (const Subscription &subscription : session->second.subscriptions)
+        {
+            topicFilters.push_back(subscription.topicFilter);
+        }
+    }
+    return topicFilters;
+}
+
+bool MqttBroker::getRetained(const std::string &topic, std::string &payload) const
+{
+    auto message = this->retained.find(topic);
+    if (message == this->retained.end())
+    {
+        return false;
+    }
+    payload = message->second.payload;
+    return true;
+}
+
+bool MqttBroker::Matches(const std::string &topicFilter, const std::string &topic)
+{
+    size_t filterPosition = 0;
+    size_t topicPosition = 0;
+    while (filterPosition <= topicFilter.size())
+    {
+        size_t filterEnd = topicFilter.find('/', filterPosition);
+        if (filterEnd == std::string::npos)
+        {
+            filterEnd = topicFilter.size();
+        }
+        std::string level = topicFilter.substr(filterPosition, filterEnd - filterPosition);
+        if (level == "#")
+        {
+            return true;
+        }
+        if (topicPosition > topic.size())
+        {
+            return false;
+        }
+        size_t topicEnd = topic.find('/', topicPosition);
+        if (topicEnd == std::string::npos)
+        {
+            topicEnd = topic.size();
+        }
+        if (level != "+" && level != topic.substr(topicPosition, topicEnd - topicPosition))
+        {
+            return false;
+        }
+        filterPosition = filterEnd + 1;
+        topicPosition = topicEnd + 1;
+    }
+    return topicPosition > topic.size();
+}
+
+// ================================ CONNECTION ================================ //
+void MqttBroker::Accept(std::shared_ptr<HostTcpSocket> socket)
+{
+    std::shared_ptr<Connection> connection = std::make_shared<Connection>();
+    connection->socket = socket;
+    connection->lastActivity = HostTime::getMicros();
+    std::weak_ptr<Connection> weak = connection;
+    socket->onReceive = [this, weak](HostTcpSocket &)
+    {
+        std::shared_ptr<Connection> connection = weak.lock();
+        if (connection)
+        {
+            this->Receive(connection);
+        }
+    };
+    socket->onClose = [this, weak](HostTcpSocket &)
+    {
+        std::shared_ptr<Connection> connection = weak.lock();
+        if (connection)
+        {
+            this->Drop(connection, true);
+        }
+    };
+    this->connections.push_back(connection);
+}
+
+void MqttBroker::Receive(const std::shared_ptr<Connection> &connection)
+{
+    std::deque<uint8_t> &received = connection->socket->received;
+    this->statistics.bytesReceived += received.size();
+    connection->buffer.insert(connection->buffer.end(), received.begin(), received.end());
+    received.clear();
+    connection->lastActivity = HostTime::getMicros();
+
+    // Every complete packet in the buffer
+    while (connection->buffer.size() >= 2 && connection->socket)
+    {
+        size_t remainingLength = 0;
+        size_t multiplier = 1;
+        size_t position = 1;
+        bool complete = false;
+        while (position < connection->buffer.size() && position <= 4)
+        {
+            uint8_t digit = connection->buffer[position++];
+            remainingLength += (digit & 0x7F) * multiplier;
+            multiplier *= 128;
+            if ((digit & 0x80) == 0)
+            {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete)
+        {
+            if (position > 4)
+            {
+                this->Drop(connection, true); // Malformed remaining length
+            }
+            return;
+        }
+        if (connection->buffer.size() < position + remainingLength)
+        {
+            return;
+        }
+        std::vector<uint8_t> packet(connection->buffer.begin() + position, connection->buffer.begin() + position + remainingLength);
+        uint8_t header = connection->buffer[0];
+        connection->buffer.erase(connection->buffer.begin(), connection->buffer.begin() + position + remainingLength);
+        this->HandlePacket(connection, header, packet.data(), packet.size());
+    }
+}
+
+void MqttBroker::HandlePacket(const std::shared_ptr<Connection> &connection, uint8_t header, const uint8_t *data, size_t length)
+{
+    uint8_t type = header >> 4;
+    if (!connection->connected && type != MQTT_PACKET_CONNECT)
+    {
+        this->Drop(connection, false);
+        return;
+    }
+    switch (type)
+    {
+    case MQTT_PACKET_CONNECT:
+        this->HandleConnect(connection, data, length);
+        break;
+    case MQTT_PACKET_PUBLISH:
+        this->HandlePublish(connection, header, data, length);
+        break;
+    case MQTT_PACKET_PUBACK:
+        break; // Delivery is fire and forget => Nothing in flight to release
+    case MQTT_PACKET_SUBSCRIBE:
+        this->HandleSubscribe(connection, data, length);
+        break;
+    case MQTT_PACKET_UNSUBSCRIBE:
+        this->HandleUnsubscribe(connection, data, length);
+        break;
+    case MQTT_PACKET_PINGREQ:
+        this->statistics.pingRequests++;
+        this->Send(connection, MQTT_PACKET_PINGRESP << 4, {});
+        break;
+    case MQTT_PACKET_DISCONNECT:
+        this->Drop(connection, false);
+        break;
+    default:
+        this->Drop(connection, true);
+        break;
+    }
+}
+
+void MqttBroker::HandleConnect(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length)
+{
+    size_t position = 0;
+    std::string protocol;
+    if (connection->connected || !ReadString(data, length, position, protocol) || protocol != "MQTT" || position + 4 > length)
+    {
+        this->Drop(connection, false);
+        return;
+    }
+    uint8_t level = data[position++];
+    uint8_t flags = data[position++];
+    uint16_t keepAlive = ((uint16_t)data[position] << 8) | data[position + 1];
+    position += 2;
+    if (level != 4)
+    {
+        this->Send(connection, MQTT_PACKET_CONNACK << 4, {0, 1}); // Unacceptable protocol version
+        this->Drop(connection, false);
+        return;
+    }
+
+    std::string clientId;
+    std::string willTopic;
+    std::string willMessage;
+    std::string username;
+    std::string password;
+    bool valid = ReadString(data, length, position, clientId);
+    if (valid && (flags & 0x04))
+    {
+        valid = ReadString(data, length, position, willTopic) && ReadString(data, length, position, willMessage);
+    }
+    if (valid && (flags & 0x80))
+    {
+        valid = ReadString(data, length, position, username);
+    }
+    if (valid && (flags & 0x40))
+    {
+        valid = ReadString(data, length, position, password);
+    }
+    if (!valid)
+    {
+        this->Drop(connection, false);
+        return;
+    }
+
+    // Same client id => The older connection gets taken over
+    std::shared_ptr<Connection> previous = this->FindConnection(clientId);
+    if (previous)
+    {
+        this->Drop(previous, true);
+    }
+
+    bool cleanSession = (flags & 0x02) != 0;
+    auto session = this->sessions.find(clientId);
+    bool sessionPresent = !cleanSession && session != this->sessions.end();
+    if (cleanSession || session == this->sessions.end())
+    {
+        this->sessions[clientId] = Session();
+        this->sessions[clientId].clientId = clientId;
+    }
+    this->sessions[clientId].cleanSession = cleanSession;
+
+    connection->connected = true;
+    connection->clientId = clientId;
+    connection->keepAlive = keepAlive;
+    connection->hasWill = (flags & 0x04) != 0;
+    if (connection->hasWill)
+    {
+        connection->will.topic = willTopic;
+        connection->will.payload = willMessage;
+        connection->will.qos = (flags >> 3) & 0x03;
+        connection->will.retained = (flags & 0x20) != 0;
+        connection->will.senderClientId = clientId;
+    }
+    this->statistics.connects++;
+    this->Send(connection, MQTT_PACKET_CONNACK << 4, {(uint8_t)(sessionPresent ? 1 : 0), 0});
+
+    // Missed QoS 1 messages of a persistent session
+    std::vector<MqttBrokerMessage> queued;
+    queued.swap(this->sessions[clientId].offlineQueue);
+    for (const MqttBrokerMessage &message : queued)
+    {
+        this->Deliver(connection, message, 1, false);
+    }
+}
+
+void MqttBroker::HandlePublish(const std::shared_ptr<Connection> &connection, uint8_t header, const uint8_t *data, size_t length)
+{
+    size_t position = 0;
+    MqttBrokerMessage message;
+    if (!ReadString(data, length, position, message.topic))
+    {
+        this->Drop(connection, true);
+        return;
+    }
+    message.qos = (header >> 1) & 0x03;
+    message.retained = (header & 0x01) != 0;
+    uint16_t packetId = 0;
+    if (message.qos > 0)
+    {
+        if (position + 2 > length)
+        {
+            this->Drop(connection, true);
+            return;
+        }
+        packetId = ((uint16_t)data[position] << 8) | data[position + 1];
+        position += 2;
+    }
+    message.payload.assign((const char *)data + position, length - position);
+    message.senderClientId = connection->clientId;
+    message.micros = HostTime::getMicros();
+    this->statistics.publishesReceived++;
+
+    if (message.qos == 1)
+    {
+        this->Send(connection, MQTT_PACKET_PUBACK << 4, {(uint8_t)(packetId >> 8), (uint8_t)(packetId & 0xFF)});
+    }
+    this->Route(message);
+}
+
+void MqttBroker::HandleSubscribe(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length)
+{
+    if (length < 2)
+    {
+        this->Drop(connection, true);
+        return;
+    }
+    size_t position = 2;
+    std::vector<uint8_t> body = {data[0], data[1]};
+    Session &session = this->sessions[connection->clientId];
+    std::vector<std::pair<std::string, uint8_t>> added;
+    while (position < length)
+    {
+        std::string topicFilter;
+        if (!ReadString(data, length, position, topicFilter) || position >= length)
+        {
+            this->Drop(connection, true);
+            return;
+        }
+        uint8_t qos = std::min<uint8_t>(data[position++] & 0x03, 1);
+        auto existing = std::find_if(session.subscriptions.begin(), session.subscriptions.end(), [&topicFilter](const Subscription &subscription)
+                                     { return subscription.topicFilter == topicFilter; });
+        if (existing != session.subscriptions.end())
+        {
+            existing->qos = qos;
+        }
+        else
+        {
+            session.subscriptions.push_back({topicFilter, qos});
+        }
+        added.emplace_back(topicFilter, qos);
+        body.push_back(qos);
+        this->statistics.subscribes++;
+    }
+    this->Send(connection, MQTT_PACKET_SUBACK << 4, body);
+
+    // Retained messages of the new subscriptions
+    for (const std::pair<std::string, uint8_t> &subscription : added)
+    {
+        for (const std::pair<const std::string, MqttBrokerMessage> &message : this->retained)
+        {
+            if (Matches(subscription.first, message.first))
+            {
+                this->Deliver(connection, message.second, std::min(subscription.second, message.second.qos), true);
+            }
+        }
+    }
+}
+
+void MqttBroker::HandleUnsubscribe(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length)
+{
+    if (length < 2)
+    {
+        this->Drop(connection, true);
+        return;
+    }
+    size_t position = 2;
+    Session &session = this->sessions[connection->clientId];
+    while (position < length)
+    {
+        std::string topicFilter;
+        if (!ReadString(data, length, position, topicFilter))
+        {
+            this->Drop(connection, true);
+            return;
+        }
+        session.subscriptions.erase(std::remove_if(session.subscriptions.begin(), session.subscriptions.end(), [&topicFilter](const Subscription &subscription)
+                                                   { return subscription.topicFilter == topicFilter; }),
+                                    session.subscriptions.end());
+        this->statistics.unsubscribes++;
+    }
+    this->Send(connection, MQTT_PACKET_UNSUBACK << 4, {data[0], data[1]});
+}
+
+void MqttBroker::Drop(const std::shared_ptr<Connection> &connection, bool sendWill)
+{
+    auto found = std::find(this->connections.begin(), this->connections.end(), connection);
+    if (found == this->connections.end())
+    {
+        return;
+    }
+    this->connections.erase(found);
+    if (connection->socket)
+    {
+        connection->socket->onReceive = nullptr;
+        connection->socket->onClose = nullptr;
+        connection->socket->Close();
+    }
+    if (!connection->connected)
+    {
+        return;
+    }
+    this->statistics.disconnects++;
+    auto session = this->sessions.find(connection->clientId);
+    if (session != this->sessions.end() && session->second.cleanSession)
+    {
+        this->sessions.erase(session);
+    }
+    if (sendWill && connection->hasWill)
+    {
+        this->statistics.willsSent++;
+        MqttBrokerMessage will = connection->will;
+        will.micros = HostTime::getMicros();
+        this->Route(will);
+    }
+}
+
+// ================================ ROUTING ================================ //
+void MqttBroker::Route(const MqttBrokerMessage &message)
+{
+    if (message.retained)
+    {
+        if (message.payload.empty())
+        {
+            this->retained.erase(message.topic);
+        }
+        else
+        {
+            this->retained[message.topic] = message;
+        }
+    }
+
+    for (const std::pair<std::string, Observer> &observer : this->observers)
+    {
+        if (Matches(observer.first, message.topic))
+        {
+            observer.second(message);
+        }
+    }
+
+    // Snapshot => A delivery can drop a connection
+    std::vector<std::shared_ptr<Connection>> current = this->connections;
+    for (std::pair<const std::string, Session> &entry : this->sessions)
+    {
+        Session &session = entry.second;
+        int8_t qos = -1;
+        for (const Subscription &subscription : session.subscriptions)
+        {
+            if (Matches(subscription.topicFilter, message.topic))
+            {
+                qos = std::max<int8_t>(qos, std::min(subscription.qos, message.qos));
+            }
+        }
+        if (qos < 0)
+        {
+            continue;
+        }
+        std::shared_ptr<Connection> connection = this->FindConnection(session.clientId);
+        if (connection)
+        {
+            this->Deliver(connection, message, qos, false);
+        }
+        else if (!session.cleanSession && qos == 1)
+        {
+            if (session.offlineQueue.size() >= MQTT_OFFLINE_QUEUE_SIZE)
+            {
+                session.offlineQueue.erase(session.offlineQueue.begin());
+            }
+            session.offlineQueue.push_back(message);
+            this->statistics.queuedForOfflineSessions++;
+        }
+    }
+}
+
+void MqttBroker::Deliver(const std::shared_ptr<Connection> &connection, const MqttBrokerMessage &message, uint8_t qos, bool retained)
+{
+    std::vector<uint8_t> body;
+    body.reserve(message.topic.size() + message.payload.size() + 4);
+    WriteString(body, message.topic);
+    if (qos > 0)
+    {
+        uint16_t packetId = connection->nextPacketId++;
+        if (connection->nextPacketId == 0)
+        {
+            connection->nextPacketId = 1;
+        }
+        body.push_back(packetId >> 8);
+        body.push_back(packetId & 0xFF);
+    }
+    body.insert(body.end(), message.payload.begin(), message.payload.end());
+    this->statistics.publishesDelivered++;
+    this->Send(connection, (MQTT_PACKET_PUBLISH << 4) | (qos << 1) | (retained ? 1 : 0), body);
+}
+
+void MqttBroker::Send(const std::shared_ptr<Connection> &connection, uint8_t header, const std::vector<uint8_t> &body)
+{
+    if (!connection->socket)
+    {
+        return;
+    }
+    std::vector<uint8_t> packet;
+    packet.reserve(body.size() + 5);
+    packet.push_back(header);
+    size_t remainingLength = body.size();
+    do
+    {
+        uint8_t digit = remainingLength % 128;
+        remainingLength /= 128;
+        if (remainingLength > 0)
+        {
+            digit |= 0x80;
+        }
+        packet.push_back(digit);
+    } while (remainingLength > 0);
+    packet.insert(packet.end(), body.begin(), body.end());
+    this->statistics.bytesSent += packet.size();
+    connection->socket->Write(packet.data(), packet.size());
+}
+
+std::shared_ptr<MqttBroker::Connection> MqttBroker::FindConnection(const std::string &clientId) const
+{
+    for (const std::shared_ptr<Connection> &connection : this->connections)
+    {
+        if (connection->connected && connection->clientId == clientId)
+        {
+            return connection;
+        }
+    }
+    return nullptr;
+}
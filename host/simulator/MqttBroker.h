@@ -0,0 +1,130 @@
+#pragma once
+
+// MQTT 3.1.1 broker on the simulated network. Stands in for the broker of the real installation in the
+// simulator, the tests and the load tool. Host side clients publish and observe without a connection
+
+#include <Arduino.h>
+#include <HostNetwork.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @brief One message as routed by the broker
+ *
+ */
+struct MqttBrokerMessage
+{
+    std::string topic;
+    std::string payload;
+    uint8_t qos = 0;
+    bool retained = false;
+    std::string senderClientId; // Empty => Published by the host
+    uint64_t micros = 0;        // Host time the broker received it
+};
+
+/**
+ * @brief Counters of the broker since the start or the last reset
+ *
+ */
+struct MqttBrokerStatistics
+{
+    uint32_t connects = 0;
+    uint32_t disconnects = 0;      // Clean disconnects and lost connections
+    uint32_t keepAliveTimeouts = 0;
+    uint32_t willsSent = 0;
+    uint64_t publishesReceived = 0; // From clients and the host
+    uint64_t publishesDelivered = 0; // To connected clients
+    uint64_t bytesReceived = 0;
+    uint64_t bytesSent = 0;
+    uint32_t subscribes = 0;
+    uint32_t unsubscribes = 0;
+    uint64_t pingRequests = 0;     // Keep alive of idle clients
+    uint32_t queuedForOfflineSessions = 0;
+};
+
+class MqttBroker
+{
+public:
+    typedef std::function<void(const MqttBrokerMessage &message)> Observer;
+
+    MqttBroker(IPAddress ipAddress = IPAddress(192, 168, 0, 10), uint16_t port = 1883);
+    ~MqttBroker();
+
+    // ---- Lifetime
+    void Start();
+    void Kill();    // Drops every connection without a will and stops listening. Retained messages and sessions survive like with persistence
+    void Restore(); // Listens again after a kill
+    bool isRunning() const { return this->running; }
+    void Loop();    // Keep alive supervision. Call regularly with the host selected
+
+    // ---- Host side client
+    void Publish(const char *topic, const char *payload, bool retained = false, uint8_t qos = 0);
+    void Observe(const char *topicFilter, Observer observer);
+    void ClearObservers();
+
+    // ---- Inspection
+    IPAddress getIpAddress() const { return this->ipAddress; }
+    uint16_t getPort() const { return this->port; }
+    bool isClientConnected(const std::string &clientId) const;
+    uint32_t getConnectedClientCount() const;
+    std::vector<std::string> getSubscriptions(const std::string &clientId) const;
+    bool getRetained(const std::string &topic, std::string &payload) const;
+    const MqttBrokerStatistics &getStatistics() const { return this->statistics; }
+    void ResetStatistics() { this->statistics = MqttBrokerStatistics(); }
+
+    static bool Matches(const std::string &topicFilter, const std::string &topic);
+
+private:
+    struct Subscription
+    {
+        std::string topicFilter;
+        uint8_t qos;
+    };
+
+    struct Session
+    {
+        std::string clientId;
+        bool cleanSession = true;
+        std::vector<Subscription> subscriptions;
+        std::vector<MqttBrokerMessage> offlineQueue; // QoS 1 messages for a persistent session while it is offline
+    };
+
+    struct Connection
+    {
+        std::shared_ptr<HostTcpSocket> socket;
+        std::vector<uint8_t> buffer; // Bytes of a packet that did not fully arrive yet
+        bool connected = false;      // CONNECT accepted
+        std::string clientId;
+        uint16_t keepAlive = 0;      // sec
+        uint64_t lastActivity = 0;
+        bool hasWill = false;
+        MqttBrokerMessage will;
+        uint16_t nextPacketId = 1;
+    };
+
+    IPAddress ipAddress;
+    uint16_t port;
+    bool running = false;
+
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::map<std::string, Session> sessions;
+    std::map<std::string, MqttBrokerMessage> retained;
+    std::vector<std::pair<std::string, Observer>> observers;
+    MqttBrokerStatistics statistics;
+
+    void Accept(std::shared_ptr<HostTcpSocket> socket);
+    void Receive(const std::shared_ptr<Connection> &connection);
+    void HandlePacket(const std::shared_ptr<Connection> &connection, uint8_t header, const uint8_t *data, size_t length);
+    void HandleConnect(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length);
+    void HandlePublish(const std::shared_ptr<Connection> &connection, uint8_t header, const uint8_t *data, size_t length);
+    void HandleSubscribe(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length);
+    void HandleUnsubscribe(const std::shared_ptr<Connection> &connection, const uint8_t *data, size_t length);
+    void Drop(const std::shared_ptr<Connection> &connection, bool sendWill);
+
+    void Route(const MqttBrokerMessage &message);
+    void Deliver(const std::shared_ptr<Connection> &connection, const MqttBrokerMessage &message, uint8_t qos, bool retained);
+    void Send(const std::shared_ptr<Connection> &connection, uint8_t header, const std::vector<uint8_t> &body);
+    std::shared_ptr<Connection> FindConnection(const std::string &clientId) const;
+};
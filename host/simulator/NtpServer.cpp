@@ -0,0 +1,67 @@
+#include "NtpServer.h"
+#include <HostEnvironment.h>
+
+#define NTP_SERVER_PACKET_SIZE 48
+#define NTP_SERVER_SEVENTY_YEARS 2208988800ULL // Seconds from 1900 to 1970
+
+NtpServer::NtpServer(const char *hostName, IPAddress ipAddress, uint16_t port) : hostName(hostName), ipAddress(ipAddress), port(port)
+{
+}
+
+NtpServer::~NtpServer()
+{
+    this->Stop();
+}
+
+void NtpServer::Start()
+{
+    HostNetwork::AddHost(this->hostName, this->ipAddress);
+    this->socket = HostNetwork::Bind(nullptr, this->port);
+}
+
+void NtpServer::Stop()
+{
+    if (this->socket)
+    {
+        HostNetwork::Unbind(this->socket);
+        this->socket.reset();
+    }
+}
+
+void NtpServer::Loop()
+{
+    if (!this->socket)
+    {
+        return;
+    }
+    uint64_t now = HostTime::getMicros();
+    while (!this->socket->received.empty() && this->socket->received.front().deliverAt <= now)
+    {
+        HostDatagram request = this->socket->received.front();
+        this->socket->received.pop_front();
+        if (request.destinationIP != this->ipAddress || request.data.size() < NTP_SERVER_PACKET_SIZE)
+        {
+            continue;
+        }
+        this->requestCount++;
+
+        // Server mode, same version as the request, stratum 1. Receive and transmit timestamp are the host time
+        uint8_t response[NTP_SERVER_PACKET_SIZE]{0};
+        response[0] = (request.data[0] & 0x38) | 0x04;
+        response[1] = 1;
+        uint64_t seconds = NTP_SERVER_SEVENTY_YEARS + NTP_SERVER_UNIX_START + now / 1000000;
+        uint32_t fraction = (uint32_t)(((now % 1000000) << 32) / 1000000);
+        for (uint8_t offset : {32, 40})
+        {
+            response[offset + 0] = (seconds >> 24) & 0xFF;
+            response[offset + 1] = (seconds >> 16) & 0xFF;
+            response[offset + 2] = (seconds >> 8) & 0xFF;
+            response[offset + 3] = seconds & 0xFF;
+            response[offset + 4] = (fraction >> 24) & 0xFF;
+            response[offset + 5] = (fraction >> 16) & 0xFF;
+            response[offset + 6] = (fraction >> 8) & 0xFF;
+            response[offset + 7] = fraction & 0xFF;
+        }
+        HostNetwork::Send(nullptr, this->ipAddress, this->port, request.sourceIP, request.sourcePort, response, sizeof(response));
+    }
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+// NTP server on the simulated network. Answers every request with the host time on top of a fixed date => Reproducible wall clock
+
+#include <Arduino.h>
+#include <HostNetwork.h>
+#include <memory>
+
+#define NTP_SERVER_UNIX_START 1767225600UL // 01.01.2026 00:00:00 UTC at host time 0
+
+class NtpServer
+{
+public:
+    NtpServer(const char *hostName = "europe.pool.ntp.org", IPAddress ipAddress = IPAddress(192, 168, 0, 2), uint16_t port = 123);
+    ~NtpServer();
+
+    void Start();
+    void Stop();
+    void Loop(); // Answers the requests that arrived until the host time. Call regularly with the host selected
+
+    uint32_t getRequestCount() const { return this->requestCount; }
+
+private:
+    const char *hostName;
+    IPAddress ipAddress;
+    uint16_t port;
+    std::shared_ptr<HostUdpSocket> socket;
+    uint32_t requestCount = 0;
+};
@@ -0,0 +1,72 @@
+#include "SimulatedController.h"
+#include <HostNetwork.h>
+
+SimulatedController::SimulatedController(uint32_t chipId,
+                                         IPAddress ipAddress,
+                                         const char *clientName,
+                                         IPAddress brokerAddress,
+                                         uint16_t brokerPort) : node(chipId, ipAddress), clientName(clientName)
+{
+    this->node.micros = HostNode::Host().micros;
+    this->node.WriteConfiguration("SimulatedWiFi", "password", brokerAddress.toString().c_str(), brokerPort, "", "", clientName);
+
+    HostNodeScope scope(this->node);
+    this->bus.AddDevice(I2CDeviceType::PCA9685, SIMULATED_PCA9685_ADDRESS);
+    this->bus.AddDevice(I2CDeviceType::INA219, SIMULATED_INA219_ADDRESS);
+    this->controller = new (&this->controllerStorage) LEDControllerMk4(&this->clock, &this->bus);
+}
+
+SimulatedController::~SimulatedController()
+{
+    HostNodeScope scope(this->node);
+    this->controller->~LEDControllerMk4();
+}
+
+/**
+ * @brief Runs the Arduino setup of the controller
+ *
+ */
+void SimulatedController::Setup()
+{
+    HostNodeScope scope(this->node);
+    this->SyncClock();
+    this->controller->_setup();
+    this->SyncClock();
+}
+
+/**
+ * @brief Runs one loop of the controller. A node that blocked longer than the host advanced since the last step runs at its own time
+ *
+ */
+void SimulatedController::Step()
+{
+    uint64_t hostMicros = HostNode::Host().micros;
+    HostNodeScope scope(this->node);
+    if (this->node.micros < hostMicros)
+    {
+        this->node.micros = hostMicros;
+    }
+    this->SyncClock();
+    HostNetwork::Pump();
+    this->controller->_loop();
+    this->SyncClock();
+    this->loopCount++;
+}
+
+/**
+ * @brief Brings the virtual clock of the components and the time of the node together. The node time moves with the host and with every delay() of the Arduino core,
+ * the virtual clock with every Delay() of the components => The one behind catches up
+ *
+ */
+void SimulatedController::SyncClock()
+{
+    uint64_t elapsedMicros = this->clock.getElapsedMicros();
+    if (this->node.micros > elapsedMicros)
+    {
+        this->clock.Advance((unsigned long)(this->node.micros - elapsedMicros));
+    }
+    else
+    {
+        this->node.micros = elapsedMicros;
+    }
+}
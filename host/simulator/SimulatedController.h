@@ -0,0 +1,79 @@
+#pragma once
+
+// One controller on the host. Owns the simulated hardware (node, clock, bus) and the unchanged firmware on top of it
+
+#include <Arduino.h>
+#include <HostEnvironment.h>
+#include <LEDControllerMk4.h>
+#include <Clock/VirtualClock.h>
+#include "MockBus.h"
+#include <memory>
+#include <type_traits>
+#include <string>
+
+#define SIMULATED_PCA9685_ADDRESS 0x40 // Address of the PCA9685 on the Mk4 board
+#define SIMULATED_INA219_ADDRESS 0x45  // Address of the INA219 on the Mk4 board
+
+/**
+ * @brief Selects a node for the lifetime of the scope and selects the previous one again at its end
+ *
+ */
+class HostNodeScope
+{
+public:
+    explicit HostNodeScope(HostNode &node) : previous(HostNode::Current()) { node.Select(); }
+    ~HostNodeScope() { this->previous.Select(); }
+
+private:
+    HostNode &previous;
+};
+
+class SimulatedController
+{
+public:
+    /**
+     * @brief Creates the controller with a configuration pointing at the broker => It connects without the setup webpage
+     *
+     * @parameter chipId        Identity of the ESP8266. Also seeds the random numbers of the node
+     * @parameter ipAddress     Address the node gets from the access point
+     * @parameter clientName    MQTT client name of the controller
+     * @parameter brokerAddress Address of the broker
+     * @parameter brokerPort    Port of the broker
+     */
+    SimulatedController(uint32_t chipId,
+                        IPAddress ipAddress,
+                        const char *clientName,
+                        IPAddress brokerAddress = IPAddress(192, 168, 0, 10),
+                        uint16_t brokerPort = 1883);
+    ~SimulatedController();
+
+    void Setup();
+    void Step(); // One pass of the Arduino loop at the time of the host
+
+    HostNode &getNode() { return this->node; }
+    LEDControllerMk4 &getFirmware() { return *this->controller; }
+    Network &getNetwork() { return this->controller->getNetwork(); }
+    Parameterhandler &getParameterhandler() { return this->controller->getParameterhandler(); }
+    I2C &getI2C() { return this->controller->getI2C(); }
+    Profiler &getProfiler() { return this->controller->getProfiler(); }
+    Realtime &getRealtime() { return this->controller->getRealtime(); }
+    SharedClock &getSharedClock() { return this->controller->getSharedClock(); }
+    VirtualClock &getClock() { return this->clock; }
+    // Local time of the shared clock => A start time and crystal error of its own like a real controller
+    void setSharedClockSource(ITimeSource *clock) { this->controller->getSharedClock().setReference(&this->controller->getNetwork(), &this->controller->getInformation(), clock); }
+    MockBus &getBus() { return this->bus; }
+    const std::string &getClientName() const { return this->clientName; }
+    uint64_t getLoopCount() const { return this->loopCount; }
+
+private:
+    HostNode node;
+    VirtualClock clock = VirtualClock();
+    MockBus bus = MockBus();
+    // Global in the sketch => Lives in the static RAM of the ESP8266, only what its members allocate counts in the heap of the node
+    std::aligned_storage_t<sizeof(LEDControllerMk4), alignof(LEDControllerMk4)> controllerStorage;
+    LEDControllerMk4 *controller = nullptr;
+    std::string clientName;
+    uint64_t loopCount = 0;
+
+    void SyncClock();
+};
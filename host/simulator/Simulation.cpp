@@ -0,0 +1,99 @@
+#include "Simulation.h"
+#include <HostNetwork.h>
+
+Simulation::Simulation(uint32_t stepMicros) : stepMicros(stepMicros)
+{
+    // Every simulation starts on a fresh network at time 0
+    HostNode::Host().Select();
+    HostNetwork::Reset();
+    HostNode::Host().micros = 0;
+    this->broker.Start();
+    this->ntpServer.Start();
+}
+
+Simulation::~Simulation()
+{
+    this->controllers.clear();
+    this->broker.Kill();
+    this->ntpServer.Stop();
+    HostNode::Host().Select();
+    HostNetwork::Reset();
+}
+
+/**
+ * @brief Adds a controller with the next free chip id and address. The controllers are 192.168.0.101, 192.168.0.102, ...
+ *
+ * @parameter clientName MQTT client name of the controller
+ */
+SimulatedController &Simulation::AddController(const char *clientName)
+{
+    uint32_t index = this->controllers.size() + 1;
+    this->controllers.emplace_back(new SimulatedController(0x00A1B200 + index,
+                                                           IPAddress(192, 168, 0, 100 + index),
+                                                           clientName,
+                                                           this->broker.getIpAddress(),
+                                                           this->broker.getPort()));
+    return *this->controllers.back();
+}
+
+void Simulation::Setup()
+{
+    for (std::unique_ptr<SimulatedController> &controller : this->controllers)
+    {
+        controller->Setup();
+    }
+}
+
+void Simulation::Step()
+{
+    HostNode::Host().micros += this->stepMicros;
+    this->broker.Loop();
+    this->ntpServer.Loop();
+    for (std::unique_ptr<SimulatedController> &controller : this->controllers)
+    {
+        controller->Step();
+    }
+}
+
+void Simulation::Run(uint64_t micros)
+{
+    uint64_t end = HostNode::Host().micros + micros;
+    while (HostNode::Host().micros < end)
+    {
+        this->Step();
+    }
+}
+
+bool Simulation::RunUntil(std::function<bool()> condition, uint64_t timeoutMicros)
+{
+    uint64_t end = HostNode::Host().micros + timeoutMicros;
+    while (!condition())
+    {
+        if (HostNode::Host().micros >= end)
+        {
+            return false;
+        }
+        this->Step();
+    }
+    return true;
+}
+
+bool Simulation::RunUntilConnected(uint64_t timeoutMicros)
+{
+    return this->RunUntil([this]()
+                          {
+                              for (std::unique_ptr<SimulatedController> &controller : this->controllers)
+                              {
+                                  if (!this->broker.isClientConnected(controller->getClientName()))
+                                  {
+                                      return false;
+                                  }
+                              }
+                              return true; },
+                          timeoutMicros);
+}
+
+uint64_t Simulation::getMicros() const
+{
+    return HostNode::Host().micros;
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+// A broker and a number of controllers on one simulated network. Steps everything at the host time
+
+#include "MqttBroker.h"
+#include "NtpServer.h"
+#include "SimulatedController.h"
+#include <functional>
+#include <memory>
+#include <vector>
+
+class Simulation
+{
+public:
+    Simulation(uint32_t stepMicros = 1000);
+    ~Simulation();
+
+    SimulatedController &AddController(const char *clientName);
+    void Setup(); // Runs the setup of every controller added so far
+
+    void Step();                   // Advances the host by one step and runs one loop of every controller
+    void Run(uint64_t micros);     // Steps for the given host time
+    bool RunUntil(std::function<bool()> condition, uint64_t timeoutMicros); // True if the condition got true before the timeout
+    bool RunUntilConnected(uint64_t timeoutMicros = 30000000);              // Until every controller is connected to the broker
+
+    MqttBroker &getBroker() { return this->broker; }
+    NtpServer &getNtpServer() { return this->ntpServer; }
+    SimulatedController &getController(size_t index) { return *this->controllers[index]; }
+    size_t getControllerCount() const { return this->controllers.size(); }
+    uint64_t getMicros() const;
+    uint32_t getStepMicros() const { return this->stepMicros; }
+
+private:
+    uint32_t stepMicros;
+    MqttBroker broker;
+    NtpServer ntpServer;
+    std::vector<std::unique_ptr<SimulatedController>> controllers;
+};
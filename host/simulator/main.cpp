@@ -0,0 +1,43 @@
+// Runs a number of controllers against the broker stand-in and prints their state once per simulated second
+//
+// Usage: controller_simulator [controllers] [seconds]
+
+#include "Simulation.h"
+#include <cstdio>
+#include <cstdlib>
+
+int main(int argc, char **argv)
+{
+    uint32_t controllerCount = argc > 1 ? (uint32_t)atoi(argv[1]) : 1;
+    uint32_t seconds = argc > 2 ? (uint32_t)atoi(argv[2]) : 10;
+
+    Serial.setEcho(false);
+    Simulation simulation;
+    for (uint32_t i = 0; i < controllerCount; i++)
+    {
+        std::string clientName = "LEDController" + std::to_string(i + 1);
+        simulation.AddController(clientName.c_str());
+    }
+    simulation.Setup();
+
+    for (uint32_t second = 1; second <= seconds; second++)
+    {
+        simulation.Run(1000000);
+        printf("t=%us broker: clients=%u received=%llu delivered=%llu\n",
+               second,
+               simulation.getBroker().getConnectedClientCount(),
+               (unsigned long long)simulation.getBroker().getStatistics().publishesReceived,
+               (unsigned long long)simulation.getBroker().getStatistics().publishesDelivered);
+        for (size_t i = 0; i < simulation.getControllerCount(); i++)
+        {
+            SimulatedController &controller = simulation.getController(i);
+            printf("  %s: connected=%d loops=%llu free heap=%lld B peak heap=%llu B\n",
+                   controller.getClientName().c_str(),
+                   simulation.getBroker().isClientConnected(controller.getClientName()) ? 1 : 0,
+                   (unsigned long long)controller.getLoopCount(),
+                   (long long)controller.getNode().heapSize - (long long)controller.getNode().getHeapBytesInUse(),
+                   (unsigned long long)controller.getNode().getHeapPeakBytesInUse());
+        }
+    }
+    return 0;
+}
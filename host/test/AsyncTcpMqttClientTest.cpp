@@ -0,0 +1,134 @@
+#include <ESP8266WiFi.h>
+#include <HostNetwork.h>
+#include <MqttBroker.h>
+#include <SimulatedController.h>
+#include <Clock/VirtualClock.h>
+#include <Network/AsyncTcpMqttClient.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+class AsyncTcpMqttClientTest : public ::testing::Test
+{
+protected:
+    HostNode node = HostNode(1, IPAddress(192, 168, 0, 60));
+    MqttBroker broker;
+    VirtualClock clock;
+    AsyncTcpMqttClient client;
+    std::vector<std::string> received;
+
+    void SetUp() override
+    {
+        HostNetwork::Reset();
+        broker.Start();
+        HostNodeScope scope(node);
+        WiFi.mode(WIFI_STA);
+        WiFi.begin(String("SSID"), String("password"));
+        client.setReference(&clock);
+        client.Begin([this](char *topic, uint8_t *payload, unsigned int length)
+                     { received.push_back(std::string(topic) + "=" + std::string((char *)payload, length)); });
+    }
+
+    void TearDown() override
+    {
+        broker.Kill();
+        HostNetwork::Reset();
+    }
+
+    // Runs the loop of the client like the network component does
+    void Loop(uint32_t millis)
+    {
+        for (uint32_t i = 0; i < millis; i++)
+        {
+            HostNode::Host().micros += 1000;
+            broker.Loop();
+            HostNodeScope scope(node);
+            node.micros = HostNode::Host().micros;
+            clock.AdvanceMillis(1);
+            HostNetwork::Pump();
+            client.Loop();
+        }
+    }
+
+    bool Connect()
+    {
+        {
+            HostNodeScope scope(node);
+            if (!client.Connect(broker.getIpAddress(), broker.getPort(), "Client", nullptr, nullptr, nullptr, 0, false, nullptr, true))
+            {
+                return false;
+            }
+        }
+        Loop(100);
+        return client.isConnected();
+    }
+};
+
+TEST_F(AsyncTcpMqttClientTest, OversizedPublishGetsSkipped)
+{
+    ASSERT_TRUE(Connect());
+    {
+        HostNodeScope scope(node);
+        ASSERT_TRUE(client.Subscribe("Client/#", 0));
+    }
+    Loop(10);
+
+    broker.Publish("Client/Large", std::string(3000, 'x').c_str());
+    broker.Publish("Client/Small", "on");
+    Loop(10);
+
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_TRUE(broker.isClientConnected("Client"));
+    EXPECT_EQ(client.getSkippedPacketCount(), 1u);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "Client/Small=on");
+}
+
+TEST_F(AsyncTcpMqttClientTest, UnsubscribedTopicGetsNoPublishes)
+{
+    ASSERT_TRUE(Connect());
+    {
+        HostNodeScope scope(node);
+        ASSERT_TRUE(client.Subscribe("Client/#", 0));
+    }
+    Loop(10);
+    ASSERT_EQ(broker.getSubscriptions("Client").size(), 1u);
+
+    {
+        HostNodeScope scope(node);
+        ASSERT_TRUE(client.Unsubscribe("Client/#"));
+    }
+    Loop(10);
+    EXPECT_TRUE(broker.getSubscriptions("Client").empty());
+
+    broker.Publish("Client/Light", "on");
+    Loop(10);
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_TRUE(received.empty());
+}
+
+TEST_F(AsyncTcpMqttClientTest, ReconnectsAfterTheBrokerGetsKilledAndRestored)
+{
+    ASSERT_TRUE(Connect());
+
+    broker.Kill();
+    Loop(10);
+    EXPECT_FALSE(client.isConnected());
+    EXPECT_EQ(client.getState(), -3); // Connection lost
+    EXPECT_FALSE(Connect());
+
+    broker.Restore();
+    EXPECT_TRUE(Connect());
+    EXPECT_TRUE(broker.isClientConnected("Client"));
+
+    // The packet framing starts over with the new connection
+    {
+        HostNodeScope scope(node);
+        ASSERT_TRUE(client.Subscribe("Client/#", 0));
+    }
+    Loop(10);
+    broker.Publish("Client/Light", "on");
+    Loop(10);
+    ASSERT_EQ(received.size(), 1u);
+    EXPECT_EQ(received[0], "Client/Light=on");
+}
@@ -0,0 +1,162 @@
+#include <MockBus.h>
+#include <I2C/I2C.h>
+#include <Clock/VirtualClock.h>
+#include <Simulation.h>
+#include <gtest/gtest.h>
+
+class I2CTest : public ::testing::Test
+{
+protected:
+    MockBus bus;
+    VirtualClock clock;
+    I2C i2c = I2C(I2CClockSpeed::StandardMode);
+
+    void SetUp() override
+    {
+        bus.AddDevice(I2CDeviceType::PCA9685, 0x40);
+        i2c.setReference(&bus, nullptr, &clock);
+        clock.AdvanceMillis(10000);
+    }
+};
+
+TEST_F(I2CTest, NackDoesNotRecoverTheBus)
+{
+    // Every attempt gets a NACK => The bus itself works
+    bus.InjectFault(2, 3);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    bus.InjectFault(3, 3);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+
+    EXPECT_EQ(i2c.getErrorCodeCount(2), 3u);
+    EXPECT_EQ(i2c.getErrorCodeCount(3), 3u);
+    EXPECT_EQ(bus.getRecoverCount(), 0u);
+    EXPECT_EQ(i2c.getBusRecoveryCount(), 0u);
+}
+
+TEST_F(I2CTest, RetriedNackStillSucceeds)
+{
+    bus.InjectFault(3, 2);
+    EXPECT_TRUE(i2c.write8(0x40, MODE1, 0x01));
+    EXPECT_EQ(bus.getRegister8(0x40, MODE1), 0x01);
+    EXPECT_EQ(bus.getRecoverCount(), 0u);
+}
+
+TEST_F(I2CTest, StuckBusGetsRecovered)
+{
+    bus.setStuckBus(true);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    EXPECT_EQ(bus.getRecoverCount(), 1u);
+
+    // The recovery released the bus
+    EXPECT_TRUE(i2c.write8(0x40, MODE1, 0x01));
+}
+
+TEST_F(I2CTest, BusErrorGetsRecovered)
+{
+    bus.InjectFault(4, 3);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    EXPECT_EQ(bus.getRecoverCount(), 1u);
+
+    clock.AdvanceMillis(1000);
+    bus.InjectFault(5, 3);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    EXPECT_EQ(bus.getRecoverCount(), 2u);
+}
+
+TEST_F(I2CTest, RecoveriesAreRateLimited)
+{
+    for (int i = 0; i < 10; i++)
+    {
+        bus.setStuckBus(true);
+        EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    }
+    EXPECT_EQ(bus.getRecoverCount(), 1u);
+    EXPECT_EQ(i2c.getBusRecoveryCount(), 1u);
+
+    clock.AdvanceMillis(1000);
+    EXPECT_FALSE(i2c.write8(0x40, MODE1, 0x01));
+    EXPECT_EQ(bus.getRecoverCount(), 2u);
+}
+
+TEST(I2CLayoutTest, CachedLayoutGetsUsedOnTheNextBoot)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+    simulation.Run(2000000);
+
+    HostNodeScope scope(controller.getNode());
+    I2C &i2c = controller.getI2C();
+    EXPECT_EQ(i2c.getPwmDeviceCount(), 1);
+
+    i2c.init = false;
+    ASSERT_TRUE(i2c.Init());
+    EXPECT_EQ(i2c.getPwmDeviceCount(), 1);
+    EXPECT_EQ(i2c.getPwmAddress(0), SIMULATED_PCA9685_ADDRESS);
+    EXPECT_TRUE(i2c.isPowerMeasurementPresent());
+}
+
+TEST(I2CLayoutTest, UncachedPca9685TriggersAScan)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+    simulation.Run(2000000);
+    ASSERT_EQ(controller.getI2C().getPwmDeviceCount(), 1);
+
+    // A second PCA9685 soldered on before the next boot
+    HostNodeScope scope(controller.getNode());
+    controller.getBus().AddDevice(I2CDeviceType::PCA9685, 0x41);
+    I2C &i2c = controller.getI2C();
+    i2c.init = false;
+    ASSERT_TRUE(i2c.Init());
+
+    EXPECT_EQ(i2c.getPwmDeviceCount(), 2);
+    EXPECT_EQ(i2c.getPwmAddress(1), 0x41);
+    EXPECT_EQ(controller.getBus().getRegister8(0x41, ALLCALLADR), 0xE0);
+}
+
+TEST(I2CLayoutTest, UnusedDevicesDoNotTriggerAScan)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    controller.getBus().AddDevice(I2CDeviceType::Unknown, 0x50);
+    controller.getBus().AddDevice(I2CDeviceType::INA219, 0x44); // Second INA219 => Only the first one gets used
+    simulation.Setup();
+    simulation.Run(2000000);
+
+    HostNodeScope scope(controller.getNode());
+    std::map<std::string, uint32_t> &writes = controller.getNode().fileWriteCounts;
+    uint32_t writesBefore = writes["/I2CLayoutData.dat"];
+
+    // The ignored devices are part of the cached layout => The next boots neither scan nor write the flash
+    I2C &i2c = controller.getI2C();
+    for (uint8_t boot = 0; boot < 2; boot++)
+    {
+        i2c.init = false;
+        ASSERT_TRUE(i2c.Init());
+    }
+    EXPECT_EQ(writes["/I2CLayoutData.dat"], writesBefore);
+    EXPECT_EQ(i2c.getPwmDeviceCount(), 1);
+    EXPECT_EQ(i2c.getPowerMeasurementAddress(), 0x44);
+}
+
+TEST(I2CLayoutTest, UnchangedLayoutIsNotWrittenAgain)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+    simulation.Run(2000000);
+
+    // The PCA9685 misses the probe of the cached layout once => Scan finds the same layout
+    HostNodeScope scope(controller.getNode());
+    std::map<std::string, uint32_t> &writes = controller.getNode().fileWriteCounts;
+    uint32_t writesBefore = writes["/I2CLayoutData.dat"];
+    controller.getBus().InjectFault(2, 1);
+    I2C &i2c = controller.getI2C();
+    i2c.init = false;
+    ASSERT_TRUE(i2c.Init());
+
+    EXPECT_EQ(i2c.getPwmDeviceCount(), 1);
+    EXPECT_EQ(writes["/I2CLayoutData.dat"], writesBefore);
+}
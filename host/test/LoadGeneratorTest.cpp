@@ -0,0 +1,41 @@
+#include <LoadGenerator.h>
+#include <gtest/gtest.h>
+
+class LoadGeneratorTest : public ::testing::Test
+{
+protected:
+    Simulation simulation;
+
+    void SetUp() override
+    {
+        simulation.AddController("LEDController1");
+        simulation.AddController("LEDController2");
+        simulation.Setup();
+        ASSERT_TRUE(simulation.RunUntilConnected());
+        simulation.Run(2000000);
+    }
+};
+
+TEST_F(LoadGeneratorTest, AlarmReachesTheRegistersOfEveryController)
+{
+    LoadGenerator generator(simulation);
+    LoadResult result = generator.Run(LoadPattern::AlarmFanOut, 2000000);
+
+    EXPECT_EQ(result.commandsSent, 8u); // 4 publishes to 2 controllers
+    EXPECT_EQ(result.commandsApplied, result.commandsSent);
+    EXPECT_EQ(result.commandsLost, 0u);
+    EXPECT_LT(result.latencyMaxMicros, 50000u);
+    EXPECT_GT(result.minFreeHeapBytes, 0);
+}
+
+TEST_F(LoadGeneratorTest, SlowSliderLosesNoCommand)
+{
+    LoadGenerator generator(simulation);
+    LoadResult result = generator.Run(LoadPattern::SliderStorm, 2000000, 200);
+
+    EXPECT_EQ(result.commandsSent, 20u);
+    EXPECT_EQ(result.commandsApplied + result.commandsSuperseded, result.commandsSent);
+    EXPECT_EQ(result.commandsLost, 0u);
+    EXPECT_EQ(result.publishQueueDropped, 0u);
+    EXPECT_GT(result.statePublishes, 0u);
+}
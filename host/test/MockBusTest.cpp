@@ -0,0 +1,134 @@
+#include <MockBus.h>
+#include <Simulation.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <vector>
+
+TEST(MockBusTest, Pca9685StartsWithThePowerOnRegisters)
+{
+    MockBus bus;
+    ASSERT_TRUE(bus.AddDevice(I2CDeviceType::PCA9685, 0x40));
+
+    EXPECT_EQ(bus.getRegister8(0x40, MODE1), 0x11);
+    EXPECT_EQ(bus.getRegister8(0x40, MODE2), 0x04);
+    EXPECT_EQ(bus.getRegister8(0x40, ALLCALLADR), 0xE0);
+    EXPECT_EQ(bus.getRegister8(0x40, PRE_SCALE), 0x1E);
+}
+
+TEST(MockBusTest, Pca9685WritesAndReadsWithAutoIncrement)
+{
+    MockBus bus;
+    bus.AddDevice(I2CDeviceType::PCA9685, 0x40);
+
+    const uint8_t write[] = {LED3_ON_L, 0x12, 0x03, 0xCF, 0x0C};
+    EXPECT_EQ(bus.Transmit(0x40, write, sizeof(write)), 0);
+    EXPECT_EQ(bus.getRegister8(0x40, LED3_ON_L), 0x12);
+    EXPECT_EQ(bus.getRegister8(0x40, LED3_ON_H), 0x03);
+    EXPECT_EQ(bus.getRegister8(0x40, LED3_OFF_L), 0xCF);
+    EXPECT_EQ(bus.getRegister8(0x40, LED3_OFF_H), 0x0C);
+
+    const uint8_t pointer[] = {LED3_OFF_L};
+    uint8_t read[2] = {0};
+    EXPECT_EQ(bus.Transmit(0x40, pointer, sizeof(pointer)), 0);
+    EXPECT_EQ(bus.Receive(0x40, read, sizeof(read)), 2);
+    EXPECT_EQ(read[0], 0xCF);
+    EXPECT_EQ(read[1], 0x0C);
+}
+
+TEST(MockBusTest, Ina219KeepsSixteenBitRegisters)
+{
+    MockBus bus;
+    bus.AddDevice(I2CDeviceType::INA219, 0x45);
+    EXPECT_EQ(bus.getRegister16(0x45, CONFIG), 0x399F);
+
+    const uint8_t calibration[] = {CALIBRATION, 0x10, 0x00};
+    EXPECT_EQ(bus.Transmit(0x45, calibration, sizeof(calibration)), 0);
+    EXPECT_EQ(bus.getRegister16(0x45, CALIBRATION), 0x1000);
+
+    // Measurement values come from the test, the driver reads them big endian
+    bus.setRegister16(0x45, BUS_VOLTAGE, 0x5DC2);
+    const uint8_t pointer[] = {BUS_VOLTAGE};
+    uint8_t read[2] = {0};
+    bus.Transmit(0x45, pointer, sizeof(pointer));
+    EXPECT_EQ(bus.Receive(0x45, read, sizeof(read)), 2);
+    EXPECT_EQ(read[0], 0x5D);
+    EXPECT_EQ(read[1], 0xC2);
+}
+
+TEST(MockBusTest, ReportsTheErrorCodesOfTheWireLibrary)
+{
+    MockBus bus;
+    bus.AddDevice(I2CDeviceType::PCA9685, 0x40);
+    const uint8_t data[] = {MODE1, 0x01};
+
+    EXPECT_EQ(bus.Transmit(0x41, data, sizeof(data)), 2); // NACK on the address
+
+    bus.InjectFault(3, 1);
+    EXPECT_EQ(bus.Transmit(0x40, data, sizeof(data)), 3);
+    EXPECT_EQ(bus.Transmit(0x40, data, sizeof(data)), 0);
+
+    bus.setStuckBus(true);
+    EXPECT_EQ(bus.Transmit(0x40, data, sizeof(data)), 4);
+    bus.Recover();
+    EXPECT_EQ(bus.getRecoverCount(), 1u);
+    EXPECT_EQ(bus.Transmit(0x40, data, sizeof(data)), 0);
+}
+
+TEST(MockBusTest, RecordsTransactionsWithTheirTimeOnTheBus)
+{
+    MockBus bus;
+    bus.AddDevice(I2CDeviceType::PCA9685, 0x40);
+    const uint8_t data[] = {LED3_ON_L, 0x12};
+
+    bus.Transmit(0x40, data, sizeof(data));
+    ASSERT_EQ(bus.getTransactionCount(), 1u);
+    I2CBusTransaction transaction = bus.getTransaction(0);
+    EXPECT_EQ(transaction.i2cAddress, 0x40);
+    EXPECT_FALSE(transaction.isRead);
+    EXPECT_EQ(transaction.length, 2);
+    EXPECT_EQ(transaction.data[0], LED3_ON_L);
+    EXPECT_EQ(transaction.data[1], 0x12);
+    EXPECT_EQ(transaction.timestamp, 290u); // START, address and 2 data bytes with ACK, STOP => 29 bits at 100 kHz
+
+    // Only the latest transactions stay in the recorder
+    for (uint16_t i = 0; i < MOCK_BUS_RECORD_SIZE; i++)
+    {
+        bus.Transmit(0x40, data, sizeof(data));
+    }
+    EXPECT_EQ(bus.getTransaction(0).i2cAddress, 0);
+    EXPECT_EQ(bus.getTransaction(MOCK_BUS_RECORD_SIZE).i2cAddress, 0x40);
+}
+
+TEST(MockBusTest, LedFrameWritesBothStripsInRegisterOrder)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+    simulation.Run(2000000);
+
+    // One led frame updates every channel of strip 1 (LED3 - LED7) and strip 2 (LED8 - LED12), one register per transaction
+    MockBus &bus = controller.getBus();
+    bus.ClearRecord();
+    simulation.Run(25000); // Two frames at 90 Hz
+
+    std::vector<uint8_t> frame;
+    for (uint32_t i = 0; i < bus.getTransactionCount(); i++)
+    {
+        I2CBusTransaction transaction = bus.getTransaction(i);
+        if (transaction.i2cAddress == SIMULATED_PCA9685_ADDRESS && !transaction.isRead &&
+            transaction.data[0] >= LED3_ON_L && transaction.data[0] <= LED12_OFF_H)
+        {
+            EXPECT_EQ(transaction.length, 2);
+            EXPECT_EQ(transaction.result, 0);
+            frame.push_back(transaction.data[0]);
+        }
+    }
+
+    // The recording may start in the middle of a frame
+    std::vector<uint8_t>::iterator start = std::find(frame.begin(), frame.end(), LED3_ON_L);
+    ASSERT_GE(frame.end() - start, LED12_OFF_H - LED3_ON_L + 1);
+    for (uint8_t i = 0; i <= LED12_OFF_H - LED3_ON_L; i++)
+    {
+        EXPECT_EQ(start[i], LED3_ON_L + i);
+    }
+}
@@ -0,0 +1,107 @@
+#include <ESP8266WiFi.h>
+#include <HostNetwork.h>
+#include <MqttBroker.h>
+#include <PubSubClient.h>
+#include <SimulatedController.h>
+#include <WiFiClient.h>
+#include <gtest/gtest.h>
+
+class MqttBrokerTest : public ::testing::Test
+{
+protected:
+    HostNode node = HostNode(1, IPAddress(192, 168, 0, 60));
+    MqttBroker broker;
+
+    void SetUp() override
+    {
+        HostNetwork::Reset();
+        this->broker.Start();
+        HostNodeScope scope(this->node);
+        WiFi.mode(WIFI_STA);
+        WiFi.begin(String("SSID"), String("password"));
+    }
+
+    void TearDown() override
+    {
+        this->broker.Kill();
+        HostNetwork::Reset();
+    }
+};
+
+TEST_F(MqttBrokerTest, TopicFiltersMatchWildcards)
+{
+    EXPECT_TRUE(MqttBroker::Matches("a/b/c", "a/b/c"));
+    EXPECT_TRUE(MqttBroker::Matches("a/+/c", "a/b/c"));
+    EXPECT_TRUE(MqttBroker::Matches("a/#", "a/b/c"));
+    EXPECT_TRUE(MqttBroker::Matches("a/#", "a"));
+    EXPECT_TRUE(MqttBroker::Matches("#", "a/b"));
+    EXPECT_FALSE(MqttBroker::Matches("a/+", "a/b/c"));
+    EXPECT_FALSE(MqttBroker::Matches("a/b/c", "a/b"));
+    EXPECT_FALSE(MqttBroker::Matches("a/b", "a/b/c"));
+}
+
+TEST_F(MqttBrokerTest, RoutesBetweenTheHostAndAClient)
+{
+    HostNodeScope scope(this->node);
+    WiFiClient wifiClient;
+    PubSubClient client(wifiClient);
+    std::string received;
+    client.setServer(this->broker.getIpAddress(), this->broker.getPort());
+    client.setCallback([&received](char *topic, uint8_t *payload, unsigned int length)
+                       { received = std::string(topic) + "=" + std::string((char *)payload, length); });
+
+    ASSERT_TRUE(client.connect("Client", "Client/status", 1, true, "offline"));
+    EXPECT_TRUE(this->broker.isClientConnected("Client"));
+    ASSERT_TRUE(client.subscribe("Client/+/command"));
+    this->broker.Publish("Client/Light/command", "on");
+    client.loop(); // SUBACK
+    client.loop(); // PUBLISH => PubSubClient handles one packet per loop
+    EXPECT_EQ(received, "Client/Light/command=on");
+
+    std::string observed;
+    this->broker.Observe("Client/#", [&observed](const MqttBrokerMessage &message)
+                         { observed = message.payload; });
+    ASSERT_TRUE(client.publish("Client/status", "online", true));
+    EXPECT_EQ(observed, "online");
+    std::string retained;
+    EXPECT_TRUE(this->broker.getRetained("Client/status", retained));
+    EXPECT_EQ(retained, "online");
+}
+
+TEST_F(MqttBrokerTest, SendsTheWillWhenTheKeepAliveRunsOut)
+{
+    HostNodeScope scope(this->node);
+    WiFiClient wifiClient;
+    PubSubClient client(wifiClient);
+    client.setServer(this->broker.getIpAddress(), this->broker.getPort());
+    ASSERT_TRUE(client.connect("Client", "Client/status", 1, true, "offline"));
+
+    // The client stops calling loop() => No ping
+    HostNode::Host().micros = this->node.micros + MQTT_KEEPALIVE * 1600000ULL;
+    {
+        HostNodeScope host(HostNode::Host());
+        this->broker.Loop();
+    }
+    EXPECT_FALSE(this->broker.isClientConnected("Client"));
+    EXPECT_EQ(this->broker.getStatistics().keepAliveTimeouts, 1u);
+    std::string retained;
+    EXPECT_TRUE(this->broker.getRetained("Client/status", retained));
+    EXPECT_EQ(retained, "offline");
+}
+
+TEST_F(MqttBrokerTest, KillDropsTheClientsAndRestoreAcceptsThemAgain)
+{
+    HostNodeScope scope(this->node);
+    WiFiClient wifiClient;
+    PubSubClient client(wifiClient);
+    client.setServer(this->broker.getIpAddress(), this->broker.getPort());
+    ASSERT_TRUE(client.connect("Client"));
+
+    this->broker.Kill();
+    EXPECT_FALSE(client.loop());
+    EXPECT_FALSE(client.connect("Client"));
+
+    this->broker.Restore();
+    EXPECT_TRUE(client.connect("Client"));
+    EXPECT_TRUE(this->broker.isClientConnected("Client"));
+}
@@ -0,0 +1,273 @@
+#include <Simulation.h>
+#include <LEDControllerMk4.h>
+#include <Network/HomeAssistantDiscovery.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+class NetworkTest : public ::testing::Test
+{
+protected:
+    Simulation simulation;
+
+    void SetUp() override
+    {
+        simulation.AddController("LEDController1");
+        simulation.Setup();
+        ASSERT_TRUE(simulation.RunUntilConnected());
+        simulation.Run(2000000); // Subscriptions
+        Publish("JSON/Strip1/command", "{\"ColorBrightness\":1000,\"ColorFadeCurve\":\"Linear\",\"Effect\":\"None\"}");
+        ASSERT_EQ(getStrip1().ColorBrightness, 1000);
+    }
+
+    void Publish(const char *suffix, const char *payload)
+    {
+        std::string topic = "LEDController/LEDController1/" + std::string(suffix);
+        simulation.getBroker().Publish(topic.c_str(), payload);
+        simulation.Run(500000);
+    }
+
+    LEDStripParameter getStrip1()
+    {
+        SimulatedController &controller = simulation.getController(0);
+        HostNodeScope scope(controller.getNode());
+        return controller.getParameterhandler().getLEDStripParameter(0);
+    }
+
+    // Queues a state without a loop in between => Nothing gets sent
+    void QueueState(const char *suffix, bool republish)
+    {
+        SimulatedController &controller = simulation.getController(0);
+        HostNodeScope scope(controller.getNode());
+        controller.getNetwork().QueueState(suffix, "1", republish);
+    }
+
+    std::vector<std::string> getQueuedSuffixes()
+    {
+        Network &network = simulation.getController(0).getNetwork();
+        std::vector<std::string> suffixes;
+        for (uint8_t i = 0; i < network.getPublishQueueCount(); i++)
+        {
+            suffixes.push_back(network.getQueuedSuffix(i));
+        }
+        return suffixes;
+    }
+};
+
+TEST_F(NetworkTest, JsonCommandWithUnknownFadeCurveGetsRejected)
+{
+    Publish("JSON/Strip1/command", "{\"ColorBrightness\":2000,\"ColorFadeCurve\":\"Bounce\"}");
+
+    EXPECT_EQ(getStrip1().ColorBrightness, 1000);
+    EXPECT_EQ(getStrip1().ColorFadeCurve, FadeCurve::Linear);
+}
+
+TEST_F(NetworkTest, JsonCommandWithUnknownEffectGetsRejected)
+{
+    Publish("JSON/Strip1/command", "{\"ColorBrightness\":2000,\"Effect\":\"Strobe\"}");
+
+    EXPECT_EQ(getStrip1().ColorBrightness, 1000);
+    EXPECT_EQ(getStrip1().Effect, SingleLEDEffect::None);
+}
+
+TEST_F(NetworkTest, UnknownEffectKeepsTheCurrentEffect)
+{
+    Publish("HomeAssistant/Strip1/Effect/command", "Rainbow");
+    ASSERT_EQ(getStrip1().Effect, SingleLEDEffect::Rainbow);
+
+    Publish("HomeAssistant/Strip1/Effect/command", "Strobe");
+    EXPECT_EQ(getStrip1().Effect, SingleLEDEffect::Rainbow);
+}
+
+TEST_F(NetworkTest, RGBCommandGetsEchoedWithTheParsedValues)
+{
+    std::string echo;
+    simulation.getBroker().Observe("LEDController/LEDController1/HomeAssistant/Strip1/RGB/state", [&](const MqttBrokerMessage &message)
+                                   { echo = message.payload; });
+    Publish("HomeAssistant/Strip1/RGB/command", "255,127,0");
+
+    EXPECT_EQ(echo, "255,127,0");
+    EXPECT_EQ(getStrip1().Red, 255);
+    EXPECT_EQ(getStrip1().Green, 127);
+    EXPECT_EQ(getStrip1().Blue, 0);
+    simulation.getBroker().ClearObservers();
+}
+
+TEST_F(NetworkTest, MotionEdgesReachTheBrokerWithin50ms)
+{
+    uint64_t receivedMicros = 0;
+    simulation.getBroker().Observe("LEDController/LEDController1/HomeAssistant/Motion/PIR/Sensor1/state", [&](const MqttBrokerMessage &message)
+                                   { receivedMicros = message.micros; });
+    simulation.Run(1000000); // The parameter save of the setup blocks the loop for FILE_LAST_WRITE_DELAY
+
+    // Rising and falling edges at a random phase to the 20 ms period of the pir reader
+    for (uint8_t i = 0; i < 10; i++)
+    {
+        simulation.Run(300000 + i * 3000);
+        receivedMicros = 0;
+        uint64_t edgeMicros = simulation.getMicros();
+        {
+            HostNodeScope scope(simulation.getController(0).getNode());
+            digitalWrite(PIR_SENSOR_1_PIN, i % 2 == 0 ? HIGH : LOW);
+        }
+        ASSERT_TRUE(simulation.RunUntil([&]()
+                                        { return receivedMicros != 0; },
+                                        1000000));
+        EXPECT_LT(receivedMicros - edgeMicros, 50000u);
+    }
+    simulation.getBroker().ClearObservers();
+}
+
+TEST_F(NetworkTest, FullPublishQueueEvictsTheOldestRepublish)
+{
+    uint32_t dropped = simulation.getController(0).getNetwork().getPublishQueueDroppedCount();
+    QueueState("Test/Event1/state", false);
+    for (uint8_t i = 0; i < MQTT_PUBLISH_QUEUE_SIZE - 1; i++)
+    {
+        QueueState(("Test/Republish" + std::to_string(i) + "/state").c_str(), true);
+    }
+
+    // An event takes the place of the oldest republish, a republish does not fit
+    QueueState("Test/Event2/state", false);
+    QueueState("Test/Republish99/state", true);
+
+    std::vector<std::string> suffixes = getQueuedSuffixes();
+    ASSERT_EQ(suffixes.size(), MQTT_PUBLISH_QUEUE_SIZE);
+    EXPECT_EQ(suffixes.front(), "Test/Event1/state");
+    EXPECT_EQ(suffixes[1], "Test/Republish1/state");
+    EXPECT_EQ(suffixes.back(), "Test/Event2/state");
+    EXPECT_EQ(simulation.getController(0).getNetwork().getPublishQueueDroppedCount(), dropped + 2);
+}
+
+TEST_F(NetworkTest, PublishQueueFullOfEventsDropsTheNewest)
+{
+    for (uint8_t i = 0; i < MQTT_PUBLISH_QUEUE_SIZE; i++)
+    {
+        QueueState(("Test/Event" + std::to_string(i) + "/state").c_str(), false);
+    }
+    QueueState("Test/Event99/state", false);
+
+    std::vector<std::string> suffixes = getQueuedSuffixes();
+    ASSERT_EQ(suffixes.size(), MQTT_PUBLISH_QUEUE_SIZE);
+    EXPECT_EQ(suffixes.front(), "Test/Event0/state");
+    EXPECT_EQ(suffixes.back(), "Test/Event" + std::to_string(MQTT_PUBLISH_QUEUE_SIZE - 1) + "/state");
+}
+
+TEST_F(NetworkTest, CommandLatencyWaitsForTheOutputOfTheCommand)
+{
+    SimulatedController &controller = simulation.getController(0);
+    {
+        HostNodeScope scope(controller.getNode());
+        controller.getProfiler().setEnabled(true);
+    }
+    simulation.getBroker().Publish("LEDController/Global/HomeAssistant/MasterPresent/command", "home");
+    Publish("JSON/Strip1/command", "{\"Power\":1,\"Red\":255,\"Green\":255,\"Blue\":255,\"ColorBrightness\":2000}");
+    simulation.Run(3000000);
+
+    // The strips fade to black while the master is away => The changing output does not show the command
+    simulation.getBroker().Publish("LEDController/Global/HomeAssistant/MasterPresent/command", "away");
+    simulation.Run(100000);
+    uint32_t count = controller.getProfiler().getCount(ProfilerComponent::CommandMQTT);
+    Publish("JSON/Strip1/command", "{\"ColorBrightness\":3000}");
+    EXPECT_EQ(controller.getProfiler().getCount(ProfilerComponent::CommandMQTT), count);
+
+    simulation.getBroker().Publish("LEDController/Global/HomeAssistant/MasterPresent/command", "home");
+    simulation.Run(3000000);
+    EXPECT_EQ(controller.getProfiler().getCount(ProfilerComponent::CommandMQTT), count + 1);
+}
+
+TEST_F(NetworkTest, MembershipChangeUnsubscribesTheLeftGroups)
+{
+    MqttBroker &broker = simulation.getBroker();
+    Publish("Group/Membership/command", "Kitchen,Hall");
+    std::vector<std::string> subscriptions = broker.getSubscriptions("LEDController1");
+    ASSERT_NE(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Kitchen/#"), subscriptions.end());
+    ASSERT_NE(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Hall/#"), subscriptions.end());
+
+    Publish("Group/Membership/command", "Hall");
+    subscriptions = broker.getSubscriptions("LEDController1");
+    EXPECT_EQ(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Kitchen/#"), subscriptions.end());
+    EXPECT_NE(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Hall/#"), subscriptions.end());
+
+    // Commands of the left group do not reach the controller anymore
+    broker.Publish("LEDController/Group/Kitchen/JSON/Strip1/command", "{\"ColorBrightness\":2000}");
+    simulation.Run(500000);
+    EXPECT_EQ(getStrip1().ColorBrightness, 1000);
+    broker.Publish("LEDController/Group/Hall/JSON/Strip1/command", "{\"ColorBrightness\":2000}");
+    simulation.Run(500000);
+    EXPECT_EQ(getStrip1().ColorBrightness, 2000);
+}
+
+TEST_F(NetworkTest, GroupCannotChangeTheMembershipOfItsMembers)
+{
+    MqttBroker &broker = simulation.getBroker();
+    Publish("Group/Membership/command", "Kitchen");
+
+    broker.Publish("LEDController/Group/Kitchen/Group/Membership/command", "Attic");
+    simulation.Run(500000);
+    std::vector<std::string> subscriptions = broker.getSubscriptions("LEDController1");
+    EXPECT_NE(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Kitchen/#"), subscriptions.end());
+    EXPECT_EQ(std::find(subscriptions.begin(), subscriptions.end(), "LEDController/Group/Attic/#"), subscriptions.end());
+}
+
+TEST_F(NetworkTest, DiscoveryCommandTopicsReachTheCallback)
+{
+    MqttBroker &broker = simulation.getBroker();
+    auto getConfig = [&](const NetworkDiscoveryDefinition &definition, std::string &config)
+    {
+        return broker.getRetained(std::string("homeassistant/") + definition.component + "/LEDController1/" + definition.objectId + "/config", config);
+    };
+    ASSERT_TRUE(simulation.RunUntil([&]()
+                                    {
+                                        std::string config;
+                                        return std::all_of(std::begin(discoveryDefinitions), std::end(discoveryDefinitions),
+                                                           [&](const NetworkDiscoveryDefinition &definition)
+                                                           { return getConfig(definition, config); });
+                                    },
+                                    30000000));
+
+    // Every "cmd_t" and "<name>_cmd_t" with the base topic "~" expanded
+    uint32_t commandTopics = 0;
+    SimulatedController &controller = simulation.getController(0);
+    HostNodeScope scope(controller.getNode());
+    for (const NetworkDiscoveryDefinition &definition : discoveryDefinitions)
+    {
+        std::string config;
+        ASSERT_TRUE(getConfig(definition, config));
+        std::string base = config.substr(6, config.find('"', 6) - 6); // {"~":"<base>"
+        for (size_t key = config.find("cmd_t\":\""); key != std::string::npos; key = config.find("cmd_t\":\"", key + 1))
+        {
+            size_t start = key + 8;
+            std::string topic = config.substr(start, config.find('"', start) - start);
+            if (topic[0] == '~')
+            {
+                topic = base + topic.substr(1);
+            }
+            EXPECT_NE(controller.getNetwork().LookupTopic(topic.c_str()), NetworkTopic::Unknown) << definition.objectId << ": " << topic;
+            commandTopics++;
+        }
+    }
+    EXPECT_EQ(commandTopics, 10u); // Power, RGB, brightness, white and effect of both strips
+}
+
+TEST_F(NetworkTest, HomeAssistantBirthRepublishesTheDiscovery)
+{
+    MqttBroker &broker = simulation.getBroker();
+    const std::string topic = "homeassistant/light/LEDController1/strip1/config";
+    std::string config;
+    ASSERT_TRUE(simulation.RunUntil([&]()
+                                    { return broker.getRetained(topic, config); },
+                                    30000000));
+
+    // A broker restart without persistence => The configs are gone, but the controller still knows their hash
+    broker.Publish(topic.c_str(), "", true);
+    simulation.Run(30000000);
+    ASSERT_FALSE(broker.getRetained(topic, config));
+
+    // Home Assistant reconnects to the broker and announces it
+    broker.Publish(MQTT_DISCOVERY_STATUS_TOPIC, "online");
+    EXPECT_TRUE(simulation.RunUntil([&]()
+                                    { return broker.getRetained(topic, config); },
+                                    15000000));
+}
@@ -0,0 +1,156 @@
+#include <Simulation.h>
+#include <gtest/gtest.h>
+#include <vector>
+
+// Frames of an external sequencer sent over the simulated network to the sockets of the controller
+class RealtimeTest : public ::testing::Test
+{
+protected:
+    Simulation simulation;
+
+    void SetUp() override
+    {
+        simulation.AddController("LEDController1");
+        simulation.Setup();
+        ASSERT_TRUE(simulation.RunUntilConnected());
+        simulation.Run(2000000);
+    }
+
+    void Send(uint16_t port, const std::vector<uint8_t> &packet)
+    {
+        // No sender node => A sequencer outside of the simulated fleet
+        HostNetwork::Send(nullptr, IPAddress(192, 168, 0, 20), port,
+                          simulation.getController(0).getNode().ipAddress, port, packet.data(), packet.size());
+    }
+
+    void SendDdp(uint8_t value)
+    {
+        // Version 1 with push, RGB with 8 bit per channel to the display
+        std::vector<uint8_t> packet = {0x41, 0x00, 0x0B, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, REALTIME_CHANNEL_COUNT};
+        packet.insert(packet.end(), REALTIME_CHANNEL_COUNT, value);
+        Send(REALTIME_DDP_PORT, packet);
+    }
+
+    void SendE131(uint8_t sequence, uint8_t options, uint8_t value)
+    {
+        std::vector<uint8_t> packet(REALTIME_E131_HEADER_LENGTH, 0);
+        const uint8_t identifier[] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00};
+        packet[1] = 0x10;
+        std::copy(identifier, identifier + sizeof(identifier), packet.begin() + 4);
+        packet[21] = 0x04;  // Root vector
+        packet[43] = 0x02;  // Framing vector
+        packet[111] = sequence;
+        packet[112] = options;
+        packet[114] = REALTIME_E131_UNIVERSE;
+        packet[117] = 0x02; // DMP vector
+        packet[118] = 0xa1; // Address and data type
+        packet[124] = REALTIME_CHANNEL_COUNT + 1;
+        packet.insert(packet.end(), REALTIME_CHANNEL_COUNT, value);
+        Send(REALTIME_E131_PORT, packet);
+    }
+
+    // Channels of both strips with a duty cycle => ON and OFF register differ
+    uint8_t getLitChannelCount()
+    {
+        MockBus &bus = simulation.getController(0).getBus();
+        uint8_t count = 0;
+        for (uint8_t reg = LED3_ON_L; reg <= LED12_ON_L; reg += 4)
+        {
+            uint16_t on = bus.getRegister8(SIMULATED_PCA9685_ADDRESS, reg) | (bus.getRegister8(SIMULATED_PCA9685_ADDRESS, reg + 1) << 8);
+            uint16_t off = bus.getRegister8(SIMULATED_PCA9685_ADDRESS, reg + 2) | (bus.getRegister8(SIMULATED_PCA9685_ADDRESS, reg + 3) << 8);
+            if (on != off)
+            {
+                count++;
+            }
+        }
+        return count;
+    }
+};
+
+TEST_F(RealtimeTest, DdpFramesDriveEveryChannelUntilTheTimeout)
+{
+    ASSERT_EQ(getLitChannelCount(), 0);
+
+    // 30 fps for 1 sec
+    for (uint8_t i = 0; i < 30; i++)
+    {
+        SendDdp(255);
+        simulation.Run(33333);
+    }
+    Realtime &realtime = simulation.getController(0).getRealtime();
+    EXPECT_TRUE(realtime.isActive());
+    EXPECT_EQ(realtime.getFrameCount(), 30u);
+    EXPECT_EQ(realtime.getInvalidPacketCount(), 0u);
+    EXPECT_EQ(realtime.getFrame()[0], 255);
+    EXPECT_GT(getLitChannelCount(), 0); // Only the channels mapped by the strip settings
+
+    // No master present => The effects fade to black once the sequencer stopped
+    simulation.Run((REALTIME_TIMEOUT + 2000) * 1000ULL);
+    EXPECT_FALSE(realtime.isActive());
+    EXPECT_EQ(getLitChannelCount(), 0);
+}
+
+TEST_F(RealtimeTest, E131StreamEndsWithTheTerminatedOption)
+{
+    Realtime &realtime = simulation.getController(0).getRealtime();
+    for (uint8_t i = 1; i <= 10; i++)
+    {
+        SendE131(i, 0x00, 128);
+        simulation.Run(33333);
+    }
+    EXPECT_TRUE(realtime.isActive());
+    EXPECT_EQ(realtime.getFrame()[REALTIME_CHANNEL_COUNT - 1], 128);
+
+    // Out of order => Ignored
+    SendE131(5, 0x00, 10);
+    simulation.Run(33333);
+    EXPECT_EQ(realtime.getFrameCount(), 10u);
+
+    SendE131(11, 0x40, 0);
+    simulation.Run(33333);
+    EXPECT_FALSE(realtime.isActive());
+}
+
+TEST_F(RealtimeTest, MalformedPacketsGetCounted)
+{
+    Realtime &realtime = simulation.getController(0).getRealtime();
+    Send(REALTIME_DDP_PORT, {0x41, 0x00});
+    Send(REALTIME_E131_PORT, std::vector<uint8_t>(REALTIME_E131_HEADER_LENGTH + REALTIME_CHANNEL_COUNT, 0));
+    simulation.Run(33333);
+
+    EXPECT_FALSE(realtime.isActive());
+    EXPECT_EQ(realtime.getInvalidPacketCount(), 2u);
+}
+
+TEST_F(RealtimeTest, JitteredFramesGetInterpolatedWithoutUnderruns)
+{
+    Realtime &realtime = simulation.getController(0).getRealtime();
+
+    // 30 fps ramp, every packet up to +-8 ms off its slot
+    uint64_t start = simulation.getMicros();
+    uint32_t seed = 1;
+    bool interpolated = false;
+    for (uint8_t i = 0; i < 40; i++)
+    {
+        seed = seed * 1103515245 + 12345;
+        int32_t jitter = (int32_t)((seed >> 16) % 16001) - 8000;
+        uint64_t sendMicros = start + 10000 + i * 33333ULL + jitter;
+        while (simulation.getMicros() < sendMicros)
+        {
+            simulation.Step();
+            interpolated |= realtime.isActive() && realtime.getFrame()[0] % 6 != 0;
+        }
+        SendDdp(i * 6);
+    }
+    simulation.Run(20000); // Shorter than the delay => The last frame is still ahead of the playout
+
+    EXPECT_EQ(realtime.getFrameCount(), 40u);
+    EXPECT_EQ(realtime.getUnderrunCount(), 0u);
+    EXPECT_EQ(realtime.getLateDropCount(), 0u);
+    EXPECT_EQ(realtime.getOverflowCount(), 0u);
+    EXPECT_TRUE(interpolated); // A led frame between two source frames shows a value in between
+
+    // The last frame gets shown after the delay, then the playout runs dry
+    simulation.Run(200000);
+    EXPECT_EQ(realtime.getFrame()[0], 39 * 6);
+}
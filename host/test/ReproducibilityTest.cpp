@@ -0,0 +1,63 @@
+#include <MockBus.h>
+#include <Simulation.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Boots two controllers, switches a strip on and fades it, then records everything the controllers did
+ *
+ * @return The published messages with their time and the I2C transactions of both controllers
+ */
+static std::vector<std::string> RunScenario()
+{
+    std::vector<std::string> trace;
+    Simulation simulation;
+    simulation.AddController("LEDController1");
+    simulation.AddController("LEDController2");
+    simulation.getBroker().Observe("#", [&trace](const MqttBrokerMessage &message)
+                                   { trace.push_back(std::to_string(message.micros) + " " + message.senderClientId + " " + message.topic + " " + message.payload); });
+    simulation.Setup();
+    EXPECT_TRUE(simulation.RunUntilConnected());
+    simulation.Run(1000000);
+
+    simulation.getBroker().Publish("LEDController/LEDController1/HomeAssistant/Strip1/Power/command", "1");
+    simulation.getBroker().Publish("LEDController/LEDController1/HomeAssistant/Strip1/RGB/Brightness/command", "2048");
+    simulation.getBroker().Publish("LEDController/Global/HomeAssistant/Sun/command", "1");
+    simulation.Run(3000000);
+
+    for (size_t i = 0; i < simulation.getControllerCount(); i++)
+    {
+        MockBus &bus = simulation.getController(i).getBus();
+        uint32_t count = bus.getTransactionCount();
+        for (uint32_t j = count > MOCK_BUS_RECORD_SIZE ? count - MOCK_BUS_RECORD_SIZE : 0; j < count; j++) // The recorder keeps the latest transactions
+        {
+            I2CBusTransaction transaction = bus.getTransaction(j);
+            std::string entry = std::to_string(i) + " " + std::to_string(transaction.timestamp) + " " + std::to_string(transaction.i2cAddress) +
+                                (transaction.isRead ? " R" : " W") + std::to_string(transaction.length) + " " + std::to_string(transaction.result);
+            for (uint8_t k = 0; k < transaction.length && k < sizeof(transaction.data); k++)
+            {
+                entry += " " + std::to_string(transaction.data[k]);
+            }
+            trace.push_back(entry);
+        }
+    }
+    return trace;
+}
+
+TEST(ReproducibilityTest, SameScenarioGivesTheSameTrace)
+{
+    std::vector<std::string> first = RunScenario();
+    std::vector<std::string> second = RunScenario();
+
+    EXPECT_GT(first.size(), 10u);
+    ASSERT_EQ(first.size(), second.size());
+    for (size_t i = 0; i < first.size(); i++)
+    {
+        EXPECT_EQ(first[i], second[i]) << "First difference at entry " << i;
+        if (first[i] != second[i])
+        {
+            break;
+        }
+    }
+}
@@ -0,0 +1,119 @@
+#include <Simulation.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+// Local time of a controller that booted at another time and whose crystal runs off by a few ppm
+class SkewedClock : public ITimeSource
+{
+public:
+    SkewedClock(VirtualClock &clock, uint64_t startMicros, double drift) : clock(clock), startMicros(startMicros), drift(drift) {}
+
+    unsigned long Millis() override { return this->Micros() / 1000; }
+    unsigned long Micros() override
+    {
+        uint64_t elapsedMicros = this->clock.getElapsedMicros();
+        // 32 bit like the ESP8266 => The shared clock has to handle the wrap
+        return (uint32_t)(this->startMicros + elapsedMicros + (int64_t)(elapsedMicros * this->drift));
+    }
+    void Delay(unsigned long millis) override { this->clock.Delay(millis); }
+
+private:
+    VirtualClock &clock;
+    uint64_t startMicros;
+    double drift;
+};
+
+// Three controllers on the simulated network with their own local times and 0.3 to 3 ms one way latency
+class SharedClockTest : public ::testing::Test
+{
+protected:
+    Simulation simulation;
+    std::vector<std::unique_ptr<SkewedClock>> clocks;
+
+    void SetUp() override
+    {
+        const uint64_t startMicros[] = {4000000000ULL, 7300000ULL, 123456789ULL}; // The first wraps after 5 minutes
+        const double drift[] = {0.00004, -0.00004, 0.00001};
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            SimulatedController &controller = simulation.AddController(("LEDController" + std::to_string(i + 1)).c_str());
+            clocks.emplace_back(new SkewedClock(controller.getClock(), startMicros[i], drift[i]));
+        }
+        HostNetwork::SetUdpLatency(300, 2700);
+        simulation.Setup();
+        // The setup sets the references => Replaced before the first loop
+        for (uint8_t i = 0; i < 3; i++)
+        {
+            simulation.getController(i).setSharedClockSource(clocks[i].get());
+        }
+        ASSERT_TRUE(simulation.RunUntilConnected());
+    }
+
+    void TearDown() override
+    {
+        HostNetwork::SetUdpLatency(0, 0);
+    }
+
+    uint64_t getSharedMicros(size_t index)
+    {
+        SimulatedController &controller = simulation.getController(index);
+        HostNodeScope scope(controller.getNode());
+        return controller.getSharedClock().getSharedMicros();
+    }
+
+    // Largest difference of the shared times at the same instant
+    int64_t getSpread(const std::vector<size_t> &indices)
+    {
+        int64_t spread = 0;
+        for (size_t i : indices)
+        {
+            for (size_t j : indices)
+            {
+                spread = std::max(spread, std::abs((int64_t)(getSharedMicros(i) - getSharedMicros(j))));
+            }
+        }
+        return spread;
+    }
+};
+
+TEST_F(SharedClockTest, FollowersAgreeWithTheLeader)
+{
+    simulation.Run(10000000);
+    for (size_t i = 0; i < 3; i++)
+    {
+        EXPECT_EQ(simulation.getController(i).getSharedClock().getLeaderId(), simulation.getController(0).getSharedClock().getNodeId());
+        EXPECT_TRUE(simulation.getController(i).getSharedClock().isSynced());
+    }
+
+    // Past the wrap of the local time of the leader and long enough to follow the drift
+    int64_t maxSpread = 0;
+    for (uint16_t i = 0; i < 400; i++)
+    {
+        simulation.Run(1000000);
+        maxSpread = std::max(maxSpread, getSpread({0, 1, 2}));
+    }
+    EXPECT_LT(maxSpread, 2000);
+}
+
+TEST_F(SharedClockTest, FollowersStayTogetherWhenTheLeaderIsLost)
+{
+    simulation.Run(30000000);
+    uint64_t before = getSharedMicros(1);
+
+    simulation.getController(0).getNode().accessPointInRange = false;
+    int64_t maxSpread = 0;
+    for (uint16_t i = 0; i < 30; i++)
+    {
+        simulation.Run(1000000);
+        maxSpread = std::max(maxSpread, getSpread({1, 2}));
+    }
+
+    EXPECT_EQ(simulation.getController(2).getSharedClock().getLeaderId(), simulation.getController(1).getSharedClock().getNodeId());
+    EXPECT_LT(maxSpread, 2000);
+    // The shared time keeps running without a jump
+    int64_t elapsed = (int64_t)(getSharedMicros(1) - before);
+    EXPECT_NEAR(elapsed, 30000000, 5000);
+}
@@ -0,0 +1,77 @@
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <HostEnvironment.h>
+#include <LittleFS.h>
+#include <SimulatedController.h>
+#include <gtest/gtest.h>
+
+TEST(ShimTest, DelayAdvancesTheTimeOfTheSelectedNode)
+{
+    HostNode node(1, IPAddress(192, 168, 0, 50));
+    HostNodeScope scope(node);
+    unsigned long start = micros();
+    delay(25);
+    EXPECT_EQ(micros() - start, 25000u);
+    EXPECT_EQ(millis(), (unsigned long)(node.micros / 1000));
+    EXPECT_EQ(HostNode::Host().micros, 0u + HostNode::Host().micros); // The host keeps its own time
+}
+
+TEST(ShimTest, FilesystemIsPerNode)
+{
+    HostNode first(1, IPAddress(192, 168, 0, 51));
+    HostNode second(2, IPAddress(192, 168, 0, 52));
+    {
+        HostNodeScope scope(first);
+        ASSERT_TRUE(LittleFS.begin());
+        File file = LittleFS.open("/Test.dat", "w");
+        file.println("Hello");
+        file.close();
+        EXPECT_TRUE(LittleFS.exists("/Test.dat"));
+    }
+    {
+        HostNodeScope scope(second);
+        ASSERT_TRUE(LittleFS.begin());
+        EXPECT_FALSE(LittleFS.exists("/Test.dat"));
+    }
+    EXPECT_EQ(first.ReadFile("/Test.dat"), "Hello\r\n");
+
+    HostNodeScope scope(first);
+    File file = LittleFS.open("/Test.dat", "r");
+    EXPECT_EQ(file.available(), 7);
+    EXPECT_EQ(file.read(), 'H');
+}
+
+TEST(ShimTest, WiFiReportsTheIdentityOfTheNode)
+{
+    HostNode node(0x123456, IPAddress(192, 168, 0, 53));
+    HostNodeScope scope(node);
+    EXPECT_EQ(ESP.getChipId(), 0x123456u);
+    EXPECT_NE(WiFi.status(), WL_CONNECTED);
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(String("SSID"), String("password"));
+    EXPECT_EQ(WiFi.status(), WL_CONNECTED);
+    EXPECT_EQ(WiFi.localIP(), IPAddress(192, 168, 0, 53));
+
+    node.accessPointInRange = false;
+    EXPECT_NE(WiFi.status(), WL_CONNECTED);
+}
+
+TEST(ShimTest, HeapIsCountedPerNode)
+{
+    HostNode node(1, IPAddress(192, 168, 0, 54));
+    uint32_t freeHeap;
+    {
+        HostNodeScope scope(node);
+        freeHeap = ESP.getFreeHeap();
+    }
+    std::vector<uint8_t> *block;
+    {
+        HostNodeScope scope(node);
+        block = new std::vector<uint8_t>(1000);
+        EXPECT_LE(ESP.getFreeHeap(), freeHeap - 1000);
+    }
+    EXPECT_GE(node.getHeapPeakBytesInUse(), 1000u);
+    delete block;
+    HostNodeScope scope(node);
+    EXPECT_EQ(ESP.getFreeHeap(), freeHeap);
+}
@@ -0,0 +1,79 @@
+#include <Simulation.h>
+#include <gtest/gtest.h>
+
+TEST(SimulationTest, ControllerBootsAndConnectsToTheBroker)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+
+    EXPECT_TRUE(simulation.RunUntilConnected());
+    EXPECT_GT(controller.getLoopCount(), 0u);
+    simulation.Run(1000000); // Subscriptions follow the connect in the next network runs
+    EXPECT_FALSE(simulation.getBroker().getSubscriptions("LEDController1").empty());
+}
+
+TEST(SimulationTest, ControllerInitializesThePwmDevice)
+{
+    Simulation simulation;
+    SimulatedController &controller = simulation.AddController("LEDController1");
+    simulation.Setup();
+    simulation.Run(2000000);
+
+    // MODE1 leaves sleep and enables the auto increment once the led driver configured the PCA9685
+    EXPECT_GT(controller.getBus().getTransactionCount(), 0u);
+    EXPECT_EQ(controller.getBus().getRegister8(SIMULATED_PCA9685_ADDRESS, 0x00) & 0x10, 0);
+}
+
+TEST(SimulationTest, FleetConnectsWithinTheHeapOfTheEsp8266)
+{
+    Simulation simulation;
+    for (int i = 1; i <= 3; i++)
+    {
+        simulation.AddController(("LEDController" + std::to_string(i)).c_str());
+    }
+    simulation.Setup();
+
+    EXPECT_TRUE(simulation.RunUntilConnected());
+    EXPECT_EQ(simulation.getBroker().getConnectedClientCount(), 3u);
+    for (size_t i = 0; i < simulation.getControllerCount(); i++)
+    {
+        HostNode &node = simulation.getController(i).getNode();
+        EXPECT_LT(node.getHeapPeakBytesInUse(), node.heapSize);
+    }
+}
+
+TEST(SimulationTest, IdleFleetMessageRate)
+{
+    const uint32_t controllerCount = 4;
+    const uint32_t seconds = 300;
+    Simulation simulation;
+    for (uint32_t i = 1; i <= controllerCount; i++)
+    {
+        simulation.AddController(("LEDController" + std::to_string(i)).c_str());
+    }
+    simulation.Setup();
+    ASSERT_TRUE(simulation.RunUntilConnected());
+    simulation.Run(70000000); // Republish after the connect and the first keep-alive states
+
+    uint64_t publishes = 0;
+    simulation.getBroker().Observe("#", [&](const MqttBrokerMessage &message)
+                                   {
+                                       if (!message.senderClientId.empty())
+                                       {
+                                           publishes++;
+                                       }
+                                   });
+    simulation.getBroker().ResetStatistics();
+    simulation.Run((uint64_t)seconds * 1000000);
+
+    // Without the heartbeat an idle controller sends its 15 keep-alive states once a minute. The client pings the broker
+    // after MQTT_KEEP_ALIVE (15 s) without outbound traffic => 3 PINGREQ a minute
+    double publishRate = (double)publishes / seconds / controllerCount;
+    double pingRate = (double)simulation.getBroker().getStatistics().pingRequests / seconds / controllerCount;
+    printf("Idle per controller: %.3f publishes/s, %.3f pings/s => %.1f msg/s for 60 controllers\n",
+           publishRate, pingRate, (publishRate + pingRate) * 60);
+    EXPECT_EQ(simulation.getBroker().getStatistics().keepAliveTimeouts, 0u);
+    EXPECT_LT((publishRate + pingRate) * 60, 20.0);
+    simulation.getBroker().ClearObservers();
+}
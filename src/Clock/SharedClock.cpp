@@ -0,0 +1,541 @@
+#include "SharedClock.h"
+
+/**
+ * @brief Construct a new SharedClock:: SharedClock object
+ * 
+ */
+SharedClock::SharedClock(){
+
+};
+
+/**
+ * @brief Sets the needed refernce for the shared clock
+ */
+void SharedClock::setReference(Network *network,
+                               Information *information,
+                               ITimeSource *clock)
+{
+    this->network = network;
+    this->information = information;
+    this->clock = clock;
+};
+
+/**
+ * @brief Initializes the shared clock. Every controller leads until it hears of one with a lower node id
+ * 
+ * @return True if the initialization was successful
+ */
+bool SharedClock::Init()
+{
+    if (!init)
+    {
+        this->nodeId = ESP.getChipId();
+        this->leaderId = this->nodeId;
+        this->synced = true;
+
+        Serial.println(F("Shared Clock initialized"));
+        init = true;
+    }
+
+    return init;
+};
+
+/**
+ * @brief Runs the shared clock
+ * 
+ */
+void SharedClock::Run()
+{
+    if (!init)
+    {
+        return;
+    }
+
+    // Keeps the 64 bit local time up to date
+    this->getLocalMicros();
+
+    HandleListener();
+    if (!this->listening)
+    {
+        return;
+    }
+
+    for (uint8_t i = 0; i < CLOCK_SYNC_SAMPLE_COUNT; i++)
+    {
+        int packetSize = this->syncUDP.parsePacket();
+        if (packetSize <= 0)
+        {
+            break;
+        }
+        HandlePacket(packetSize);
+        this->syncUDP.flush();
+    }
+
+    unsigned long currentMillis = this->clock->Millis();
+
+    // Leader is gone => Lead until a controller with a lower node id shows up
+    if (this->leaderId != this->nodeId && currentMillis - this->prevMillisLeaderBeacon >= CLOCK_SYNC_LEADER_TIMEOUT)
+    {
+        this->ChangeLeader(this->nodeId);
+    }
+
+    if (currentMillis - this->prevMillisBeacon >= CLOCK_SYNC_BEACON_INTERVAL)
+    {
+        this->prevMillisBeacon = currentMillis;
+        this->BuildPacket(ClockSyncPacketType::Beacon, 0, 0, 0);
+        this->SendMulticastPacket();
+    }
+
+    // Faster samples until the filter is filled => Synced within a second after a leader change
+    if (this->leaderId != this->nodeId)
+    {
+        unsigned long interval = this->sampleCount < CLOCK_SYNC_SAMPLE_COUNT ? CLOCK_SYNC_REQUEST_INTERVAL / 8 : CLOCK_SYNC_REQUEST_INTERVAL;
+        if (currentMillis - this->prevMillisRequest >= interval)
+        {
+            this->prevMillisRequest = currentMillis;
+            this->requestMicros = this->getLocalMicros();
+            this->BuildPacket(ClockSyncPacketType::DelayRequest, this->leaderId, this->requestMicros, 0);
+            this->SendPacket(this->leaderAddress, CLOCK_SYNC_PORT);
+        }
+    }
+};
+
+/**
+ * @brief Returns the time between two runs
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t SharedClock::getRunPeriod()
+{
+    return 11111; // One led frame at 90 Hz => Runs right before the led driver and adds no deadline of its own for the other tasks
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority SharedClock::getRunPriority()
+{
+    return SchedulerPriority::High; // The time a packet waits in the socket is an error of the offset
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t SharedClock::getRunBudget()
+{
+    return 300;
+};
+
+/**
+ * @return Milliseconds of the shared time. Same on all synced controllers
+ */
+unsigned long SharedClock::Millis()
+{
+    return (unsigned long)(this->getSharedMicros(this->getLocalMicros()) / 1000);
+};
+
+/**
+ * @return Microseconds of the shared time. Same on all synced controllers
+ */
+unsigned long SharedClock::Micros()
+{
+    return (unsigned long)this->getSharedMicros(this->getLocalMicros());
+};
+
+/**
+ * @brief Waits on the local time. The offset to the shared time does not change while waiting
+ * 
+ * @param millis Milliseconds to wait
+ */
+void SharedClock::Delay(unsigned long millis)
+{
+    this->clock->Delay(millis);
+};
+
+/**
+ * @brief Joins the multicast group while the WiFi is connected and leaves it on a disconnect
+ * 
+ */
+void SharedClock::HandleListener()
+{
+    bool wiFiConnected = this->network->isWiFiConnected();
+    if (wiFiConnected && !this->listening)
+    {
+        this->syncUDP.beginMulticast(WiFi.localIP(), this->multicastAddress, CLOCK_SYNC_PORT);
+        this->listening = true;
+    }
+    else if (!wiFiConnected && this->listening)
+    {
+        this->syncUDP.stop();
+        this->listening = false;
+        if (this->leaderId != this->nodeId)
+        {
+            this->ChangeLeader(this->nodeId);
+        }
+    }
+};
+
+/**
+ * @brief Reads a clock sync packet and passes it to its handler
+ * 
+ * @param packetSize The size of the received packet
+ */
+void SharedClock::HandlePacket(int packetSize)
+{
+    if (packetSize < CLOCK_SYNC_PACKET_LENGTH)
+    {
+        return;
+    }
+    this->syncUDP.read(this->packet, CLOCK_SYNC_PACKET_LENGTH);
+
+    uint32_t senderId = this->ReadUint32(5);
+    uint32_t targetId = this->ReadUint32(9);
+    if (memcmp(this->packet, "LCS1", 4) != 0 || senderId == this->nodeId)
+    {
+        return; // Other protocol or our own multicast
+    }
+
+    switch ((ClockSyncPacketType)this->packet[4])
+    {
+    case ClockSyncPacketType::Beacon:
+        this->HandleBeacon(senderId);
+        break;
+
+    case ClockSyncPacketType::DelayRequest:
+        if (targetId == this->nodeId && this->isLeader())
+        {
+            this->HandleDelayRequest(senderId);
+        }
+        break;
+
+    case ClockSyncPacketType::DelayResponse:
+        if (targetId == this->nodeId)
+        {
+            this->HandleDelayResponse(senderId);
+        }
+        break;
+    }
+};
+
+/**
+ * @brief Elects the controller with the lowest node id as leader
+ * 
+ * @param senderId The node id of the controller that sent the beacon
+ */
+void SharedClock::HandleBeacon(uint32_t senderId)
+{
+    if (senderId == this->leaderId)
+    {
+        this->prevMillisLeaderBeacon = this->clock->Millis();
+        this->leaderAddress = this->syncUDP.remoteIP();
+    }
+    else if (senderId < this->leaderId)
+    {
+        this->prevMillisLeaderBeacon = this->clock->Millis();
+        this->leaderAddress = this->syncUDP.remoteIP();
+        this->ChangeLeader(senderId);
+    }
+};
+
+/**
+ * @brief Answers the request of a follower with the shared time. Receive and send time are the same
+ * 
+ * @param senderId The node id of the follower
+ */
+void SharedClock::HandleDelayRequest(uint32_t senderId)
+{
+    uint64_t requestMicros = this->ReadUint64(13);
+    this->BuildPacket(ClockSyncPacketType::DelayResponse, senderId, requestMicros, this->getSharedMicros(this->getLocalMicros()));
+    this->SendPacket(this->syncUDP.remoteIP(), this->syncUDP.remotePort());
+};
+
+/**
+ * @brief Calculates an offset sample from the response of the leader. The shared time of the leader is taken
+ * as the time in the middle of the round trip
+ * 
+ * @param senderId The node id of the leader
+ */
+void SharedClock::HandleDelayResponse(uint32_t senderId)
+{
+    uint64_t requestMicros = this->ReadUint64(13);
+    if (senderId != this->leaderId || requestMicros != this->requestMicros || this->requestMicros == 0)
+    {
+        return; // Stale response or from the previous leader
+    }
+    this->requestMicros = 0;
+
+    uint64_t responseMicros = this->getLocalMicros();
+    uint64_t roundTrip = responseMicros - requestMicros;
+    if (roundTrip > CLOCK_SYNC_MAX_ROUND_TRIP)
+    {
+        return;
+    }
+
+    ClockSyncSample sample = {};
+    sample.offset = (int64_t)(this->ReadUint64(21) + roundTrip / 2) - (int64_t)responseMicros;
+    sample.roundTrip = (uint32_t)roundTrip;
+    sample.localMicros = responseMicros;
+    this->AddSample(sample);
+};
+
+/**
+ * @brief Adds an offset sample. The sample with the shortest round trip of the last samples has the smallest
+ * network delay error and becomes the offset. The change between two offsets far enough apart is the drift
+ * 
+ * @param sample The new sample
+ */
+void SharedClock::AddSample(ClockSyncSample sample)
+{
+    this->samples[this->sampleIndex] = sample;
+    this->sampleIndex = (this->sampleIndex + 1) % CLOCK_SYNC_SAMPLE_COUNT;
+    if (this->sampleCount < CLOCK_SYNC_SAMPLE_COUNT)
+    {
+        this->sampleCount++;
+    }
+
+    const ClockSyncSample *best = &this->samples[0];
+    for (uint8_t i = 1; i < this->sampleCount; i++)
+    {
+        if (this->samples[i].roundTrip < best->roundTrip)
+        {
+            best = &this->samples[i];
+        }
+    }
+    if (this->synced && best->localMicros == this->offsetLocalMicros)
+    {
+        return; // Best sample did not change
+    }
+
+    if (!this->synced)
+    {
+        this->driftOffset = best->offset;
+        this->driftLocalMicros = best->localMicros;
+    }
+    else if (best->localMicros - this->driftLocalMicros >= CLOCK_SYNC_DRIFT_INTERVAL)
+    {
+        double measuredDrift = (double)(best->offset - this->driftOffset) / (double)(best->localMicros - this->driftLocalMicros);
+        this->drift += (measuredDrift - this->drift) / 4;
+        this->drift = constrain(this->drift, -0.0005, 0.0005); // 500 ppm => Far beyond any crystal
+        this->driftOffset = best->offset;
+        this->driftLocalMicros = best->localMicros;
+    }
+
+    this->offset = best->offset;
+    this->offsetLocalMicros = best->localMicros;
+    this->synced = true;
+};
+
+/**
+ * @brief Follows a new leader. The shared time stays continuous until the first sample of the new leader
+ * 
+ * @param leaderId The node id of the new leader
+ */
+void SharedClock::ChangeLeader(uint32_t leaderId)
+{
+    uint64_t localMicros = this->getLocalMicros();
+    this->offset = (int64_t)this->getSharedMicros(localMicros) - (int64_t)localMicros;
+    this->offsetLocalMicros = localMicros;
+    this->drift = 0.0;
+
+    this->sampleCount = 0;
+    this->sampleIndex = 0;
+    this->requestMicros = 0;
+    this->leaderId = leaderId;
+    this->synced = this->isLeader();
+
+    this->information->FormatPrintSingle("Shared Clock Leader", String(leaderId, HEX));
+};
+
+/**
+ * @brief Fills the packet buffer
+ * 
+ * @param type              The packet type
+ * @param targetId          The node id the packet is for. 0 for all
+ * @param firstTimestamp    Local time of the request
+ * @param secondTimestamp   Shared time of the response
+ */
+void SharedClock::BuildPacket(ClockSyncPacketType type,
+                              uint32_t targetId,
+                              uint64_t firstTimestamp,
+                              uint64_t secondTimestamp)
+{
+    memcpy(this->packet, "LCS1", 4);
+    this->packet[4] = (uint8_t)type;
+    this->WriteUint32(5, this->nodeId);
+    this->WriteUint32(9, targetId);
+    this->WriteUint64(13, firstTimestamp);
+    this->WriteUint64(21, secondTimestamp);
+};
+
+/**
+ * @brief Sends the packet buffer to one controller
+ * 
+ * @param address   The address of the controller
+ * @param port      The port of the controller
+ */
+void SharedClock::SendPacket(IPAddress address,
+                             uint16_t port)
+{
+    if (this->syncUDP.beginPacket(address, port))
+    {
+        this->syncUDP.write(this->packet, CLOCK_SYNC_PACKET_LENGTH);
+        this->syncUDP.endPacket();
+    }
+};
+
+/**
+ * @brief Sends the packet buffer to all controllers
+ * 
+ */
+void SharedClock::SendMulticastPacket()
+{
+    if (this->syncUDP.beginPacketMulticast(this->multicastAddress, CLOCK_SYNC_PORT, WiFi.localIP()))
+    {
+        this->syncUDP.write(this->packet, CLOCK_SYNC_PACKET_LENGTH);
+        this->syncUDP.endPacket();
+    }
+};
+
+/**
+ * @brief Returns the local time without wrap. Needs a call at least every 71 minutes
+ * 
+ * @return Microseconds since start
+ */
+uint64_t SharedClock::getLocalMicros()
+{
+    uint32_t localMicros = this->clock->Micros();
+    if (localMicros < this->prevLocalMicros)
+    {
+        this->localMicrosWraps++;
+    }
+    this->prevLocalMicros = localMicros;
+    return ((uint64_t)this->localMicrosWraps << 32) | localMicros;
+};
+
+/**
+ * @brief Converts a local time to the shared time
+ * 
+ * @param localMicros The local time
+ * @return The shared time
+ */
+uint64_t SharedClock::getSharedMicros(uint64_t localMicros)
+{
+    int64_t elapsed = (int64_t)(localMicros - this->offsetLocalMicros);
+    return localMicros + this->offset + (int64_t)(this->drift * (double)elapsed);
+};
+
+/**
+ * @brief Writes a big endian value into the packet buffer
+ */
+void SharedClock::WriteUint32(uint8_t position, uint32_t value)
+{
+    for (uint8_t i = 0; i < 4; i++)
+    {
+        this->packet[position + i] = (uint8_t)(value >> (24 - 8 * i));
+    }
+};
+
+/**
+ * @brief Writes a big endian value into the packet buffer
+ */
+void SharedClock::WriteUint64(uint8_t position, uint64_t value)
+{
+    this->WriteUint32(position, (uint32_t)(value >> 32));
+    this->WriteUint32(position + 4, (uint32_t)value);
+};
+
+/**
+ * @brief Reads a big endian value from the packet buffer
+ */
+uint32_t SharedClock::ReadUint32(uint8_t position)
+{
+    return ((uint32_t)this->packet[position] << 24) |
+           ((uint32_t)this->packet[position + 1] << 16) |
+           ((uint32_t)this->packet[position + 2] << 8) |
+           this->packet[position + 3];
+};
+
+/**
+ * @brief Reads a big endian value from the packet buffer
+ */
+uint64_t SharedClock::ReadUint64(uint8_t position)
+{
+    return ((uint64_t)this->ReadUint32(position) << 32) | this->ReadUint32(position + 4);
+};
+
+/**
+ * @brief Returns the shared time without wrap => Periods that do not divide 2^32 keep their phase
+ * 
+ * @return Microseconds of the shared time. Same on all synced controllers
+ */
+uint64_t SharedClock::getSharedMicros()
+{
+    return this->getSharedMicros(this->getLocalMicros());
+};
+
+/**
+ * @brief Returns if this controller is the time reference of the others
+ * 
+ * @return True if leading
+ */
+bool SharedClock::isLeader()
+{
+    return this->leaderId == this->nodeId;
+};
+
+/**
+ * @brief Returns if the shared time follows the leader
+ * 
+ * @return True if leading or at least one sample of the leader was taken
+ */
+bool SharedClock::isSynced()
+{
+    return this->synced;
+};
+
+/**
+ * @brief Returns the node id of this controller
+ * 
+ * @return The chip id of the ESP8266
+ */
+uint32_t SharedClock::getNodeId()
+{
+    return this->nodeId;
+};
+
+/**
+ * @brief Returns the node id of the leading controller
+ * 
+ * @return The node id
+ */
+uint32_t SharedClock::getLeaderId()
+{
+    return this->leaderId;
+};
+
+/**
+ * @brief Returns the round trip of the sample the offset is taken from
+ * 
+ * @return Microseconds. 0 while leading or not synced
+ */
+uint32_t SharedClock::getRoundTrip()
+{
+    if (this->isLeader() || this->sampleCount == 0)
+    {
+        return 0;
+    }
+
+    uint32_t roundTrip = this->samples[0].roundTrip;
+    for (uint8_t i = 1; i < this->sampleCount; i++)
+    {
+        if (this->samples[i].roundTrip < roundTrip)
+        {
+            roundTrip = this->samples[i].roundTrip;
+        }
+    }
+    return roundTrip;
+};
@@ -0,0 +1,113 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include "../Network/Network.h"
+#include "../Information/Information.h"
+#include "../Constants/Constants.h"
+#include "../Enums/Enums.h"
+#include "../Structs/Structs.h"
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+
+// Blueprint for compiler. Problem => circular dependency
+class Network;
+class Information;
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The SharedClock Class is a time source that is the same on all controllers in the network.
+ * The controllers find each other over UDP multicast and the one with the lowest node id leads. The followers
+ * measure the offset to the leader with a request and response like NTP and follow its drift.
+ * Without other controllers the shared time is the local time
+ */
+class SharedClock : public IBaseClass, public ITimeSource
+{
+    // ================ Constructor / Reference ================ //
+public:
+    SharedClock();
+    void setReference(Network *network,
+                      Information *information,
+                      ITimeSource *clock);
+    bool init = false;
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual bool Init();
+    virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+
+    virtual unsigned long Millis();
+    virtual unsigned long Micros();
+    virtual void Delay(unsigned long millis);
+
+    // ================ Data ================ //
+private:
+    Network *network;
+    Information *information;
+    ITimeSource *clock; // Local time
+
+    // ======== UDP ======== //
+    WiFiUDP syncUDP;
+    bool listening = false;
+    IPAddress multicastAddress = IPAddress(239, 255, 76, 67);
+    uint8_t packet[CLOCK_SYNC_PACKET_LENGTH]{0};
+
+    // ======== Local time ======== //
+    uint32_t prevLocalMicros = 0;
+    uint32_t localMicrosWraps = 0; // Extends the local micros to 64 bit => The shared time never wraps
+
+    // ======== Leader election ======== //
+    uint32_t nodeId = 0;
+    uint32_t leaderId = 0;
+    IPAddress leaderAddress;
+    unsigned long prevMillisLeaderBeacon = 0;
+    unsigned long prevMillisBeacon = 0;
+
+    // ======== Offset and drift ======== //
+    ClockSyncSample samples[CLOCK_SYNC_SAMPLE_COUNT] = {};
+    uint8_t sampleCount = 0;
+    uint8_t sampleIndex = 0;
+    unsigned long prevMillisRequest = 0;
+    uint64_t requestMicros = 0; // Local time of the pending request => Stale responses get ignored
+    int64_t offset = 0;         // us from the local to the shared time at offsetLocalMicros
+    uint64_t offsetLocalMicros = 0;
+    double drift = 0.0; // us the shared time runs faster per local us
+    int64_t driftOffset = 0;
+    uint64_t driftLocalMicros = 0;
+    bool synced = false;
+
+    // ================ Methods ================ //
+private:
+    void HandleListener();
+    void HandlePacket(int packetSize);
+    void HandleBeacon(uint32_t senderId);
+    void HandleDelayRequest(uint32_t senderId);
+    void HandleDelayResponse(uint32_t senderId);
+    void AddSample(ClockSyncSample sample);
+    void ChangeLeader(uint32_t leaderId);
+    void BuildPacket(ClockSyncPacketType type, uint32_t targetId, uint64_t firstTimestamp, uint64_t secondTimestamp);
+    void SendPacket(IPAddress address, uint16_t port);
+    void SendMulticastPacket();
+    uint64_t getLocalMicros();
+    uint64_t getSharedMicros(uint64_t localMicros);
+    void WriteUint32(uint8_t position, uint32_t value);
+    void WriteUint64(uint8_t position, uint64_t value);
+    uint32_t ReadUint32(uint8_t position);
+    uint64_t ReadUint64(uint8_t position);
+
+public:
+    uint64_t getSharedMicros();
+    bool isLeader();
+    bool isSynced();
+    uint32_t getNodeId();
+    uint32_t getLeaderId();
+    uint32_t getRoundTrip();
+};
@@ -0,0 +1,35 @@
+#include "SystemClock.h"
+
+/**
+ * @brief Construct a new SystemClock:: SystemClock object
+ * 
+ */
+SystemClock::SystemClock(){
+
+};
+
+/**
+ * @return Milliseconds since start of the ESP8266
+ */
+unsigned long SystemClock::Millis()
+{
+    return millis();
+};
+
+/**
+ * @return Microseconds since start of the ESP8266
+ */
+unsigned long SystemClock::Micros()
+{
+    return micros();
+};
+
+/**
+ * @brief Blocks the ESP8266 like delay(). Lets the WiFi stack run in the meantime
+ * 
+ * @param millis Milliseconds to wait
+ */
+void SystemClock::Delay(unsigned long millis)
+{
+    delay(millis);
+};
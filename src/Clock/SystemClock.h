@@ -0,0 +1,25 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/ITimeSource.h"
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The SystemClock Class passes the time of the ESP8266 to the components
+ */
+class SystemClock : public ITimeSource
+{
+    // ================ Constructor / Reference ================ //
+public:
+    SystemClock();
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual unsigned long Millis();
+    virtual unsigned long Micros();
+    virtual void Delay(unsigned long millis);
+};
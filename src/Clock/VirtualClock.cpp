@@ -0,0 +1,72 @@
+#include "VirtualClock.h"
+
+/**
+ * @brief Construct a new VirtualClock:: VirtualClock object
+ * 
+ */
+VirtualClock::VirtualClock(){
+
+};
+
+/**
+ * @return Simulated milliseconds since start
+ */
+unsigned long VirtualClock::Millis()
+{
+    return (unsigned long)(this->elapsedMicros / 1000);
+};
+
+/**
+ * @return Simulated microseconds since start
+ */
+unsigned long VirtualClock::Micros()
+{
+    return (unsigned long)this->elapsedMicros;
+};
+
+/**
+ * @brief Waits by moving the simulated time forward => Returns at once
+ * 
+ * @param millis Milliseconds to wait
+ */
+void VirtualClock::Delay(unsigned long millis)
+{
+    this->AdvanceMillis(millis);
+};
+
+/**
+ * @brief Moves the simulated time forward
+ * 
+ * @param micros The time to advance in microseconds
+ */
+void VirtualClock::Advance(unsigned long micros)
+{
+    this->elapsedMicros += micros;
+};
+
+/**
+ * @brief Moves the simulated time forward
+ * 
+ * @param millis The time to advance in milliseconds
+ */
+void VirtualClock::AdvanceMillis(unsigned long millis)
+{
+    this->elapsedMicros += (uint64_t)millis * 1000;
+};
+
+/**
+ * @brief Sets the simulated time back to the start
+ * 
+ */
+void VirtualClock::Reset()
+{
+    this->elapsedMicros = 0;
+};
+
+/**
+ * @return The simulated time since start in microseconds without wrap around
+ */
+uint64_t VirtualClock::getElapsedMicros()
+{
+    return this->elapsedMicros;
+};
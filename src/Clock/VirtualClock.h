@@ -0,0 +1,38 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/ITimeSource.h"
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The VirtualClock Class is a time source that only moves when it gets advanced.
+ * Lets the controller be stepped through long simulated periods faster than real time with reproducible results
+ */
+class VirtualClock : public ITimeSource
+{
+    // ================ Constructor / Reference ================ //
+public:
+    VirtualClock();
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual unsigned long Millis();
+    virtual unsigned long Micros();
+    virtual void Delay(unsigned long millis);
+
+    // ================ Data ================ //
+private:
+    uint64_t elapsedMicros = 0; // Does not wrap so millis and micros stay consistent over long simulations
+
+    // ================ Methods ================ //
+private:
+public:
+    void Advance(unsigned long micros);
+    void AdvanceMillis(unsigned long millis);
+    void Reset();
+    uint64_t getElapsedMicros();
+};
@@ -3,4 +3,49 @@
 const uint8_t STRIP_COUNT = 2;
 const uint8_t CHANNEL_COUNT = 5;
 const uint8_t MAX_DATA = 10;
-const uint8_t MAX_STRING_LENGTH = 40;
\ No newline at end of file
+const uint8_t MAX_STRING_LENGTH = 40;
+const uint8_t I2C_ERROR_CODE_COUNT = 5;     // Result codes of Wire.endTransmission() => 0 success, 1-4 errors
+const uint8_t I2C_MAX_PWM_DEVICE_COUNT = 8; // PCA9685 devices the bus scan keeps track of
+const uint8_t I2C_IGNORED_ADDRESS_BYTES = 7; // Bitmap of the probed range 0x40 - 0x77 => One bit per address
+const uint8_t PROFILER_COMPONENT_COUNT = 18; // Entries of ProfilerComponent
+const uint8_t PROFILER_BUCKET_COUNT = 24;    // Power of two micro second buckets => Last bucket holds everything above 4.2 sec
+const uint8_t SCHEDULER_TASK_COUNT = 16;     // Components the scheduler can run
+const uint8_t SCHEDULER_MAX_DEFER_COUNT = 50; // Times a task gets deferred in a row before it runs regardless of the deadline
+const uint8_t MQTT_TOPIC_COUNT = 33;         // Entries of NetworkTopic without Unknown and HomeAssistantStatus
+const uint8_t MQTT_TOPIC_TABLE_SIZE = 64;    // Slots of the topic lookup table. Power of two and at least twice the topic count
+const uint8_t MQTT_TOPIC_TABLE_EMPTY = 0xFF; // Marks an unused slot of the topic lookup table
+const uint8_t MQTT_TOPIC_LENGTH = 128;       // Longest mqtt topic the network component builds
+const uint8_t MQTT_PAYLOAD_LENGTH = 64;      // Longest state payload the network component formats
+const uint16_t MQTT_JSON_DOCUMENT_SIZE = 512;  // Fixed json document for the json commands and states
+const uint16_t MQTT_JSON_PAYLOAD_LENGTH = 768; // Longest json state or discovery config the network component formats
+const uint16_t MQTT_BUFFER_SIZE = 1024;        // Mqtt packet buffer => Topic and json payload
+const uint8_t PIR_EVENT_QUEUE_SIZE = 8;      // Motion state changes the pir reader keeps until the network publishes them
+const uint8_t MQTT_PUBLISH_QUEUE_SIZE = 16;        // Different state topics the outbound queue can hold
+const uint8_t MQTT_PUBLISH_SUFFIX_LENGTH = 64;     // Longest topic suffix an outbound queue entry can hold
+const uint16_t MQTT_PUBLISH_BYTE_BUDGET = 512;     // Topic and payload bytes the outbound queue sends per loop
+const char MQTT_AVAILABILITY_ONLINE[] = "online";   // Retained birth message on the availability topic
+const char MQTT_AVAILABILITY_OFFLINE[] = "offline"; // Retained last will on the availability topic
+const uint8_t MQTT_DISCOVERY_COUNT = 9;             // Home Assistant entities announced over mqtt discovery
+const char MQTT_DISCOVERY_STATUS_TOPIC[] = "homeassistant/status"; // Birth message of Home Assistant => "online" after it (re)connected to the broker
+const uint16_t MQTT_CONNECT_PACKET_LENGTH = 256;   // Connect packet of the asynchronous mqtt client => Client name, credentials and last will
+const uint8_t MQTT_GROUP_COUNT = 4;                // Groups a controller can be member of
+const uint8_t MQTT_GROUP_NAME_LENGTH = 24;         // Longest group name without the terminator
+const uint8_t PCA9685_CHANNEL_COUNT = 16;               // PWM outputs of one PCA9685
+const unsigned long COMMAND_LATENCY_TIMEOUT = 5000000;  // us. A command that does not change the led output in time gets no latency sample
+const uint8_t REALTIME_CHANNEL_COUNT = STRIP_COUNT * CHANNEL_COUNT; // Channels of a realtime frame => R, G, B, CW, WW of strip 1 then strip 2
+const uint16_t REALTIME_DDP_PORT = 4048;                // Default DDP port
+const uint16_t REALTIME_E131_PORT = 5568;               // Default sACN port
+const uint16_t REALTIME_E131_UNIVERSE = 1;              // Universe the controller listens to. Channel 1 of the universe is the first frame channel
+const uint8_t REALTIME_DDP_HEADER_LENGTH = 14;          // 10 byte header and the optional 4 byte timecode
+const uint8_t REALTIME_E131_HEADER_LENGTH = 126;        // Root, framing and DMP layer including the start code
+const uint8_t REALTIME_PACKET_BUDGET = 4;               // Packets read per run. The newest frame wins
+const unsigned long REALTIME_TIMEOUT = 2500;            // ms without a frame before the effects take over again
+const uint8_t REALTIME_JITTER_BUFFER_SIZE = 8;          // Frames the jitter buffer holds => 266 ms of a 30 fps source
+const uint16_t CLOCK_SYNC_PORT = 7667;                  // Port of the clock sync multicast group
+const uint8_t CLOCK_SYNC_PACKET_LENGTH = 29;            // Magic, type, sender, target and two timestamps
+const uint8_t CLOCK_SYNC_SAMPLE_COUNT = 8;              // Offset samples the follower keeps. The one with the shortest round trip wins
+const unsigned long CLOCK_SYNC_BEACON_INTERVAL = 1000;  // ms between two beacons of a controller
+const unsigned long CLOCK_SYNC_LEADER_TIMEOUT = 3500;   // ms without a beacon of the leader before a new leader gets elected
+const unsigned long CLOCK_SYNC_REQUEST_INTERVAL = 1000; // ms between two offset samples of a synced follower. Faster until the samples are filled
+const unsigned long CLOCK_SYNC_MAX_ROUND_TRIP = 50000;  // us. Samples with a longer round trip get ignored
+const unsigned long CLOCK_SYNC_DRIFT_INTERVAL = 10000000; // us between two samples the drift gets measured with
@@ -110,6 +110,8 @@ enum class NetworkAccessPointState
 enum class NetworkMQTTState
 {
     StartMQTT,
+    ConnectMQTT,
+    SubscribeMQTT,
     SuperviseMQTTConnection,
     CheckMQTTDisconnect,
 };
@@ -122,6 +124,7 @@ enum class NetworkNTPState
 {
     StartNTP,
     SuperviseNTPConnection,
+    WaitNTPResponse,
     CheckNTPDisconnect,
 };
 
@@ -137,3 +140,149 @@ enum class LEDOutputType
     CW,
     WW,
 };
+
+
+/**
+ * @brief Defines the supported I2C bus clock speeds
+ * 
+ */
+enum class I2CClockSpeed
+{
+    StandardMode, // 100 kHz
+    FastMode,     // 400 kHz
+    FastModePlus, // 1 MHz
+};
+
+/**
+ * @brief Defines the I2C devices that can be found on the bus
+ * 
+ */
+enum class I2CDeviceType
+{
+    Unknown,
+    PCA9685,
+    INA219,
+};
+
+/**
+ * @brief Defines the sections of the main loop that are tracked by the profiler
+ * 
+ */
+enum class ProfilerComponent
+{
+    OTA,
+    I2C,
+    Network,
+    PowerMeasurement,
+    LedDriver,
+    Information,
+    PirReader,
+    Webserver,
+    Helper,
+    Filesystem,
+    Parameterhandler,
+    Profiler,
+    MotionEvent,      // Latency from a pir sensor edge to the mqtt publish of the motion state
+    CommandMQTT,      // Latency from a mqtt strip command to the first changed PCA9685 output
+    CommandWebSocket, // Latency from a websocket strip command to the first changed PCA9685 output
+    Realtime,
+    SharedClock,
+    Loop,             // The whole loop including all components
+};
+
+/**
+ * @brief Defines the priority a component gets scheduled with
+ * 
+ */
+enum class SchedulerPriority
+{
+    High,   // Runs on time, e.g. the led frames
+    Normal, // Runs when it fits before the next high priority deadline
+    Low,    // Same as normal, but after all normal priority components
+};
+
+/**
+ * @brief Defines the mqtt topics the network component reacts on
+ * 
+ */
+enum class NetworkTopic
+{
+    Unknown,
+    // HomeAssistant global
+    HomeAssistantSun,
+    HomeAssistantMasterPresent,
+    HomeAssistantAlarm,
+    // HomeAssistant motion
+    HomeAssistantMotionBrightnessTimeBasedEnabled,
+    HomeAssistantMotionEnabled,
+    HomeAssistantMotionTimeout,
+    HomeAssistantMotionRGB,
+    HomeAssistantMotionRGBBrightness,
+    HomeAssistantMotionWhite,
+    HomeAssistantMotionWhiteBrightness,
+    // HomeAssistant strip 1
+    HomeAssistantStrip1Power,
+    HomeAssistantStrip1RGB,
+    HomeAssistantStrip1RGBBrightness,
+    HomeAssistantStrip1White,
+    HomeAssistantStrip1WhiteBrightness,
+    HomeAssistantStrip1Effect,
+    // HomeAssistant strip 2
+    HomeAssistantStrip2Power,
+    HomeAssistantStrip2RGB,
+    HomeAssistantStrip2RGBBrightness,
+    HomeAssistantStrip2White,
+    HomeAssistantStrip2WhiteBrightness,
+    HomeAssistantStrip2Effect,
+    // HomeAssistant virtual
+    HomeAssistantVirtualPIR,
+    // JSON
+    JSONSun,
+    JSONMasterPresent,
+    JSONAlarm,
+    JSONMotionDetection,
+    JSONStrip1,
+    JSONStrip2,
+    JSONVirtualPIR,
+    // Profiler
+    ProfilerEnabled,
+    ProfilerReset,
+    // Group
+    GroupMembership,
+    // Home Assistant itself. Outside of "LEDController/" => Not in the topic table
+    HomeAssistantStatus,
+};
+
+/**
+ * @brief Defines the protocol of the realtime frames that currently drive the led strips
+ * 
+ */
+enum class RealtimeProtocol
+{
+    None, // No frame within the timeout => Normal mode
+    DDP,
+    E131,
+};
+
+/**
+ * @brief Defines the packets of the clock sync between the controllers
+ * 
+ */
+enum class ClockSyncPacketType
+{
+    Beacon = 1,        // Every controller announces itself => The lowest node id leads
+    DelayRequest = 2,  // Follower asks the leader for its shared time
+    DelayResponse = 3, // Leader answers with its shared time
+};
+
+/**
+ * @brief Defines the connection states of the asynchronous mqtt client
+ * 
+ */
+enum class AsyncMqttClientState
+{
+    Disconnected,
+    ConnectingTCP,
+    ConnectingMQTT,
+    Connected,
+};
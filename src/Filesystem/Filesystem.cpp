@@ -74,6 +74,8 @@ bool Filesystem::Init()
         // == Create files if missing
         this->createFileIfMissing(this->configurationDataFilename);
         this->createFileIfMissing(this->motionDataFilename);
+        this->createFileIfMissing(this->i2cLayoutDataFilename);
+        this->createFileIfMissing(this->groupDataFilename);
         for (int i = 0; i < STRIP_COUNT; i++)
         {
             this->createFileIfMissing(this->settingsStripDataFilename[i]);
@@ -86,11 +88,14 @@ bool Filesystem::Init()
         // == Load all files
         this->loadMotionData();
         this->loadConfigurationData();
+        this->loadI2CLayoutData();
+        this->loadGroupData();
         for (int i = 0; i < STRIP_COUNT; i++)
         {
             this->loadSettingsStripData(i);
             this->loadLEDStripData(i);
         }
+        this->initialDataRequested = true;
 
         Serial.println(F("Filesystem initialized"));
         init = true;
@@ -107,6 +112,7 @@ void Filesystem::Run()
     {
         return;
     }
+    this->initialDataRequested = false;
 
     // == Create Inital data on new installation (Not Configuration because it needs to be set via the web interface)
     if (this->isMotionDataReady())
@@ -192,6 +198,16 @@ void Filesystem::Run()
     }
 };
 
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if the loaded data was not checked yet
+ */
+bool Filesystem::isRunRequested()
+{
+    return this->initialDataRequested;
+};
+
 /**
  * @brief Returns the loaded FilesystemMotionData if 'motionDataReady' is true
  * 
@@ -203,6 +219,8 @@ FilesystemMotionData Filesystem::getMotionData()
     {
         return this->motionData;
     }
+
+    return {};
 };
 
 /**
@@ -216,6 +234,8 @@ FilesystemConfigurationData Filesystem::getConfigurationData()
     {
         return this->configurationData;
     }
+
+    return {};
 };
 
 /**
@@ -232,6 +252,8 @@ FilesystemSettingsStripData Filesystem::getSettingStripData(uint8_t stripID)
             return this->settingsStripData[stripID];
         }
     }
+
+    return {};
 };
 
 /**
@@ -248,6 +270,38 @@ FilesystemLEDStripData Filesystem::getLEDStripData(uint8_t stripID)
             return this->ledStripData[stripID];
         }
     }
+
+    return {};
+};
+
+/**
+ * @brief Returns the loaded FilesystemI2CLayoutData if 'i2cLayoutDataReady' is true
+ * 
+ * @return The loaded FilesystemI2CLayoutData from the filesystem
+ */
+FilesystemI2CLayoutData Filesystem::getI2CLayoutData()
+{
+    if (this->i2cLayoutDataReady)
+    {
+        return this->i2cLayoutData;
+    }
+
+    return {};
+};
+
+/**
+ * @brief Returns the loaded FilesystemGroupData if 'groupDataReady' is true
+ * 
+ * @return The loaded FilesystemGroupData from the filesystem
+ */
+FilesystemGroupData Filesystem::getGroupData()
+{
+    if (this->groupDataReady)
+    {
+        return this->groupData;
+    }
+
+    return {};
 };
 
 /**
@@ -414,6 +468,60 @@ void Filesystem::saveLEDStripData(uint8_t stripID, FilesystemLEDStripData data)
     }
 };
 
+/**
+ * @brief Saves the i2c layout data to the file on the filesystem
+ * 
+ * @param data The i2c layout data to save
+ */
+void Filesystem::saveI2CLayoutData(FilesystemI2CLayoutData data)
+{
+    Serial.println(F("Saving i2c layout data"));
+    Serial.println(F(""));
+
+    File file = LittleFS.open("/" + this->i2cLayoutDataFilename, "w");
+    if (!file)
+    {
+        Serial.println(F("Failed to open file for writing"));
+        return;
+    }
+    else
+    {
+        file.write((byte *)&data, sizeof(data));
+    }
+
+    delay(this->FILE_LAST_WRITE_DELAY);
+    file.close();
+    this->i2cLayoutData = data;
+    this->i2cLayoutDataReady = true;
+};
+
+/**
+ * @brief Saves the group data to the file on the filesystem
+ * 
+ * @param data The group data to save
+ */
+void Filesystem::saveGroupData(FilesystemGroupData data)
+{
+    Serial.println(F("Saving group data"));
+    Serial.println(F(""));
+
+    File file = LittleFS.open("/" + this->groupDataFilename, "w");
+    if (!file)
+    {
+        Serial.println(F("Failed to open file for writing"));
+        return;
+    }
+    else
+    {
+        file.write((byte *)&data, sizeof(data));
+    }
+
+    delay(this->FILE_LAST_WRITE_DELAY);
+    file.close();
+    this->groupData = data;
+    this->groupDataReady = true;
+};
+
 /**
  * @brief Loads the motion data from the file on the filesystem
  * 
@@ -573,6 +681,8 @@ FilesystemSettingsStripData Filesystem::loadSettingsStripData(uint8_t stripID)
         this->parameterhandler->updateSettingsStripParameter(stripID, data);
         return data;
     }
+
+    return {};
 };
 
 /**
@@ -606,6 +716,78 @@ FilesystemLEDStripData Filesystem::loadLEDStripData(uint8_t stripID)
         this->parameterhandler->updateLEDStripParameter(stripID, data);
         return data;
     }
+
+    return {};
+};
+
+/**
+ * @brief Loads the i2c layout data from the file on the filesystem
+ * 
+ * @return If the file exists the loaded i2c layout data from the file
+ */
+FilesystemI2CLayoutData Filesystem::loadI2CLayoutData()
+{
+    FilesystemI2CLayoutData data;
+    Serial.println(F("Loading i2c layout data"));
+
+    File file = LittleFS.open("/" + this->i2cLayoutDataFilename, "r");
+    if (!file)
+    {
+        Serial.println(F("Failed to open file for reading"));
+        return data;
+    }
+    else if (file.size() != sizeof(data))
+    {
+        // Empty on a new installation or written by an older firmware
+        file.close();
+        Serial.println(F("No valid i2c layout data found"));
+        return data;
+    }
+    else
+    {
+        file.read((byte *)&data, sizeof(data));
+    }
+
+    file.close();
+    this->i2cLayoutData = data;
+    this->i2cLayoutDataReady = true;
+    Serial.println(F("Loaded i2c layout data"));
+    return data;
+};
+
+/**
+ * @brief Loads the group data from the file on the filesystem
+ * 
+ * @return If the file exists the loaded group data from the file
+ */
+FilesystemGroupData Filesystem::loadGroupData()
+{
+    FilesystemGroupData data;
+    Serial.println(F("Loading group data"));
+
+    File file = LittleFS.open("/" + this->groupDataFilename, "r");
+    if (!file)
+    {
+        Serial.println(F("Failed to open file for reading"));
+        return data;
+    }
+    else if (file.size() != sizeof(data))
+    {
+        // Empty on a new installation => Member of no group
+        file.close();
+        Serial.println(F("No valid group data found"));
+        return data;
+    }
+    else
+    {
+        file.read((byte *)&data, sizeof(data));
+    }
+
+    file.close();
+    this->groupData = data;
+    this->groupDataReady = true;
+    Serial.println(F("Loaded group data"));
+    return data;
 };
 
 /**
@@ -691,6 +873,8 @@ bool Filesystem::isSettingsStripDataReady(uint8_t stripID)
     {
         return this->settingsStripDataReady[stripID];
     }
+
+    return false;
 }
 
 /**
@@ -717,6 +901,48 @@ bool Filesystem::isLEDStripDataReady(uint8_t stripID)
     {
         return this->ledStripDataReady[stripID];
     }
+
+    return false;
+}
+
+/**
+ * @brief Resets the i2c layout file on the filesystem and the i2c layout data. The bus gets scanned again on the next boot
+ * 
+ */
+void Filesystem::resetI2CLayoutData()
+{
+    this->resetFileIfExists(this->i2cLayoutDataFilename);
+    this->i2cLayoutData = {};
+    this->i2cLayoutDataReady = false;
+}
+
+/**
+ * 
+ * @return True the i2c layout data is ready (loaded / saved)
+ */
+bool Filesystem::isI2CLayoutDataReady()
+{
+    return this->i2cLayoutDataReady;
+}
+
+/**
+ * @brief Resets the group file on the filesystem and the group data => Member of no group
+ * 
+ */
+void Filesystem::resetGroupData()
+{
+    this->resetFileIfExists(this->groupDataFilename);
+    this->groupData = {};
+    this->groupDataReady = false;
+}
+
+/**
+ * 
+ * @return True the group data is ready (loaded / saved)
+ */
+bool Filesystem::isGroupDataReady()
+{
+    return this->groupDataReady;
 }
 
 /**
@@ -34,6 +34,7 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual bool isRunRequested();
 
     // ================ Data ================ //
 private:
@@ -61,8 +62,19 @@ private:
     FilesystemLEDStripData ledStripData[STRIP_COUNT]{};
     bool ledStripDataReady[STRIP_COUNT]{false};
 
+    // ======== I2C Layout ======== //
+    String i2cLayoutDataFilename = "I2CLayoutData.dat";
+    FilesystemI2CLayoutData i2cLayoutData = {};
+    bool i2cLayoutDataReady = false;
+
+    // ======== Group ======== //
+    String groupDataFilename = "GroupData.dat";
+    FilesystemGroupData groupData = {};
+    bool groupDataReady = false;
+
     // ======== Other ======== //
     uint state = 0;
+    bool initialDataRequested = false; // Loaded data gets checked once for a new installation
     const uint16_t FILE_LAST_WRITE_DELAY = 50;
 
     // ================ Methods ================ //
@@ -75,6 +87,10 @@ private:
     FilesystemSettingsStripData loadSettingsStripData(uint8_t stripID);
     // ======== LED State ======== //
     FilesystemLEDStripData loadLEDStripData(uint8_t stripID);
+    // ======== I2C Layout ======== //
+    FilesystemI2CLayoutData loadI2CLayoutData();
+    // ======== Group ======== //
+    FilesystemGroupData loadGroupData();
     // ======== File Operations ======== //
     void createFileIfMissing(String filename);
     void resetFileIfExists(String filename);
@@ -101,4 +117,14 @@ public:
     void saveLEDStripData(uint8_t stripID, FilesystemLEDStripData data);
     FilesystemLEDStripData getLEDStripData(uint8_t stripID);
     bool isLEDStripDataReady(uint8_t stripID);
+    // ======== I2C Layout Data ======== //
+    void resetI2CLayoutData();
+    void saveI2CLayoutData(FilesystemI2CLayoutData data);
+    FilesystemI2CLayoutData getI2CLayoutData();
+    bool isI2CLayoutDataReady();
+    // ======== Group Data ======== //
+    void resetGroupData();
+    void saveGroupData(FilesystemGroupData data);
+    FilesystemGroupData getGroupData();
+    bool isGroupDataReady();
 };
@@ -11,7 +11,10 @@ Helper::Helper(){
 /**
  * @brief Sets the needed refernce for the helper
  */
-void Helper::setReference(){};
+void Helper::setReference(ITimeSource *clock)
+{
+    this->clock = clock;
+};
 
 /**
  * @brief Initializes the helper component
@@ -47,6 +50,16 @@ void Helper::Run()
     }
 };
 
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool Helper::isRunRequested()
+{
+    return false; // Only used by other components
+};
+
 /**
  * @brief Converts the uint8_t value to an ENUM LEDOutputType
  * 
@@ -270,26 +283,28 @@ String Helper::SingleLEDEffectToString(SingleLEDEffect effect)
  * @brief Converts a string to a LEDEffect
  * 
  * @param effect The name of effect as string
- * @return The corresponding LEDEffect to the given string effect 
+ * @param value  Gets the corresponding LEDEffect. Stays unchanged for an unknown name
+ * @return True if the name is known, false if not
  */
-SingleLEDEffect Helper::StringToSingleLEDEffect(String effect)
+bool Helper::StringToSingleLEDEffect(const char *effect, SingleLEDEffect &value)
 {
-    if (effect == "None")
+    if (strcmp(effect, "None") == 0)
     {
-        return SingleLEDEffect::None;
+        value = SingleLEDEffect::None;
     }
-    else if (effect == "TriplePulse")
+    else if (strcmp(effect, "TriplePulse") == 0)
     {
-        return SingleLEDEffect::TriplePulse;
+        value = SingleLEDEffect::TriplePulse;
     }
-    else if (effect == "Rainbow")
+    else if (strcmp(effect, "Rainbow") == 0)
     {
-        return SingleLEDEffect::Rainbow;
+        value = SingleLEDEffect::Rainbow;
     }
-    else // default
+    else
     {
-        return SingleLEDEffect::None;
+        return false;
     }
+    return true;
 };
 
 /**
@@ -362,6 +377,130 @@ String Helper::FadeCurveToString(FadeCurve curve)
     }
 };
 
+/**
+ * @brief Converts a String to a FadeCurve
+ * 
+ * @param curve The String to convert to FadeCurve
+ * @param value Gets the corresponding FadeCurve. Stays unchanged for an unknown name
+ * @return True if the name is known, false if not
+ */
+bool Helper::StringToFadeCurve(const char *curve, FadeCurve &value)
+{
+    if (strcmp(curve, "None") == 0)
+    {
+        value = FadeCurve::None;
+    }
+    else if (strcmp(curve, "Linear") == 0)
+    {
+        value = FadeCurve::Linear;
+    }
+    else if (strcmp(curve, "EaseIn") == 0)
+    {
+        value = FadeCurve::EaseIn;
+    }
+    else if (strcmp(curve, "EaseOut") == 0)
+    {
+        value = FadeCurve::EaseOut;
+    }
+    else if (strcmp(curve, "EaseInOut") == 0)
+    {
+        value = FadeCurve::EaseInOut;
+    }
+    else
+    {
+        return false;
+    }
+    return true;
+};
+
+/**
+ * @brief Converts a ProfilerComponent to a String
+ * 
+ * @param component The ProfilerComponent to convert to string
+ * @return The corresponding string name to the given ProfilerComponent
+ */
+String Helper::ProfilerComponentToString(ProfilerComponent component)
+{
+    switch (component)
+    {
+    case ProfilerComponent::OTA:
+        return "OTA";
+        break;
+
+    case ProfilerComponent::I2C:
+        return "I2C";
+        break;
+
+    case ProfilerComponent::Network:
+        return "Network";
+        break;
+
+    case ProfilerComponent::PowerMeasurement:
+        return "PowerMeasurement";
+        break;
+
+    case ProfilerComponent::LedDriver:
+        return "LedDriver";
+        break;
+
+    case ProfilerComponent::Information:
+        return "Information";
+        break;
+
+    case ProfilerComponent::PirReader:
+        return "PirReader";
+        break;
+
+    case ProfilerComponent::Webserver:
+        return "Webserver";
+        break;
+
+    case ProfilerComponent::Helper:
+        return "Helper";
+        break;
+
+    case ProfilerComponent::Filesystem:
+        return "Filesystem";
+        break;
+
+    case ProfilerComponent::Parameterhandler:
+        return "Parameterhandler";
+        break;
+
+    case ProfilerComponent::Profiler:
+        return "Profiler";
+        break;
+
+    case ProfilerComponent::MotionEvent:
+        return "MotionEvent";
+        break;
+
+    case ProfilerComponent::CommandMQTT:
+        return "CommandMQTT";
+        break;
+
+    case ProfilerComponent::CommandWebSocket:
+        return "CommandWebSocket";
+        break;
+
+    case ProfilerComponent::Realtime:
+        return "Realtime";
+        break;
+
+    case ProfilerComponent::SharedClock:
+        return "SharedClock";
+        break;
+
+    case ProfilerComponent::Loop:
+        return "Loop";
+        break;
+
+    default:
+        return "Unknown";
+        break;
+    }
+};
+
 /**
  * @brief Prints a string message with length of insertLength * spaces to serial
  * 
@@ -374,6 +513,34 @@ void Helper::InsertPrint()
     }
 };
 
+/**
+ * @brief Converts a realtime protocol to a string
+ * 
+ * @param protocol The realtime protocol to convert
+ * @return The name of the realtime protocol
+ */
+String Helper::RealtimeProtocolToString(RealtimeProtocol protocol)
+{
+    switch (protocol)
+    {
+    case RealtimeProtocol::None:
+        return "None";
+        break;
+
+    case RealtimeProtocol::DDP:
+        return "DDP";
+        break;
+
+    case RealtimeProtocol::E131:
+        return "E1.31";
+        break;
+
+    default:
+        return "Unknown";
+        break;
+    }
+};
+
 String Helper::LEDOutputTypeToString(LEDOutputType type)
 {
     String msg = "";
@@ -508,9 +675,9 @@ uint8_t Helper::MultiLEDEffectToUint8(MultiLEDEffect effect)
  */
 void Helper::blinkOnBoardLED(uint16_t interval)
 {
-    if (millis() >= (this->prevMillisBlinkOnBoardLED + interval))
+    if (this->clock->Millis() >= (this->prevMillisBlinkOnBoardLED + interval))
     {
-        this->prevMillisBlinkOnBoardLED = millis();
+        this->prevMillisBlinkOnBoardLED = this->clock->Millis();
         this->onboardLEDState = !this->onboardLEDState;
         if (this->onboardLEDState)
         {
@@ -7,6 +7,7 @@
 
 // ================================ INTERFACES ================================ //
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
 
 // ================================ CLASS ================================ //
 /**
@@ -17,7 +18,7 @@ class Helper : public IBaseClass
     // ================ Constructor / Reference ================ //
 public:
     Helper();
-    void setReference();
+    void setReference(ITimeSource *clock);
     bool init = false;
 
     // ================ Interface ================ //
@@ -25,12 +26,14 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual bool isRunRequested();
     // ================ Data ================ //
     // ======== OnBoard LED ======== //
     bool onboardLEDState = false;
     unsigned long prevMillisBlinkOnBoardLED = 0;
 
 private:
+    ITimeSource *clock;
     const String symbol = "=";
     const uint8_t spacerLength = 45; // x * Spaces
     const uint8_t insertLength = 3;  // x * Spaces
@@ -54,7 +57,7 @@ public:
     uint8_t MultiLEDEffectToUint8(MultiLEDEffect effect);
     // == SingleLEDEffect
     String SingleLEDEffectToString(SingleLEDEffect effect);
-    SingleLEDEffect StringToSingleLEDEffect(String effect);
+    bool StringToSingleLEDEffect(const char *effect, SingleLEDEffect &value);
     uint8_t SingleLEDEffectToUint8(SingleLEDEffect value);
     // == LEDOutputType
     String LEDOutputTypeToString(LEDOutputType type);
@@ -62,8 +65,13 @@ public:
     uint8_t LEDOutputTypeToUint8(LEDOutputType type);
     // == FadeCurve
     String FadeCurveToString(FadeCurve curve);
+    bool StringToFadeCurve(const char *curve, FadeCurve &value);
     FadeCurve Uint8ToFadeCurve(uint8_t value);
     uint8_t FadeCurveToUint8(FadeCurve type);
+    // == ProfilerComponent
+    String ProfilerComponentToString(ProfilerComponent component);
+    // == RealtimeProtocol
+    String RealtimeProtocolToString(RealtimeProtocol protocol);
     // == Other
     String BoolToString(bool b);
     String BollToConnectionState(bool b);
@@ -1,17 +1,29 @@
 #include "I2C.h"
 
 /**
- * Empty constructor
+ * Constructor for the I2C class
+ * 
+ * @parameter clockSpeed    The requested bus clock speed. Falls back to a slower speed if the self test fails
  */
-I2C::I2C()
+I2C::I2C(I2CClockSpeed clockSpeed)
 {
+    this->clockSpeed = clockSpeed;
 };
 
 /**
  * Sets reference to external components
+ * 
+ * @parameter bus           The bus the transactions get send on. Either the hardware bus or a mock
+ * @parameter filesystem    The filesystem the discovered device layout gets cached in
+ * @parameter clock         The time source of the controller
  */
-void I2C::setReference()
+void I2C::setReference(II2CBus *bus,
+                       Filesystem *filesystem,
+                       ITimeSource *clock)
 {
+    this->bus = bus;
+    this->filesystem = filesystem;
+    this->clock = clock;
 };
 
 /**
@@ -23,7 +35,40 @@ bool I2C::Init()
 {
     if (!init)
     {
-        Wire.begin();
+        this->bus->Begin();
+
+        // ==== Find the devices on the bus at the slowest clock speed
+        ApplyClockSpeed(I2CClockSpeed::StandardMode);
+        if (!LoadLayout())
+        {
+            ScanLayout();
+        }
+        PrintLayout();
+
+        // ==== Find the fastest clock speed at which all devices respond
+        I2CClockSpeed speed = this->clockSpeed;
+        while (!SelfTest(speed))
+        {
+            if (speed == I2CClockSpeed::FastModePlus)
+            {
+                speed = I2CClockSpeed::FastMode;
+            }
+            else if (speed == I2CClockSpeed::FastMode)
+            {
+                speed = I2CClockSpeed::StandardMode;
+            }
+            else
+            {
+                Serial.println(F("I2C self test failed at the slowest clock speed!"));
+                break;
+            }
+        }
+        ApplyClockSpeed(speed);
+
+        Serial.print(F("I2C clock speed set to '"));
+        Serial.print(ClockSpeedToFrequency(this->activeClockSpeed));
+        Serial.println(F("' Hz"));
+
         Serial.println(F("I2C initialized"));
         init = true;
     }
@@ -32,10 +77,72 @@ bool I2C::Init()
 };
 
 /**
- * Runs the I2C component. !! Not used for now !!
+ * Runs the I2C component. Supervises the error rate of the bus and falls back to a slower clock speed if needed
+ */
+void I2C::Run()
+{
+    if (!init)
+    {
+        return;
+    }
+
+    unsigned long curMillis = this->clock->Millis();
+    if (curMillis - this->prevMillisErrorRateWindow >= this->TimeOut_ErrorRateWindow)
+    {
+        this->prevMillisErrorRateWindow = curMillis;
+
+        if (this->windowTransmissionCount >= this->ERROR_RATE_MIN_TRANSMISSIONS)
+        {
+            uint32_t errorRatePercent = ((uint32_t)this->windowErrorCount * 100) / this->windowTransmissionCount;
+            if (errorRatePercent >= this->ERROR_RATE_FALLBACK_PERCENT)
+            {
+                FallbackClockSpeed();
+            }
+        }
+
+        this->windowTransmissionCount = 0;
+        this->windowErrorCount = 0;
+    }
+};
+
+/**
+ * @brief Returns the time between two Run calls
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t I2C::getRunPeriod()
+{
+    return 100000; // 100 ms => Error rate window is checked in between
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority I2C::getRunPriority()
+{
+    return SchedulerPriority::Low;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
  */
-void I2C::Run(){
+uint32_t I2C::getRunBudget()
+{
+    return 200;
+};
 
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool I2C::isRunRequested()
+{
+    return init;
 };
 
 /**
@@ -50,24 +157,20 @@ uint8_t I2C::read8(uint8_t i2cAddress,
                    uint8_t regAddress)
 {
     // Send register data request to i2c device
-    Wire.beginTransmission(i2cAddress);
-    Wire.write(regAddress);
-    uint8_t result = Wire.endTransmission();
-    bool transmissionGood = checkTransmissionError(result);
+    bool transmissionGood = Transmit(i2cAddress, &regAddress, 1);
 
     // Check if transmission was good
     if (transmissionGood)
     {
         // Request data from i2c device
-        Wire.requestFrom(i2cAddress, (uint8_t)1);
-        int data = Wire.read();
-        if (data == -1)
+        uint8_t data = 0;
+        if (this->bus->Receive(i2cAddress, &data, 1) != 1)
         {
             return 0;
         }
         else
         {
-            return (uint8_t)data;
+            return data;
         }
     }
     else
@@ -87,26 +190,20 @@ uint8_t I2C::read8(uint8_t i2cAddress,
 uint16_t I2C::read16(uint8_t i2cAddress,
                      uint8_t regAddress)
 {
-    Wire.beginTransmission(i2cAddress);
-    Wire.write(regAddress);
-    uint8_t result = Wire.endTransmission();
-    bool transmissionGood = checkTransmissionError(result);
+    bool transmissionGood = Transmit(i2cAddress, &regAddress, 1);
 
     // Check if transmission was good
     if (transmissionGood)
     {
         // Request data from i2c device
-        Wire.requestFrom((uint8_t)i2cAddress, (uint8_t)2);
-        int MSB = Wire.read();
-        int LSB = Wire.read();
-
-        if (MSB == -1 || LSB == -1)
+        uint8_t data[2] = {0, 0};
+        if (this->bus->Receive(i2cAddress, data, 2) != 2)
         {
             return 0;
         }
         else
         {
-            uint16_t value = (((uint8_t)MSB << 8) | (uint8_t)LSB);
+            uint16_t value = ((uint16_t)data[0] << 8) | data[1];
             return value;
         }
     }
@@ -129,11 +226,8 @@ bool I2C::write8(uint8_t i2cAddres,
                  uint8_t regAddress,
                  uint8_t data)
 {
-    Wire.beginTransmission(i2cAddres);
-    Wire.write(regAddress);
-    Wire.write(data);
-    uint8_t result = Wire.endTransmission();
-    return checkTransmissionError(result);
+    uint8_t buffer[2] = {regAddress, data};
+    return Transmit(i2cAddres, buffer, 2);
 };
 
 /**
@@ -149,16 +243,60 @@ bool I2C::write16(uint8_t i2cAddres,
                   uint8_t regAddress,
                   uint16_t data)
 {
-    Wire.beginTransmission(i2cAddres);
-    Wire.write(regAddress);
-    Wire.write(highByte(data));
-    Wire.write(lowByte(data));
-    uint8_t result = Wire.endTransmission();
-    return checkTransmissionError(result);
+    uint8_t buffer[3] = {regAddress, highByte(data), lowByte(data)};
+    return Transmit(i2cAddres, buffer, 3);
+};
+
+/**
+ * Sends data to a i2c device. Retries failed transmissions with a growing backoff
+ * and recovers the bus if all retries failed because of a stuck bus. A NACK means the bus works => No recovery
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * @parameter data          Pointer to the data to send
+ * @parameter length        The number of bytes to send
+ * 
+ * @return True if successfull, false if not
+ **/
+bool I2C::Transmit(uint8_t i2cAddress,
+                   const uint8_t *data,
+                   uint8_t length)
+{
+    uint16_t backoff = this->TRANSMISSION_RETRY_BACKOFF_US;
+    uint8_t result = 0;
+
+    for (uint8_t attempt = 0; attempt <= this->TRANSMISSION_RETRY_COUNT; attempt++)
+    {
+        result = this->bus->Transmit(i2cAddress, data, length);
+        if (checkTransmissionError(result))
+        {
+            return true;
+        }
+
+        // Retrying wont help if the data does not fit into the transmit buffer
+        if (result == 1)
+        {
+            return false;
+        }
+
+        if (attempt < this->TRANSMISSION_RETRY_COUNT)
+        {
+            delayMicroseconds(backoff);
+            backoff *= 2;
+        }
+    }
+
+    // All retries failed => Only a line held low or a bus error (4 other error, 5 timeout) needs the recovery
+    if (result >= 4 || this->bus->isStuck())
+    {
+        RecoverBus();
+    }
+
+    return false;
 };
 
 /**
  * Checks for errors in the result of a Wire.endTransmission()
+ * Counts every error per error code and prints at most one message per log interval
  * 
  * @parameter result The result of the Wire.endTransmission()
  * 
@@ -166,28 +304,491 @@ bool I2C::write16(uint8_t i2cAddres,
  */
 bool I2C::checkTransmissionError(uint8_t result)
 {
-    bool success = false;
+    this->transmissionCount++;
+    this->windowTransmissionCount++;
+
+    if (result == 0)
+    {
+        return true;
+    }
+
+    // Unknown codes are counted as other error
+    if (result >= I2C_ERROR_CODE_COUNT)
+    {
+        result = I2C_ERROR_CODE_COUNT - 1;
+    }
+
+    this->transmissionErrorCount++;
+    this->windowErrorCount++;
+    this->errorCodeCount[result]++;
+
+    // Rate limited error print
+    unsigned long curMillis = this->clock->Millis();
+    if (curMillis - this->prevMillisErrorPrint < this->TimeOut_ErrorPrint)
+    {
+        this->suppressedErrorPrintCount++;
+        return false;
+    }
+    this->prevMillisErrorPrint = curMillis;
+
     switch (result)
     {
-    case 0:
-        success = true;
-        break;
     case 1:
-        Serial.println(F("I2C Write ERROR! => data too long to fit in transmit buffer"));
-        success = false;
+        Serial.print(F("I2C Write ERROR! => data too long to fit in transmit buffer"));
         break;
     case 2:
-        Serial.println(F("I2C Write ERROR! => received NACK on transmit of address"));
-        success = false;
+        Serial.print(F("I2C Write ERROR! => received NACK on transmit of address"));
         break;
     case 3:
-        Serial.println(F("I2C Write ERROR! => received NACK on transmit of data"));
-        success = false;
+        Serial.print(F("I2C Write ERROR! => received NACK on transmit of data"));
         break;
-    case 4:
-        Serial.println(F("I2C Write ERROR! => other error"));
-        success = false;
+    default:
+        Serial.print(F("I2C Write ERROR! => other error"));
         break;
     }
-    return success;
+    if (this->suppressedErrorPrintCount > 0)
+    {
+        Serial.print(F(" ("));
+        Serial.print(this->suppressedErrorPrintCount);
+        Serial.print(F(" more errors suppressed)"));
+        this->suppressedErrorPrintCount = 0;
+    }
+    Serial.println("");
+
+    return false;
+};
+
+/**
+ * Frees the bus from a device that holds SDA low and restarts it with the active clock speed.
+ * At most one recovery per TimeOut_BusRecovery => A dead device does not stall every transmission with the clocking
+ **/
+void I2C::RecoverBus()
+{
+    unsigned long curMillis = this->clock->Millis();
+    if (this->busRecovered && curMillis - this->prevMillisBusRecovery < this->TimeOut_BusRecovery)
+    {
+        return;
+    }
+    this->busRecovered = true;
+    this->prevMillisBusRecovery = curMillis;
+    this->busRecoveryCount++;
+
+    this->bus->Recover();
+
+    if (curMillis - this->prevMillisErrorPrint >= this->TimeOut_ErrorPrint)
+    {
+        this->prevMillisErrorPrint = curMillis;
+        Serial.println(F("I2C bus recovered"));
+    }
+};
+
+/**
+ * Loads the device layout cached in the filesystem, checks if all cached devices still respond
+ * and probes the PCA9685 address range for devices added since the layout got cached
+ * 
+ * @return True if the cached layout is valid, false if the bus needs to be scanned
+ */
+bool I2C::LoadLayout()
+{
+    if (!this->filesystem->isI2CLayoutDataReady())
+    {
+        return false;
+    }
+
+    FilesystemI2CLayoutData data = this->filesystem->getI2CLayoutData();
+    if (!data.isConfigured || data.PwmDeviceCount > I2C_MAX_PWM_DEVICE_COUNT)
+    {
+        return false;
+    }
+
+    for (uint8_t i = 0; i < data.PwmDeviceCount; i++)
+    {
+        if (!ProbeDevice(data.PwmAddress[i]))
+        {
+            Serial.println(F("Cached I2C layout does not match the bus => Scanning bus"));
+            return false;
+        }
+    }
+    if (data.PowerMeasurementPresent && !ProbeDevice(data.PowerMeasurementAddress))
+    {
+        Serial.println(F("Cached I2C layout does not match the bus => Scanning bus"));
+        return false;
+    }
+
+    this->layout = data;
+
+    // A PCA9685 added to the board only shows up on a probe of its address. The INA219 range 0x40 - 0x4F lies within
+    for (uint8_t i2cAddress = this->PCA9685_FIRST_ADDRESS; i2cAddress <= this->PCA9685_LAST_ADDRESS; i2cAddress++)
+    {
+        if (i2cAddress != this->PCA9685_ALL_CALL_ADDRESS && !isCachedAddress(i2cAddress) && ProbeDevice(i2cAddress))
+        {
+            Serial.print(F("Uncached I2C device at 0x"));
+            Serial.print(i2cAddress, HEX);
+            Serial.println(F(" => Scanning bus"));
+            this->layout = {};
+            return false;
+        }
+    }
+
+    Serial.println(F("Using cached I2C layout"));
+
+    return true;
+};
+
+/**
+ * Checks if an address belongs to a device of the current layout or to a device the layout ignores
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * 
+ * @return True if the address is in the layout, false if not
+ */
+bool I2C::isCachedAddress(uint8_t i2cAddress)
+{
+    for (uint8_t i = 0; i < this->layout.PwmDeviceCount; i++)
+    {
+        if (this->layout.PwmAddress[i] == i2cAddress)
+        {
+            return true;
+        }
+    }
+
+    if (i2cAddress >= this->PCA9685_FIRST_ADDRESS && i2cAddress <= this->PCA9685_LAST_ADDRESS)
+    {
+        uint8_t bit = i2cAddress - this->PCA9685_FIRST_ADDRESS;
+        if (this->layout.IgnoredAddress[bit / 8] & (1 << (bit % 8)))
+        {
+            return true;
+        }
+    }
+
+    return this->layout.PowerMeasurementPresent && this->layout.PowerMeasurementAddress == i2cAddress;
+};
+
+/**
+ * Remembers a device the layout does not use, so its address does not trigger a scan on the next boot.
+ * Only the probed PCA9685 range needs it
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ */
+void I2C::IgnoreAddress(uint8_t i2cAddress)
+{
+    if (i2cAddress >= this->PCA9685_FIRST_ADDRESS && i2cAddress <= this->PCA9685_LAST_ADDRESS)
+    {
+        uint8_t bit = i2cAddress - this->PCA9685_FIRST_ADDRESS;
+        this->layout.IgnoredAddress[bit / 8] |= 1 << (bit % 8);
+    }
+};
+
+/**
+ * Scans all addresses of the bus, identifies the responding devices by their register signature
+ * and caches the found layout in the filesystem
+ */
+void I2C::ScanLayout()
+{
+    Serial.println(F("Scanning I2C bus"));
+    this->layout = {};
+
+    for (uint8_t i2cAddress = this->SCAN_FIRST_ADDRESS; i2cAddress <= this->SCAN_LAST_ADDRESS; i2cAddress++)
+    {
+        if (i2cAddress == this->PCA9685_ALL_CALL_ADDRESS || !ProbeDevice(i2cAddress))
+        {
+            continue;
+        }
+
+        switch (IdentifyDevice(i2cAddress))
+        {
+        case I2CDeviceType::PCA9685:
+            if (this->layout.PwmDeviceCount < I2C_MAX_PWM_DEVICE_COUNT)
+            {
+                this->layout.PwmAddress[this->layout.PwmDeviceCount] = i2cAddress;
+                this->layout.PwmDeviceCount++;
+            }
+            else
+            {
+                Serial.print(F("Ignoring PCA9685 at 0x"));
+                Serial.print(i2cAddress, HEX);
+                Serial.println(F(" => Too many pwm devices"));
+                IgnoreAddress(i2cAddress);
+            }
+            break;
+
+        case I2CDeviceType::INA219:
+            if (!this->layout.PowerMeasurementPresent)
+            {
+                this->layout.PowerMeasurementAddress = i2cAddress;
+                this->layout.PowerMeasurementPresent = true;
+            }
+            else
+            {
+                IgnoreAddress(i2cAddress);
+            }
+            break;
+
+        default:
+            Serial.print(F("Unknown I2C device at 0x"));
+            Serial.println(i2cAddress, HEX);
+            IgnoreAddress(i2cAddress);
+            break;
+        }
+    }
+
+    // ==== Cache layout so the next boot can skip the scan. Unchanged => No flash write
+    if (this->filesystem->init)
+    {
+        FilesystemI2CLayoutData data = {};
+        for (uint8_t i = 0; i < I2C_MAX_PWM_DEVICE_COUNT; i++)
+        {
+            data.PwmAddress[i] = this->layout.PwmAddress[i];
+        }
+        data.PwmDeviceCount = this->layout.PwmDeviceCount;
+        data.PowerMeasurementAddress = this->layout.PowerMeasurementAddress;
+        data.PowerMeasurementPresent = this->layout.PowerMeasurementPresent;
+        for (uint8_t i = 0; i < I2C_IGNORED_ADDRESS_BYTES; i++)
+        {
+            data.IgnoredAddress[i] = this->layout.IgnoredAddress[i];
+        }
+        data.isConfigured = true;
+
+        FilesystemI2CLayoutData cachedData = this->filesystem->getI2CLayoutData();
+        if (!this->filesystem->isI2CLayoutDataReady() || memcmp(&data, &cachedData, sizeof(data)) != 0)
+        {
+            this->filesystem->saveI2CLayoutData(data);
+        }
+    }
+};
+
+/**
+ * Identifies a device by registers that hold fixed values
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * 
+ * @return The type of the device or unknown if no signature matched
+ */
+I2CDeviceType I2C::IdentifyDevice(uint8_t i2cAddress)
+{
+    // PCA9685 => The all call address register keeps its power on value
+    if (read8(i2cAddress, ALLCALLADR) == this->PCA9685_ALLCALLADR_VALUE)
+    {
+        return I2CDeviceType::PCA9685;
+    }
+
+    // INA219 => Bit 14 of the config register and bit 0 of the calibration register always read 0
+    uint16_t configRegister = read16(i2cAddress, CONFIG);
+    uint16_t calibrationRegister = read16(i2cAddress, CALIBRATION);
+    if (configRegister != 0 && (configRegister & 0x4000) == 0 && (calibrationRegister & 0x0001) == 0)
+    {
+        return I2CDeviceType::INA219;
+    }
+
+    return I2CDeviceType::Unknown;
+};
+
+/**
+ * Prints the device layout of the bus
+ */
+void I2C::PrintLayout()
+{
+    for (uint8_t i = 0; i < this->layout.PwmDeviceCount; i++)
+    {
+        Serial.print(F("Found PCA9685 at 0x"));
+        Serial.println(this->layout.PwmAddress[i], HEX);
+    }
+    if (this->layout.PowerMeasurementPresent)
+    {
+        Serial.print(F("Found INA219 at 0x"));
+        Serial.println(this->layout.PowerMeasurementAddress, HEX);
+    }
+    if (this->layout.PwmDeviceCount == 0 && !this->layout.PowerMeasurementPresent)
+    {
+        Serial.println(F("No I2C devices found!"));
+    }
+};
+
+/**
+ * Runs the self test of the bus at the given clock speed
+ * 
+ * @parameter speed The clock speed to test
+ * 
+ * @return True if all devices responded to every probe, false if not
+ */
+bool I2C::SelfTest(I2CClockSpeed speed)
+{
+    this->bus->SetClock(ClockSpeedToFrequency(speed));
+
+    for (uint8_t i = 0; i < this->SELF_TEST_PROBE_COUNT; i++)
+    {
+        for (uint8_t j = 0; j < this->layout.PwmDeviceCount; j++)
+        {
+            if (!ProbeDevice(this->layout.PwmAddress[j]))
+            {
+                return false;
+            }
+        }
+        if (this->layout.PowerMeasurementPresent && !ProbeDevice(this->layout.PowerMeasurementAddress))
+        {
+            return false;
+        }
+    }
+
+    return true;
+};
+
+/**
+ * Checks if a device acknowledges its address on the bus
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * 
+ * @return True if the device acknowledged, false if not
+ */
+bool I2C::ProbeDevice(uint8_t i2cAddress)
+{
+    return this->bus->Transmit(i2cAddress, nullptr, 0) == 0;
+};
+
+/**
+ * Sets the clock speed of the bus
+ * 
+ * @parameter speed The clock speed to use
+ */
+void I2C::ApplyClockSpeed(I2CClockSpeed speed)
+{
+    this->activeClockSpeed = speed;
+    this->bus->SetClock(ClockSpeedToFrequency(speed));
+};
+
+/**
+ * Switches the bus to the next slower clock speed
+ * 
+ * @return True if the clock speed got lowered, false if already at the slowest clock speed
+ */
+bool I2C::FallbackClockSpeed()
+{
+    switch (this->activeClockSpeed)
+    {
+    case I2CClockSpeed::FastModePlus:
+        ApplyClockSpeed(I2CClockSpeed::FastMode);
+        break;
+
+    case I2CClockSpeed::FastMode:
+        ApplyClockSpeed(I2CClockSpeed::StandardMode);
+        break;
+
+    default:
+        return false;
+    }
+
+    Serial.print(F("I2C error rate too high! => Clock speed lowered to '"));
+    Serial.print(ClockSpeedToFrequency(this->activeClockSpeed));
+    Serial.println(F("' Hz"));
+
+    return true;
+};
+
+/**
+ * Returns the bus frequency of the given clock speed
+ * 
+ * @parameter speed The clock speed
+ * 
+ * @return The frequency in Hz
+ */
+uint32_t I2C::ClockSpeedToFrequency(I2CClockSpeed speed)
+{
+    switch (speed)
+    {
+    case I2CClockSpeed::FastModePlus:
+        return 1000000;
+
+    case I2CClockSpeed::FastMode:
+        return 400000;
+
+    case I2CClockSpeed::StandardMode:
+    default:
+        return 100000;
+    }
+};
+
+/**
+ * @return The number of PCA9685 found on the bus
+ */
+uint8_t I2C::getPwmDeviceCount()
+{
+    return this->layout.PwmDeviceCount;
+};
+
+/**
+ * @parameter index The index of the PCA9685 in order of ascending addresses
+ * 
+ * @return The address of the PCA9685, or 0 if there is no device with the given index
+ */
+uint8_t I2C::getPwmAddress(uint8_t index)
+{
+    if (index < this->layout.PwmDeviceCount)
+    {
+        return this->layout.PwmAddress[index];
+    }
+
+    return 0;
+};
+
+/**
+ * @return True if a INA219 was found on the bus
+ */
+bool I2C::isPowerMeasurementPresent()
+{
+    return this->layout.PowerMeasurementPresent;
+};
+
+/**
+ * @return The address of the INA219, or 0 if none was found
+ */
+uint8_t I2C::getPowerMeasurementAddress()
+{
+    return this->layout.PowerMeasurementAddress;
+};
+
+/**
+ * @return The clock speed that is currently used on the bus
+ */
+I2CClockSpeed I2C::getActiveClockSpeed()
+{
+    return this->activeClockSpeed;
+};
+
+/**
+ * @return The number of transmissions since startup
+ */
+uint32_t I2C::getTransmissionCount()
+{
+    return this->transmissionCount;
+};
+
+/**
+ * @return The number of failed transmissions since startup
+ */
+uint32_t I2C::getTransmissionErrorCount()
+{
+    return this->transmissionErrorCount;
+};
+
+/**
+ * @parameter errorCode The error code of the Wire.endTransmission()
+ * 
+ * @return The number of failed transmissions with the given error code since startup
+ */
+uint32_t I2C::getErrorCodeCount(uint8_t errorCode)
+{
+    if (errorCode < I2C_ERROR_CODE_COUNT)
+    {
+        return this->errorCodeCount[errorCode];
+    }
+
+    return 0;
+};
+
+/**
+ * @return The number of bus recoveries since startup
+ */
+uint32_t I2C::getBusRecoveryCount()
+{
+    return this->busRecoveryCount;
 };
\ No newline at end of file
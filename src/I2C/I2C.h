@@ -2,18 +2,30 @@
 
 // Includes
 #include <Arduino.h>
-#include <Wire.h>
+#include "../Enums/Enums.h"
+#include "../Constants/Constants.h"
+#include "../Structs/Structs.h"
+#include "../Filesystem/Filesystem.h"
+#include "../Register/PCA9685_LED_Reg.h"
+#include "../Register/INA219AIDR_Reg.h"
 
 // Interface
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+#include "../Interface/II2CBus.h"
+
+// Blueprint for compiler. Problem => circular dependency
+class Filesystem;
 
 // Classes
 class I2C : public IBaseClass
 {
     // ## Constructor / Important ## //
 public:
-    I2C();
-    void setReference();
+    I2C(I2CClockSpeed clockSpeed);
+    void setReference(II2CBus *bus,
+                      Filesystem *filesystem,
+                      ITimeSource *clock);
     bool init = false;
 
     // ## Interface ## //
@@ -21,13 +33,80 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+    virtual bool isRunRequested();
 
     // ## Data ## //
 private:
+    II2CBus *bus;
+    Filesystem *filesystem;
+    ITimeSource *clock;
+
+    // ---- Clock
+    I2CClockSpeed clockSpeed = I2CClockSpeed::StandardMode;       // The requested clock speed
+    I2CClockSpeed activeClockSpeed = I2CClockSpeed::StandardMode; // The clock speed that is currently used on the bus
+
+    // ---- Device discovery
+    I2CLayoutParameter layout = {};
+    const uint8_t SCAN_FIRST_ADDRESS = 0x08;       // Addresses below are reserved
+    const uint8_t SCAN_LAST_ADDRESS = 0x77;        // Addresses above are reserved
+    const uint8_t PCA9685_ALL_CALL_ADDRESS = 0x70; // Every PCA9685 acknowledges its default all call address
+    const uint8_t PCA9685_FIRST_ADDRESS = 0x40;    // Address range of the PCA9685 (A5 - A0), probed on every boot
+    const uint8_t PCA9685_LAST_ADDRESS = 0x77;     // 0x78 - 0x7F are reserved on the bus
+    const uint8_t PCA9685_ALLCALLADR_VALUE = 0xE0; // Power on value of the ALLCALLADR register. Never changed by the LedDriver
+
+    // ---- Self test
+    const uint8_t SELF_TEST_PROBE_COUNT = 10; // Probes per device and clock speed
+
+    // ---- Error rate supervision
+    unsigned long prevMillisErrorRateWindow = 0;
+    const unsigned long TimeOut_ErrorRateWindow = 1000; // 1 sec
+    const uint16_t ERROR_RATE_MIN_TRANSMISSIONS = 20;   // Minimum transmissions in one window before the rate gets evaluated
+    const uint8_t ERROR_RATE_FALLBACK_PERCENT = 5;      // Error rate in percent that triggers a fallback to a slower clock
+    uint16_t windowTransmissionCount = 0;
+    uint16_t windowErrorCount = 0;
+
+    // ---- Retry
+    const uint8_t TRANSMISSION_RETRY_COUNT = 2;        // Retries after the first failed transmission
+    const uint16_t TRANSMISSION_RETRY_BACKOFF_US = 50; // Wait time before the first retry. Doubles with every retry
+
+    // ---- Bus recovery
+    unsigned long prevMillisBusRecovery = 0;
+    bool busRecovered = false;                      // False until the first recovery => The first one never waits
+    const unsigned long TimeOut_BusRecovery = 1000; // 1 sec between two recoveries
+
+    // ---- Error print
+    unsigned long prevMillisErrorPrint = 0;
+    const unsigned long TimeOut_ErrorPrint = 1000; // 1 sec
+    uint32_t suppressedErrorPrintCount = 0;
+
+    // ---- Statistics
+    uint32_t transmissionCount = 0;
+    uint32_t transmissionErrorCount = 0;
+    uint32_t errorCodeCount[I2C_ERROR_CODE_COUNT]{0};
+    uint32_t busRecoveryCount = 0;
+
 public:
     // ## Functions ## //
 private:
+    bool Transmit(uint8_t i2cAddress,
+                  const uint8_t *data,
+                  uint8_t length);
     bool checkTransmissionError(uint8_t result);
+    void RecoverBus();
+    bool LoadLayout();
+    bool isCachedAddress(uint8_t i2cAddress);
+    void IgnoreAddress(uint8_t i2cAddress);
+    void ScanLayout();
+    I2CDeviceType IdentifyDevice(uint8_t i2cAddress);
+    void PrintLayout();
+    bool SelfTest(I2CClockSpeed speed);
+    bool ProbeDevice(uint8_t i2cAddress);
+    void ApplyClockSpeed(I2CClockSpeed speed);
+    bool FallbackClockSpeed();
+    uint32_t ClockSpeedToFrequency(I2CClockSpeed speed);
 
 public:
     // I2C read functions
@@ -45,4 +124,17 @@ public:
     bool write16(uint8_t i2cAddres,
                  uint8_t regAddress,
                  uint16_t data);
+
+    // I2C device layout
+    uint8_t getPwmDeviceCount();
+    uint8_t getPwmAddress(uint8_t index);
+    bool isPowerMeasurementPresent();
+    uint8_t getPowerMeasurementAddress();
+
+    // I2C bus information
+    I2CClockSpeed getActiveClockSpeed();
+    uint32_t getTransmissionCount();
+    uint32_t getTransmissionErrorCount();
+    uint32_t getErrorCodeCount(uint8_t errorCode);
+    uint32_t getBusRecoveryCount();
 };
@@ -0,0 +1,120 @@
+#include "WireBus.h"
+
+/**
+ * Empty constructor
+ */
+WireBus::WireBus()
+{
+};
+
+/**
+ * Starts the hardware bus
+ */
+void WireBus::Begin()
+{
+    Wire.begin();
+};
+
+/**
+ * Sets the clock frequency of the hardware bus
+ * 
+ * @parameter frequency The clock frequency in Hz
+ */
+void WireBus::SetClock(uint32_t frequency)
+{
+    this->frequency = frequency;
+    Wire.setClock(frequency);
+};
+
+/**
+ * Sends data to a device
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * @parameter data          Pointer to the data to send
+ * @parameter length        The number of bytes to send
+ * 
+ * @return The result of the Wire.endTransmission()
+ */
+uint8_t WireBus::Transmit(uint8_t i2cAddress,
+                          const uint8_t *data,
+                          uint8_t length)
+{
+    Wire.beginTransmission(i2cAddress);
+    if (length > 0)
+    {
+        Wire.write(data, length);
+    }
+    return Wire.endTransmission();
+};
+
+/**
+ * Requests data from a device
+ * 
+ * @parameter i2cAddress    The 8 Bit address of the I2C device
+ * @parameter data          Pointer to the buffer for the received data
+ * @parameter length        The number of bytes to request
+ * 
+ * @return The number of bytes received
+ */
+uint8_t WireBus::Receive(uint8_t i2cAddress,
+                         uint8_t *data,
+                         uint8_t length)
+{
+    Wire.requestFrom(i2cAddress, length);
+
+    uint8_t received = 0;
+    while (received < length)
+    {
+        int value = Wire.read();
+        if (value == -1)
+        {
+            break;
+        }
+        data[received] = (uint8_t)value;
+        received++;
+    }
+
+    return received;
+};
+
+/**
+ * Frees the bus from a device that holds SDA low by clocking SCL until SDA gets released
+ * and issuing a STOP condition afterwards. Restarts the bus with the last clock frequency
+ **/
+void WireBus::Recover()
+{
+    pinMode(SDA, INPUT_PULLUP);
+    pinMode(SCL, OUTPUT_OPEN_DRAIN);
+
+    // Clock SCL up to 9 times so the device can finish the byte it is sending
+    for (uint8_t i = 0; i < 9 && digitalRead(SDA) == LOW; i++)
+    {
+        digitalWrite(SCL, LOW);
+        delayMicroseconds(5);
+        digitalWrite(SCL, HIGH);
+        delayMicroseconds(5);
+    }
+
+    // STOP condition => SDA goes from low to high while SCL is high
+    pinMode(SDA, OUTPUT_OPEN_DRAIN);
+    digitalWrite(SDA, LOW);
+    delayMicroseconds(5);
+    digitalWrite(SCL, HIGH);
+    delayMicroseconds(5);
+    digitalWrite(SDA, HIGH);
+    delayMicroseconds(5);
+
+    // Restart bus
+    Wire.begin();
+    Wire.setClock(this->frequency);
+};
+
+/**
+ * Checks the idle levels of the bus lines. Both get pulled up while no transaction runs
+ * 
+ * @return True if a device holds SDA or SCL low
+ **/
+bool WireBus::isStuck()
+{
+    return digitalRead(SDA) == LOW || digitalRead(SCL) == LOW;
+};
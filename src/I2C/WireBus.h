@@ -0,0 +1,34 @@
+#pragma once
+
+// Includes
+#include <Arduino.h>
+#include <Wire.h>
+
+// Interface
+#include "../Interface/II2CBus.h"
+
+// Classes
+/**
+ * @brief The WireBus Class connects the I2C component to the hardware bus of the ESP8266
+ * 
+ */
+class WireBus : public II2CBus
+{
+    // ## Constructor / Important ## //
+public:
+    WireBus();
+
+    // ## Interface ## //
+private:
+public:
+    virtual void Begin();
+    virtual void SetClock(uint32_t frequency);
+    virtual uint8_t Transmit(uint8_t i2cAddress, const uint8_t *data, uint8_t length);
+    virtual uint8_t Receive(uint8_t i2cAddress, uint8_t *data, uint8_t length);
+    virtual void Recover();
+    virtual bool isStuck();
+
+    // ## Data ## //
+private:
+    uint32_t frequency = 100000; // Hz
+};
@@ -44,6 +44,16 @@ void Information::Run()
     }
 };
 
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool Information::isRunRequested()
+{
+    return false; // Only prints on request of other components
+};
+
 /**
  * @brief Prints a single parameter/component formatted message to serial
  * 
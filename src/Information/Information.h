@@ -31,6 +31,7 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual bool isRunRequested();
 
     // ================ Data ================ //
 private:
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <Arduino.h>
+#include "../Enums/Enums.h"
+
 // Interface
 class IBaseClass
 {
@@ -14,7 +17,26 @@ public:
         */
     virtual bool Init() = 0;
     /*
-            Gets called every loop cycle 
+            Gets called by the scheduler every period
         */
     virtual void Run() = 0;
+
+    // ## Scheduling ## //
+    /*
+            Time between two Run calls in micro seconds
+            @return 0 to run every loop cycle
+        */
+    virtual uint32_t getRunPeriod() { return 0; }
+    /*
+            High priority components run first and are never delayed by lower priority ones
+        */
+    virtual SchedulerPriority getRunPriority() { return SchedulerPriority::Normal; }
+    /*
+            Expected worst case run time in micro seconds
+        */
+    virtual uint32_t getRunBudget() { return 1000; }
+    /*
+            Gets checked before every Run call. Components that only have work on demand return false while idle
+        */
+    virtual bool isRunRequested() { return true; }
 };
@@ -0,0 +1,39 @@
+#pragma once
+
+// Interface
+class II2CBus
+{
+
+    // ## Functions ## //
+private:
+public:
+    virtual ~II2CBus() {}
+    /*
+            Starts the bus
+        */
+    virtual void Begin() = 0;
+    /*
+            Sets the clock frequency of the bus
+            @param frequency The clock frequency in Hz
+        */
+    virtual void SetClock(uint32_t frequency) = 0;
+    /*
+            Sends data to a device
+            @return 0 if successfull, otherwise the error code of Wire.endTransmission()
+        */
+    virtual uint8_t Transmit(uint8_t i2cAddress, const uint8_t *data, uint8_t length) = 0;
+    /*
+            Requests data from a device
+            @return The number of bytes received
+        */
+    virtual uint8_t Receive(uint8_t i2cAddress, uint8_t *data, uint8_t length) = 0;
+    /*
+            Frees the bus from a device that holds SDA low and restarts the bus
+        */
+    virtual void Recover() = 0;
+    /*
+            Checks if a device holds SDA or SCL low
+            @return True if the bus is stuck and needs a recovery
+        */
+    virtual bool isStuck() = 0;
+};
@@ -0,0 +1,70 @@
+#pragma once
+
+// Includes
+#include <Arduino.h>
+#include <IPAddress.h>
+#include <functional>
+
+// Interface
+class IMqttClient
+{
+
+    // ## Functions ## //
+private:
+public:
+    virtual ~IMqttClient() {}
+    /*
+            Prepares the client. Called once by the network component
+            @param callback Gets called from Loop() for every received publish. Topic is null terminated, payload is not
+        */
+    virtual void Begin(std::function<void(char *, uint8_t *, unsigned int)> callback) = 0;
+    /*
+            Starts a connection to the broker. The connection is ready once isConnected() returns true
+            @return False if the connection could not be started
+        */
+    virtual bool Connect(IPAddress brokerIpAddress,
+                         uint16_t brokerPort,
+                         const char *clientName,
+                         const char *username,
+                         const char *password,
+                         const char *willTopic,
+                         uint8_t willQos,
+                         bool willRetain,
+                         const char *willMessage,
+                         bool cleanSession) = 0;
+    /*
+            Closes the connection to the broker
+        */
+    virtual void Disconnect() = 0;
+    /*
+            @return True while the connect is still in progress
+        */
+    virtual bool isConnecting() = 0;
+    /*
+            @return True if the broker accepted the connection
+        */
+    virtual bool isConnected() = 0;
+    /*
+            @return The client state. Same codes as PubSubClient::state()
+        */
+    virtual int getState() = 0;
+    /*
+            Subscribes to a topic. Wildcards are allowed
+            @return True if the subscribe was sent
+        */
+    virtual bool Subscribe(const char *topic, uint8_t qos) = 0;
+    /*
+            Unsubscribes from a topic. Same topic as subscribed, wildcards included
+            @return True if the unsubscribe was sent
+        */
+    virtual bool Unsubscribe(const char *topic) = 0;
+    /*
+            Publishes a message with QoS 0
+            @return True if the publish was sent
+        */
+    virtual bool Publish(const char *topic, const char *payload, bool retained) = 0;
+    /*
+            Handles the received packets and the keep alive. Called every loop
+        */
+    virtual void Loop() = 0;
+};
@@ -0,0 +1,26 @@
+#pragma once
+
+// Interface
+class ITimeSource
+{
+
+    // ## Functions ## //
+private:
+public:
+    virtual ~ITimeSource() {}
+    /*
+            Same behaviour as the Arduino millis()
+            @return Milliseconds since start, wraps like an unsigned long
+        */
+    virtual unsigned long Millis() = 0;
+    /*
+            Same behaviour as the Arduino micros()
+            @return Microseconds since start, wraps like an unsigned long
+        */
+    virtual unsigned long Micros() = 0;
+    /*
+            Same behaviour as the Arduino delay()
+            @param millis Milliseconds to wait
+        */
+    virtual void Delay(unsigned long millis) = 0;
+};
@@ -3,6 +3,19 @@
 LEDControllerMk4::LEDControllerMk4()
 {
 }
+
+/**
+ * @brief Constructor to run the controller with a different time source and bus, e.g. a virtual clock and mock bus for simulation
+ * 
+ * @param clock The time source used by all components
+ * @param bus   The bus used by the I2C component
+ */
+LEDControllerMk4::LEDControllerMk4(ITimeSource *clock,
+                                   II2CBus *bus)
+{
+    this->clock = clock;
+    this->bus = bus;
+}
 /**
  * @brief Setup function call in Arduino Main
  * 
@@ -10,7 +23,7 @@ LEDControllerMk4::LEDControllerMk4()
 void LEDControllerMk4::_setup()
 {
     Serial.begin(BAUDRATE);
-    delay(100);
+    this->clock->Delay(100);
 
     // ================ Initial Info Print ================ //
     Serial.println("# ======================== #");
@@ -30,33 +43,82 @@ void LEDControllerMk4::_setup()
     // ================ Component references ================ //
     this->ota.setReference(&this->network,
                            &this->filesystem);
-    this->i2c.setReference();
-    this->network.setReference(&this->filesystem,
+    this->i2c.setReference(this->bus,
+                           &this->filesystem,
+                           this->clock);
+#ifdef MQTT_ASYNC_CLIENT
+    this->mqttClient.setReference(this->clock);
+#endif
+    this->network.setReference(&this->mqttClient,
+                               &this->filesystem,
                                &this->helper,
                                &this->information,
                                &this->pirReader,
                                &this->powerMessurement,
-                               &this->parameterhandler);
+                               &this->parameterhandler,
+                               &this->realtime,
+                               &this->profiler,
+                               this->clock);
     this->powerMessurement.setReference(&this->i2c,
-                                        &this->network);
+                                        &this->network,
+                                        this->clock);
     this->ledDriver.setReference(&this->i2c,
                                  &this->network,
                                  &this->pirReader,
                                  &this->filesystem,
-                                 &this->parameterhandler);
+                                 &this->parameterhandler,
+                                 &this->realtime,
+                                 &this->profiler,
+                                 &this->sharedClock,
+                                 this->clock);
+    this->realtime.setReference(&this->network,
+                                &this->information,
+                                &this->helper,
+                                this->clock);
+    this->sharedClock.setReference(&this->network,
+                                   &this->information,
+                                   this->clock);
     this->information.setReference(&this->helper);
     this->pirReader.setReference(&this->network,
                                  &this->information,
-                                 &this->helper);
+                                 &this->helper,
+                                 this->clock);
     this->webserver.setReference(&this->filesystem,
                                  &this->helper,
                                  &this->network,
-                                 &this->parameterhandler);
-    this->helper.setReference();
+                                 &this->parameterhandler,
+                                 &this->profiler,
+                                 this->clock);
+    this->helper.setReference(this->clock);
     this->filesystem.setReference(&this->helper,
                                   &this->parameterhandler);
     this->parameterhandler.setReference(&this->filesystem,
                                         &this->network);
+    this->profiler.setReference(&this->helper,
+                                this->clock);
+    this->scheduler.setReference(&this->profiler,
+                                 this->clock);
+
+    // ================ Scheduled components ================ //
+    // Period, priority and budget are declared by the components
+    this->scheduler.AddTask(&this->ota, ProfilerComponent::OTA);
+    this->scheduler.AddTask(&this->i2c, ProfilerComponent::I2C);
+    this->scheduler.AddTask(&this->network, ProfilerComponent::Network);
+    //this->scheduler.AddTask(&this->powerMessurement, ProfilerComponent::PowerMeasurement);
+#ifdef REALTIME_ENABLED
+    this->scheduler.AddTask(&this->realtime, ProfilerComponent::Realtime); // Before the led driver => A frame gets shown in the same loop
+#endif
+#ifdef CLOCK_SYNC_ENABLED
+    this->scheduler.AddTask(&this->sharedClock, ProfilerComponent::SharedClock);
+#endif
+    this->scheduler.AddTask(&this->ledDriver, ProfilerComponent::LedDriver);
+    this->scheduler.AddTask(&this->information, ProfilerComponent::Information);
+    this->scheduler.AddTask(&this->pirReader, ProfilerComponent::PirReader);
+    this->scheduler.AddTask(&this->webserver, ProfilerComponent::Webserver);
+    this->scheduler.AddTask(&this->helper, ProfilerComponent::Helper);
+    this->scheduler.AddTask(&this->filesystem, ProfilerComponent::Filesystem);
+    this->scheduler.AddTask(&this->parameterhandler, ProfilerComponent::Parameterhandler);
+    this->scheduler.AddTask(&this->profiler, ProfilerComponent::Profiler);
 
     Serial.println("# ==== Setup finished ==== #");
     Serial.println("");
@@ -69,11 +131,9 @@ void LEDControllerMk4::_setup()
 void LEDControllerMk4::_loop()
 {
 
-    unsigned long x = 0;
     unsigned long y = 0;
 
-    y = micros();
-    x = micros();
+    y = this->clock->Micros();
 
     yield();
 
@@ -85,6 +145,12 @@ void LEDControllerMk4::_loop()
         this->i2c.init = false;
         this->network.init = false;
         //this->powerMessurement.init = false;
+#ifdef REALTIME_ENABLED
+        this->realtime.init = false;
+#endif
+#ifdef CLOCK_SYNC_ENABLED
+        this->sharedClock.init = false;
+#endif
         this->ledDriver.init = false;
         this->information.init = false;
         this->pirReader.init = false;
@@ -92,237 +158,130 @@ void LEDControllerMk4::_loop()
         this->filesystem.init = false;
         this->helper.init = false;
         this->parameterhandler.init = false;
+        this->profiler.init = false;
+        this->scheduler.init = false;
         state++;
         break;
 
     // ================ Call Components Init Function ================ //
     case 1:
         this->ota.Init();
+        this->filesystem.Init(); // Before I2C => Holds the cached device layout
         this->i2c.Init();
         this->network.Init();
         //this->powerMessurement.Init();
+#ifdef REALTIME_ENABLED
+        this->realtime.Init();
+#endif
+#ifdef CLOCK_SYNC_ENABLED
+        this->sharedClock.Init();
+#endif
         this->ledDriver.Init();
         this->information.Init();
         this->pirReader.Init();
-        this->filesystem.Init();
         this->webserver.Init();
         this->helper.Init();
         this->parameterhandler.Init();
+        this->profiler.Init();
+        this->scheduler.Init(); // Last => All periodic components are due right after the initialization
         state++;
         break;
 
     // ================ Call Components Run Function ================ //
     case 2:
-        // ======== OTA ======== //
-        x = micros();
-        this->ota.Run();
-        yield();
-        difTimeOTA[cycleCounter] = micros() - x;
-        // ======== I2C ======== //
-        x = micros();
-        this->i2c.Run();
-        yield();
-        difTimeI2C[cycleCounter] = micros() - x;
-        // ======== NETWORK ======== //
-        x = micros();
-        this->network.Run();
-        yield();
-        difTimeNetwork[cycleCounter] = micros() - x;
-        // ======== POWER MESSUREMENT ======== //
-        x = micros();
-        //this->powerMessurement.Run();
-        //yield();
-        difTimePowerMeasurement[cycleCounter] = micros() - x;
-        // ======== I2C ======== //
-        x = micros();
-        this->ledDriver.Run();
-        yield();
-        difTimeLED[cycleCounter] = micros() - x;
-        // ======== INFORMATION ======== //
-        x = micros();
-        this->information.Run();
-        yield();
-        difTimeInformation[cycleCounter] = micros() - x;
-        // ======== PIR ======== //
-        x = micros();
-        this->pirReader.Run();
-        yield();
-        difTimePIR[cycleCounter] = micros() - x;
-        // ======== WEBSERVER ======== //
-        x = micros();
-        this->webserver.Run();
-        yield();
-        difTimeWebserver[cycleCounter] = micros() - x;
-        // ======== HELPER ======== //
-        x = micros();
-        this->helper.Run();
-        yield();
-        difTimeHelper[cycleCounter] = micros() - x;
-        // ======== FILESYSTEM ======== //
-        x = micros();
-        this->filesystem.Run();
-        yield();
-        difTimeFilesystem[cycleCounter] = micros() - x;
-        // ======== PARAMETERHANDLER ======== //
-        x = micros();
-        this->parameterhandler.Run();
-        yield();
-        difTimeParameterhandler[cycleCounter] = micros() - x;
-        // Reset virtual pir sensor at end of current loop after all components got called
-        network.resetVirtualPIRSensor();
-        break;
-    }
+        this->scheduler.Run();
 
-    if (enablePerformanceMonitor)
-    {
-        difTimeAll[cycleCounter] = micros() - y;
-        cycleCounter++;
-        if (cycleCounter >= cycle)
-        {
-            CalcPerformance();
-            cycleCounter = 0;
-        }
+        this->profiler.Record(ProfilerComponent::Loop, this->clock->Micros() - y);
+        break;
     }
 };
 
 /**
- * Calc performance times for analysis
+ * @brief Returns the I2C component of the controller
+ * 
+ * @return Reference to the component
  */
-void LEDControllerMk4::CalcPerformance()
+I2C &LEDControllerMk4::getI2C()
 {
+    return this->i2c;
+};
 
-    unsigned long avgTimeI2C = 0;
-    unsigned long avgTimeWebserver = 0;
-    unsigned long avgTimeNetwork = 0;
-    unsigned long avgTimeOTA = 0;
-    unsigned long avgTimePowerMeasurement = 0;
-    unsigned long avgTimePIR = 0;
-    unsigned long avgTimeLED = 0;
-    unsigned long avgTimeInformation = 0;
-    unsigned long avgTimeFilesystem = 0;
-    unsigned long avgTimeHelper = 0;
-    unsigned long avgTimeParameterhandler = 0;
-    unsigned long avgTimeAll = 0;
+/**
+ * @brief Returns the filesystem component of the controller
+ * 
+ * @return Reference to the component
+ */
+Filesystem &LEDControllerMk4::getFilesystem()
+{
+    return this->filesystem;
+};
 
-    double percent = 0.0;
+/**
+ * @brief Returns the network component of the controller
+ * 
+ * @return Reference to the component
+ */
+Network &LEDControllerMk4::getNetwork()
+{
+    return this->network;
+};
 
-    for (int i = 0; i < cycle - 1; i++)
-    {
-        avgTimeI2C += difTimeI2C[i];
-        avgTimeWebserver += difTimeWebserver[i];
-        avgTimeNetwork += difTimeNetwork[i];
-        avgTimeOTA += difTimeOTA[i];
-        avgTimePowerMeasurement += difTimePowerMeasurement[i];
-        avgTimePIR += difTimePIR[i];
-        avgTimeLED += difTimeLED[i];
-        avgTimeInformation += difTimeInformation[i];
-        avgTimeFilesystem += difTimeFilesystem[i];
-        avgTimeHelper += difTimeHelper[i];
-        avgTimeParameterhandler += difTimeParameterhandler[i];
-        avgTimeAll += difTimeAll[i];
-    }
+/**
+ * @brief Returns the led driver component of the controller
+ * 
+ * @return Reference to the component
+ */
+LedDriver &LEDControllerMk4::getLedDriver()
+{
+    return this->ledDriver;
+};
 
-    avgTimeI2C = avgTimeI2C / localCycle;
-    avgTimeWebserver = avgTimeWebserver / localCycle;
-    avgTimeNetwork = avgTimeNetwork / localCycle;
-    avgTimeOTA = avgTimeOTA / localCycle;
-    avgTimePowerMeasurement = avgTimePowerMeasurement / localCycle;
-    avgTimePIR = avgTimePIR / localCycle;
-    avgTimeLED = avgTimeLED / localCycle;
-    avgTimeInformation = avgTimeInformation / localCycle;
-    avgTimeFilesystem = avgTimeFilesystem / localCycle;
-    avgTimeHelper = avgTimeHelper / localCycle;
-    avgTimeParameterhandler = avgTimeParameterhandler / localCycle;
-    avgTimeAll = avgTimeAll / localCycle;
+/**
+ * @brief Returns the information component of the controller
+ * 
+ * @return Reference to the component
+ */
+Information &LEDControllerMk4::getInformation()
+{
+    return this->information;
+};
 
-    if (avgTimeAll == 0)
-    {
-        return;
-    }
+/**
+ * @brief Returns the parameterhandler component of the controller
+ * 
+ * @return Reference to the component
+ */
+Parameterhandler &LEDControllerMk4::getParameterhandler()
+{
+    return this->parameterhandler;
+};
 
-    helper.TopSpacerPrint();
+/**
+ * @brief Returns the profiler component of the controller
+ * 
+ * @return Reference to the component
+ */
+Profiler &LEDControllerMk4::getProfiler()
+{
+    return this->profiler;
+};
 
-    // ================ I2C ================ //
-    percent = double(avgTimeI2C) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("I2C Time                    : "));
-    Serial.println(avgTimeI2C);
-    Serial.print(F("I2C Percent                 : "));
-    Serial.println(percent);
-    // ============ WEBSERVER ================ //
-    percent = double(avgTimeWebserver) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Webserver Time              : "));
-    Serial.println(avgTimeWebserver);
-    Serial.print(F("Webserver Percent           : "));
-    Serial.println(percent);
-    // ============ NETWORK ================ //
-    percent = double(avgTimeNetwork) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Network Time                : "));
-    Serial.println(avgTimeNetwork);
-    Serial.print(F("Network Percent             : "));
-    Serial.println(percent);
-    // ============ OTA ================ //
-    percent = double(avgTimeOTA) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("OTA Time                    : "));
-    Serial.println(avgTimeOTA);
-    Serial.print(F("OTA Percent                 : "));
-    Serial.println(percent);
-    // ============ POWER MEASUREMENT ================ //
-    percent = double(avgTimePowerMeasurement) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Power Time                  : "));
-    Serial.println(avgTimePowerMeasurement);
-    Serial.print(F("Power Percent               : "));
-    Serial.println(percent);
-    // ============ PIR ================ //
-    percent = double(avgTimePIR) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("PIR Time                    : "));
-    Serial.println(avgTimePIR);
-    Serial.print(F("PIR Percent                 : "));
-    Serial.println(percent);
-    // ============ LED ================ //
-    percent = double(avgTimeLED) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("LED Time                    : "));
-    Serial.println(avgTimeLED);
-    Serial.print(F("LED Percent                 : "));
-    Serial.println(percent);
-    // ============ INFORMATION ================ //
-    percent = double(avgTimeInformation) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Info Time                   : "));
-    Serial.println(avgTimeInformation);
-    Serial.print(F("Info Percent                : "));
-    Serial.println(percent);
-    // ============ HELPER ================ //
-    percent = double(avgTimeHelper) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Helper Time                 : "));
-    Serial.println(avgTimeHelper);
-    Serial.print(F("Helper Percent              : "));
-    Serial.println(percent);
-    // ============ FILESYSTEM ================ //
-    percent = double(avgTimeFilesystem) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Filesystem Time             : "));
-    Serial.println(avgTimeFilesystem);
-    Serial.print(F("Filesystem Percent          : "));
-    Serial.println(percent);
-    // ============ FILESYSTEM ================ //
-    percent = double(avgTimeParameterhandler) / double(avgTimeAll) * 100;
-    helper.InsertPrint();
-    Serial.print(F("Parameterhandler Time       : "));
-    Serial.println(avgTimeParameterhandler);
-    Serial.print(F("Parameterhandler Percent    : "));
-    Serial.println(percent);
-    // ==== All
-    helper.InsertPrint();
-    Serial.print(F("All Time        : "));
-    Serial.println(avgTimeAll);
+/**
+ * @brief Returns the realtime component of the controller
+ * 
+ * @return Reference to the component
+ */
+Realtime &LEDControllerMk4::getRealtime()
+{
+    return this->realtime;
+};
 
-    helper.BottomSpacerPrint();
-}
\ No newline at end of file
+/**
+ * @brief Returns the shared clock component of the controller
+ * 
+ * @return Reference to the component
+ */
+SharedClock &LEDControllerMk4::getSharedClock()
+{
+    return this->sharedClock;
+};
@@ -3,16 +3,24 @@
 #include "Webserver/Webserver.h"
 #include "Enums/Enums.h"
 #include "I2C/I2C.h"
+#include "I2C/WireBus.h"
+#include "Clock/SystemClock.h"
 #include "Information/Information.h"
 #include "Interface/IBaseClass.h"
 #include "LedDriver/LedDriver.h"
 #include "Network/Network.h"
+#include "Network/PubSubMqttClient.h"
+#include "Network/AsyncTcpMqttClient.h"
 #include "OTA/OTA.h"
 #include "PirReader/PirReader.h"
 #include "PowerMeasurement/PowerMeasurement.h"
 #include "Filesystem/Filesystem.h"
 #include "Parameterhandler/Parameterhandler.h"
 #include "Helper/Helper.h"
+#include "Profiler/Profiler.h"
+#include "Realtime/Realtime.h"
+#include "Clock/SharedClock.h"
+#include "Scheduler/Scheduler.h"
 #include "Register/INA219AIDR_Reg.h"
 #include "Register/PCA9685_LED_Reg.h"
 #include "Structs/Structs.h"
@@ -26,56 +34,66 @@
 
 // ================ Global Defines ================ //
 #define BAUDRATE 115200
-#define PCA9685PW_I2C_ADDRESS 0x40
-#define INA219AIDR_I2C_ADDRESS 0x45
+#define I2C_CLOCK_SPEED I2CClockSpeed::FastModePlus // Falls back to a slower speed if the bus is unstable
 #define PIR_SENSOR_1_PIN D6
 #define PIR_SENSOR_2_PIN D7
+#define MQTT_PERSISTENT_SESSION false // Keeps the subscriptions and missed QoS 1 commands on the broker over a reconnect
+#define MQTT_HEARTBEAT_INTERVAL 0     // ms between the heartbeat publishes. 0 disables the heartbeat => Availability comes from the birth message and the last will. The broker sends the will 1.5 x 15 s (mqtt keep alive) after the last packet
+#define REALTIME_JITTER_BUFFER_DELAY 70 // ms the realtime frames get delayed to hide the WiFi jitter. 0 shows every frame at once
 
-#define cycle 10
+// #define MQTT_ASYNC_CLIENT // Connects to the broker over ESPAsyncTCP => The loop never blocks while the broker is unreachable
+// #define REALTIME_ENABLED  // Listens for DDP and E1.31 frames of an external sequencer
+// #define CLOCK_SYNC_ENABLED // Syncs the shared clock with the other controllers. Without it the effects run on the local time
 
 class LEDControllerMk4
 {
-
 public:
     LEDControllerMk4();
+    LEDControllerMk4(ITimeSource *clock,
+                     II2CBus *bus);
     void _setup();
     void _loop();
 
+    // ================ Components ================ //
+    I2C &getI2C();
+    Filesystem &getFilesystem();
+    Network &getNetwork();
+    LedDriver &getLedDriver();
+    Information &getInformation();
+    Parameterhandler &getParameterhandler();
+    Profiler &getProfiler();
+    Realtime &getRealtime();
+    SharedClock &getSharedClock();
+
 private:
     uint8_t state = 0;
 
+    // ================ Hardware ================ //
+    SystemClock systemClock = SystemClock();
+    WireBus wireBus = WireBus();
+    ITimeSource *clock = &systemClock; // Replaced by a virtual clock for simulation
+    II2CBus *bus = &wireBus;           // Replaced by a mock bus for simulation
+#ifdef MQTT_ASYNC_CLIENT
+    AsyncTcpMqttClient mqttClient = AsyncTcpMqttClient();
+#else
+    PubSubMqttClient mqttClient = PubSubMqttClient(); // Blocks the loop during the connect
+#endif
+
     // ================ Components ================ //
-    I2C i2c = I2C();
+    I2C i2c = I2C(I2C_CLOCK_SPEED);
     Webserver webserver = Webserver();
     Helper helper = Helper();
     Filesystem filesystem = Filesystem();
-    Network network = Network(Version);
+    Network network = Network(Version, MQTT_PERSISTENT_SESSION, MQTT_HEARTBEAT_INTERVAL);
     OTA ota = OTA();
-    PowerMeasurement powerMessurement = PowerMeasurement(INA219AIDR_I2C_ADDRESS,
-                                                         0.002); // 2 mOhm
+    PowerMeasurement powerMessurement = PowerMeasurement(0.002); // 2 mOhm
     PirReader pirReader = PirReader(PIR_SENSOR_1_PIN,
                                     PIR_SENSOR_2_PIN);
-    LedDriver ledDriver = LedDriver(PCA9685PW_I2C_ADDRESS);
+    LedDriver ledDriver = LedDriver();
     Information information = Information();
     Parameterhandler parameterhandler = Parameterhandler();
-
-    // ================ Performance Calculation ================ //
-    bool enablePerformanceMonitor = false;
-
-    unsigned long difTimeI2C[cycle];
-    unsigned long difTimeWebserver[cycle];
-    unsigned long difTimeNetwork[cycle];
-    unsigned long difTimeOTA[cycle];
-    unsigned long difTimePowerMeasurement[cycle];
-    unsigned long difTimePIR[cycle];
-    unsigned long difTimeLED[cycle];
-    unsigned long difTimeInformation[cycle];
-    unsigned long difTimeHelper[cycle];
-    unsigned long difTimeFilesystem[cycle];
-    unsigned long difTimeParameterhandler[cycle];
-    unsigned long difTimeAll[cycle];
-
-    uint16_t localCycle = 10;
-    uint16_t cycleCounter = 0;
-    void CalcPerformance();
+    Profiler profiler = Profiler(); // Loop time histograms. Enabled at runtime over mqtt or the webserver
+    Realtime realtime = Realtime(REALTIME_JITTER_BUFFER_DELAY); // DDP and E1.31 frames of an external sequencer
+    SharedClock sharedClock = SharedClock(); // Same time on all controllers => Synchronized effects
+    Scheduler scheduler = Scheduler();
 };
@@ -1,13 +1,10 @@
 #include "LedDriver.h"
 
 /**
- * Constructor for the LedDriver class
- * 
- * @parameter i2cAddress    The i2c address of the pwm ic
+ * Constructor for the LedDriver class. The i2c address of the pwm ic gets discovered by the I2C component
  */
-LedDriver::LedDriver(uint8_t i2cAddress)
+LedDriver::LedDriver()
 {
-    this->i2cAddress = i2cAddress;
 };
 
 /**
@@ -17,13 +14,21 @@ void LedDriver::setReference(I2C *i2c,
                              Network *network,
                              PirReader *pirReader,
                              Filesystem *filesystem,
-                             Parameterhandler *parameterhandler)
+                             Parameterhandler *parameterhandler,
+                             Realtime *realtime,
+                             Profiler *profiler,
+                             SharedClock *sharedClock,
+                             ITimeSource *clock)
 {
     this->i2c = i2c;
     this->network = network;
     this->pirReader = pirReader;
     this->filesystem = filesystem;
     this->parameterhandler = parameterhandler;
+    this->realtime = realtime;
+    this->profiler = profiler;
+    this->sharedClock = sharedClock;
+    this->clock = clock;
 };
 
 // # ================================================================ ================================================================ # //
@@ -41,20 +46,34 @@ bool LedDriver::Init()
     {
         i2c->Init();
 
-        // Set sleep bit to set prescaler
-        i2c->write8(i2cAddress, MODE1, 0b00010000);
+        // Only enable the led driver if a pwm ic was found on the bus
+        if (i2c->getPwmDeviceCount() == 0)
+        {
+            Serial.println(F("No PCA9685 found => LED Driver disabled"));
+            return init;
+        }
+        i2cAddress = i2c->getPwmAddress(0);
+
+        // Configure every pwm ic so additional ones start in a known state with all outputs off
+        for (uint8_t i = 0; i < i2c->getPwmDeviceCount(); i++)
+        {
+            uint8_t pwmAddress = i2c->getPwmAddress(i);
 
-        // Set prescaler to 1526 hz
-        i2c->write8(i2cAddress, PRE_SCALE, 0b00000011);
+            // Set sleep bit to set prescaler
+            i2c->write8(pwmAddress, MODE1, 0b00010000);
 
-        // Reset sleep bit after prescaler set
-        i2c->write8(i2cAddress, MODE1, 0b00000000);
+            // Set prescaler to 1526 hz
+            i2c->write8(pwmAddress, PRE_SCALE, 0b00000011);
 
-        // Set Mode 2 register
-        i2c->write8(i2cAddress, MODE2, 0b00000100);
-        /*
-            OUTDRV = 1
-        */
+            // Reset sleep bit after prescaler set
+            i2c->write8(pwmAddress, MODE1, 0b00000000);
+
+            // Set Mode 2 register
+            i2c->write8(pwmAddress, MODE2, 0b00000100);
+            /*
+                OUTDRV = 1
+            */
+        }
 
         createInitalTypes();
 
@@ -82,51 +101,115 @@ void LedDriver::Run()
         return;
     }
 
-    // Refersh LED Strip data every x seconds => Needed for time based color fade
-    unsigned long currentMillisRefreshRate = millis();
-    if (currentMillisRefreshRate - previousMillisRefreshRate >= intervalRefreshRate)
-    {
-        previousMillisRefreshRate = currentMillisRefreshRate;
-        refreshRateCounter++;
+    // Called by the scheduler once per led frame => Needed for time based color fade
+    unsigned long currentMillisRefreshRate = this->clock->Millis();
+    StartRefreshCycle(currentMillisRefreshRate);
 
-        // Check if WiFi or MQTT got a disconnect and start the timer
-        unsigned long CurMillis_ConnectionLost = millis();
-        if (!network->isWiFiConnected() || !network->isMQTTConnected())
-        {
-            if (CurMillis_ConnectionLost - PrevMillis_ConnectionLost >= TimeOut_ConnectionLost)
-            {
-                ConnectionLost = true;
-            }
-        }
-        else
+    // Check if WiFi or MQTT got a disconnect and start the timer
+    unsigned long CurMillis_ConnectionLost = this->clock->Millis();
+    if (!network->isWiFiConnected() || !network->isMQTTConnected())
+    {
+        if (CurMillis_ConnectionLost - PrevMillis_ConnectionLost >= TimeOut_ConnectionLost)
         {
-            PrevMillis_ConnectionLost = CurMillis_ConnectionLost;
-            ConnectionLost = false;
+            ConnectionLost = true;
         }
+    }
+    else
+    {
+        PrevMillis_ConnectionLost = CurMillis_ConnectionLost;
+        ConnectionLost = false;
+    }
 
-        // Only Display when we got a connection
-        if (!ConnectionLost)
-        {
-            // Wait a little to receive data from mqtt before showing led strip
-            if (currentMillisRefreshRate - prevMillisReconnect >= timeoutReconnect)
-            {
-                // == Handle multi LED strip effects
-                HandleMultiLEDStripControlLogic();
-                HandleMultiLEDStripEffects();
-            }
-        }
-        else
+    // Frames of an external sequencer bypass the effects and fades
+    this->realtime->Playout(this->clock->Micros());
+    if (this->realtime->isActive())
+    {
+        ApplyRealtimeFrame(1);
+        ApplyRealtimeFrame(2);
+    }
+    // Only Display when we got a connection
+    else if (!ConnectionLost)
+    {
+        // Wait a little to receive data from mqtt before showing led strip
+        if (currentMillisRefreshRate - prevMillisReconnect >= timeoutReconnect)
         {
-            prevMillisReconnect = currentMillisRefreshRate;
-            FadeToBlack();
+            // == Handle multi LED strip effects
+            HandleMultiLEDStripControlLogic();
+            HandleMultiLEDStripEffects();
         }
-
-        // ==== Update LED strip
-        // == Strip 1
-        UpdateLEDStrip(1);
-        // == Strip 2
-        UpdateLEDStrip(2);
     }
+    else
+    {
+        prevMillisReconnect = currentMillisRefreshRate;
+        FadeToBlack();
+    }
+
+    // ==== Update LED strip
+    // == Strip 1
+    UpdateLEDStrip(1);
+    // == Strip 2
+    UpdateLEDStrip(2);
+};
+
+/**
+ * @brief Returns the time between two Run calls
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t LedDriver::getRunPeriod()
+{
+    return (uint32_t)(1000000.0 / LED_STRIP_REFRESH_RATE); // One led frame
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority LedDriver::getRunPriority()
+{
+    return SchedulerPriority::High;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t LedDriver::getRunBudget()
+{
+    return 3000; // Both strips over I2C
+};
+
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool LedDriver::isRunRequested()
+{
+    return init; // Nothing to drive without a PCA9685 on the bus
+};
+
+/**
+ * @brief Starts the next led frame. The fades of the frame are calculated for this time
+ * 
+ * @param currentMillis Time of the frame
+ */
+void LedDriver::StartRefreshCycle(unsigned long currentMillis)
+{
+    previousMillisRefreshRate = currentMillis;
+    refreshRateCounter++;
+};
+
+/**
+ * @brief Returns the time between two led frames
+ * 
+ * @return The interval in milliseconds
+ */
+uint16_t LedDriver::getRefreshInterval()
+{
+    return intervalRefreshRate;
 };
 
 // # ================================================================ ================================================================ # //
@@ -208,7 +291,7 @@ void LedDriver::HandleMultiLEDStripEffects()
         fadeToBlackStrip2Finished = FadeToBlack(2);
         if (fadeToBlackStrip1Finished && fadeToBlackStrip2Finished)
         {
-            effectData->prevMillis = millis();
+            effectData->prevMillis = this->clock->Millis();
             effectData->transitionState = 10;
         }
         break;
@@ -225,6 +308,8 @@ void LedDriver::HandleMultiLEDStripEffects()
             break;
 
         case MultiLEDEffect::SingleLEDEffect:
+            this->shownLEDStripRevision[0] = this->parameterhandler->getLEDStripRevision(0);
+            this->shownLEDStripRevision[1] = this->parameterhandler->getLEDStripRevision(1);
             HandleSingleLEDStripEffects(1, this->parameterhandler->getLEDStripParameter(0));
             HandleSingleLEDStripEffects(2, this->parameterhandler->getLEDStripParameter(1));
             break;
@@ -270,13 +355,13 @@ void LedDriver::HandleMultiLEDStripEffects()
                 fadeToBlackStrip2Finished = FadeToBlack(2);
                 if (fadeToBlackStrip1Finished && fadeToBlackStrip2Finished)
                 {
-                    effectData->prevMillis = millis();
+                    effectData->prevMillis = this->clock->Millis();
                     effectData->subTransitionState = 10;
                 }
                 break;
 
             case 10:
-                if (millis() - effectData->prevMillis >= 500)
+                if (this->clock->Millis() - effectData->prevMillis >= 500)
                 {
                     effectData->subTransitionState = 20;
                 }
@@ -287,13 +372,13 @@ void LedDriver::HandleMultiLEDStripEffects()
                 fadeToColorStrip2Finished = FadeToColor(2, highLevelLEDStripData);
                 if (fadeToColorStrip1Finished && fadeToColorStrip2Finished)
                 {
-                    effectData->prevMillis = millis();
+                    effectData->prevMillis = this->clock->Millis();
                     effectData->subTransitionState = 30;
                 }
                 break;
 
             case 30:
-                if (millis() - effectData->prevMillis >= 1500)
+                if (this->clock->Millis() - effectData->prevMillis >= 1500)
                 {
                     effectData->subTransitionState = 0;
                 }
@@ -342,7 +427,7 @@ void LedDriver::HandleSingleLEDStripEffects(uint8_t stripID,
         case 0:
             if (FadeToBlack(stripID))
             {
-                effectData->prevMillis = millis();
+                effectData->prevMillis = this->clock->Millis();
                 effectData->transitionState = 10;
             }
             break;
@@ -358,165 +443,101 @@ void LedDriver::HandleSingleLEDStripEffects(uint8_t stripID,
                 break;
 
             case SingleLEDEffect::TriplePulse:
-                // Red
-                lowLevelLEDStripData.redColorValue = ledStripParameter.Red;
-                // Green
-                lowLevelLEDStripData.greenColorValue = ledStripParameter.Green;
-                //Blue
-                lowLevelLEDStripData.blueColorValue = ledStripParameter.Blue;
+            {
+                // Phase from the 64 bit shared time => The pulses of all controllers line up, also past the wrap of the 32 bit millis
+                unsigned long phase = (unsigned long)((this->sharedClock->getSharedMicros() / 1000) % 4600);
+                uint16_t brightness = 512;
 
-                switch (effectData->subTransitionState)
+                // Three pulses after 1500 milliseconds at 12,5% brightness
+                if (phase >= 1500)
                 {
-                // Fade to 12,5% brightness and wait 1500 milliseconds
-                case 0:
-                    // Red
-                    lowLevelLEDStripData.redBrightnessValue = 512;
-                    lowLevelLEDStripData.redBrightnessFadeTime = 800;
-                    // Green
-                    lowLevelLEDStripData.greenBrightnessValue = 512;
-                    lowLevelLEDStripData.greenBrightnessFadeTime = 800;
-                    // Blue
-                    lowLevelLEDStripData.blueBrightnessValue = 512;
-                    lowLevelLEDStripData.blueBrightnessFadeTime = 800;
-
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
-                    {
-                        if (millis() - effectData->prevMillis >= 1500)
-                        {
-                            effectData->subTransitionState = 10;
-                        }
-                    }
-                    else
-                    {
-                        effectData->prevMillis = millis();
-                    }
-                    break;
-
-                // Fade to 100% brightness and wait 100 milliseconds
-                case 10:
-                    // Red
-                    lowLevelLEDStripData.redBrightnessValue = 4096;
-                    lowLevelLEDStripData.redBrightnessFadeTime = 400;
-                    // Green
-                    lowLevelLEDStripData.greenBrightnessValue = 4096;
-                    lowLevelLEDStripData.greenBrightnessFadeTime = 400;
-                    // Blue
-                    lowLevelLEDStripData.blueBrightnessValue = 4096;
-                    lowLevelLEDStripData.blueBrightnessFadeTime = 400;
-
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
+                    unsigned long pulsePhase = (phase - 1500) % 1100;
+                    // Fade to 100% brightness
+                    if (pulsePhase < 400)
                     {
-                        if (millis() - effectData->prevMillis >= 100)
-                        {
-                            effectData->subTransitionState = 20;
-                        }
+                        brightness = getCurveValue(lowLevelLEDStripData.redBrightnessFadeCurve, pulsePhase / 400.0, 512, 4096);
                     }
-                    else
+                    // Wait 100 milliseconds
+                    else if (pulsePhase < 500)
                     {
-                        effectData->prevMillis = millis();
+                        brightness = 4096;
                     }
-                    break;
-
-                // Fade to 12,5% and check counter
-                case 20:
-                    // Red
-                    lowLevelLEDStripData.redBrightnessValue = 512;
-                    lowLevelLEDStripData.redBrightnessFadeTime = 400;
-                    // Green
-                    lowLevelLEDStripData.greenBrightnessValue = 512;
-                    lowLevelLEDStripData.greenBrightnessFadeTime = 400;
-                    // Blue
-                    lowLevelLEDStripData.blueBrightnessValue = 512;
-                    lowLevelLEDStripData.blueBrightnessFadeTime = 400;
-
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
-                    {
-                        effectData->prevMillis = millis();
-                        if (effectData->counter >= 2)
-                        {
-                            effectData->counter = 0;
-                            effectData->subTransitionState = 0;
-                        }
-                        else
-                        {
-                            effectData->counter++;
-                            effectData->subTransitionState = 30;
-                        }
-                    }
-                    break;
-                // Wait 200 milliseconds
-                case 30:
-                    // Red
-                    lowLevelLEDStripData.redBrightnessValue = 512;
-                    lowLevelLEDStripData.redBrightnessFadeTime = 400;
-                    // Green
-                    lowLevelLEDStripData.greenBrightnessValue = 512;
-                    lowLevelLEDStripData.greenBrightnessFadeTime = 400;
-                    // Blue
-                    lowLevelLEDStripData.blueBrightnessValue = 512;
-                    lowLevelLEDStripData.blueBrightnessFadeTime = 400;
-
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
+                    // Fade to 12,5% and wait 200 milliseconds
+                    else if (pulsePhase < 900)
                     {
-                        if (millis() - effectData->prevMillis >= 200)
-                        {
-                            effectData->subTransitionState = 10;
-                        }
+                        brightness = getCurveValue(lowLevelLEDStripData.redBrightnessFadeCurve, (pulsePhase - 500) / 400.0, 4096, 512);
                     }
-                    else
-                    {
-                        effectData->prevMillis = millis();
-                    }
-                    break;
                 }
 
-                break;
+                // Local fade in after the effect change
+                double entrancePercent = 1.0;
+                if (lowLevelLEDStripData.redBrightnessFadeTime != 0)
+                {
+                    entrancePercent = (this->clock->Millis() - effectData->prevMillis) / (double)lowLevelLEDStripData.redBrightnessFadeTime;
+                }
+                brightness = getCurveValue(lowLevelLEDStripData.redBrightnessFadeCurve, entrancePercent, 0, brightness);
 
-            case SingleLEDEffect::Rainbow:
                 // Red
-                lowLevelLEDStripData.redBrightnessValue = ledStripParameter.ColorBrightness;
-                lowLevelLEDStripData.redColorFadeTime = 6000;
+                lowLevelLEDStripData.redColorValue = ledStripParameter.Red;
+                lowLevelLEDStripData.redBrightnessValue = brightness;
                 // Green
-                lowLevelLEDStripData.greenBrightnessValue = ledStripParameter.ColorBrightness;
-                lowLevelLEDStripData.greenColorFadeTime = 6000;
+                lowLevelLEDStripData.greenColorValue = ledStripParameter.Green;
+                lowLevelLEDStripData.greenBrightnessValue = brightness;
                 //Blue
-                lowLevelLEDStripData.blueBrightnessValue = ledStripParameter.ColorBrightness;
-                lowLevelLEDStripData.blueColorFadeTime = 6000;
+                lowLevelLEDStripData.blueColorValue = ledStripParameter.Blue;
+                lowLevelLEDStripData.blueBrightnessValue = brightness;
+
+                effectData->fadeFinished = SetColor(stripID, lowLevelLEDStripData);
+                break;
+            }
 
-                switch (effectData->subTransitionState)
+            case SingleLEDEffect::Rainbow:
+            {
+                // Phase from the shared clock => All controllers show the same color
+                unsigned long phase = (unsigned long)((this->sharedClock->getSharedMicros() / 1000) % 18000);
+                uint16_t rising = getCurveValue(lowLevelLEDStripData.redColorFadeCurve, (phase % 6000) / 6000.0, 0, 255);
+                uint16_t falling = 255 - rising;
+
+                lowLevelLEDStripData.redColorValue = 0;
+                lowLevelLEDStripData.greenColorValue = 0;
+                lowLevelLEDStripData.blueColorValue = 0;
+                switch (phase / 6000)
                 {
                     // Fade to red
                 case 0:
-                    lowLevelLEDStripData.redColorValue = 255;
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
-                    {
-                        effectData->subTransitionState = 10;
-                    }
+                    lowLevelLEDStripData.redColorValue = rising;
+                    lowLevelLEDStripData.blueColorValue = falling;
                     break;
                     // Fade to green
-                case 10:
-                    lowLevelLEDStripData.greenColorValue = 255;
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
-                    {
-                        effectData->subTransitionState = 20;
-                    }
+                case 1:
+                    lowLevelLEDStripData.greenColorValue = rising;
+                    lowLevelLEDStripData.redColorValue = falling;
                     break;
                     // Fade to blue
-                case 20:
-                    lowLevelLEDStripData.blueColorValue = 255;
-                    effectData->fadeFinished = FadeToColor(stripID, lowLevelLEDStripData);
-                    if (effectData->fadeFinished)
-                    {
-                        effectData->subTransitionState = 0;
-                    }
+                case 2:
+                    lowLevelLEDStripData.blueColorValue = rising;
+                    lowLevelLEDStripData.greenColorValue = falling;
                     break;
                 }
+
+                // Local fade in after the effect change
+                double entrancePercent = 1.0;
+                if (lowLevelLEDStripData.redBrightnessFadeTime != 0)
+                {
+                    entrancePercent = (this->clock->Millis() - effectData->prevMillis) / (double)lowLevelLEDStripData.redBrightnessFadeTime;
+                }
+                uint16_t brightness = getCurveValue(lowLevelLEDStripData.redBrightnessFadeCurve, entrancePercent, 0, ledStripParameter.ColorBrightness);
+
+                // Red
+                lowLevelLEDStripData.redBrightnessValue = brightness;
+                // Green
+                lowLevelLEDStripData.greenBrightnessValue = brightness;
+                //Blue
+                lowLevelLEDStripData.blueBrightnessValue = brightness;
+
+                effectData->fadeFinished = SetColor(stripID, lowLevelLEDStripData);
+                break;
+            }
             }
 
             break;
@@ -1325,6 +1346,45 @@ bool LedDriver::FadeToBlack()
 // #                                                             LED STRIP                                                             # //
 // # ================================================================ ================================================================ # //
 
+/**
+ * Sets the current LED strip data to the newest realtime frame. The previous values get set too,
+ * so the effects fade from the last frame once the realtime mode times out
+ * 
+ * @parameter stripID  The ID of the used led strip
+ **/
+void LedDriver::ApplyRealtimeFrame(uint8_t stripID)
+{
+    RawLEDStripData *ptrCurrentLEDStripData = getCurrentLEDStripData(stripID);
+    const uint8_t *channel = this->realtime->getFrame() + (stripID - 1) * CHANNEL_COUNT;
+    const uint16_t fullBrightness = 4095;
+
+    // == RED
+    ptrCurrentLEDStripData->redColorValue = channel[0];
+    ptrCurrentLEDStripData->prevRedColorValue = channel[0];
+    ptrCurrentLEDStripData->redBrightnessValue = fullBrightness;
+    ptrCurrentLEDStripData->prevRedBrightnessValue = fullBrightness;
+    // == GREEN
+    ptrCurrentLEDStripData->greenColorValue = channel[1];
+    ptrCurrentLEDStripData->prevGreenColorValue = channel[1];
+    ptrCurrentLEDStripData->greenBrightnessValue = fullBrightness;
+    ptrCurrentLEDStripData->prevGreenBrightnessValue = fullBrightness;
+    // == BLUE
+    ptrCurrentLEDStripData->blueColorValue = channel[2];
+    ptrCurrentLEDStripData->prevBlueColorValue = channel[2];
+    ptrCurrentLEDStripData->blueBrightnessValue = fullBrightness;
+    ptrCurrentLEDStripData->prevBlueBrightnessValue = fullBrightness;
+    // == CW
+    ptrCurrentLEDStripData->cwColorValue = channel[3];
+    ptrCurrentLEDStripData->prevCwColorValue = channel[3];
+    ptrCurrentLEDStripData->cwBrightnessValue = fullBrightness;
+    ptrCurrentLEDStripData->prevCwBrightnessValue = fullBrightness;
+    // == WW
+    ptrCurrentLEDStripData->wwColorValue = channel[4];
+    ptrCurrentLEDStripData->prevWwColorValue = channel[4];
+    ptrCurrentLEDStripData->wwBrightnessValue = fullBrightness;
+    ptrCurrentLEDStripData->prevWwBrightnessValue = fullBrightness;
+};
+
 /**
  * Updates all led channels to the current LED strip data if the changed from the previous value
  * 
@@ -1346,27 +1406,32 @@ void LedDriver::UpdateLEDStrip(uint8_t stripID)
     uint16_t phaseShiftBlue = 3279;
 
     // ======== Update color channel ======== //
-    UpdateLEDChannel(STRIP.CW_REG,
+    UpdateLEDChannel(stripID,
+                     STRIP.CW_REG,
                      phaseShiftCw,
                      this->getBasicDataBasedOnSettings(stripID, 1, ptrCurrentLEDStripData).colorValue,
                      this->getBasicDataBasedOnSettings(stripID, 1, ptrCurrentLEDStripData).brightnessValue);
 
-    UpdateLEDChannel(STRIP.BLUE_REG,
+    UpdateLEDChannel(stripID,
+                     STRIP.BLUE_REG,
                      phaseShiftBlue,
                      this->getBasicDataBasedOnSettings(stripID, 2, ptrCurrentLEDStripData).colorValue,
                      this->getBasicDataBasedOnSettings(stripID, 2, ptrCurrentLEDStripData).brightnessValue);
 
-    UpdateLEDChannel(STRIP.RED_REG,
+    UpdateLEDChannel(stripID,
+                     STRIP.RED_REG,
                      phaseShiftRed,
                      this->getBasicDataBasedOnSettings(stripID, 3, ptrCurrentLEDStripData).colorValue,
                      this->getBasicDataBasedOnSettings(stripID, 3, ptrCurrentLEDStripData).brightnessValue);
 
-    UpdateLEDChannel(STRIP.GREEN_REG,
+    UpdateLEDChannel(stripID,
+                     STRIP.GREEN_REG,
                      phaseShiftGreen,
                      this->getBasicDataBasedOnSettings(stripID, 4, ptrCurrentLEDStripData).colorValue,
                      this->getBasicDataBasedOnSettings(stripID, 4, ptrCurrentLEDStripData).brightnessValue);
 
-    UpdateLEDChannel(STRIP.WW_REG,
+    UpdateLEDChannel(stripID,
+                     STRIP.WW_REG,
                      phaseShiftWw,
                      this->getBasicDataBasedOnSettings(stripID, 5, ptrCurrentLEDStripData).colorValue,
                      this->getBasicDataBasedOnSettings(stripID, 5, ptrCurrentLEDStripData).brightnessValue);
@@ -1375,12 +1440,14 @@ void LedDriver::UpdateLEDStrip(uint8_t stripID)
 /**
  * Writes a color value to the specified register with phase shift
  * 
+ * @parameter stripID           The ID of the used led strip
  * @parameter REG               The LED Color channel registers to update with new color and brightness
  * @parameter phaseShift        The phase shift value to apply to the given LED channel
  * @parameter colorValue        The color value of the given LED channel
  * @parameter brightnessValue   The brightness of the given LED channel
  **/
-void LedDriver::UpdateLEDChannel(LEDColorReg REG,
+void LedDriver::UpdateLEDChannel(uint8_t stripID,
+                                 LEDColorReg REG,
                                  uint16_t phaseShift,
                                  uint8_t colorValue,
                                  uint16_t brightnessValue)
@@ -1432,6 +1499,32 @@ void LedDriver::UpdateLEDChannel(LEDColorReg REG,
     }
     i2c->write8(i2cAddress, REG.OFF_L, lowByte(OFF_REG));
     i2c->write8(i2cAddress, REG.OFF_H, highByte(OFF_REG));
+
+    // First changed output after a command => Command to photon latency
+    uint8_t channel = (REG.OFF_L - LED0_OFF_L) / 4;
+    if (channel < PCA9685_CHANNEL_COUNT && this->channelOffReg[channel] != OFF_REG)
+    {
+        this->channelOffReg[channel] = OFF_REG;
+        this->RecordCommandLatency(stripID);
+    }
+};
+
+/**
+ * Records the latency of the pending command of the strip once the output comes from parameters that hold it
+ * 
+ * @parameter stripID   The ID of the used led strip
+ **/
+void LedDriver::RecordCommandLatency(uint8_t stripID)
+{
+    CommandStamp stamp = {};
+    if (this->parameterhandler->takeLEDStripCommandStamp(stripID - 1, this->shownLEDStripRevision[stripID - 1], stamp))
+    {
+        uint32_t latency = this->clock->Micros() - stamp.ingressMicros;
+        if (latency < COMMAND_LATENCY_TIMEOUT)
+        {
+            this->profiler->Record(stamp.path, latency);
+        }
+    }
 };
 
 /**
@@ -1685,11 +1778,10 @@ bool LedDriver::ConfigureMode()
     else
     {
 
-        unsigned long currentMillisRefreshRate = millis();
+        unsigned long currentMillisRefreshRate = this->clock->Millis();
         if (currentMillisRefreshRate - previousMillisRefreshRate >= intervalRefreshRate)
         {
-            previousMillisRefreshRate = currentMillisRefreshRate;
-            refreshRateCounter++;
+            StartRefreshCycle(currentMillisRefreshRate);
 
             // Fade both strips to black
             finishedConfigureMode = FadeToBlack();
@@ -1707,9 +1799,9 @@ LEDBasicStripData LedDriver::getBasicDataBasedOnSettings(uint8_t stripID, uint8_
 {
     LEDBasicStripData data;
     SettingsStripParameter settingsStripParameter = this->parameterhandler->getSettingsStripParameter(stripID);
-    if (stripID >= 0 && stripID < STRIP_COUNT)
+    if (stripID < STRIP_COUNT)
     {
-        if (channelID >= 0 && channelID < CHANNEL_COUNT)
+        if (channelID < CHANNEL_COUNT)
         {
             data = getBasicDataBasedOnOutput(settingsStripParameter.ChannelOutputType[channelID], ptrData);
         }
@@ -7,12 +7,16 @@
 #include "../Network/Network.h"
 #include "../Parameterhandler/Parameterhandler.h"
 #include "../Filesystem/Filesystem.h"
+#include "../Profiler/Profiler.h"
+#include "../Realtime/Realtime.h"
+#include "../Clock/SharedClock.h"
 #include "../Register/PCA9685_LED_Reg.h"
 #include "../Enums/Enums.h"
 #include "../Structs/Structs.h"
 
 // Interface
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
 
 // Blueprint for compiler. Problem => circular dependency
 class I2C;
@@ -20,18 +24,24 @@ class Network;
 class PirReader;
 class FileSystem;
 class Parameterhandler;
+class Realtime;
+class SharedClock;
 
 // Classes
 class LedDriver : public IBaseClass
 {
     // ## Constructor / Important ## //
 public:
-    LedDriver(uint8_t i2cAddress);
+    LedDriver();
     void setReference(I2C *i2c,
                       Network *network,
                       PirReader *pirReader,
                       Filesystem *filesystem,
-                      Parameterhandler *parameterhandler);
+                      Parameterhandler *parameterhandler,
+                      Realtime *realtime,
+                      Profiler *profiler,
+                      SharedClock *sharedClock,
+                      ITimeSource *clock);
     bool init = false;
 
     // ## Interface ## //
@@ -39,15 +49,23 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+    virtual bool isRunRequested();
 
     // ## Data ## //
 private:
-    uint8_t i2cAddress;
+    uint8_t i2cAddress = 0;
     I2C *i2c;
     PirReader *pirReader;
     Network *network;
     Filesystem *filesystem;
     Parameterhandler *parameterhandler;
+    Realtime *realtime;
+    Profiler *profiler;
+    SharedClock *sharedClock; // Phase of the effects => Same on all controllers
+    ITimeSource *clock;
 
     // ---- LED Strip Refresh Rate
     unsigned long previousMillisRefreshRate = 0;
@@ -55,6 +73,10 @@ private:
     double LED_STRIP_REFRESH_RATE = 90; // x Times per Second
     unsigned long refreshRateCounter = 0;
 
+    // ---- Command latency
+    uint16_t channelOffReg[PCA9685_CHANNEL_COUNT]{0}; // Last written LED_OFF_REG => Detects the first changed frame after a command
+    uint32_t shownLEDStripRevision[STRIP_COUNT]{0};   // Revision of the strip parameters the output is derived from
+
     unsigned long prevMillisReconnect = 0;
     unsigned long timeoutReconnect = 4000;
 
@@ -90,6 +112,15 @@ public:
     // ## Functions ## //
     bool ConfigureMode();
 
+    // ---- Frame steps. Run calls them once per led frame, the host benchmarks one at a time
+    void StartRefreshCycle(unsigned long currentMillis);
+    uint16_t getRefreshInterval();
+
+    bool FadeToColor(uint8_t stripID,
+                     LowLevelLEDStripData commandLowLevelLEDStripData);
+
+    void UpdateLEDStrip(uint8_t stripID);
+
 private:
     // ---- Logic
     void HandleMultiLEDStripControlLogic();
@@ -163,9 +194,6 @@ private:
 
     bool FadeToColor(uint8_t stripID,
                      HighLevelLEDStripData commandHighLevelLEDStripData);
-
-    bool FadeToColor(uint8_t stripID,
-                     LowLevelLEDStripData commandLowLevelLEDStripData);
     // -- Multi Strip
     bool FadeToColor(LEDStripParameter ledStripParameter);
 
@@ -180,13 +208,16 @@ private:
     // -- Multi Strip
     bool FadeToBlack();
 
-    // ---- LED Strip
-    void UpdateLEDStrip(uint8_t stripID);
+    // ---- Realtime
+    void ApplyRealtimeFrame(uint8_t stripID);
 
-    void UpdateLEDChannel(LEDColorReg REG,
+    // ---- LED Strip
+    void UpdateLEDChannel(uint8_t stripID,
+                          LEDColorReg REG,
                           uint16_t phaseShift,
                           uint8_t colorValue,
                           uint16_t brightnessValue);
+    void RecordCommandLatency(uint8_t stripID);
 
     uint16_t getCurveValue(FadeCurve curve,
                            double percent,
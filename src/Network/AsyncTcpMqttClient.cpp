@@ -0,0 +1,615 @@
+#include "AsyncTcpMqttClient.h"
+
+/**
+ * Empty constructor
+ */
+AsyncTcpMqttClient::AsyncTcpMqttClient()
+{
+};
+
+/**
+ * Sets the needed reference for the client
+ */
+void AsyncTcpMqttClient::setReference(ITimeSource *clock)
+{
+    this->clock = clock;
+};
+
+/**
+ * Registers the TCP callbacks. They only set flags and buffer the received bytes
+ * 
+ * @parameter callback  Gets called from Loop() for every received publish
+ */
+void AsyncTcpMqttClient::Begin(std::function<void(char *, uint8_t *, unsigned int)> callback)
+{
+    this->callback = callback;
+
+    this->client.onConnect([this](void *, AsyncClient *)
+                           { this->tcpConnected = true; });
+    this->client.onDisconnect([this](void *, AsyncClient *)
+                              { this->tcpDisconnected = true; });
+    this->client.onData([this](void *, AsyncClient *, void *data, size_t length)
+                        { this->OnData((const uint8_t *)data, length); });
+    this->client.setNoDelay(true);
+};
+
+/**
+ * Builds the connect packet and starts the TCP handshake. Returns right away
+ * 
+ * @return False if the connect packet does not fit or the handshake could not be started
+ */
+bool AsyncTcpMqttClient::Connect(IPAddress brokerIpAddress,
+                                 uint16_t brokerPort,
+                                 const char *clientName,
+                                 const char *username,
+                                 const char *password,
+                                 const char *willTopic,
+                                 uint8_t willQos,
+                                 bool willRetain,
+                                 const char *willMessage,
+                                 bool cleanSession)
+{
+    if (this->state != AsyncMqttClientState::Disconnected)
+    {
+        this->Close(STATE_DISCONNECTED);
+    }
+
+    // ==== Connect packet
+    uint8_t flags = cleanSession ? 0x02 : 0x00;
+    uint16_t remainingLength = 10 + 2 + strlen(clientName);
+    if (willTopic != nullptr)
+    {
+        flags |= 0x04 | (willQos << 3) | (willRetain ? 0x20 : 0x00);
+        remainingLength += 2 + strlen(willTopic) + 2 + strlen(willMessage);
+    }
+    if (username != nullptr)
+    {
+        flags |= 0x80;
+        remainingLength += 2 + strlen(username);
+        if (password != nullptr)
+        {
+            flags |= 0x40;
+            remainingLength += 2 + strlen(password);
+        }
+    }
+
+    uint16_t position = this->EncodeHeader(0x10, remainingLength, this->connectPacket);
+    const uint8_t variableHeader[10] = {0x00, 0x04, 'M', 'Q', 'T', 'T', 0x04, flags,
+                                        (uint8_t)(MQTT_KEEP_ALIVE >> 8), (uint8_t)(MQTT_KEEP_ALIVE & 0xFF)};
+    if (position + sizeof(variableHeader) + remainingLength - 10 > MQTT_CONNECT_PACKET_LENGTH)
+    {
+        this->clientState = STATE_CONNECT_FAILED;
+        return false;
+    }
+    memcpy(this->connectPacket + position, variableHeader, sizeof(variableHeader));
+    position += sizeof(variableHeader);
+    position = this->WriteString(this->connectPacket, position, MQTT_CONNECT_PACKET_LENGTH, clientName);
+    if (willTopic != nullptr)
+    {
+        position = this->WriteString(this->connectPacket, position, MQTT_CONNECT_PACKET_LENGTH, willTopic);
+        position = this->WriteString(this->connectPacket, position, MQTT_CONNECT_PACKET_LENGTH, willMessage);
+    }
+    if (username != nullptr)
+    {
+        position = this->WriteString(this->connectPacket, position, MQTT_CONNECT_PACKET_LENGTH, username);
+        if (password != nullptr)
+        {
+            position = this->WriteString(this->connectPacket, position, MQTT_CONNECT_PACKET_LENGTH, password);
+        }
+    }
+    this->connectPacketLength = position;
+
+    // ==== TCP handshake. Finishes in the background
+    this->tcpConnected = false;
+    this->tcpDisconnected = false;
+    this->ResetReceive();
+    if (!this->client.connect(brokerIpAddress, brokerPort))
+    {
+        this->clientState = STATE_CONNECT_FAILED;
+        return false;
+    }
+
+    this->state = AsyncMqttClientState::ConnectingTCP;
+    this->prevMillisConnect = this->clock->Millis();
+    return true;
+};
+
+/**
+ * Sends the disconnect packet and closes the connection
+ */
+void AsyncTcpMqttClient::Disconnect()
+{
+    if (this->state == AsyncMqttClientState::Connected)
+    {
+        const uint8_t packet[2] = {0xE0, 0x00};
+        this->Send(packet, sizeof(packet), nullptr, nullptr, 0);
+    }
+    this->Close(STATE_DISCONNECTED);
+};
+
+/**
+ * Returns if the TCP handshake or the broker acknowledge is outstanding
+ */
+bool AsyncTcpMqttClient::isConnecting()
+{
+    return this->state == AsyncMqttClientState::ConnectingTCP || this->state == AsyncMqttClientState::ConnectingMQTT;
+};
+
+/**
+ * Returns if the broker accepted the connection
+ */
+bool AsyncTcpMqttClient::isConnected()
+{
+    return this->state == AsyncMqttClientState::Connected;
+};
+
+/**
+ * Returns the client state with the codes of PubSubClient::state()
+ */
+int AsyncTcpMqttClient::getState()
+{
+    return this->clientState;
+};
+
+/**
+ * Sends a subscribe packet
+ * 
+ * @parameter topic The topic. Wildcards are allowed
+ * @parameter qos   The maximum QoS the broker sends with
+ * 
+ * @return True if the subscribe was sent
+ */
+bool AsyncTcpMqttClient::Subscribe(const char *topic, uint8_t qos)
+{
+    if (this->state != AsyncMqttClientState::Connected)
+    {
+        return false;
+    }
+
+    this->packetId = (this->packetId == 0xFFFF) ? 1 : this->packetId + 1;
+    uint8_t head[7];
+    uint8_t headLength = this->EncodeHeader(0x82, 2 + 2 + strlen(topic) + 1, head);
+    head[headLength++] = this->packetId >> 8;
+    head[headLength++] = this->packetId & 0xFF;
+    return this->Send(head, headLength, topic, &qos, 1);
+};
+
+/**
+ * Sends an unsubscribe packet
+ * 
+ * @parameter topic The subscribed topic
+ * 
+ * @return True if the unsubscribe was sent
+ */
+bool AsyncTcpMqttClient::Unsubscribe(const char *topic)
+{
+    if (this->state != AsyncMqttClientState::Connected)
+    {
+        return false;
+    }
+
+    this->packetId = (this->packetId == 0xFFFF) ? 1 : this->packetId + 1;
+    uint8_t head[7];
+    uint8_t headLength = this->EncodeHeader(0xA2, 2 + 2 + strlen(topic), head);
+    head[headLength++] = this->packetId >> 8;
+    head[headLength++] = this->packetId & 0xFF;
+    return this->Send(head, headLength, topic, nullptr, 0);
+};
+
+/**
+ * Sends a publish packet with QoS 0. Never waits for the TCP window
+ * 
+ * @parameter topic     The topic
+ * @parameter payload   The null terminated message
+ * @parameter retained  True to let the broker keep the message
+ * 
+ * @return True if the publish was sent. False if there is no space in the TCP window
+ */
+bool AsyncTcpMqttClient::Publish(const char *topic, const char *payload, bool retained)
+{
+    if (this->state != AsyncMqttClientState::Connected)
+    {
+        return false;
+    }
+
+    uint16_t payloadLength = strlen(payload);
+    uint32_t remainingLength = 2 + strlen(topic) + payloadLength;
+    if (remainingLength > MQTT_BUFFER_SIZE)
+    {
+        return false; // Same limit as the PubSubClient backend
+    }
+
+    uint8_t head[5];
+    uint8_t headLength = this->EncodeHeader(retained ? 0x31 : 0x30, remainingLength, head);
+    return this->Send(head, headLength, topic, (const uint8_t *)payload, payloadLength);
+};
+
+/**
+ * Advances the connection and handles the received packets
+ */
+void AsyncTcpMqttClient::Loop()
+{
+    if (this->tcpDisconnected)
+    {
+        this->tcpDisconnected = false;
+        if (this->state != AsyncMqttClientState::Disconnected)
+        {
+            this->Close(this->state == AsyncMqttClientState::Connected ? STATE_CONNECTION_LOST : STATE_CONNECT_FAILED);
+        }
+    }
+
+    // Bytes got lost or the stream is malformed => The packet stream can not be resynchronized
+    if (this->receiveOverflow)
+    {
+        this->receiveOverflow = false;
+        this->Close(STATE_CONNECTION_LOST);
+    }
+
+    switch (this->state)
+    {
+    case AsyncMqttClientState::Disconnected:
+        break;
+
+    case AsyncMqttClientState::ConnectingTCP:
+    case AsyncMqttClientState::ConnectingMQTT:
+        if (this->state == AsyncMqttClientState::ConnectingTCP && this->tcpConnected)
+        {
+            if (this->Send(this->connectPacket, this->connectPacketLength, nullptr, nullptr, 0))
+            {
+                this->state = AsyncMqttClientState::ConnectingMQTT;
+            }
+        }
+        this->ReadPackets();
+
+        if (this->isConnecting() && this->clock->Millis() - this->prevMillisConnect >= this->TimeOut_Connect)
+        {
+            this->Close(STATE_CONNECTION_TIMEOUT);
+        }
+        break;
+
+    case AsyncMqttClientState::Connected:
+        this->ReadPackets();
+        this->HandleKeepAlive();
+        break;
+    }
+};
+
+/**
+ * Returns the number of received packets that got skipped because they do not fit into the receive buffer
+ */
+uint32_t AsyncTcpMqttClient::getSkippedPacketCount()
+{
+    return this->skippedPacketCount;
+};
+
+/**
+ * Frames the received bytes into packets and appends them to the receive buffer. Called by ESPAsyncTCP.
+ * A packet larger than the receive buffer gets skipped while it arrives => The connection stays up like with PubSubClient
+ * 
+ * @parameter data      The received bytes
+ * @parameter length    The number of received bytes
+ */
+void AsyncTcpMqttClient::OnData(const uint8_t *data, size_t length)
+{
+    size_t position = 0;
+    while (position < length && !this->receiveOverflow)
+    {
+        // ==== Rest of a packet that never fits into the receive buffer
+        if (this->skipLength > 0)
+        {
+            uint32_t count = (length - position < this->skipLength) ? length - position : this->skipLength;
+            this->skipLength -= count;
+            position += count;
+            continue;
+        }
+
+        // ==== Body of the current packet
+        if (this->packetBytesLeft > 0)
+        {
+            uint32_t count = (length - position < this->packetBytesLeft) ? length - position : this->packetBytesLeft;
+            if (this->receiveLength + count > MQTT_BUFFER_SIZE)
+            {
+                this->receiveOverflow = true; // Packets not handled by the loop in time
+                return;
+            }
+            memcpy(this->receiveBuffer + this->receiveLength, data + position, count);
+            this->receiveLength += count;
+            this->packetBytesLeft -= count;
+            position += count;
+            continue;
+        }
+
+        // ==== Fixed header of the next packet. Type and up to 4 bytes remaining length
+        uint8_t value = data[position++];
+        this->packetHeader[this->packetHeaderLength++] = value;
+        if (this->packetHeaderLength == 1 || (value & 0x80) != 0)
+        {
+            if (this->packetHeaderLength == sizeof(this->packetHeader))
+            {
+                this->receiveOverflow = true; // Malformed
+            }
+            continue;
+        }
+
+        uint32_t remainingLength = 0;
+        for (uint8_t i = 1; i < this->packetHeaderLength; i++)
+        {
+            remainingLength |= (uint32_t)(this->packetHeader[i] & 0x7F) << (7 * (i - 1));
+        }
+        if (this->packetHeaderLength + remainingLength > MQTT_BUFFER_SIZE)
+        {
+            this->skipLength = remainingLength;
+            this->skippedPacketCount++;
+        }
+        else if (this->receiveLength + this->packetHeaderLength > MQTT_BUFFER_SIZE)
+        {
+            this->receiveOverflow = true; // Packets not handled by the loop in time
+        }
+        else
+        {
+            memcpy(this->receiveBuffer + this->receiveLength, this->packetHeader, this->packetHeaderLength);
+            this->receiveLength += this->packetHeaderLength;
+            this->packetBytesLeft = remainingLength;
+        }
+        this->packetHeaderLength = 0;
+    }
+};
+
+/**
+ * Clears the receive buffer and the framing of the packet stream
+ */
+void AsyncTcpMqttClient::ResetReceive()
+{
+    this->receiveLength = 0;
+    this->receiveOverflow = false;
+    this->packetHeaderLength = 0;
+    this->packetBytesLeft = 0;
+    this->skipLength = 0;
+};
+
+/**
+ * Handles all complete packets in the receive buffer and keeps the incomplete rest
+ */
+void AsyncTcpMqttClient::ReadPackets()
+{
+    uint16_t position = 0;
+    while (position + 2 <= this->receiveLength)
+    {
+        // ==== Remaining length. Up to 4 bytes, checked by OnData
+        uint32_t remainingLength = 0;
+        uint8_t headerLength = 1;
+        bool complete = false;
+        while (headerLength <= 4 && position + headerLength < this->receiveLength)
+        {
+            uint8_t value = this->receiveBuffer[position + headerLength];
+            remainingLength |= (uint32_t)(value & 0x7F) << (7 * (headerLength - 1));
+            headerLength++;
+            if ((value & 0x80) == 0)
+            {
+                complete = true;
+                break;
+            }
+        }
+        if (!complete || position + headerLength + remainingLength > this->receiveLength)
+        {
+            break; // Rest of the packet not received yet
+        }
+
+        this->HandlePacket(this->receiveBuffer + position, headerLength, remainingLength);
+        if (this->state == AsyncMqttClientState::Disconnected)
+        {
+            return;
+        }
+        position += headerLength + remainingLength;
+    }
+
+    if (position > 0)
+    {
+        memmove(this->receiveBuffer, this->receiveBuffer + position, this->receiveLength - position);
+        this->receiveLength -= position;
+    }
+};
+
+/**
+ * Handles one received packet
+ * 
+ * @parameter packet            The packet in the receive buffer. Gets modified to terminate the topic
+ * @parameter headerLength      The length of the fixed header
+ * @parameter remainingLength   The length of the packet behind the fixed header
+ */
+void AsyncTcpMqttClient::HandlePacket(uint8_t *packet, uint8_t headerLength, uint16_t remainingLength)
+{
+    this->prevMillisReceive = this->clock->Millis();
+    uint8_t *body = packet + headerLength;
+
+    switch (packet[0] & 0xF0)
+    {
+    // ==== CONNACK
+    case 0x20:
+        if (this->state == AsyncMqttClientState::ConnectingMQTT && remainingLength >= 2)
+        {
+            if (body[1] == 0)
+            {
+                this->state = AsyncMqttClientState::Connected;
+                this->clientState = STATE_CONNECTED;
+                this->prevMillisSend = this->prevMillisReceive;
+                this->pingOutstanding = false;
+            }
+            else
+            {
+                this->Close(body[1]); // Refused by the broker
+            }
+        }
+        break;
+
+    // ==== PUBLISH
+    case 0x30:
+    {
+        if (this->state != AsyncMqttClientState::Connected || remainingLength < 2)
+        {
+            break;
+        }
+
+        uint8_t qos = (packet[0] >> 1) & 0x03;
+        uint16_t topicLength = (body[0] << 8) | body[1];
+        uint16_t payloadStart = 2 + topicLength + (qos > 0 ? 2 : 0);
+        if (payloadStart > remainingLength)
+        {
+            break; // Malformed
+        }
+        uint16_t id = (qos > 0) ? (body[2 + topicLength] << 8) | body[3 + topicLength] : 0;
+
+        // Move the topic over its length field => Room for the terminator without a copy
+        memmove(body, body + 2, topicLength);
+        body[topicLength] = '\0';
+        if (this->callback)
+        {
+            this->callback((char *)body, body + payloadStart, remainingLength - payloadStart);
+        }
+
+        if (qos == 1)
+        {
+            const uint8_t puback[4] = {0x40, 0x02, (uint8_t)(id >> 8), (uint8_t)(id & 0xFF)};
+            this->Send(puback, sizeof(puback), nullptr, nullptr, 0);
+        }
+    }
+    break;
+
+    // ==== PINGRESP
+    case 0xD0:
+        this->pingOutstanding = false;
+        break;
+
+    // ==== SUBACK / UNSUBACK / PUBACK
+    default:
+        break;
+    }
+};
+
+/**
+ * Sends a ping when the connection was idle for the keep alive time. Closes the connection if the last ping got no answer
+ */
+void AsyncTcpMqttClient::HandleKeepAlive()
+{
+    unsigned long curMillis = this->clock->Millis();
+    unsigned long keepAlive = MQTT_KEEP_ALIVE * 1000UL;
+    if (curMillis - this->prevMillisReceive < keepAlive && curMillis - this->prevMillisSend < keepAlive)
+    {
+        return;
+    }
+
+    if (this->pingOutstanding)
+    {
+        this->Close(STATE_CONNECTION_TIMEOUT);
+        return;
+    }
+
+    const uint8_t pingreq[2] = {0xC0, 0x00};
+    if (this->Send(pingreq, sizeof(pingreq), nullptr, nullptr, 0))
+    {
+        this->prevMillisReceive = curMillis;
+        this->pingOutstanding = true;
+    }
+};
+
+/**
+ * Closes the TCP connection
+ * 
+ * @parameter clientState   The state reported by getState()
+ */
+void AsyncTcpMqttClient::Close(int clientState)
+{
+    this->client.close(true);
+    this->state = AsyncMqttClientState::Disconnected;
+    this->clientState = clientState;
+    this->tcpConnected = false;
+    this->ResetReceive();
+};
+
+/**
+ * Writes the fixed header of a packet
+ * 
+ * @parameter type              The packet type and flags
+ * @parameter remainingLength   The length of the packet behind the fixed header
+ * @parameter header            At least 4 bytes
+ * 
+ * @return The length of the fixed header
+ */
+uint8_t AsyncTcpMqttClient::EncodeHeader(uint8_t type, uint16_t remainingLength, uint8_t *header)
+{
+    uint8_t length = 0;
+    header[length++] = type;
+    do
+    {
+        uint8_t value = remainingLength & 0x7F;
+        remainingLength >>= 7;
+        header[length++] = (remainingLength > 0) ? (value | 0x80) : value;
+    } while (remainingLength > 0);
+    return length;
+};
+
+/**
+ * Writes a string with its 2 byte length
+ * 
+ * @parameter buffer    The packet
+ * @parameter position  The write position
+ * @parameter size      The size of the packet buffer
+ * @parameter text      The null terminated string
+ * 
+ * @return The position behind the string
+ */
+uint16_t AsyncTcpMqttClient::WriteString(uint8_t *buffer, uint16_t position, uint16_t size, const char *text)
+{
+    uint16_t length = strlen(text);
+    if (position + 2 + length > size)
+    {
+        return position; // Checked by the caller before
+    }
+
+    buffer[position++] = length >> 8;
+    buffer[position++] = length & 0xFF;
+    memcpy(buffer + position, text, length);
+    return position + length;
+};
+
+/**
+ * Queues a packet in the TCP window. Never waits for the window to free up
+ * 
+ * @parameter head          The fixed header and the variable header before the topic
+ * @parameter headLength    The length of the head
+ * @parameter topic         Written with its 2 byte length. Optional
+ * @parameter data          The bytes behind the topic. Optional
+ * @parameter dataLength    The length of the data
+ * 
+ * @return True if the packet was sent. False if the connection is closed or the window is full
+ */
+bool AsyncTcpMqttClient::Send(const uint8_t *head, uint16_t headLength, const char *topic, const uint8_t *data, uint16_t dataLength)
+{
+    if (!this->client.connected())
+    {
+        return false;
+    }
+
+    uint16_t topicLength = (topic != nullptr) ? strlen(topic) : 0;
+    size_t packetLength = headLength + ((topic != nullptr) ? 2 + topicLength : 0) + dataLength;
+    if (this->client.space() < packetLength)
+    {
+        return false;
+    }
+
+    this->client.add((const char *)head, headLength, ASYNC_WRITE_FLAG_COPY);
+    if (topic != nullptr)
+    {
+        const uint8_t topicLengthField[2] = {(uint8_t)(topicLength >> 8), (uint8_t)(topicLength & 0xFF)};
+        this->client.add((const char *)topicLengthField, sizeof(topicLengthField), ASYNC_WRITE_FLAG_COPY);
+        this->client.add(topic, topicLength, ASYNC_WRITE_FLAG_COPY);
+    }
+    if (dataLength > 0)
+    {
+        this->client.add((const char *)data, dataLength, ASYNC_WRITE_FLAG_COPY);
+    }
+    this->client.send();
+
+    this->prevMillisSend = this->clock->Millis();
+    return true;
+};
@@ -0,0 +1,103 @@
+#pragma once
+
+// Includes
+#include <ESPAsyncTCP.h>
+#include <Arduino.h>
+#include "../Enums/Enums.h"
+#include "../Constants/Constants.h"
+
+// Interface
+#include "../Interface/IMqttClient.h"
+#include "../Interface/ITimeSource.h"
+
+// Classes
+/**
+ * @brief The AsyncTcpMqttClient Class connects the network component to the broker without blocking the loop.
+ * Implements the subset of MQTT 3.1.1 the network component uses on top of ESPAsyncTCP.
+ * The TCP callbacks only buffer the received bytes, the packets get handled in Loop() => Same context as PubSubClient
+ * 
+ */
+class AsyncTcpMqttClient : public IMqttClient
+{
+    // ## Constructor / Important ## //
+public:
+    AsyncTcpMqttClient();
+    void setReference(ITimeSource *clock);
+
+    // ## Interface ## //
+private:
+public:
+    virtual void Begin(std::function<void(char *, uint8_t *, unsigned int)> callback);
+    virtual bool Connect(IPAddress brokerIpAddress,
+                         uint16_t brokerPort,
+                         const char *clientName,
+                         const char *username,
+                         const char *password,
+                         const char *willTopic,
+                         uint8_t willQos,
+                         bool willRetain,
+                         const char *willMessage,
+                         bool cleanSession);
+    virtual void Disconnect();
+    virtual bool isConnecting();
+    virtual bool isConnected();
+    virtual int getState();
+    virtual bool Subscribe(const char *topic, uint8_t qos);
+    virtual bool Unsubscribe(const char *topic);
+    virtual bool Publish(const char *topic, const char *payload, bool retained);
+    virtual void Loop();
+    uint32_t getSkippedPacketCount();
+
+    // ## Data ## //
+private:
+    ITimeSource *clock;
+
+    AsyncClient client;
+    std::function<void(char *, uint8_t *, unsigned int)> callback;
+    AsyncMqttClientState state = AsyncMqttClientState::Disconnected;
+    int clientState = -1; // Same codes as PubSubClient::state()
+
+    // ---- PubSubClient state codes
+    const int STATE_CONNECTION_TIMEOUT = -4;
+    const int STATE_CONNECTION_LOST = -3;
+    const int STATE_CONNECT_FAILED = -2;
+    const int STATE_DISCONNECTED = -1;
+    const int STATE_CONNECTED = 0;
+
+    // ---- Set by the TCP callbacks
+    volatile bool tcpConnected = false;
+    volatile bool tcpDisconnected = false;
+
+    // ---- Packets
+    uint8_t connectPacket[MQTT_CONNECT_PACKET_LENGTH]{0}; // Built on connect, sent once the TCP connection is open
+    uint16_t connectPacketLength = 0;
+    uint8_t receiveBuffer[MQTT_BUFFER_SIZE]{0}; // Only packets that fit as a whole
+    uint16_t receiveLength = 0;
+    bool receiveOverflow = false;
+    uint8_t packetHeader[5]{0}; // Fixed header of the next packet while it arrives
+    uint8_t packetHeaderLength = 0;
+    uint32_t packetBytesLeft = 0; // Bytes of the current packet still to receive
+    uint32_t skipLength = 0;      // Bytes of a packet larger than the receive buffer still to skip
+    uint32_t skippedPacketCount = 0;
+    uint16_t packetId = 0;
+
+    // ---- Timeouts
+    unsigned long prevMillisConnect = 0;
+    const unsigned long TimeOut_Connect = 5000; // 5 sec => TCP handshake and broker acknowledge
+    unsigned long prevMillisSend = 0;
+    unsigned long prevMillisReceive = 0;
+    const uint16_t MQTT_KEEP_ALIVE = 15; // sec. Same as PubSubClient
+    bool pingOutstanding = false;
+
+    // ## Functions ## //
+private:
+    void OnData(const uint8_t *data, size_t length);
+    void ResetReceive();
+    void ReadPackets();
+    void HandlePacket(uint8_t *packet, uint8_t headerLength, uint16_t remainingLength);
+    void HandleKeepAlive();
+    void Close(int clientState);
+    uint8_t EncodeHeader(uint8_t type, uint16_t remainingLength, uint8_t *header);
+    uint16_t WriteString(uint8_t *buffer, uint16_t position, uint16_t size, const char *text);
+    bool Send(const uint8_t *head, uint16_t headLength, const char *topic, const uint8_t *data, uint16_t dataLength);
+};
@@ -0,0 +1,38 @@
+#pragma once
+
+// Home Assistant mqtt discovery templates. Only the entity specific part of the config is stored here.
+// The network component frames it with the base topic "~", the unique id, the availability and the device
+// => {"~":"LEDController/<client name><base>","uniq_id":"<client name>_<object id>","avty_t":"...",<config>,"dev":{...}}
+// Abbreviations see https://www.home-assistant.io/docs/mqtt/discovery/
+
+const char DiscoveryModel[] = "12V LED Controller Mk4";
+
+// ================ Strips ================ //
+// White is the color temperature in mired. Brightness uses the full 12 bit range of the PCA9685
+const char DiscoveryConfigStrip1[] PROGMEM = "\"name\":\"Strip 1\",\"cmd_t\":\"~/Power/command\",\"stat_t\":\"~/Power/state\",\"pl_on\":\"1\",\"pl_off\":\"0\",\"rgb_cmd_t\":\"~/RGB/command\",\"rgb_stat_t\":\"~/RGB/state\",\"bri_cmd_t\":\"~/RGB/Brightness/command\",\"bri_stat_t\":\"~/RGB/Brightness/state\",\"bri_scl\":4095,\"clr_temp_cmd_t\":\"~/White/command\",\"clr_temp_stat_t\":\"~/White/state\",\"fx_cmd_t\":\"~/Effect/command\",\"fx_stat_t\":\"~/Effect/state\",\"fx_list\":[\"None\",\"TriplePulse\",\"Rainbow\"]";
+const char DiscoveryConfigStrip2[] PROGMEM = "\"name\":\"Strip 2\",\"cmd_t\":\"~/Power/command\",\"stat_t\":\"~/Power/state\",\"pl_on\":\"1\",\"pl_off\":\"0\",\"rgb_cmd_t\":\"~/RGB/command\",\"rgb_stat_t\":\"~/RGB/state\",\"bri_cmd_t\":\"~/RGB/Brightness/command\",\"bri_stat_t\":\"~/RGB/Brightness/state\",\"bri_scl\":4095,\"clr_temp_cmd_t\":\"~/White/command\",\"clr_temp_stat_t\":\"~/White/state\",\"fx_cmd_t\":\"~/Effect/command\",\"fx_stat_t\":\"~/Effect/state\",\"fx_list\":[\"None\",\"TriplePulse\",\"Rainbow\"]";
+
+// ================ Motion ================ //
+const char DiscoveryConfigMotion[] PROGMEM = "\"name\":\"Motion\",\"stat_t\":\"~/state\",\"pl_on\":\"1\",\"pl_off\":\"0\",\"dev_cla\":\"motion\"";
+
+// ================ Electrical Measurement ================ //
+const char DiscoveryConfigPower[] PROGMEM = "\"name\":\"Power\",\"stat_t\":\"~/CurrentPower/state\",\"unit_of_meas\":\"mW\",\"dev_cla\":\"power\",\"stat_cla\":\"measurement\"";
+const char DiscoveryConfigVoltage[] PROGMEM = "\"name\":\"Voltage\",\"stat_t\":\"~/BusVoltage/state\",\"unit_of_meas\":\"V\",\"dev_cla\":\"voltage\",\"stat_cla\":\"measurement\"";
+const char DiscoveryConfigCurrent[] PROGMEM = "\"name\":\"Current\",\"stat_t\":\"~/CurrentAmpere/state\",\"unit_of_meas\":\"mA\",\"dev_cla\":\"current\",\"stat_cla\":\"measurement\"";
+
+// ================ Diagnostics ================ //
+const char DiscoveryConfigIPAddress[] PROGMEM = "\"name\":\"IP Address\",\"stat_t\":\"~/IPAddress/state\",\"ent_cat\":\"diagnostic\"";
+const char DiscoveryConfigPublishQueueDropped[] PROGMEM = "\"name\":\"Publish Queue Dropped\",\"stat_t\":\"~/PublishQueue/Dropped/state\",\"stat_cla\":\"total_increasing\",\"ent_cat\":\"diagnostic\"";
+const char DiscoveryConfigVersion[] PROGMEM = "\"name\":\"Version\",\"stat_t\":\"~/Version\",\"ent_cat\":\"diagnostic\"";
+
+// ================ Table ================ //
+const NetworkDiscoveryDefinition discoveryDefinitions[MQTT_DISCOVERY_COUNT] = {
+    {"light", "strip1", "/HomeAssistant/Strip1", DiscoveryConfigStrip1},
+    {"light", "strip2", "/HomeAssistant/Strip2", DiscoveryConfigStrip2},
+    {"binary_sensor", "motion", "/HomeAssistant/Motion", DiscoveryConfigMotion},
+    {"sensor", "power", "/HomeAssistant/ElectricalMesurement", DiscoveryConfigPower},
+    {"sensor", "voltage", "/HomeAssistant/ElectricalMesurement", DiscoveryConfigVoltage},
+    {"sensor", "current", "/HomeAssistant/ElectricalMesurement", DiscoveryConfigCurrent},
+    {"sensor", "ipaddress", "/HomeAssistant/Network", DiscoveryConfigIPAddress},
+    {"sensor", "publishqueuedropped", "/HomeAssistant/Network", DiscoveryConfigPublishQueueDropped},
+    {"sensor", "version", "", DiscoveryConfigVersion}};
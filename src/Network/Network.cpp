@@ -1,30 +1,87 @@
 #include "Network.h"
+#include "HomeAssistantDiscovery.h"
+
+// Every topic the callback reacts on. Static => One table instead of a copy in every network object
+const NetworkTopicDefinition Network::topicDefinitions[MQTT_TOPIC_COUNT] = {
+    // HomeAssistant global
+    {NetworkTopic::HomeAssistantSun, true, "HomeAssistant/Sun/command"},
+    {NetworkTopic::HomeAssistantMasterPresent, true, "HomeAssistant/MasterPresent/command"},
+    {NetworkTopic::HomeAssistantAlarm, true, "HomeAssistant/Effect/Alarm/command"},
+    // HomeAssistant motion
+    {NetworkTopic::HomeAssistantMotionBrightnessTimeBasedEnabled, false, "HomeAssistant/MotionDetection/BrightnessTimeBasedEnabled/command"},
+    {NetworkTopic::HomeAssistantMotionEnabled, false, "HomeAssistant/MotionDetection/Enabled/command"},
+    {NetworkTopic::HomeAssistantMotionTimeout, false, "HomeAssistant/MotionDetection/Timeout/command"},
+    {NetworkTopic::HomeAssistantMotionRGB, false, "HomeAssistant/MotionDetection/RGB/command"},
+    {NetworkTopic::HomeAssistantMotionRGBBrightness, false, "HomeAssistant/MotionDetection/RGB/Brightness/command"},
+    {NetworkTopic::HomeAssistantMotionWhite, false, "HomeAssistant/MotionDetection/White/command"},
+    {NetworkTopic::HomeAssistantMotionWhiteBrightness, false, "HomeAssistant/MotionDetection/White/Brightness/command"},
+    // HomeAssistant strip 1
+    {NetworkTopic::HomeAssistantStrip1Power, false, "HomeAssistant/Strip1/Power/command"},
+    {NetworkTopic::HomeAssistantStrip1RGB, false, "HomeAssistant/Strip1/RGB/command"},
+    {NetworkTopic::HomeAssistantStrip1RGBBrightness, false, "HomeAssistant/Strip1/RGB/Brightness/command"},
+    {NetworkTopic::HomeAssistantStrip1White, false, "HomeAssistant/Strip1/White/command"},
+    {NetworkTopic::HomeAssistantStrip1WhiteBrightness, false, "HomeAssistant/Strip1/White/Brightness/command"},
+    {NetworkTopic::HomeAssistantStrip1Effect, false, "HomeAssistant/Strip1/Effect/command"},
+    // HomeAssistant strip 2
+    {NetworkTopic::HomeAssistantStrip2Power, false, "HomeAssistant/Strip2/Power/command"},
+    {NetworkTopic::HomeAssistantStrip2RGB, false, "HomeAssistant/Strip2/RGB/command"},
+    {NetworkTopic::HomeAssistantStrip2RGBBrightness, false, "HomeAssistant/Strip2/RGB/Brightness/command"},
+    {NetworkTopic::HomeAssistantStrip2White, false, "HomeAssistant/Strip2/White/command"},
+    {NetworkTopic::HomeAssistantStrip2WhiteBrightness, false, "HomeAssistant/Strip2/White/Brightness/command"},
+    {NetworkTopic::HomeAssistantStrip2Effect, false, "HomeAssistant/Strip2/Effect/command"},
+    // HomeAssistant virtual
+    // !!! Make sure that the retain flag is set to false for messages in this topic for this to work probably !!!
+    {NetworkTopic::HomeAssistantVirtualPIR, false, "HomeAssistant/Virtual/PIR/command"},
+    // JSON
+    {NetworkTopic::JSONSun, true, "JSON/Sun/command"},
+    {NetworkTopic::JSONMasterPresent, true, "JSON/MasterPresent/command"},
+    {NetworkTopic::JSONAlarm, true, "JSON/Effect/Alarm/command"},
+    {NetworkTopic::JSONMotionDetection, false, "JSON/MotionDetection/command"},
+    {NetworkTopic::JSONStrip1, false, "JSON/Strip1/command"},
+    {NetworkTopic::JSONStrip2, false, "JSON/Strip2/command"},
+    {NetworkTopic::JSONVirtualPIR, false, "JSON/Virtual/PIR/command"},
+    // Profiler
+    {NetworkTopic::ProfilerEnabled, false, "Profiler/Enabled/command"},
+    {NetworkTopic::ProfilerReset, false, "Profiler/Reset/command"},
+    // Group
+    {NetworkTopic::GroupMembership, false, "Group/Membership/command"},
+};
 
 /**
  * @brief Construct a new Network::Network object
  * 
  */
-Network::Network(String codeVersion)
+Network::Network(String codeVersion, bool persistentSession, uint32_t heartbeatInterval)
 {
     this->codeVersion = codeVersion;
+    this->persistentSession = persistentSession;
+    this->timeoutPublishHeartbeat = heartbeatInterval;
 };
 
 /**
  * @brief Sets the needed refernce for the helper
  */
-void Network::setReference(Filesystem *filesystem,
+void Network::setReference(IMqttClient *mqttClient,
+                           Filesystem *filesystem,
                            Helper *helper,
                            Information *information,
                            PirReader *pirReader,
                            PowerMeasurement *powerMeasurement,
-                           Parameterhandler *parameterhandler)
+                           Parameterhandler *parameterhandler,
+                           Realtime *realtime,
+                           Profiler *profiler,
+                           ITimeSource *clock)
 {
+    this->mqttClient = mqttClient;
     this->filesystem = filesystem;
     this->helper = helper;
     this->information = information;
     this->pirReader = pirReader;
     this->powerMeasurement = powerMeasurement;
     this->parameterhandler = parameterhandler;
+    this->realtime = realtime;
+    this->profiler = profiler;
+    this->clock = clock;
 };
 
 /**
@@ -42,6 +99,8 @@ bool Network::Init()
 
         this->networkMotionData.VirtualPIRSensorTriggered = false;
 
+        this->mqttClient->Begin(std::bind(&Network::MqttCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+
         Serial.println(F("Network initialized"));
         init = true;
     }
@@ -89,16 +148,21 @@ void Network::Run()
     HandleWiFi(this->shutdownWiFi);
 
     // ==== MQTT ==== //
-    mqttClient.loop();
+    this->mqttClient->Loop();
     HandleMqtt();
 
     // ==== NTP ==== //
     HandleNTP();
 
+    // ==== MOTION EVENTS ==== //
+    HandleMotionEvents();
+
     // ==== REPUBLISH ==== //
     HandleRepublish();
+    HandlePublishQueue();
 
     // ======== Information Print ======== //
+    // One at a time => Saving and printing a data set takes a while
     if (this->motionDetectionDataPrint)
     {
         // We use here the same flag for our parameter update
@@ -116,10 +180,11 @@ void Network::Run()
                                              String(this->getNetworkMotionData().WhiteTemperature),
                                              String(this->getNetworkMotionData().WhiteTemperatureBrightness));
     }
-    if (this->ledStripDataPrint[0])
+    else if (this->ledStripDataPrint[0])
     {
         // We use here the same flag for our parameter update
         this->parameterhandler->updateLEDStripParameter(0, this->getNetworkLEDStripData(1));
+        this->parameterhandler->stampLEDStripCommand(0, ProfilerComponent::CommandMQTT, this->ledStripCommandMicros[0]);
 
         this->ledStripDataPrint[0] = false;
         this->information->FormatPrintLEDStrip("LED Strip 1",
@@ -140,10 +205,11 @@ void Network::Run()
                                                this->helper->FadeCurveToString(this->getNetworkLEDStripData(1).WhiteTemperatureBrightnessFadeCurve),
                                                this->helper->SingleLEDEffectToString(this->getNetworkLEDStripData(1).Effect));
     }
-    if (this->ledStripDataPrint[1])
+    else if (this->ledStripDataPrint[1])
     {
         // We use here the same flag for our parameter update
         this->parameterhandler->updateLEDStripParameter(1, this->getNetworkLEDStripData(2));
+        this->parameterhandler->stampLEDStripCommand(1, ProfilerComponent::CommandMQTT, this->ledStripCommandMicros[1]);
 
         this->ledStripDataPrint[1] = false;
         this->information->FormatPrintLEDStrip("LED Strip 2",
@@ -166,6 +232,26 @@ void Network::Run()
     }
 };
 
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority Network::getRunPriority()
+{
+    return SchedulerPriority::Normal;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t Network::getRunBudget()
+{
+    return 5000; // MQTT loop and publishes
+};
+
 /**
  * @brief Handles the access point
  * 
@@ -294,7 +380,7 @@ void Network::HandleWiFi(bool shutdown)
         if (WiFi.status() != WL_CONNECTED)
         {
             this->wifiState = NetworkWiFiState::CheckWiFiDisconnect;
-            PrevMillis_WiFiTimeout = millis();
+            PrevMillis_WiFiTimeout = this->clock->Millis();
         }
         else
         {
@@ -311,7 +397,7 @@ void Network::HandleWiFi(bool shutdown)
         if (WiFi.status() != WL_CONNECTED)
         {
             // Wait for timeout. After timeout restart WiFi
-            unsigned long CurMillis_WiFiTimeout = millis();
+            unsigned long CurMillis_WiFiTimeout = this->clock->Millis();
             if (CurMillis_WiFiTimeout - PrevMillis_WiFiTimeout >= TimeOut_WiFiTimeout)
             {
                 this->WiFiConnected = false;
@@ -358,6 +444,7 @@ void Network::HandleWiFi(bool shutdown)
  * Handels the MQTT connection after the wifi is connected
  * Subscribes to a list pre defined topics
  * Auto reconnects after dc and resubscribes to the defined topics
+ * Every call does at most one bounded step, so a reconnect never stalls the led frames
  */
 void Network::HandleMqtt()
 {
@@ -381,119 +468,92 @@ void Network::HandleMqtt()
     }
 
     // Client state for this->helper print
-    clientState = mqttClient.state();
+    clientState = this->mqttClient->getState();
 
     switch (this->mqttState)
     {
+        // ================================ StartMQTT ================================ //
     case NetworkMQTTState::StartMQTT:
         // Only try reconnect when WiFi is connected
         if (this->WiFiConnected && this->filesystem->isConfigurationDataReady())
         {
-            FilesystemConfigurationData data = this->filesystem->getConfigurationData();
+            unsigned long CurMillis_MQTTRetry = this->clock->Millis();
+            if (CurMillis_MQTTRetry - PrevMillis_MQTTRetry >= TimeOut_MQTTRetry + this->mqttRetryJitter)
+            {
+                PrevMillis_MQTTRetry = CurMillis_MQTTRetry;
 
-            mqttClient.setClient(wifiMqtt);
-            mqttClient.setServer(data.MQTTBrokerIpAddress.c_str(),
-                                 data.MQTTBrokerPort);
-            mqttClient.setCallback(std::bind(&Network::MqttCallback, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3));
+                FilesystemConfigurationData data = this->filesystem->getConfigurationData();
 
-            if (mqttClient.connect(data.MQTTClientName.c_str(),
-                                   data.MQTTBrokerUsername.c_str(),
-                                   data.MQTTBrokerPassword.c_str()))
-            {
-                // ================ HomeAssistant ================ //
-                /*
-                    These Mqtt paths are for the paths given for the desired behavior when controlloing over homeassistant
-                */
-                // ==== Global ==== //
-                // Sun
-                mqttClient.subscribe("LEDController/Global/HomeAssistant/Sun/command");
-
-                // Master
-                mqttClient.subscribe("LEDController/Global/HomeAssistant/MasterPresent/command");
-
-                // Alarm
-                mqttClient.subscribe("LEDController/Global/HomeAssistant/Effect/Alarm/command");
-
-                // Code Version
-                // The installed code version of the LED Controller Mk4.1 is published under the following path on connect
-                // "LEDController/" + data.MQTTClientName + "/Version"
-
-                // ==== Specific ==== //
-                // Motion
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/BrightnessTimeBasedEnabled/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/Enabled/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/White/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/White/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/MotionDetection/Timeout/command").c_str());
-
-                // Strip 1
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/Power/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/RGB/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/RGB/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/White/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/White/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip1/Effect/command").c_str());
-
-                // Strip 2
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/Power/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/RGB/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/RGB/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/White/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/White/Brightness/command").c_str());
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Strip2/Effect/command").c_str());
-
-                // ==== Virtual ==== //
-                // PIR
-                /*
-                    !!! Make sure that the retain flag is set to false for messages in this topic for this to work probably !!!
-                    !!! You may need to clear all messages in the history of this topic with retain flag set to true !!!
-                */
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/HomeAssistant/Virtual/PIR/command").c_str());
-
-                // ================ Json ================ //
-                /*
-                    These Mqtt paths are for the paths given for the desired behavior when controlloing over custom json data
-                */
-                // ==== Global ==== //
-                mqttClient.subscribe("LEDController/Global/JSON/Sun/command");
-                mqttClient.subscribe("LEDController/Global/JSON/MasterPresent/command");
-                mqttClient.subscribe("LEDController/Global/JSON/Effect/Alarm/command");
-
-                // ==== Specific ==== //
-                // Motion
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/JSON/MotionDetection/command").c_str());
-
-                // Strip 1
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/JSON/Strip1/command").c_str());
-
-                // Strip 2
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/JSON/Strip2/command").c_str());
-
-                // PIR
-                mqttClient.subscribe(("LEDController/" + data.MQTTClientName + "/JSON/Virtual/PIR/command").c_str());
-
-                // === Republish == //
-                this->UpdateNetworkLEDStripData(0, this->networkLEDStripData[0], true);
-                this->UpdateNetworkLEDStripData(1, this->networkLEDStripData[1], true);
-                this->UpdateNetworkMotionData(this->networkMotionData, true);
-                PublishMotionDetected();
-                PublishNetwork();
-                PublishHeartbeat();
-                PublishElectricalMeasurement();
-                PublishCodeVersion();
-
-                mqttState = NetworkMQTTState::SuperviseMQTTConnection;
+                // The broker is normally given as ip address => Name lookup only as bounded fallback
+                IPAddress brokerIpAddress;
+                if (!brokerIpAddress.fromString(data.MQTTBrokerIpAddress.c_str()))
+                {
+                    if (!WiFi.hostByName(data.MQTTBrokerIpAddress.c_str(), brokerIpAddress, MQTT_DNS_TIMEOUT))
+                    {
+                        break;
+                    }
+                }
+
+                // The broker publishes the retained last will when the connection drops without a disconnect
+                this->BuildTopicTable();
+                if (this->mqttClient->Connect(brokerIpAddress,
+                                              data.MQTTBrokerPort,
+                                              data.MQTTClientName.c_str(),
+                                              data.MQTTBrokerUsername.c_str(),
+                                              data.MQTTBrokerPassword.c_str(),
+                                              this->getAvailabilityTopic(), 1, true, MQTT_AVAILABILITY_OFFLINE,
+                                              !this->persistentSession))
+                {
+                    mqttState = NetworkMQTTState::ConnectMQTT;
+                }
+                else
+                {
+                    // Spread the retries of many controllers after a broker restart
+                    this->mqttRetryJitter = random(this->TimeOut_MQTTRetryJitter);
+                }
             }
         }
         break;
 
+        // ================================ ConnectMQTT ================================ //
+    case NetworkMQTTState::ConnectMQTT:
+        // The blocking client returns connected or failed from Connect. The asynchronous client connects in the background
+        if (this->mqttClient->isConnected())
+        {
+            mqttState = NetworkMQTTState::SubscribeMQTT;
+        }
+        else if (!this->mqttClient->isConnecting())
+        {
+            // Spread the retries of many controllers after a broker restart
+            this->mqttRetryJitter = random(this->TimeOut_MQTTRetryJitter);
+            mqttState = NetworkMQTTState::StartMQTT;
+        }
+        break;
+
+        // ================================ SubscribeMQTT ================================ //
+    case NetworkMQTTState::SubscribeMQTT:
+        if (!this->mqttClient->isConnected())
+        {
+            mqttState = NetworkMQTTState::StartMQTT;
+        }
+        else
+        {
+            this->Subscribe();
+
+            // Birth message => Replaces the retained last will
+            this->mqttClient->Publish(this->getAvailabilityTopic(), MQTT_AVAILABILITY_ONLINE, true);
+
+            this->StartRepublish();
+            mqttState = NetworkMQTTState::SuperviseMQTTConnection;
+        }
+        break;
+
+        // ================================ SuperviseMQTTConnection ================================ //
     case NetworkMQTTState::SuperviseMQTTConnection:
-        if (!mqttClient.connected())
+        if (!this->mqttClient->isConnected())
         {
             mqttState = NetworkMQTTState::CheckMQTTDisconnect; // Check if dc occurred
-            PrevMillis_MQTTTimeout = millis();                 // Set time for WiFi timeout check
+            PrevMillis_MQTTTimeout = this->clock->Millis();    // Set time for WiFi timeout check
         }
         else
         {
@@ -501,16 +561,17 @@ void Network::HandleMqtt()
         }
         break;
 
+        // ================================ CheckMQTTDisconnect ================================ //
     case NetworkMQTTState::CheckMQTTDisconnect:
-        if (!mqttClient.connected())
+        if (!this->mqttClient->isConnected())
         {
             // Wait for timeout. After timeout restart WiFi
-            unsigned long CurMillis_MQTTTimeout = millis();
+            unsigned long CurMillis_MQTTTimeout = this->clock->Millis();
             if (CurMillis_MQTTTimeout - PrevMillis_MQTTTimeout >= TimeOut_MQTTTimeout)
             {
                 this->MQTTConnected = false;
                 PrevMillis_MQTTTimeout = CurMillis_MQTTTimeout;
-                mqttClient.disconnect(); // Disconnect MQTT and start new connection
+                this->mqttClient->Disconnect(); // Disconnect MQTT and start new connection
                 mqttState = NetworkMQTTState::StartMQTT;
             }
         }
@@ -526,8 +587,111 @@ void Network::HandleMqtt()
     }
 };
 
+/**
+ * @brief Builds the availability topic "LEDController/<client name>/Availability" behind the cached prefix
+ * 
+ * @return The topic. Valid until the next publish
+ */
+const char *Network::getAvailabilityTopic()
+{
+    strncpy(this->publishTopic + this->publishTopicPrefixLength, "Availability", MQTT_TOPIC_LENGTH - this->publishTopicPrefixLength - 1);
+    return this->publishTopic;
+};
+
+/**
+ * @brief Subscribes to all topics of this controller, of its groups and to the global topics with wildcards.
+ * The callback resolves the topics with the topic table. Topics without a handler (e.g. our own states) get ignored there
+ * 
+ */
+void Network::Subscribe()
+{
+    // QoS 1 => The broker keeps missed commands while a persistent session is disconnected
+    uint8_t qos = this->persistentSession ? 1 : 0;
+
+    // ==== Global ==== //
+    this->mqttClient->Subscribe("LEDController/Global/#", qos);
+
+    // ==== Specific ==== //
+    strncpy(this->publishTopic + this->publishTopicPrefixLength, "#", MQTT_TOPIC_LENGTH - this->publishTopicPrefixLength - 1);
+    this->mqttClient->Subscribe(this->publishTopic, qos);
+
+    // ==== Groups ==== //
+    this->SubscribeGroups();
+
+    // ==== Home Assistant ==== //
+    this->mqttClient->Subscribe(MQTT_DISCOVERY_STATUS_TOPIC, 0);
+};
+
+/**
+ * @brief Starts the republish of the discovery configs and the states in the background.
+ * Random start => A fleet does not publish at once
+ * 
+ */
+void Network::StartRepublish()
+{
+    this->republishStep = 0;
+    this->republishPending = true;
+    this->PrevMillis_RepublishStep = this->clock->Millis();
+    this->republishStepDelay = random(this->TimeOut_RepublishJitter);
+};
+
+/**
+ * @brief Republishes one group of states after the connect
+ * 
+ * @param step The group to publish. Starts with 0
+ * @return True if all groups are published
+ */
+bool Network::RepublishStep(uint8_t step)
+{
+    // Discovery first => Home Assistant knows the entities before their states arrive
+    if (step < MQTT_DISCOVERY_COUNT)
+    {
+        this->PublishDiscovery(step);
+        return false;
+    }
+
+    switch (step - MQTT_DISCOVERY_COUNT)
+    {
+    case 0:
+        this->UpdateNetworkLEDStripData(1, this->networkLEDStripData[0], true);
+        break;
+    case 1:
+        this->UpdateNetworkLEDStripData(2, this->networkLEDStripData[1], true);
+        break;
+    case 2:
+        this->UpdateNetworkMotionData(this->networkMotionData, true);
+        break;
+    case 3:
+        PublishMotionDetected();
+        break;
+    case 4:
+        PublishNetwork();
+        break;
+    case 5:
+        if (this->timeoutPublishHeartbeat > 0)
+        {
+            PublishHeartbeat();
+        }
+        break;
+    case 6:
+        PublishElectricalMeasurement();
+        break;
+    case 7:
+        PublishCodeVersion();
+        break;
+    case 8:
+        PublishGroupMembership();
+        break;
+    default:
+        return true;
+    }
+
+    return false;
+};
+
 /**
  * Handles the Network Time Protocol for accurate time updates
+ * The request is sent in one call and the response is polled in the following calls => Never waits for the server
  */
 void Network::HandleNTP()
 {
@@ -536,7 +700,8 @@ void Network::HandleNTP()
     {
         // ================================ StartNTP ================================ //
     case NetworkNTPState::StartNTP:
-        this->ntpTimeClient.begin();
+        this->ntpUDP.begin(NTP_LOCAL_PORT);
+        this->ntpRequestPending = true; // First update right after the connect
         this->ntpState = NetworkNTPState::SuperviseNTPConnection;
         break;
 
@@ -545,24 +710,15 @@ void Network::HandleNTP()
         if (this->WiFiConnected)
         {
             // Get Time update
-            unsigned long CurMillis_NTPTimeout = millis();
-            if (CurMillis_NTPTimeout - this->PrevMillis_NTPTimeout >= this->TimeOut_NTPTimeout)
+            unsigned long CurMillis_NTPTimeout = this->clock->Millis();
+            if (CurMillis_NTPTimeout - this->PrevMillis_NTPTimeout >= this->TimeOut_NTPTimeout || this->ntpRequestPending)
             {
                 this->PrevMillis_NTPTimeout = CurMillis_NTPTimeout;
-                bool updateSuccessful = this->ntpTimeClient.update();
-
-                if (updateSuccessful)
+                if (this->SendNTPRequest())
                 {
-                    this->networkTimeData.hour = this->ntpTimeClient.getHours();
-                    this->networkTimeData.minute = this->ntpTimeClient.getMinutes();
-                    this->networkTimeData.second = this->ntpTimeClient.getSeconds();
-                    this->networkTimeData.unix = this->ntpTimeClient.getEpochTime();
-
-                    this->information->FormatPrintTime("Time",
-                                                       String(this->networkTimeData.hour),
-                                                       String(this->networkTimeData.minute),
-                                                       String(this->networkTimeData.second),
-                                                       String(this->networkTimeData.unix));
+                    this->ntpRequestPending = false;
+                    this->PrevMillis_NTPResponse = CurMillis_NTPTimeout;
+                    this->ntpState = NetworkNTPState::WaitNTPResponse;
                 }
             }
         }
@@ -572,11 +728,50 @@ void Network::HandleNTP()
         }
         break;
 
+        // ================================ WaitNTPResponse ================================ //
+    case NetworkNTPState::WaitNTPResponse:
+        if (this->ntpUDP.parsePacket() >= NTP_PACKET_SIZE)
+        {
+            uint8_t packet[NTP_PACKET_SIZE];
+            this->ntpUDP.read(packet, NTP_PACKET_SIZE);
+
+            // Transmit timestamp => Seconds since 1900
+            unsigned long secondsSince1900 = ((unsigned long)packet[40] << 24) |
+                                             ((unsigned long)packet[41] << 16) |
+                                             ((unsigned long)packet[42] << 8) |
+                                             (unsigned long)packet[43];
+            unsigned long epoch = secondsSince1900 - NTP_SEVENTY_YEARS + this->utcOffsetInSeconds;
+
+            this->networkTimeData.hour = (epoch % 86400L) / 3600;
+            this->networkTimeData.minute = (epoch % 3600) / 60;
+            this->networkTimeData.second = epoch % 60;
+            this->networkTimeData.unix = epoch;
+
+            this->information->FormatPrintTime("Time",
+                                               String(this->networkTimeData.hour),
+                                               String(this->networkTimeData.minute),
+                                               String(this->networkTimeData.second),
+                                               String(this->networkTimeData.unix));
+
+            this->ntpState = NetworkNTPState::SuperviseNTPConnection;
+        }
+        else
+        {
+            // No answer => Try again with the next update
+            unsigned long CurMillis_NTPResponse = this->clock->Millis();
+            if (CurMillis_NTPResponse - this->PrevMillis_NTPResponse >= this->TimeOut_NTPResponse)
+            {
+                this->ntpServerResolved = false; // Server of the pool might be gone
+                this->ntpState = NetworkNTPState::SuperviseNTPConnection;
+            }
+        }
+        break;
+
         // ================================ CheckNTPDisconnect ================================ //
     case NetworkNTPState::CheckNTPDisconnect:
         if (this->WiFiConnected)
         {
-            this->PrevMillis_NTPTimeout = millis();
+            this->PrevMillis_NTPTimeout = this->clock->Millis();
             this->ntpState = NetworkNTPState::SuperviseNTPConnection;
         }
         break;
@@ -587,8 +782,45 @@ void Network::HandleNTP()
     }
 };
 
+/**
+ * @brief Sends a time request to the ntp server without waiting for the response
+ * 
+ * @return True if the request was sent
+ */
+bool Network::SendNTPRequest()
+{
+    if (!this->ntpServerResolved)
+    {
+        // Bounded name lookup. The address is kept for the following updates
+        if (!WiFi.hostByName(this->ntpServerName, this->ntpServerIpAddress, NTP_DNS_TIMEOUT))
+        {
+            return false;
+        }
+        this->ntpServerResolved = true;
+    }
+
+    // Drop an old answer that arrived after the timeout
+    while (this->ntpUDP.parsePacket() > 0)
+    {
+        this->ntpUDP.flush();
+    }
+
+    uint8_t packet[NTP_PACKET_SIZE]{0};
+    packet[0] = 0b11100011; // LI = unsynchronized, Version 4, Mode = client
+    packet[2] = 6;          // Polling interval
+    packet[3] = 0xEC;       // Peer clock precision
+
+    if (!this->ntpUDP.beginPacket(this->ntpServerIpAddress, NTP_PORT))
+    {
+        return false;
+    }
+    this->ntpUDP.write(packet, NTP_PACKET_SIZE);
+    return this->ntpUDP.endPacket();
+};
+
 /**
  * @brief  MQTT callback function. Processes all the receives commands from the subscribed topics
+ * The topic gets resolved with one lookup in the topic table => No string gets built per message
  * 
  * @param topic A pointer to a char array containing the mqtt topic that calles this function with new data 
  * @param payload A pointer to a byte array with data send over the mqtt topic
@@ -596,19 +828,25 @@ void Network::HandleNTP()
  */
 void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
 {
+    // Ingress time of the command => Command to photon latency
+    unsigned long ingressMicros = this->clock->Micros();
+    bool ledStripCommandPending[STRIP_COUNT];
+    for (uint8_t i = 0; i < STRIP_COUNT; i++)
+    {
+        ledStripCommandPending[i] = this->ledStripDataPrint[i];
+    }
 
-    char message[length + 1];
-    char memMessage[length + 1];
-    for (unsigned int i = 0; i < length; i++)
+    // The packet buffer of the client limits the payload => Always fits. The parsed json command points into the copy
+    if (length > MQTT_BUFFER_SIZE)
     {
-        message[i] = (char)payload[i];
-        memMessage[i] = (char)payload[i];
+        return;
     }
+    char *message = this->callbackMessage;
+    memcpy(message, payload, length);
     message[length] = '\0';
-    memMessage[length] = '\0';
-
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
 
+    switch (this->LookupTopic(topic))
+    {
     // # ================================ HomeAssistant ================================ //
     /*
         Callback stuff for data received by home assistant endpoints
@@ -616,59 +854,35 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
 
     // ================ Global ================ //
     // ======== Sun ======== //
-    if (String("LEDController/Global/HomeAssistant/Sun/command").equals(topic))
+    case NetworkTopic::HomeAssistantSun:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1)
         {
-            if (this->networkMotionData.SunUnderTheHorizon != (bool)data)
-            {
-                this->networkMotionData.SunUnderTheHorizon = (bool)data;
-                this->information->FormatPrintSingle("Sun under the horizon", String(this->networkMotionData.SunUnderTheHorizon));
-            }
-
-            if ((bool)data)
-            {
-                this->detailedSunData.sunfallUnix = this->networkTimeData.unix;
-                this->detailedSunData.isSunfallSet = true;
-            }
-            else
-            {
-                this->detailedSunData.sunriseUnix = this->networkTimeData.unix;
-                this->detailedSunData.isSunriseSet = true;
-            }
+            this->ApplySunUnderTheHorizon((bool)data);
         }
     }
+    break;
     // ======== MasterPresent ======== //
-    else if (String("LEDController/Global/HomeAssistant/MasterPresent/command").equals(topic))
+    case NetworkTopic::HomeAssistantMasterPresent:
     {
-        String temp_message = strtok(message, "\0");
-        bool temp = temp_message.equals("home");
-        if (this->networkLEDStripData[0].MasterPresent != temp)
-        {
-            this->networkLEDStripData[0].MasterPresent = temp;
-            this->networkLEDStripData[1].MasterPresent = temp;
-            this->information->FormatPrintSingle("Master Present", String(this->networkLEDStripData[0].MasterPresent));
-        }
+        this->ApplyMasterPresent(strcmp(message, "home") == 0);
     }
+    break;
     // ======== Alarm ======== //
-    else if (String("LEDController/Global/HomeAssistant/Effect/Alarm/command").equals(topic))
+    case NetworkTopic::HomeAssistantAlarm:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1)
         {
-            if (this->networkLEDStripData[0].AlarmActive != (bool)data)
-            {
-                this->networkLEDStripData[0].AlarmActive = (bool)data;
-                this->networkLEDStripData[1].AlarmActive = (bool)data;
-                this->information->FormatPrintSingle("Alarm Active", String(this->networkLEDStripData[0].AlarmActive));
-            }
+            this->ApplyAlarm((bool)data);
         }
     }
+    break;
 
     // ================ Specific ================ //
     // ======== Motion ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/BrightnessTimeBasedEnabled/command").equals(topic))
+    case NetworkTopic::HomeAssistantMotionBrightnessTimeBasedEnabled:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1)
@@ -679,10 +893,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->networkMotionData.TimeBasedBrightnessChangeEnabled = (bool)data;
             }
 
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/BrightnessTimeBasedEnabled/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/Enabled/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionEnabled:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1)
@@ -692,10 +907,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->motionDetectionDataPrint = true;
                 this->networkMotionData.MotionDetectionEnabled = (bool)data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/Enabled/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/Timeout/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionTimeout:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1000)
@@ -705,10 +921,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->motionDetectionDataPrint = true;
                 this->networkMotionData.MotionDetectionTimeout = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/Timeout/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionRGB:
     {
         long int red = strtol(strtok(message, ","), NULL, 10);
         long int green = strtol(strtok(NULL, ","), NULL, 10);
@@ -725,10 +942,13 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->networkMotionData.Blue = blue;
             }
 
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/state").c_str(), memMessage);
+            // strtok split the message => Echo the parsed values
+            snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%ld,%ld,%ld", red, green, blue);
+            this->PublishCommandState(topic, this->publishPayload);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionRGBBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -746,10 +966,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                     this->networkMotionData.ColorBrightness = data;
                 }
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionWhite:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 500)
@@ -759,10 +980,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->motionDetectionDataPrint = true;
                 this->networkMotionData.WhiteTemperature = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantMotionWhiteBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -772,12 +994,13 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->motionDetectionDataPrint = true;
                 this->networkMotionData.WhiteTemperatureBrightness = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
+    break;
 
     // ======== Strip 1 ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Power/command").equals(topic))
+    case NetworkTopic::HomeAssistantStrip1Power:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 1)
@@ -787,10 +1010,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[0] = true;
                 this->networkLEDStripData[0].Power = (bool)data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Power/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip1RGB:
     {
         long int red = strtol(strtok(message, ","), NULL, 10);
         long int green = strtol(strtok(NULL, ","), NULL, 10);
@@ -807,10 +1031,13 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->networkLEDStripData[0].Blue = blue;
             }
 
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/state").c_str(), memMessage);
+            // strtok split the message => Echo the parsed values
+            snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%ld,%ld,%ld", red, green, blue);
+            this->PublishCommandState(topic, this->publishPayload);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip1RGBBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -828,10 +1055,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                     this->networkLEDStripData[0].ColorBrightness = data;
                 }
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip1White:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 500)
@@ -841,10 +1069,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[0] = true;
                 this->networkLEDStripData[0].WhiteTemperature = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip1WhiteBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -854,21 +1083,27 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[0] = true;
                 this->networkLEDStripData[0].WhiteTemperatureBrightness = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Effect/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip1Effect:
     {
-        if (this->networkLEDStripData[0].Effect != this->helper->StringToSingleLEDEffect(message))
+        SingleLEDEffect effect = SingleLEDEffect::None;
+        if (this->helper->StringToSingleLEDEffect(message, effect))
         {
-            this->ledStripDataPrint[0] = true;
-            this->networkLEDStripData[0].Effect = this->helper->StringToSingleLEDEffect(message);
+            if (this->networkLEDStripData[0].Effect != effect)
+            {
+                this->ledStripDataPrint[0] = true;
+                this->networkLEDStripData[0].Effect = effect;
+            }
+            this->PublishCommandState(topic, message);
         }
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Effect/state").c_str(), memMessage);
     }
+    break;
 
     // ======== Strip 2 ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Power/command").equals(topic))
+    case NetworkTopic::HomeAssistantStrip2Power:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 2)
@@ -878,10 +1113,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[1] = true;
                 this->networkLEDStripData[1].Power = (bool)data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Power/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip2RGB:
     {
         long int red = strtol(strtok(message, ","), NULL, 10);
         long int green = strtol(strtok(NULL, ","), NULL, 10);
@@ -897,10 +1133,13 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->networkLEDStripData[1].Green = green;
                 this->networkLEDStripData[1].Blue = blue;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/state").c_str(), memMessage);
+            // strtok split the message => Echo the parsed values
+            snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%ld,%ld,%ld", red, green, blue);
+            this->PublishCommandState(topic, this->publishPayload);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip2RGBBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -918,10 +1157,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                     this->networkLEDStripData[1].ColorBrightness = data;
                 }
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip2White:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 500)
@@ -931,10 +1171,11 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[1] = true;
                 this->networkLEDStripData[1].WhiteTemperature = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/Brightness/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip2WhiteBrightness:
     {
         long int data = strtol(message, NULL, 10);
         if (data >= 0 && data <= 4095)
@@ -944,206 +1185,1339 @@ void Network::MqttCallback(char *topic, byte *payload, unsigned int length)
                 this->ledStripDataPrint[1] = true;
                 this->networkLEDStripData[1].WhiteTemperatureBrightness = data;
             }
-            mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/Brightness/state").c_str(), memMessage);
+            this->PublishCommandState(topic, message);
         }
     }
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Effect/command").equals(topic))
+    break;
+    case NetworkTopic::HomeAssistantStrip2Effect:
     {
-        if (this->networkLEDStripData[1].Effect != this->helper->StringToSingleLEDEffect(message))
+        SingleLEDEffect effect = SingleLEDEffect::None;
+        if (this->helper->StringToSingleLEDEffect(message, effect))
         {
-            this->ledStripDataPrint[1] = true;
-            this->networkLEDStripData[1].Effect = this->helper->StringToSingleLEDEffect(message);
+            if (this->networkLEDStripData[1].Effect != effect)
+            {
+                this->ledStripDataPrint[1] = true;
+                this->networkLEDStripData[1].Effect = effect;
+            }
+            this->PublishCommandState(topic, message);
         }
-
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Effect/state").c_str(), memMessage);
     }
+    break;
 
     // ================ Virtual ================ //
     // ======== PIR ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Virtual/PIR/command").equals(topic))
+    case NetworkTopic::HomeAssistantVirtualPIR:
     {
         long int data = strtol(message, NULL, 10);
-        if (data == 1)
-        {
-            this->networkMotionData.VirtualPIRSensorTriggered = true;
-        }
-        this->information->FormatPrintSingle("Virtual PIR Sensor", String(this->networkMotionData.VirtualPIRSensorTriggered));
+        this->ApplyVirtualPIRSensor(data == 1);
     }
+    break;
 
     // # ================================ JSON ================================ //
     /*
         Callback stuff for data received by json endpoints
+        The keys are the names of the parameter fields, e.g. {"Power":1,"Red":255,"ColorFadeCurve":"Linear","Effect":"None"}
+        Keys that are not given keep their value. One invalid value rejects the whole command
     */
 
     // ================ Global ================ //
     // ======== Sun ======== //
-    else if (String("LEDController/Global/JSON/Sun/command").equals(topic))
+    case NetworkTopic::JSONSun:
     {
+        bool sunUnderTheHorizon = false;
+        if (this->ParseJsonCommand(message) &&
+            this->ReadJsonBool("SunUnderTheHorizon", true, sunUnderTheHorizon))
+        {
+            this->ApplySunUnderTheHorizon(sunUnderTheHorizon);
+        }
     }
+    break;
     // ======== MasterPresent ======== //
-    else if (String("LEDController/Global/JSON/MasterPresent/command").equals(topic))
+    case NetworkTopic::JSONMasterPresent:
     {
+        bool masterPresent = false;
+        if (this->ParseJsonCommand(message) &&
+            this->ReadJsonBool("MasterPresent", true, masterPresent))
+        {
+            this->ApplyMasterPresent(masterPresent);
+        }
     }
+    break;
 
     // ======== Effects ======== //
     // ======== Alarm ======== //
-    else if (String("LEDController/Global/JSON/Effect/Alarm/command").equals(topic))
+    case NetworkTopic::JSONAlarm:
     {
+        bool alarmActive = false;
+        if (this->ParseJsonCommand(message) &&
+            this->ReadJsonBool("AlarmActive", true, alarmActive))
+        {
+            this->ApplyAlarm(alarmActive);
+        }
     }
+    break;
 
     // ================ Specific ================ //
     // ======== Motion ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/JSON/MotionDetection/command").equals(topic))
+    case NetworkTopic::JSONMotionDetection:
     {
+        this->ApplyJsonMotionData(message);
     }
+    break;
 
     // ======== Strip 1 ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/JSON/Strip1/command").equals(topic))
+    case NetworkTopic::JSONStrip1:
     {
+        this->ApplyJsonLEDStripData(0, message);
     }
+    break;
 
     // ======== Strip 2 ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/JSON/Strip2/command").equals(topic))
+    case NetworkTopic::JSONStrip2:
     {
+        this->ApplyJsonLEDStripData(1, message);
     }
+    break;
 
     // ================ Virtual ================ //
     // ======== PIR ======== //
-    else if (String("LEDController/" + configurationData.MQTTClientName + "/JSON/Virtual/PIR/command").equals(topic))
+    case NetworkTopic::JSONVirtualPIR:
     {
+        bool virtualPIRSensorTriggered = false;
+        if (this->ParseJsonCommand(message) &&
+            this->ReadJsonBool("VirtualPIRSensorTriggered", true, virtualPIRSensorTriggered))
+        {
+            this->ApplyVirtualPIRSensor(virtualPIRSensorTriggered);
+        }
     }
-}
+    break;
 
-void Network::HandleRepublish()
-{
-    // For now disabled
-
-    unsigned long curMillis = millis();
-
-    // == Motion Detection
-    if (curMillis - prevMillisPublishMotionDetected >= timeoutPublishMotionDetected)
+    // # ================================ Profiler ================================ //
+    // ======== Enabled ======== //
+    case NetworkTopic::ProfilerEnabled:
     {
-        PublishMotionDetected();
+        long int data = strtol(message, NULL, 10);
+        if (data >= 0 && data <= 1)
+        {
+            this->profiler->setEnabled((bool)data);
+            this->information->FormatPrintSingle("Profiler enabled", String(this->profiler->isEnabled()));
+            this->PublishCommandState(topic, message);
+        }
+    }
+    break;
+    // ======== Reset ======== //
+    case NetworkTopic::ProfilerReset:
+    {
+        this->profiler->Reset();
+        PublishProfiler();
     }
+    break;
 
-    // == Electrical Messurement
-    if (curMillis - prevMillisPublishElectricalMeasurement >= timeoutPublishElectricalMeasurement)
+    // # ================================ Group ================================ //
+    // ======== Membership ======== //
+    case NetworkTopic::GroupMembership:
     {
-        PublishElectricalMeasurement();
+        FilesystemGroupData data = {};
+        if (this->ParseGroupMembership(message, &data))
+        {
+            // Retained membership gets received on every connect => Only a change gets written to the flash
+            if (memcmp(data.Name, this->groupName, sizeof(data.Name)) != 0)
+            {
+                this->filesystem->saveGroupData(data);
+                this->UnsubscribeGroups(data);
+                this->ApplyGroupData(data);
+                this->SubscribeGroups();
+                this->information->FormatPrintSingle("Groups", String(message));
+            }
+            PublishGroupMembership();
+        }
     }
+    break;
 
-    // == Heartbeat
-    if (curMillis - prevMillisPublishHeartbeat >= timeoutPublishHeartbeat)
+    // # ================================ Home Assistant ================================ //
+    // ======== Status ======== //
+    case NetworkTopic::HomeAssistantStatus:
     {
-        PublishHeartbeat();
+        // Home Assistant lost its states and the broker may have lost the retained configs => Discovery and states again
+        if (strcmp(message, MQTT_AVAILABILITY_ONLINE) == 0)
+        {
+            memset(this->discoveryHash, 0, sizeof(this->discoveryHash));
+            if (!this->republishPending || this->republishStep > 0)
+            {
+                this->StartRepublish();
+            }
+        }
     }
+    break;
 
-    // == Network
-    if (curMillis - prevMillisPublishNetwork >= timeoutPublishNetwork)
+    default:
+        break;
+    }
+
+    // The command changed a strip => Stamp it. A command that is already pending keeps its older stamp
+    for (uint8_t i = 0; i < STRIP_COUNT; i++)
     {
-        PublishNetwork();
+        if (this->ledStripDataPrint[i] && !ledStripCommandPending[i])
+        {
+            this->ledStripCommandMicros[i] = ingressMicros;
+        }
     }
-}
+};
 
 /**
- * @brief Publishes a update of the motion detection data over mqtt
+ * @brief Builds the topic lookup table and the publish topic prefix for the current client name. Called on every connect
  * 
  */
-void Network::PublishMotionDetected()
+void Network::BuildTopicTable()
 {
-    prevMillisPublishMotionDetected = millis();
-
-    String message = "";
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-
-    // ================================================ HOMEASSISTANT ================================================ //
-    message = String(this->pirReader->getPIRReaderData().motionDetected);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Motion/state").c_str(), message.c_str());
-    message = String(this->pirReader->getPIRReaderData().sensorTriggered);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Motion/PIR/state").c_str(), message.c_str());
-    message = String(this->pirReader->getPIRReaderData().sensor1Triggered);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Motion/PIR/Sensor1/state").c_str(), message.c_str());
-    message = String(this->pirReader->getPIRReaderData().sensor2Triggered);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Motion/PIR/Sensor2/state").c_str(), message.c_str());
-    message = String(this->pirReader->getPIRReaderData().virtualSensorTriggered);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Motion/PIR/VirtualSensor/state").c_str(), message.c_str());
+    FilesystemConfigurationData data = this->filesystem->getConfigurationData();
+    strncpy(this->mqttClientName, data.MQTTClientName.c_str(), MAX_STRING_LENGTH);
+    this->mqttClientName[MAX_STRING_LENGTH] = '\0';
+    this->mqttClientNameLength = strlen(this->mqttClientName);
+    this->publishTopicPrefixLength = snprintf(this->publishTopic, MQTT_TOPIC_LENGTH, "LEDController/%s/", this->mqttClientName);
+    this->ApplyGroupData(this->filesystem->getGroupData());
+
+    for (uint8_t i = 0; i < MQTT_TOPIC_TABLE_SIZE; i++)
+    {
+        this->topicTable[i] = {};
+    }
 
-    // ================================================ JSON ================================================ //
-}
+    // Open addressing with linear probing. The table is at least twice the topic count => Short probe sequences
+    for (uint8_t i = 0; i < MQTT_TOPIC_COUNT; i++)
+    {
+        uint32_t hash = this->HashTopic(this->topicDefinitions[i].suffix, this->topicDefinitions[i].isGlobal);
+        uint8_t slot = hash & (MQTT_TOPIC_TABLE_SIZE - 1);
+        while (this->topicTable[slot].definition != MQTT_TOPIC_TABLE_EMPTY)
+        {
+            slot = (slot + 1) & (MQTT_TOPIC_TABLE_SIZE - 1);
+        }
+        this->topicTable[slot].hash = hash;
+        this->topicTable[slot].definition = i;
+    }
+};
 
 /**
- * @brief Publishes a update of the electrical measurement data over mqtt
+ * @brief Calculates the FNV-1a hash of a topic suffix. Global and client topics hash differently
  * 
+ * @param suffix   The topic without "LEDController/<Global or client name>/"
+ * @param isGlobal True for a topic below "LEDController/Global/"
+ * @return The hash
  */
-void Network::PublishElectricalMeasurement()
+uint32_t Network::HashTopic(const char *suffix, bool isGlobal)
 {
-    prevMillisPublishElectricalMeasurement = millis();
-
-    String message = "";
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-
-    // ================================================ HOMEASSISTANT ================================================ //
-    message = String(powerMeasurement->valuePower_mW);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/ElectricalMesurement/CurrentPower/state").c_str(), message.c_str());
-    message = String(powerMeasurement->valueBus_V);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/ElectricalMesurement/BusVoltage/state").c_str(), message.c_str());
-    message = String(powerMeasurement->valueCurrent_mA);
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/ElectricalMesurement/CurrentAmpere/state").c_str(), message.c_str());
-
-    // ================================================ JSON ================================================ //
-}
+    uint32_t hash = 2166136261UL;
+    hash = (hash ^ (isGlobal ? 'G' : 'C')) * 16777619UL;
+    while (*suffix != '\0')
+    {
+        hash = (hash ^ (uint8_t)*suffix++) * 16777619UL;
+    }
+    return hash;
+};
 
 /**
- * @brief Publishes a heartbear over mqtt
+ * @brief Returns one entry of the topics the callback reacts on
  * 
+ * @param index Position in the definitions. Below MQTT_TOPIC_COUNT
+ * @return The definition
  */
-void Network::PublishHeartbeat()
+const NetworkTopicDefinition &Network::getTopicDefinition(uint8_t index)
 {
-    prevMillisPublishHeartbeat = millis();
-
-    String message = "pulse";
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-
-    // ================================================ HOMEASSISTANT ================================================ //
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Heartbeat/state").c_str(), message.c_str());
-
-    // ================================================ JSON ================================================ //
-}
+    return topicDefinitions[index];
+};
 
 /**
- * @brief Publishes a update of the network information over mqtt
+ * @brief Resolves a received topic. Only works on the given char array => No heap allocation
  * 
+ * @param topic The full mqtt topic
+ * @return The topic or NetworkTopic::Unknown
  */
-void Network::PublishNetwork()
+NetworkTopic Network::LookupTopic(const char *topic)
 {
-    prevMillisPublishNetwork = millis();
+    const char *root = "LEDController/";
+    const uint8_t rootLength = 14;
+    if (strncmp(topic, root, rootLength) != 0)
+    {
+        return strcmp(topic, MQTT_DISCOVERY_STATUS_TOPIC) == 0 ? NetworkTopic::HomeAssistantStatus : NetworkTopic::Unknown;
+    }
 
-    String message = "";
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-    NetworkWiFiInformation wiFiInformation = this->getWiFiInformation();
+    // Strip "Global/" or "<client name>/"
+    const char *scope = topic + rootLength;
+    const char *suffix = nullptr;
+    bool isGlobal = false;
+    bool isGroup = false;
+    if (strncmp(scope, "Global/", 7) == 0)
+    {
+        isGlobal = true;
+        suffix = scope + 7;
+    }
+    else if (this->mqttClientNameLength > 0 &&
+             strncmp(scope, this->mqttClientName, this->mqttClientNameLength) == 0 &&
+             scope[this->mqttClientNameLength] == '/')
+    {
+        suffix = scope + this->mqttClientNameLength + 1;
+    }
+    else
+    {
+        // "Group/<group name>/" => Same topics as the controller itself
+        suffix = this->StripGroupScope(scope);
+        if (suffix == nullptr)
+        {
+            return NetworkTopic::Unknown;
+        }
+        isGroup = true;
+    }
 
-    // ================================================ HOMEASSISTANT ================================================ //
-    message = wiFiInformation.ipAddress;
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Network/IPAddress/state").c_str(), message.c_str());
-    message = wiFiInformation.macAddress;
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Network/MACAddress/state").c_str(), message.c_str());
+    uint32_t hash = this->HashTopic(suffix, isGlobal);
+    uint8_t slot = hash & (MQTT_TOPIC_TABLE_SIZE - 1);
+    for (uint8_t probe = 0; probe < MQTT_TOPIC_TABLE_SIZE; probe++)
+    {
+        NetworkTopicTableEntry &entry = this->topicTable[slot];
+        if (entry.definition == MQTT_TOPIC_TABLE_EMPTY)
+        {
+            break;
+        }
 
-    // ================================================ JSON ================================================ //
-}
+        const NetworkTopicDefinition &definition = this->topicDefinitions[entry.definition];
+        if (entry.hash == hash && definition.isGlobal == isGlobal && strcmp(definition.suffix, suffix) == 0)
+        {
+            // One membership publish to a group would move all of its members => Only the topic of the controller itself
+            if (isGroup && definition.topic == NetworkTopic::GroupMembership)
+            {
+                return NetworkTopic::Unknown;
+            }
+            return definition.topic;
+        }
+        slot = (slot + 1) & (MQTT_TOPIC_TABLE_SIZE - 1);
+    }
+    return NetworkTopic::Unknown;
+};
 
 /**
- * @brief Publishes the current code version over mqtt
+ * @brief Returns the topic suffix behind the group scope if the controller is member of the group
  * 
+ * @param scope The topic without "LEDController/"
+ * @return The suffix behind "Group/<group name>/" or nullptr
  */
-void Network::PublishCodeVersion()
+const char *Network::StripGroupScope(const char *scope)
 {
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-
-    // ================================================ HOMEASSISTANT ================================================ //
-    mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/Version").c_str(), codeVersion.c_str());
+    if (strncmp(scope, "Group/", 6) != 0)
+    {
+        return nullptr;
+    }
 
-    // ================================================ JSON ================================================ //
-}
+    const char *name = scope + 6;
+    for (uint8_t i = 0; i < MQTT_GROUP_COUNT; i++)
+    {
+        uint8_t length = this->groupNameLength[i];
+        if (length > 0 && strncmp(name, this->groupName[i], length) == 0 && name[length] == '/')
+        {
+            return name + length + 1;
+        }
+    }
+    return nullptr;
+};
+
+/**
+ * @brief Echoes a command to its state topic. ".../command" becomes ".../state". Goes through the outbound queue => A slider drag publishes only the last value
+ * 
+ * @param topic   The command topic
+ * @param message The message to publish
+ */
+void Network::PublishCommandState(const char *topic, const char *message)
+{
+    if (this->publishTopicPrefixLength == 0)
+    {
+        return;
+    }
+
+    // Topics of this controller and of its groups get echoed to the state topic of this controller
+    const char *suffix = nullptr;
+    if (strncmp(topic, this->publishTopic, this->publishTopicPrefixLength) == 0)
+    {
+        suffix = topic + this->publishTopicPrefixLength;
+    }
+    else if (strncmp(topic, "LEDController/", 14) == 0)
+    {
+        suffix = this->StripGroupScope(topic + 14);
+    }
+    if (suffix == nullptr)
+    {
+        return;
+    }
+
+    size_t length = strlen(suffix);
+    const size_t commandLength = 7; // "command"
+    if (length < commandLength || length - commandLength + 5 >= MQTT_PUBLISH_SUFFIX_LENGTH)
+    {
+        return;
+    }
+
+    char stateSuffix[MQTT_PUBLISH_SUFFIX_LENGTH];
+    memcpy(stateSuffix, suffix, length - commandLength);
+    strcpy(stateSuffix + length - commandLength, "state");
+    this->PublishState(stateSuffix, message);
+};
+
+/**
+ * @brief Takes over the group names the callback and the subscribe work with
+ * 
+ * @param data The group data
+ */
+void Network::ApplyGroupData(FilesystemGroupData data)
+{
+    for (uint8_t i = 0; i < MQTT_GROUP_COUNT; i++)
+    {
+        strncpy(this->groupName[i], data.Name[i], MQTT_GROUP_NAME_LENGTH);
+        this->groupName[i][MQTT_GROUP_NAME_LENGTH] = '\0';
+        this->groupNameLength[i] = strlen(this->groupName[i]);
+    }
+};
+
+/**
+ * @brief Parses a comma separated list of group names. An empty list leaves all groups
+ * 
+ * @param message The list, e.g. "LivingRoom,Downstairs"
+ * @param data    Gets the parsed group names
+ * @return False if the list has too many groups or an invalid name
+ */
+bool Network::ParseGroupMembership(const char *message, FilesystemGroupData *data)
+{
+    uint8_t count = 0;
+    const char *name = message;
+    while (*name != '\0')
+    {
+        const char *end = name;
+        while (*end != '\0' && *end != ',')
+        {
+            end++;
+        }
+
+        size_t length = end - name;
+        if (length > 0)
+        {
+            if (count >= MQTT_GROUP_COUNT || length > MQTT_GROUP_NAME_LENGTH)
+            {
+                return false;
+            }
+            for (size_t i = 0; i < length; i++)
+            {
+                // Levels and wildcards would reach topics of other groups
+                if (name[i] == '/' || name[i] == '+' || name[i] == '#')
+                {
+                    return false;
+                }
+            }
+            memcpy(data->Name[count], name, length);
+            data->Name[count][length] = '\0';
+            count++;
+        }
+
+        name = *end == ',' ? end + 1 : end;
+    }
+
+    data->isConfigured = true;
+    return true;
+};
+
+/**
+ * @brief Subscribes to the topics of all groups the controller is member of
+ * 
+ */
+void Network::SubscribeGroups()
+{
+    uint8_t qos = this->persistentSession ? 1 : 0;
+    char topic[MQTT_TOPIC_LENGTH];
+    for (uint8_t i = 0; i < MQTT_GROUP_COUNT; i++)
+    {
+        if (this->groupNameLength[i] > 0)
+        {
+            snprintf(topic, MQTT_TOPIC_LENGTH, "LEDController/Group/%s/#", this->groupName[i]);
+            this->mqttClient->Subscribe(topic, qos);
+        }
+    }
+};
+
+/**
+ * @brief Unsubscribes from the topics of the groups the controller leaves. Must be called before the new groups get applied
+ * 
+ * @param data The new group data
+ */
+void Network::UnsubscribeGroups(const FilesystemGroupData &data)
+{
+    char topic[MQTT_TOPIC_LENGTH];
+    for (uint8_t i = 0; i < MQTT_GROUP_COUNT; i++)
+    {
+        if (this->groupNameLength[i] == 0)
+        {
+            continue;
+        }
+
+        bool staysMember = false;
+        for (uint8_t j = 0; j < MQTT_GROUP_COUNT; j++)
+        {
+            if (strncmp(this->groupName[i], data.Name[j], MQTT_GROUP_NAME_LENGTH) == 0)
+            {
+                staysMember = true;
+                break;
+            }
+        }
+        if (!staysMember)
+        {
+            snprintf(topic, MQTT_TOPIC_LENGTH, "LEDController/Group/%s/#", this->groupName[i]);
+            this->mqttClient->Unsubscribe(topic);
+        }
+    }
+};
+
+/**
+ * @brief Publishes the groups the controller is member of as comma separated list
+ * 
+ */
+void Network::PublishGroupMembership()
+{
+    char membership[MQTT_GROUP_COUNT * (MQTT_GROUP_NAME_LENGTH + 1)] = "";
+    for (uint8_t i = 0; i < MQTT_GROUP_COUNT; i++)
+    {
+        if (this->groupNameLength[i] > 0)
+        {
+            if (membership[0] != '\0')
+            {
+                strcat(membership, ",");
+            }
+            strcat(membership, this->groupName[i]);
+        }
+    }
+    this->PublishState("Group/Membership/state", membership);
+};
+
+/**
+ * @brief Sets if the sun is under the horizon and remembers the time of the sunfall / sunrise
+ * 
+ * @param sunUnderTheHorizon True if the sun is under the horizon
+ */
+void Network::ApplySunUnderTheHorizon(bool sunUnderTheHorizon)
+{
+    if (this->networkMotionData.SunUnderTheHorizon != sunUnderTheHorizon)
+    {
+        this->networkMotionData.SunUnderTheHorizon = sunUnderTheHorizon;
+        this->information->FormatPrintSingle("Sun under the horizon", String(this->networkMotionData.SunUnderTheHorizon));
+    }
+
+    if (sunUnderTheHorizon)
+    {
+        this->detailedSunData.sunfallUnix = this->networkTimeData.unix;
+        this->detailedSunData.isSunfallSet = true;
+    }
+    else
+    {
+        this->detailedSunData.sunriseUnix = this->networkTimeData.unix;
+        this->detailedSunData.isSunriseSet = true;
+    }
+};
+
+/**
+ * @brief Sets if the master is present for all strips
+ * 
+ * @param masterPresent True if the master is at home
+ */
+void Network::ApplyMasterPresent(bool masterPresent)
+{
+    if (this->networkLEDStripData[0].MasterPresent != masterPresent)
+    {
+        this->networkLEDStripData[0].MasterPresent = masterPresent;
+        this->networkLEDStripData[1].MasterPresent = masterPresent;
+        this->information->FormatPrintSingle("Master Present", String(this->networkLEDStripData[0].MasterPresent));
+    }
+};
+
+/**
+ * @brief Sets if the alarm is active for all strips
+ * 
+ * @param alarmActive True if the alarm effect should run
+ */
+void Network::ApplyAlarm(bool alarmActive)
+{
+    if (this->networkLEDStripData[0].AlarmActive != alarmActive)
+    {
+        this->networkLEDStripData[0].AlarmActive = alarmActive;
+        this->networkLEDStripData[1].AlarmActive = alarmActive;
+        this->information->FormatPrintSingle("Alarm Active", String(this->networkLEDStripData[0].AlarmActive));
+    }
+};
+
+/**
+ * @brief Triggers the virtual pir sensor. The pir reader resets it once consumed
+ * 
+ * @param triggered True to trigger the sensor
+ */
+void Network::ApplyVirtualPIRSensor(bool triggered)
+{
+    if (triggered)
+    {
+        this->networkMotionData.VirtualPIRSensorTriggered = true;
+    }
+    this->information->FormatPrintSingle("Virtual PIR Sensor", String(this->networkMotionData.VirtualPIRSensorTriggered));
+};
+
+/**
+ * @brief Parses a json command into the fixed size json document. The strings stay in the message => It must outlive the document use
+ * 
+ * @param message The received message
+ * @return True if the message is a json object
+ */
+bool Network::ParseJsonCommand(char *message)
+{
+    DeserializationError error = deserializeJson(this->doc, message);
+    if (error)
+    {
+        Serial.print(F("Network json command rejected: "));
+        Serial.println(error.c_str());
+        return false;
+    }
+    if (!this->doc.is<JsonObject>())
+    {
+        Serial.println(F("Network json command rejected: No object"));
+        return false;
+    }
+    return true;
+};
+
+/**
+ * @brief Reads a bool from the parsed json command. Accepts true / false and 1 / 0
+ * 
+ * @param key      The key of the value
+ * @param required True if a missing key is invalid
+ * @param value    Gets the value if it is valid. Stays unchanged otherwise
+ * @return True if the value is valid or not given and not required
+ */
+bool Network::ReadJsonBool(const char *key, bool required, bool &value)
+{
+    JsonVariant variant = this->doc[key];
+    if (variant.isNull())
+    {
+        return !required;
+    }
+    if (variant.is<bool>())
+    {
+        value = variant.as<bool>();
+        return true;
+    }
+    if (variant.is<long>() && (variant.as<long>() == 0 || variant.as<long>() == 1))
+    {
+        value = variant.as<long>() == 1;
+        return true;
+    }
+    return false;
+};
+
+/**
+ * @brief Reads a number from the parsed json command. A missing key keeps the current value
+ * 
+ * @param key   The key of the value
+ * @param min   The smallest valid value
+ * @param max   The largest valid value
+ * @param value Gets the value if it is valid. Stays unchanged otherwise
+ * @return True if the value is valid or not given
+ */
+bool Network::ReadJsonNumber(const char *key, long min, long max, long &value)
+{
+    JsonVariant variant = this->doc[key];
+    if (variant.isNull())
+    {
+        return true;
+    }
+    if (!variant.is<long>() || variant.as<long>() < min || variant.as<long>() > max)
+    {
+        return false;
+    }
+    value = variant.as<long>();
+    return true;
+};
+
+/**
+ * @brief Reads a fade curve name from the parsed json command. A missing key keeps the current value
+ * 
+ * @param key   The key of the value
+ * @param value Gets the value if it is valid. Stays unchanged otherwise
+ * @return True if the value is valid or not given
+ */
+bool Network::ReadJsonFadeCurve(const char *key, FadeCurve &value)
+{
+    JsonVariant variant = this->doc[key];
+    if (variant.isNull())
+    {
+        return true;
+    }
+    if (!variant.is<const char *>())
+    {
+        return false;
+    }
+    return this->helper->StringToFadeCurve(variant.as<const char *>(), value);
+};
+
+/**
+ * @brief Reads an effect name from the parsed json command. A missing key keeps the current value
+ * 
+ * @param key   The key of the value
+ * @param value Gets the value if it is valid. Stays unchanged otherwise
+ * @return True if the value is valid or not given
+ */
+bool Network::ReadJsonEffect(const char *key, SingleLEDEffect &value)
+{
+    JsonVariant variant = this->doc[key];
+    if (variant.isNull())
+    {
+        return true;
+    }
+    if (!variant.is<const char *>())
+    {
+        return false;
+    }
+    return this->helper->StringToSingleLEDEffect(variant.as<const char *>(), value);
+};
+
+/**
+ * @brief Applies a full or partial motion parameter set from one json command.
+ * Every value gets validated before anything is applied => Either all values are taken or none.
+ * Saving happens once in the next run, the new state gets published once as json
+ * 
+ * @param message The received message
+ */
+void Network::ApplyJsonMotionData(char *message)
+{
+    if (!this->ParseJsonCommand(message))
+    {
+        return;
+    }
+
+    NetworkMotionData data = this->networkMotionData;
+    long timeout = data.MotionDetectionTimeout;
+    long red = data.Red;
+    long green = data.Green;
+    long blue = data.Blue;
+    long colorFadeTime = data.ColorFadeTime;
+    long colorBrightness = data.ColorBrightness;
+    long colorBrightnessFadeTime = data.ColorBrightnessFadeTime;
+    long whiteTemperature = data.WhiteTemperature;
+    long whiteTemperatureFadeTime = data.WhiteTemperatureFadeTime;
+    long whiteTemperatureBrightness = data.WhiteTemperatureBrightness;
+    long whiteTemperatureBrightnessFadeTime = data.WhiteTemperatureBrightnessFadeTime;
+
+    bool valid = this->ReadJsonBool("MotionDetectionEnabled", false, data.MotionDetectionEnabled) &&
+                 this->ReadJsonBool("TimeBasedBrightnessChangeEnabled", false, data.TimeBasedBrightnessChangeEnabled) &&
+                 this->ReadJsonNumber("MotionDetectionTimeout", 0, 1000, timeout) &&
+                 this->ReadJsonNumber("Red", 0, 255, red) &&
+                 this->ReadJsonNumber("Green", 0, 255, green) &&
+                 this->ReadJsonNumber("Blue", 0, 255, blue) &&
+                 this->ReadJsonNumber("ColorFadeTime", 0, 65535, colorFadeTime) &&
+                 this->ReadJsonFadeCurve("ColorFadeCurve", data.ColorFadeCurve) &&
+                 this->ReadJsonNumber("ColorBrightness", 0, 4095, colorBrightness) &&
+                 this->ReadJsonNumber("ColorBrightnessFadeTime", 0, 65535, colorBrightnessFadeTime) &&
+                 this->ReadJsonFadeCurve("ColorBrightnessFadeCurve", data.ColorBrightnessFadeCurve) &&
+                 this->ReadJsonNumber("WhiteTemperature", 0, 500, whiteTemperature) &&
+                 this->ReadJsonNumber("WhiteTemperatureFadeTime", 0, 65535, whiteTemperatureFadeTime) &&
+                 this->ReadJsonFadeCurve("WhiteTemperatureFadeCurve", data.WhiteTemperatureFadeCurve) &&
+                 this->ReadJsonNumber("WhiteTemperatureBrightness", 0, 4095, whiteTemperatureBrightness) &&
+                 this->ReadJsonNumber("WhiteTemperatureBrightnessFadeTime", 0, 65535, whiteTemperatureBrightnessFadeTime) &&
+                 this->ReadJsonFadeCurve("WhiteTemperatureBrightnessFadeCurve", data.WhiteTemperatureBrightnessFadeCurve);
+    if (!valid)
+    {
+        Serial.println(F("Network json motion command rejected: Invalid value"));
+        return;
+    }
+
+    data.MotionDetectionTimeout = timeout;
+    data.Red = red;
+    data.Green = green;
+    data.Blue = blue;
+    data.ColorFadeTime = colorFadeTime;
+    data.ColorBrightness = colorBrightness;
+    data.ColorBrightnessFadeTime = colorBrightnessFadeTime;
+    data.WhiteTemperature = whiteTemperature;
+    data.WhiteTemperatureFadeTime = whiteTemperatureFadeTime;
+    data.WhiteTemperatureBrightness = whiteTemperatureBrightness;
+    data.WhiteTemperatureBrightnessFadeTime = whiteTemperatureBrightnessFadeTime;
+
+    this->networkMotionData = data;
+    this->motionDetectionDataPrint = true; // Saves the parameters once in the next run
+    this->PublishJsonMotionState();
+};
+
+/**
+ * @brief Applies a full or partial led strip parameter set from one json command.
+ * Every value gets validated before anything is applied => Either all values are taken or none.
+ * Saving happens once in the next run, the new state gets published once as json
+ * 
+ * @param stripIndex The index of the strip. Starts with 0
+ * @param message    The received message
+ */
+void Network::ApplyJsonLEDStripData(uint8_t stripIndex, char *message)
+{
+    if (stripIndex >= STRIP_COUNT || !this->ParseJsonCommand(message))
+    {
+        return;
+    }
+
+    NetworkLEDStripData data = this->networkLEDStripData[stripIndex];
+    long red = data.Red;
+    long green = data.Green;
+    long blue = data.Blue;
+    long colorFadeTime = data.ColorFadeTime;
+    long colorBrightness = data.ColorBrightness;
+    long colorBrightnessFadeTime = data.ColorBrightnessFadeTime;
+    long whiteTemperature = data.WhiteTemperature;
+    long whiteTemperatureFadeTime = data.WhiteTemperatureFadeTime;
+    long whiteTemperatureBrightness = data.WhiteTemperatureBrightness;
+    long whiteTemperatureBrightnessFadeTime = data.WhiteTemperatureBrightnessFadeTime;
+
+    bool valid = this->ReadJsonBool("Power", false, data.Power) &&
+                 this->ReadJsonNumber("Red", 0, 255, red) &&
+                 this->ReadJsonNumber("Green", 0, 255, green) &&
+                 this->ReadJsonNumber("Blue", 0, 255, blue) &&
+                 this->ReadJsonNumber("ColorFadeTime", 0, 65535, colorFadeTime) &&
+                 this->ReadJsonFadeCurve("ColorFadeCurve", data.ColorFadeCurve) &&
+                 this->ReadJsonNumber("ColorBrightness", 0, 4095, colorBrightness) &&
+                 this->ReadJsonNumber("ColorBrightnessFadeTime", 0, 65535, colorBrightnessFadeTime) &&
+                 this->ReadJsonFadeCurve("ColorBrightnessFadeCurve", data.ColorBrightnessFadeCurve) &&
+                 this->ReadJsonNumber("WhiteTemperature", 0, 500, whiteTemperature) &&
+                 this->ReadJsonNumber("WhiteTemperatureFadeTime", 0, 65535, whiteTemperatureFadeTime) &&
+                 this->ReadJsonFadeCurve("WhiteTemperatureFadeCurve", data.WhiteTemperatureFadeCurve) &&
+                 this->ReadJsonNumber("WhiteTemperatureBrightness", 0, 4095, whiteTemperatureBrightness) &&
+                 this->ReadJsonNumber("WhiteTemperatureBrightnessFadeTime", 0, 65535, whiteTemperatureBrightnessFadeTime) &&
+                 this->ReadJsonFadeCurve("WhiteTemperatureBrightnessFadeCurve", data.WhiteTemperatureBrightnessFadeCurve) &&
+                 this->ReadJsonEffect("Effect", data.Effect);
+
+    if (!valid)
+    {
+        Serial.println(F("Network json strip command rejected: Invalid value"));
+        return;
+    }
+
+    data.Red = red;
+    data.Green = green;
+    data.Blue = blue;
+    data.ColorFadeTime = colorFadeTime;
+    data.ColorBrightness = colorBrightness;
+    data.ColorBrightnessFadeTime = colorBrightnessFadeTime;
+    data.WhiteTemperature = whiteTemperature;
+    data.WhiteTemperatureFadeTime = whiteTemperatureFadeTime;
+    data.WhiteTemperatureBrightness = whiteTemperatureBrightness;
+    data.WhiteTemperatureBrightnessFadeTime = whiteTemperatureBrightnessFadeTime;
+
+    this->networkLEDStripData[stripIndex] = data;
+    this->ledStripDataPrint[stripIndex] = true; // Saves the parameters once in the next run
+    this->PublishJsonLEDStripState(stripIndex);
+};
+
+/**
+ * @brief Publishes all motion parameters as one json state
+ * 
+ */
+void Network::PublishJsonMotionState()
+{
+    NetworkMotionData &data = this->networkMotionData;
+
+    this->doc.clear();
+    this->doc["MotionDetectionEnabled"] = data.MotionDetectionEnabled;
+    this->doc["TimeBasedBrightnessChangeEnabled"] = data.TimeBasedBrightnessChangeEnabled;
+    this->doc["MotionDetectionTimeout"] = data.MotionDetectionTimeout;
+    this->doc["Red"] = data.Red;
+    this->doc["Green"] = data.Green;
+    this->doc["Blue"] = data.Blue;
+    this->doc["ColorFadeTime"] = data.ColorFadeTime;
+    this->doc["ColorFadeCurve"] = this->helper->FadeCurveToString(data.ColorFadeCurve);
+    this->doc["ColorBrightness"] = data.ColorBrightness;
+    this->doc["ColorBrightnessFadeTime"] = data.ColorBrightnessFadeTime;
+    this->doc["ColorBrightnessFadeCurve"] = this->helper->FadeCurveToString(data.ColorBrightnessFadeCurve);
+    this->doc["WhiteTemperature"] = data.WhiteTemperature;
+    this->doc["WhiteTemperatureFadeTime"] = data.WhiteTemperatureFadeTime;
+    this->doc["WhiteTemperatureFadeCurve"] = this->helper->FadeCurveToString(data.WhiteTemperatureFadeCurve);
+    this->doc["WhiteTemperatureBrightness"] = data.WhiteTemperatureBrightness;
+    this->doc["WhiteTemperatureBrightnessFadeTime"] = data.WhiteTemperatureBrightnessFadeTime;
+    this->doc["WhiteTemperatureBrightnessFadeCurve"] = this->helper->FadeCurveToString(data.WhiteTemperatureBrightnessFadeCurve);
+
+    serializeJson(this->doc, this->publishJsonPayload, MQTT_JSON_PAYLOAD_LENGTH);
+    this->PublishState("JSON/MotionDetection/state", this->publishJsonPayload);
+};
+
+/**
+ * @brief Publishes all parameters of a led strip as one json state
+ * 
+ * @param stripIndex The index of the strip. Starts with 0
+ */
+void Network::PublishJsonLEDStripState(uint8_t stripIndex)
+{
+    NetworkLEDStripData &data = this->networkLEDStripData[stripIndex];
+
+    this->doc.clear();
+    this->doc["Power"] = data.Power;
+    this->doc["Red"] = data.Red;
+    this->doc["Green"] = data.Green;
+    this->doc["Blue"] = data.Blue;
+    this->doc["ColorFadeTime"] = data.ColorFadeTime;
+    this->doc["ColorFadeCurve"] = this->helper->FadeCurveToString(data.ColorFadeCurve);
+    this->doc["ColorBrightness"] = data.ColorBrightness;
+    this->doc["ColorBrightnessFadeTime"] = data.ColorBrightnessFadeTime;
+    this->doc["ColorBrightnessFadeCurve"] = this->helper->FadeCurveToString(data.ColorBrightnessFadeCurve);
+    this->doc["WhiteTemperature"] = data.WhiteTemperature;
+    this->doc["WhiteTemperatureFadeTime"] = data.WhiteTemperatureFadeTime;
+    this->doc["WhiteTemperatureFadeCurve"] = this->helper->FadeCurveToString(data.WhiteTemperatureFadeCurve);
+    this->doc["WhiteTemperatureBrightness"] = data.WhiteTemperatureBrightness;
+    this->doc["WhiteTemperatureBrightnessFadeTime"] = data.WhiteTemperatureBrightnessFadeTime;
+    this->doc["WhiteTemperatureBrightnessFadeCurve"] = this->helper->FadeCurveToString(data.WhiteTemperatureBrightnessFadeCurve);
+    this->doc["Effect"] = this->helper->SingleLEDEffectToString(data.Effect);
+
+    serializeJson(this->doc, this->publishJsonPayload, MQTT_JSON_PAYLOAD_LENGTH);
+    this->PublishState(stripIndex == 0 ? "JSON/Strip1/state" : "JSON/Strip2/state", this->publishJsonPayload);
+};
+
+/**
+ * @brief Queues a state below "LEDController/<client name>/". A state that is already queued for the same topic gets replaced,
+ * so only the newest value gets sent. States that do not fit into a queue entry (e.g. the json states) get published right away.
+ * A full queue makes room for events and command echoes by evicting its oldest republish or keep-alive state
+ * 
+ * @param suffix  The topic without "LEDController/<client name>/"
+ * @param payload The message to publish
+ */
+void Network::PublishState(const char *suffix, const char *payload)
+{
+    if (this->mqttState != NetworkMQTTState::SuperviseMQTTConnection)
+    {
+        return; // Not connected => Everything gets republished after the connect
+    }
+
+    if (strlen(suffix) >= MQTT_PUBLISH_SUFFIX_LENGTH || strlen(payload) >= MQTT_PAYLOAD_LENGTH)
+    {
+        this->PublishDirect(suffix, payload);
+        return;
+    }
+
+    // Coalesce with a queued state of the same topic
+    uint32_t hash = this->HashTopic(suffix, false);
+    for (uint8_t i = 0; i < this->publishQueueCount; i++)
+    {
+        NetworkPublishEntry &entry = this->publishQueue[(this->publishQueueHead + i) % MQTT_PUBLISH_QUEUE_SIZE];
+        if (entry.hash == hash && strcmp(entry.suffix, suffix) == 0)
+        {
+            strcpy(entry.payload, payload);
+            entry.republish = entry.republish && this->publishingRepublish;
+            this->publishQueueCoalescedCount++;
+            return;
+        }
+    }
+
+    if (this->publishQueueCount >= MQTT_PUBLISH_QUEUE_SIZE)
+    {
+        // A republish or keep-alive gets sent again anyway => Never evicts an event or a command echo
+        this->publishQueueDroppedCount++;
+        if (this->publishingRepublish)
+        {
+            return;
+        }
+        uint8_t position = 0;
+        while (position < this->publishQueueCount && !this->publishQueue[(this->publishQueueHead + position) % MQTT_PUBLISH_QUEUE_SIZE].republish)
+        {
+            position++;
+        }
+        if (position == this->publishQueueCount)
+        {
+            return; // Only events and command echoes queued
+        }
+        this->RemoveQueueEntry(position);
+    }
+
+    NetworkPublishEntry &entry = this->publishQueue[(this->publishQueueHead + this->publishQueueCount) % MQTT_PUBLISH_QUEUE_SIZE];
+    entry.hash = hash;
+    strcpy(entry.suffix, suffix);
+    strcpy(entry.payload, payload);
+    entry.republish = this->publishingRepublish;
+    this->publishQueueCount++;
+};
+
+/**
+ * @brief Queues a state like a command echo or like a republish, which the queue evicts first when it is full
+ * 
+ * @param suffix    The topic without "LEDController/<client name>/"
+ * @param payload   The message to publish
+ * @param republish True to queue the state as a republish
+ */
+void Network::QueueState(const char *suffix, const char *payload, bool republish)
+{
+    this->publishingRepublish = republish;
+    this->PublishState(suffix, payload);
+    this->publishingRepublish = false;
+};
+
+/**
+ * @brief Sends the queued states in order until the byte budget of this loop is used up
+ * 
+ */
+void Network::HandlePublishQueue()
+{
+    if (this->mqttState != NetworkMQTTState::SuperviseMQTTConnection)
+    {
+        this->publishQueueHead = 0;
+        this->publishQueueCount = 0;
+        return;
+    }
+
+    uint16_t sentBytes = 0;
+    while (this->publishQueueCount > 0)
+    {
+        NetworkPublishEntry &entry = this->publishQueue[this->publishQueueHead];
+        uint16_t entryBytes = this->publishTopicPrefixLength + strlen(entry.suffix) + strlen(entry.payload);
+        if (sentBytes > 0 && sentBytes + entryBytes > MQTT_PUBLISH_BYTE_BUDGET)
+        {
+            break; // Rest in the next loop
+        }
+
+        this->PublishDirect(entry.suffix, entry.payload);
+        sentBytes += entryBytes;
+        this->publishQueueHead = (this->publishQueueHead + 1) % MQTT_PUBLISH_QUEUE_SIZE;
+        this->publishQueueCount--;
+    }
+};
+
+/**
+ * @brief Publishes a state below "LEDController/<client name>/" right away. The topic gets built behind the cached prefix => No heap allocation
+ * 
+ * @param suffix  The topic without "LEDController/<client name>/"
+ * @param payload The message to publish
+ */
+void Network::PublishDirect(const char *suffix, const char *payload)
+{
+    if (this->publishTopicPrefixLength == 0)
+    {
+        return; // Not connected yet
+    }
+
+    strncpy(this->publishTopic + this->publishTopicPrefixLength, suffix, MQTT_TOPIC_LENGTH - this->publishTopicPrefixLength - 1);
+    this->publishTopic[MQTT_TOPIC_LENGTH - 1] = '\0';
+    this->mqttClient->Publish(this->publishTopic, payload, false);
+};
+
+/**
+ * @brief Removes a queued state => An older value can not overwrite a state that got published right away
+ * 
+ * @param suffix The topic without "LEDController/<client name>/"
+ */
+void Network::RemoveQueuedState(const char *suffix)
+{
+    uint32_t hash = this->HashTopic(suffix, false);
+    for (uint8_t i = 0; i < this->publishQueueCount; i++)
+    {
+        NetworkPublishEntry &entry = this->publishQueue[(this->publishQueueHead + i) % MQTT_PUBLISH_QUEUE_SIZE];
+        if (entry.hash == hash && strcmp(entry.suffix, suffix) == 0)
+        {
+            this->RemoveQueueEntry(i);
+            return;
+        }
+    }
+};
+
+/**
+ * @brief Removes one entry of the publish queue. The gap gets closed => The order of the other states stays
+ * 
+ * @param position The position of the entry counted from the head of the queue
+ */
+void Network::RemoveQueueEntry(uint8_t position)
+{
+    for (uint8_t i = position; i + 1 < this->publishQueueCount; i++)
+    {
+        this->publishQueue[(this->publishQueueHead + i) % MQTT_PUBLISH_QUEUE_SIZE] = this->publishQueue[(this->publishQueueHead + i + 1) % MQTT_PUBLISH_QUEUE_SIZE];
+    }
+    this->publishQueueCount--;
+};
+
+/**
+ * @brief Publishes a number as state
+ * 
+ * @param suffix The topic without "LEDController/<client name>/"
+ * @param value  The number to publish
+ * @param direct True => Published right away instead of queued
+ */
+void Network::PublishStateNumber(const char *suffix, long value, bool direct)
+{
+    snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%ld", value);
+    if (direct)
+    {
+        this->RemoveQueuedState(suffix);
+        this->PublishDirect(suffix, this->publishPayload);
+    }
+    else
+    {
+        this->PublishState(suffix, this->publishPayload);
+    }
+};
+
+/**
+ * @brief Publishes a decimal number with two decimal places as state
+ * 
+ * @param suffix The topic without "LEDController/<client name>/"
+ * @param value  The number to publish
+ */
+void Network::PublishStateDecimal(const char *suffix, double value)
+{
+    dtostrf(value, 1, 2, this->publishPayload);
+    this->PublishState(suffix, this->publishPayload);
+};
+
+/**
+ * @brief Publishes a color as "red,green,blue" state
+ * 
+ * @param suffix The topic without "LEDController/<client name>/"
+ * @param red    The red value
+ * @param green  The green value
+ * @param blue   The blue value
+ */
+void Network::PublishStateRGB(const char *suffix, uint8_t red, uint8_t green, uint8_t blue)
+{
+    snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%u,%u,%u", red, green, blue);
+    this->PublishState(suffix, this->publishPayload);
+};
+
+/**
+ * @brief Publishes the queued motion changes of the pir reader right away, past the publish queue. Publishes at most every TimeOut_MotionEventPublish,
+ * queued changes in between get coalesced into one publish of the newest state. The latency from the oldest change to the publish gets profiled
+ * 
+ */
+void Network::HandleMotionEvents()
+{
+    if (!this->pirReader->hasEvent())
+    {
+        return;
+    }
+
+    bool connected = this->mqttState == NetworkMQTTState::SuperviseMQTTConnection;
+    unsigned long curMillis = this->clock->Millis();
+    if (connected && curMillis - this->prevMillisPublishMotionEvent < this->TimeOut_MotionEventPublish)
+    {
+        return; // Rate limit => The events stay queued
+    }
+
+    PIRReaderEvent event = {};
+    PIRReaderEvent newestEvent = {};
+    unsigned long oldestTimestamp = 0;
+    bool first = true;
+    while (this->pirReader->PopEvent(event))
+    {
+        if (first)
+        {
+            oldestTimestamp = event.timestamp;
+            first = false;
+        }
+        newestEvent = event;
+    }
+
+    // Not connected => The state gets republished after the connect
+    if (!connected)
+    {
+        return;
+    }
+
+    this->prevMillisPublishMotionEvent = curMillis;
+    this->PublishMotionState(newestEvent.data, true);
+    this->profiler->Record(ProfilerComponent::MotionEvent, this->clock->Micros() - oldestTimestamp);
+};
+
+void Network::HandleRepublish()
+{
+    // Only while connected and at most one publish group per call => Bounded time per loop
+    if (this->mqttState != NetworkMQTTState::SuperviseMQTTConnection)
+    {
+        return;
+    }
+
+    unsigned long curMillis = this->clock->Millis();
+    this->publishingRepublish = true;
+
+    // == Republish after the connect
+    if (this->republishPending && curMillis - this->PrevMillis_RepublishStep >= this->republishStepDelay)
+    {
+        this->PrevMillis_RepublishStep = curMillis;
+        this->republishStepDelay = this->TimeOut_RepublishStep;
+        if (this->RepublishStep(this->republishStep++))
+        {
+            this->republishPending = false;
+        }
+    }
+    // == Motion Detection
+    else if (curMillis - prevMillisPublishMotionDetected >= timeoutPublishMotionDetected)
+    {
+        PublishMotionDetected();
+    }
+
+    // == Electrical Messurement
+    else if (curMillis - prevMillisPublishElectricalMeasurement >= timeoutPublishElectricalMeasurement)
+    {
+        PublishElectricalMeasurement();
+    }
+
+    // == Heartbeat. Disabled with 0 => Availability only from the birth message and the last will
+    else if (timeoutPublishHeartbeat > 0 && curMillis - prevMillisPublishHeartbeat >= timeoutPublishHeartbeat)
+    {
+        PublishHeartbeat();
+    }
+
+    // == Network
+    else if (curMillis - prevMillisPublishNetwork >= timeoutPublishNetwork)
+    {
+        PublishNetwork();
+    }
+
+    // == Profiler
+    else if (this->profiler->isEnabled() && curMillis - prevMillisPublishProfiler >= timeoutPublishProfiler)
+    {
+        PublishProfiler();
+    }
+    this->publishingRepublish = false;
+}
+
+/**
+ * @brief Publishes the retained Home Assistant discovery config of one entity.
+ * The config gets built from its template into the json payload buffer and is only published if its hash changed
+ * => A reconnect costs no broker traffic because the broker keeps the retained config
+ * 
+ * @param index The entity in the discovery table
+ */
+void Network::PublishDiscovery(uint8_t index)
+{
+    const NetworkDiscoveryDefinition &definition = discoveryDefinitions[index];
+    const char *name = this->mqttClientName;
+
+    // ==== Frame around the entity specific config
+    int length = snprintf(this->publishJsonPayload, MQTT_JSON_PAYLOAD_LENGTH,
+                          "{\"~\":\"LEDController/%s%s\",\"uniq_id\":\"%s_%s\",\"avty_t\":\"LEDController/%s/Availability\",",
+                          name, definition.base, name, definition.objectId, name);
+    if (length > 0 && length < MQTT_JSON_PAYLOAD_LENGTH)
+    {
+        strncpy_P(this->publishJsonPayload + length, definition.config, MQTT_JSON_PAYLOAD_LENGTH - length - 1);
+        this->publishJsonPayload[MQTT_JSON_PAYLOAD_LENGTH - 1] = '\0';
+        length = strlen(this->publishJsonPayload);
+        length += snprintf(this->publishJsonPayload + length, MQTT_JSON_PAYLOAD_LENGTH - length,
+                           ",\"dev\":{\"ids\":[\"%s\"],\"name\":\"%s\",\"mdl\":\"%s\",\"sw\":\"%s\"}}",
+                           name, name, DiscoveryModel, this->codeVersion.c_str());
+    }
+    if (length <= 0 || length >= MQTT_JSON_PAYLOAD_LENGTH)
+    {
+        Serial.println(F("Discovery config does not fit into the payload buffer!"));
+        return;
+    }
+
+    // The config contains the client name and object id => Hash of the config covers the topic
+    uint32_t hash = this->HashTopic(this->publishJsonPayload, false);
+    if (hash == this->discoveryHash[index])
+    {
+        return;
+    }
+
+    char topic[MQTT_TOPIC_LENGTH];
+    snprintf(topic, MQTT_TOPIC_LENGTH, "homeassistant/%s/%s/%s/config", definition.component, name, definition.objectId);
+    if (this->mqttClient->Publish(topic, this->publishJsonPayload, true))
+    {
+        this->discoveryHash[index] = hash;
+    }
+};
+
+/**
+ * @brief Publishes a update of the motion detection data over mqtt
+ * 
+ */
+void Network::PublishMotionDetected()
+{
+    prevMillisPublishMotionDetected = this->clock->Millis();
+
+    this->PublishMotionState(this->pirReader->getPIRReaderData());
+}
+
+/**
+ * @brief Publishes the given motion detection data over mqtt
+ * 
+ * @param pirReaderData The data to publish
+ * @param direct        True => Published right away instead of queued
+ */
+void Network::PublishMotionState(PIRReaderData pirReaderData, bool direct)
+{
+    // ================================================ HOMEASSISTANT ================================================ //
+    this->PublishStateNumber("HomeAssistant/Motion/state", pirReaderData.motionDetected, direct);
+    this->PublishStateNumber("HomeAssistant/Motion/PIR/state", pirReaderData.sensorTriggered, direct);
+    this->PublishStateNumber("HomeAssistant/Motion/PIR/Sensor1/state", pirReaderData.sensor1Triggered, direct);
+    this->PublishStateNumber("HomeAssistant/Motion/PIR/Sensor2/state", pirReaderData.sensor2Triggered, direct);
+    this->PublishStateNumber("HomeAssistant/Motion/PIR/VirtualSensor/state", pirReaderData.virtualSensorTriggered, direct);
+
+    // ================================================ JSON ================================================ //
+}
+
+/**
+ * @brief Publishes a update of the electrical measurement data over mqtt
+ * 
+ */
+void Network::PublishElectricalMeasurement()
+{
+    prevMillisPublishElectricalMeasurement = this->clock->Millis();
+
+    // ================================================ HOMEASSISTANT ================================================ //
+    this->PublishStateDecimal("HomeAssistant/ElectricalMesurement/CurrentPower/state", powerMeasurement->valuePower_mW);
+    this->PublishStateDecimal("HomeAssistant/ElectricalMesurement/BusVoltage/state", powerMeasurement->valueBus_V);
+    this->PublishStateDecimal("HomeAssistant/ElectricalMesurement/CurrentAmpere/state", powerMeasurement->valueCurrent_mA);
+
+    // ================================================ JSON ================================================ //
+}
+
+/**
+ * @brief Publishes a heartbear over mqtt
+ * 
+ */
+void Network::PublishHeartbeat()
+{
+    prevMillisPublishHeartbeat = this->clock->Millis();
+
+    // ================================================ HOMEASSISTANT ================================================ //
+    this->PublishState("HomeAssistant/Heartbeat/state", "pulse");
+
+    // ================================================ JSON ================================================ //
+}
+
+/**
+ * @brief Publishes a update of the network information over mqtt
+ * 
+ */
+void Network::PublishNetwork()
+{
+    prevMillisPublishNetwork = this->clock->Millis();
+
+    // Formatted from the raw bytes => getWiFiInformation would build a String per field
+    IPAddress ipAddress = WiFi.localIP();
+    uint8_t macAddress[6];
+    WiFi.macAddress(macAddress);
+
+    // ================================================ HOMEASSISTANT ================================================ //
+    snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%u.%u.%u.%u",
+             ipAddress[0], ipAddress[1], ipAddress[2], ipAddress[3]);
+    this->PublishState("HomeAssistant/Network/IPAddress/state", this->publishPayload);
+    snprintf(this->publishPayload, MQTT_PAYLOAD_LENGTH, "%02X:%02X:%02X:%02X:%02X:%02X",
+             macAddress[0], macAddress[1], macAddress[2], macAddress[3], macAddress[4], macAddress[5]);
+    this->PublishState("HomeAssistant/Network/MACAddress/state", this->publishPayload);
+    this->PublishStateNumber("HomeAssistant/Network/PublishQueue/Dropped/state", this->publishQueueDroppedCount);
+    this->PublishStateNumber("HomeAssistant/Network/PublishQueue/Coalesced/state", this->publishQueueCoalescedCount);
+    this->PublishStateNumber("HomeAssistant/Network/Realtime/LateDropped/state", this->realtime->getLateDropCount());
+    this->PublishStateNumber("HomeAssistant/Network/Realtime/Underrun/state", this->realtime->getUnderrunCount());
+    this->PublishStateNumber("HomeAssistant/Network/Realtime/Overflow/state", this->realtime->getOverflowCount());
+
+    // ================================================ JSON ================================================ //
+}
+
+/**
+ * @brief Publishes the current code version over mqtt
+ * 
+ */
+void Network::PublishCodeVersion()
+{
+    // ================================================ HOMEASSISTANT ================================================ //
+    this->PublishState("Version", codeVersion.c_str());
+
+    // ================================================ JSON ================================================ //
+}
 
 /**
  * @brief Request for the network componente to change into access point mode
@@ -1205,6 +2579,51 @@ NetworkMQTTInformation Network::getMQTTInformation()
     return mqttInformation;
 }
 
+/**
+ * @brief Returns the number of states waiting in the outbound queue
+ * 
+ * @return The queued count
+ */
+uint8_t Network::getPublishQueueCount()
+{
+    return this->publishQueueCount;
+};
+
+/**
+ * @brief Returns the topic of a queued state
+ * 
+ * @param position Position in the queue. 0 => Oldest state
+ * @return The topic without "LEDController/<client name>/" or nullptr behind the last queued state
+ */
+const char *Network::getQueuedSuffix(uint8_t position)
+{
+    if (position >= this->publishQueueCount)
+    {
+        return nullptr;
+    }
+    return this->publishQueue[(this->publishQueueHead + position) % MQTT_PUBLISH_QUEUE_SIZE].suffix;
+};
+
+/**
+ * @brief Returns the number of states the outbound queue dropped because it was full
+ * 
+ * @return The dropped count
+ */
+uint32_t Network::getPublishQueueDroppedCount()
+{
+    return this->publishQueueDroppedCount;
+};
+
+/**
+ * @brief Returns the number of states that replaced a queued state of the same topic
+ * 
+ * @return The coalesced count
+ */
+uint32_t Network::getPublishQueueCoalescedCount()
+{
+    return this->publishQueueCoalescedCount;
+};
+
 bool Network::isWiFiConnected()
 {
     return this->WiFiConnected;
@@ -1242,18 +2661,26 @@ void Network::resetVirtualPIRSensor()
 
 bool Network::isMasterPresent(uint8_t stripID)
 {
-    if (stripID >= 0 && stripID < sizeof(this->networkLEDStripData))
+    // Strip ID's are 1 and 2 but the index of the array starts at 0
+    if (stripID == 0 || stripID > STRIP_COUNT)
     {
-        return this->networkLEDStripData[stripID].MasterPresent;
+        return false;
     }
+    stripID--;
+
+    return this->networkLEDStripData[stripID].MasterPresent;
 }
 
 bool Network::isAlarm(uint8_t stripID)
 {
-    if (stripID >= 0 && stripID < sizeof(this->networkLEDStripData))
+    // Strip ID's are 1 and 2 but the index of the array starts at 0
+    if (stripID == 0 || stripID > STRIP_COUNT)
     {
-        return this->networkLEDStripData[stripID].AlarmActive;
+        return false;
     }
+    stripID--;
+
+    return this->networkLEDStripData[stripID].AlarmActive;
 }
 
 bool Network::isSunUnderTheHorizon()
@@ -1269,36 +2696,28 @@ NetworkMotionData Network::getNetworkMotionData()
 void Network::UpdateNetworkMotionData(NetworkMotionData data, bool republish)
 {
 
-    FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-    String message = "";
-
     if (this->networkMotionData.MotionDetectionEnabled != data.MotionDetectionEnabled || republish)
     {
-        message = String(data.MotionDetectionEnabled);
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/Enable/state").c_str(), message.c_str());
+        this->PublishStateNumber("HomeAssistant/MotionDetection/Enabled/state", data.MotionDetectionEnabled);
     }
     if (this->networkMotionData.Red != data.Red ||
         this->networkMotionData.Green != data.Green ||
         this->networkMotionData.Blue != data.Blue ||
         republish)
     {
-        message = String(data.Red + String(",") + data.Green + String(",") + data.Blue);
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/state").c_str(), message.c_str());
+        this->PublishStateRGB("HomeAssistant/MotionDetection/RGB/state", data.Red, data.Green, data.Blue);
     }
     if (this->networkMotionData.ColorBrightness != data.ColorBrightness || republish)
     {
-        message = String(data.ColorBrightness);
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/RGB/Brightness/state").c_str(), message.c_str());
+        this->PublishStateNumber("HomeAssistant/MotionDetection/RGB/Brightness/state", data.ColorBrightness);
     }
     if (this->networkMotionData.WhiteTemperature != data.WhiteTemperature || republish)
     {
-        message = String(data.WhiteTemperature);
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/state").c_str(), message.c_str());
+        this->PublishStateNumber("HomeAssistant/MotionDetection/White/state", data.WhiteTemperature);
     }
     if (this->networkMotionData.WhiteTemperatureBrightness != data.WhiteTemperatureBrightness || republish)
     {
-        message = String(data.WhiteTemperatureBrightness);
-        mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/MotionDetection/White/Brightness/state").c_str(), message.c_str());
+        this->PublishStateNumber("HomeAssistant/MotionDetection/White/Brightness/state", data.WhiteTemperatureBrightness);
     }
 
     this->networkMotionData = data;
@@ -1313,101 +2732,87 @@ void Network::UpdateNetworkMotionData(NetworkMotionData data, bool republish)
 NetworkLEDStripData Network::getNetworkLEDStripData(uint8_t stripID)
 {
     // Strip ID's are 1 and 2 but the index of the array starts at 0
-    stripID--;
-    NetworkLEDStripData data = {};
-    if (stripID >= 0 && stripID <= sizeof(this->networkLEDStripData))
+    if (stripID == 0 || stripID > STRIP_COUNT)
     {
-        data = this->networkLEDStripData[stripID];
+        return {};
     }
+    stripID--;
 
-    return data;
+    return this->networkLEDStripData[stripID];
 }
 
 void Network::UpdateNetworkLEDStripData(uint8_t stripID, NetworkLEDStripData data, bool republish)
 {
     // Strip ID's are 1 and 2 but the index of the array starts at 0
-    stripID--;
-    if (stripID >= 0 && stripID <= sizeof(this->networkLEDStripData))
+    if (stripID == 0 || stripID > STRIP_COUNT)
     {
-        FilesystemConfigurationData configurationData = this->filesystem->getConfigurationData();
-        String message = "";
+        return;
+    }
+    stripID--;
 
-        if (stripID == 1)
+    if (stripID == 0)
+    {
+        if (this->networkLEDStripData[stripID].Power != data.Power || republish)
         {
-            if (this->networkLEDStripData[stripID].Power != data.Power || republish)
-            {
-                message = String(data.Power);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Power/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].Red != data.Red ||
-                this->networkLEDStripData[stripID].Green != data.Green ||
-                this->networkLEDStripData[stripID].Blue != data.Blue ||
-                republish)
-            {
-                message = String(data.Red + String(",") + data.Green + String(",") + data.Blue);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].ColorBrightness != data.ColorBrightness || republish)
-            {
-                message = String(data.ColorBrightness);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/RGB/Brightness/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].WhiteTemperature != data.WhiteTemperature || republish)
-            {
-                message = String(data.WhiteTemperature);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].WhiteTemperatureBrightness != data.WhiteTemperatureBrightness || republish)
-            {
-                message = String(data.WhiteTemperatureBrightness);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/White/Brightness/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].Effect != data.Effect || republish)
-            {
-                message = String(this->helper->SingleLEDEffectToString(data.Effect));
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip1/Effect/state").c_str(), message.c_str());
-            }
+            this->PublishStateNumber("HomeAssistant/Strip1/Power/state", data.Power);
         }
-
-        if (stripID == 2)
+        if (this->networkLEDStripData[stripID].Red != data.Red ||
+            this->networkLEDStripData[stripID].Green != data.Green ||
+            this->networkLEDStripData[stripID].Blue != data.Blue ||
+            republish)
         {
-            if (this->networkLEDStripData[stripID].Power != data.Power || republish)
-            {
-                message = String(data.Power);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Power/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].Red != data.Red ||
-                this->networkLEDStripData[stripID].Green != data.Green ||
-                this->networkLEDStripData[stripID].Blue != data.Blue ||
-                republish)
-            {
-                message = String(data.Red + String(",") + data.Green + String(",") + data.Blue);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].ColorBrightness != data.ColorBrightness || republish)
-            {
-                message = String(data.ColorBrightness);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/RGB/Brightness/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].WhiteTemperature != data.WhiteTemperature || republish)
-            {
-                message = String(data.WhiteTemperature);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].WhiteTemperatureBrightness != data.WhiteTemperatureBrightness || republish)
-            {
-                message = String(data.WhiteTemperatureBrightness);
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/White/Brightness/state").c_str(), message.c_str());
-            }
-            if (this->networkLEDStripData[stripID].Effect != data.Effect || republish)
-            {
-                message = String(this->helper->SingleLEDEffectToString(data.Effect));
-                mqttClient.publish(("LEDController/" + configurationData.MQTTClientName + "/HomeAssistant/Strip2/Effect/state").c_str(), message.c_str());
-            }
+            this->PublishStateRGB("HomeAssistant/Strip1/RGB/state", data.Red, data.Green, data.Blue);
         }
+        if (this->networkLEDStripData[stripID].ColorBrightness != data.ColorBrightness || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip1/RGB/Brightness/state", data.ColorBrightness);
+        }
+        if (this->networkLEDStripData[stripID].WhiteTemperature != data.WhiteTemperature || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip1/White/state", data.WhiteTemperature);
+        }
+        if (this->networkLEDStripData[stripID].WhiteTemperatureBrightness != data.WhiteTemperatureBrightness || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip1/White/Brightness/state", data.WhiteTemperatureBrightness);
+        }
+        if (this->networkLEDStripData[stripID].Effect != data.Effect || republish)
+        {
+            this->PublishState("HomeAssistant/Strip1/Effect/state", this->helper->SingleLEDEffectToString(data.Effect).c_str());
+        }
+    }
 
-        this->networkLEDStripData[stripID] = data;
+    if (stripID == 1)
+    {
+        if (this->networkLEDStripData[stripID].Power != data.Power || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip2/Power/state", data.Power);
+        }
+        if (this->networkLEDStripData[stripID].Red != data.Red ||
+            this->networkLEDStripData[stripID].Green != data.Green ||
+            this->networkLEDStripData[stripID].Blue != data.Blue ||
+            republish)
+        {
+            this->PublishStateRGB("HomeAssistant/Strip2/RGB/state", data.Red, data.Green, data.Blue);
+        }
+        if (this->networkLEDStripData[stripID].ColorBrightness != data.ColorBrightness || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip2/RGB/Brightness/state", data.ColorBrightness);
+        }
+        if (this->networkLEDStripData[stripID].WhiteTemperature != data.WhiteTemperature || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip2/White/state", data.WhiteTemperature);
+        }
+        if (this->networkLEDStripData[stripID].WhiteTemperatureBrightness != data.WhiteTemperatureBrightness || republish)
+        {
+            this->PublishStateNumber("HomeAssistant/Strip2/White/Brightness/state", data.WhiteTemperatureBrightness);
+        }
+        if (this->networkLEDStripData[stripID].Effect != data.Effect || republish)
+        {
+            this->PublishState("HomeAssistant/Strip2/Effect/state", this->helper->SingleLEDEffectToString(data.Effect).c_str());
+        }
     }
+
+    this->networkLEDStripData[stripID] = data;
 }
 
 DetailedSunData Network::getDetailedSunData()
@@ -1419,3 +2824,21 @@ NetworkTimeData Network::getNetworkTimeData()
 {
     return this->networkTimeData;
 }
+
+/**
+ * @brief Publishes the loop time report of the profiler over mqtt
+ * 
+ */
+void Network::PublishProfiler()
+{
+    prevMillisPublishProfiler = this->clock->Millis();
+
+    // One topic per component => The whole report does not fit into the mqtt packet buffer
+    char suffix[MQTT_TOPIC_LENGTH];
+    for (uint8_t i = 0; i < PROFILER_COMPONENT_COUNT; i++)
+    {
+        ProfilerComponent component = static_cast<ProfilerComponent>(i);
+        snprintf(suffix, MQTT_TOPIC_LENGTH, "Profiler/%s/state", this->helper->ProfilerComponentToString(component).c_str());
+        this->PublishState(suffix, this->profiler->getComponentJson(component).c_str());
+    }
+}
@@ -1,9 +1,7 @@
 #pragma once
 
 // Arduino Lib Includes
-#include <NTPClient.h>    // @installed via Arduino Library Manger    GitHub => https://github.com/arduino-libraries/NTPClient
-#include <PubSubClient.h> // @installed via Arduino Library Manger    GitHub => https://github.com/knolleary/pubsubclient
-#include <ArduinoJson.h>  // @installed via Arduino Library Manger    GitHub => https://github.com/bblanchon/ArduinoJson
+#include <ArduinoJson.h> // @installed via Arduino Library Manger    GitHub => https://github.com/bblanchon/ArduinoJson
 
 // ================================ INCLUDES ================================ //
 #include <Arduino.h>
@@ -18,9 +16,13 @@
 #include "../PirReader/PirReader.h"
 #include "../Parameterhandler/Parameterhandler.h"
 #include "../PowerMeasurement/PowerMeasurement.h"
+#include "../Profiler/Profiler.h"
+#include "../Realtime/Realtime.h"
 
 // ================================ INTERFACES ================================ //
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+#include "../Interface/IMqttClient.h"
 
 // Blueprint for compiler. Problem => circular dependency
 class Filesystem;
@@ -29,19 +31,25 @@ class Information;
 class PirReader;
 class PowerMeasurement;
 class Parameterhandler;
+class Profiler;
+class Realtime;
 
 // ================================ CLASS ================================ //
 class Network : public IBaseClass
 {
     // ================ Constructor / Reference ================ //
 public:
-    Network(String codeVersion);
-    void setReference(Filesystem *filesystem,
+    Network(String codeVersion, bool persistentSession, uint32_t heartbeatInterval);
+    void setReference(IMqttClient *mqttClient,
+                      Filesystem *filesystem,
                       Helper *helper,
                       Information *information,
                       PirReader *pirReader,
                       PowerMeasurement *powerMeasurement,
-                      Parameterhandler *parameterhandler);
+                      Parameterhandler *parameterhandler,
+                      Realtime *realtime,
+                      Profiler *profiler,
+                      ITimeSource *clock);
     bool init = false;
 
     // ================ Interface ================ //
@@ -49,36 +57,82 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
 
     // ================ Data ================ //
 private:
     // ======== External Components ======== //
+    IMqttClient *mqttClient;
     Filesystem *filesystem;
     Helper *helper;
     Information *information;
     PirReader *pirReader;
     PowerMeasurement *powerMeasurement;
     Parameterhandler *parameterhandler;
+    Realtime *realtime;
+    Profiler *profiler;
+    ITimeSource *clock;
 
     // ==== NTP
     unsigned long PrevMillis_NTPTimeout = 0;
     const unsigned long TimeOut_NTPTimeout = 60000; // 1 minute
+    unsigned long PrevMillis_NTPResponse = 0;
+    const unsigned long TimeOut_NTPResponse = 1000; // 1 sec
     NetworkNTPState ntpState = NetworkNTPState::StartNTP;
     NetworkNTPState memNtpState = NetworkNTPState::StartNTP;
     const long utcOffsetInSeconds = 3600; // UTC +1 (Germany) => 1 * 60 * 60 => 3600
     WiFiUDP ntpUDP;
-    NTPClient ntpTimeClient = NTPClient(ntpUDP, "europe.pool.ntp.org", utcOffsetInSeconds);
+    const char *ntpServerName = "europe.pool.ntp.org";
+    IPAddress ntpServerIpAddress;
+    bool ntpServerResolved = false;
+    bool ntpRequestPending = false;
+    const uint16_t NTP_PORT = 123;
+    const uint16_t NTP_LOCAL_PORT = 2390;
+    const uint8_t NTP_PACKET_SIZE = 48;
+    const unsigned long NTP_SEVENTY_YEARS = 2208988800UL; // Seconds from 1900 to 1970
+    const uint32_t NTP_DNS_TIMEOUT = 200;                // ms
 
     // ==== MQTT
     unsigned long PrevMillis_MQTTTimeout = 0;
     const unsigned long TimeOut_MQTTTimeout = 5000; // 5 sec
+    unsigned long PrevMillis_MQTTRetry = 0;
+    const unsigned long TimeOut_MQTTRetry = 5000;       // 5 sec
+    const unsigned long TimeOut_MQTTRetryJitter = 5000; // Up to 5 sec on top of the retry time after a failed connect
+    unsigned long mqttRetryJitter = 0;
+    const uint32_t MQTT_DNS_TIMEOUT = 200; // ms
+    bool persistentSession = false;        // Clean session flag is not set on connect
     NetworkMQTTState mqttState = NetworkMQTTState::StartMQTT;
     NetworkMQTTState memMqttState = NetworkMQTTState::StartMQTT;
-    PubSubClient mqttClient;
     bool MQTTConnected = false;
     int clientState = 0;
-    WiFiClient wifiMqtt;
-    DynamicJsonDocument doc = DynamicJsonDocument(2048);
+    StaticJsonDocument<MQTT_JSON_DOCUMENT_SIZE> doc; // Parses the json commands and builds the json states. Fixed size => No heap allocation
+    char callbackMessage[MQTT_BUFFER_SIZE + 1] = "";  // Terminated copy of the received payload. Member => Off the stack and valid as long as the parsed json command
+
+    // ==== MQTT topic dispatch
+    /*
+        Every topic the callback reacts on. The lookup table gets built from these on connect, so the callback
+        only needs one hash and one string compare per message. Shared by all instances => Defined in Network.cpp
+    */
+    static const NetworkTopicDefinition topicDefinitions[MQTT_TOPIC_COUNT];
+    NetworkTopicTableEntry topicTable[MQTT_TOPIC_TABLE_SIZE] = {};
+    char mqttClientName[MAX_STRING_LENGTH + 1] = ""; // Client name the table was built for
+    uint8_t mqttClientNameLength = 0;
+    char groupName[MQTT_GROUP_COUNT][MQTT_GROUP_NAME_LENGTH + 1]{}; // Groups the table was built for. Empty => Unused
+    uint8_t groupNameLength[MQTT_GROUP_COUNT]{0};
+
+    // ==== MQTT publish
+    char publishTopic[MQTT_TOPIC_LENGTH] = ""; // "LEDController/<client name>/" followed by the suffix of the last publish
+    uint8_t publishTopicPrefixLength = 0;
+    char publishPayload[MQTT_PAYLOAD_LENGTH] = "";
+    char publishJsonPayload[MQTT_JSON_PAYLOAD_LENGTH] = "";     // Json states and discovery configs
+    uint32_t discoveryHash[MQTT_DISCOVERY_COUNT]{0};            // Hash of the last published discovery config
+    NetworkPublishEntry publishQueue[MQTT_PUBLISH_QUEUE_SIZE] = {};
+    uint8_t publishQueueHead = 0;
+    uint8_t publishQueueCount = 0;
+    uint32_t publishQueueDroppedCount = 0;   // States that did not fit into the full queue or got evicted
+    bool publishingRepublish = false;        // The states get published by the republish or a keep-alive
+    uint32_t publishQueueCoalescedCount = 0; // States that replaced a queued state of the same topic
 
     // ==== WiFi
     unsigned long PrevMillis_WiFiTimeout = 0;
@@ -104,6 +158,7 @@ private:
     // ==== Information Print
     bool motionDetectionDataPrint = false;
     bool ledStripDataPrint[STRIP_COUNT]{false};
+    unsigned long ledStripCommandMicros[STRIP_COUNT]{0}; // Ingress time of the command that set the print flag
 
     // ====  Data
     NetworkMotionData networkMotionData = {};
@@ -116,11 +171,21 @@ private:
     unsigned long prevMillisPublishElectricalMeasurement = 0;
     unsigned long prevMillisPublishHeartbeat = 0;
     unsigned long prevMillisPublishNetwork = 0;
+    unsigned long prevMillisPublishProfiler = 0;
+    unsigned long prevMillisPublishMotionEvent = 0;
+    const unsigned long TimeOut_MotionEventPublish = 100; // 100 ms. Rate limit of the motion publishes on the edge
+    unsigned long PrevMillis_RepublishStep = 0;
+    const unsigned long TimeOut_RepublishStep = 200;     // 200 ms between the republish groups after the connect
+    const unsigned long TimeOut_RepublishJitter = 10000; // Up to 10 sec before the first republish group
+    unsigned long republishStepDelay = 0;
+    uint8_t republishStep = 0;
+    bool republishPending = false;
 
-    uint32_t timeoutPublishMotionDetected = 60000;        // 1 Minute
+    uint32_t timeoutPublishMotionDetected = 60000;        // 1 Minute. Only a keep alive => Changes get published on the edge
     uint32_t timeoutPublishElectricalMeasurement = 60000; // 1 Minute
-    uint32_t timeoutPublishHeartbeat = 5000;              // 5 Seconds
+    uint32_t timeoutPublishHeartbeat = 0;                 // Set by the constructor. 0 => Disabled
     uint32_t timeoutPublishNetwork = 60000;               // 1 Minute
+    uint32_t timeoutPublishProfiler = 10000;              // 10 Seconds. Only while the profiler is enabled
 
     // ======== Other ======== //
     String codeVersion = "";
@@ -133,19 +198,71 @@ private:
     void HandleAccessPoint(bool shutdown);
     void HandleMqtt();
     void HandleNTP();
-    void MqttCallback(char *topic, byte *payload, unsigned int length);
+    bool SendNTPRequest();
+    void Subscribe();
+    void StartRepublish();
+    const char *getAvailabilityTopic();
+    bool RepublishStep(uint8_t step);
+
+    // ==== MQTT topic dispatch
+    void BuildTopicTable();
+    uint32_t HashTopic(const char *suffix, bool isGlobal);
+    const char *StripGroupScope(const char *scope);
+    void PublishCommandState(const char *topic, const char *message);
+
+    // ==== MQTT groups
+    void ApplyGroupData(FilesystemGroupData data);
+    bool ParseGroupMembership(const char *message, FilesystemGroupData *data);
+    void SubscribeGroups();
+    void UnsubscribeGroups(const FilesystemGroupData &data);
+    void PublishGroupMembership();
+
+    // ==== MQTT publish
+    void PublishState(const char *suffix, const char *payload);
+    void PublishDirect(const char *suffix, const char *payload);
+    void RemoveQueuedState(const char *suffix);
+    void RemoveQueueEntry(uint8_t position);
+    void PublishStateNumber(const char *suffix, long value, bool direct = false);
+    void PublishStateDecimal(const char *suffix, double value);
+    void PublishStateRGB(const char *suffix, uint8_t red, uint8_t green, uint8_t blue);
+
+    // ==== MQTT commands
+    void ApplySunUnderTheHorizon(bool sunUnderTheHorizon);
+    void ApplyMasterPresent(bool masterPresent);
+    void ApplyAlarm(bool alarmActive);
+    void ApplyVirtualPIRSensor(bool triggered);
+
+    // ==== MQTT json commands
+    bool ParseJsonCommand(char *message);
+    bool ReadJsonBool(const char *key, bool required, bool &value);
+    bool ReadJsonNumber(const char *key, long min, long max, long &value);
+    bool ReadJsonFadeCurve(const char *key, FadeCurve &value);
+    bool ReadJsonEffect(const char *key, SingleLEDEffect &value);
+    void ApplyJsonMotionData(char *message);
+    void ApplyJsonLEDStripData(uint8_t stripIndex, char *message);
+    void PublishJsonMotionState();
+    void PublishJsonLEDStripState(uint8_t stripIndex);
 
     // ==== Republish / Publish functions
     void HandleRepublish();
+    void HandleMotionEvents();
 
     void PublishMotionDetected();
+    void PublishMotionState(PIRReaderData pirReaderData, bool direct = false);
     void PublishElectricalMeasurement();
     void PublishHeartbeat();
+    void PublishDiscovery(uint8_t index);
     void PublishMotionLEDStripData();
     void PublishNetwork();
     void PublishCodeVersion();
+    void PublishProfiler();
 
 public:
+    // ==== MQTT topic dispatch
+    void MqttCallback(char *topic, byte *payload, unsigned int length);
+    NetworkTopic LookupTopic(const char *topic);
+    static const NetworkTopicDefinition &getTopicDefinition(uint8_t index);
+
     bool isWiFiConnected();
     bool isAccessPointReady();
     bool isMQTTConnected();
@@ -157,6 +274,12 @@ public:
 
     NetworkWiFiInformation getWiFiInformation();
     NetworkMQTTInformation getMQTTInformation();
+    void QueueState(const char *suffix, const char *payload, bool republish);
+    void HandlePublishQueue();
+    uint8_t getPublishQueueCount();
+    const char *getQueuedSuffix(uint8_t position);
+    uint32_t getPublishQueueDroppedCount();
+    uint32_t getPublishQueueCoalescedCount();
 
     bool isVirtualPIRSensorTriggered();
     void resetVirtualPIRSensor();
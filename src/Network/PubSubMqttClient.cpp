@@ -0,0 +1,138 @@
+#include "PubSubMqttClient.h"
+
+/**
+ * Empty constructor
+ */
+PubSubMqttClient::PubSubMqttClient()
+{
+};
+
+/**
+ * Prepares the client
+ * 
+ * @parameter callback  Gets called for every received publish
+ */
+void PubSubMqttClient::Begin(std::function<void(char *, uint8_t *, unsigned int)> callback)
+{
+    // The default packet buffer is too small for the json commands and states
+    this->mqttClient.setBufferSize(MQTT_BUFFER_SIZE);
+    this->mqttClient.setCallback(callback);
+    this->mqttClient.setSocketTimeout(MQTT_ACKNOWLEDGE_TIMEOUT);
+};
+
+/**
+ * Connects to the broker. Blocks for the TCP handshake and the broker acknowledge
+ * 
+ * @return True if the broker accepted the connection
+ */
+bool PubSubMqttClient::Connect(IPAddress brokerIpAddress,
+                               uint16_t brokerPort,
+                               const char *clientName,
+                               const char *username,
+                               const char *password,
+                               const char *willTopic,
+                               uint8_t willQos,
+                               bool willRetain,
+                               const char *willMessage,
+                               bool cleanSession)
+{
+    // TCP handshake only. Waits at most the client timeout
+    this->wifiMqtt.setTimeout(MQTT_CONNECT_TIMEOUT);
+    if (!this->wifiMqtt.connect(brokerIpAddress, brokerPort))
+    {
+        return false;
+    }
+
+    // Socket is already open => Only sends the connect packet and waits for the broker acknowledge
+    this->mqttClient.setClient(this->wifiMqtt);
+    this->mqttClient.setServer(brokerIpAddress, brokerPort);
+    if (!this->mqttClient.connect(clientName,
+                                  username,
+                                  password,
+                                  willTopic, willQos, willRetain, willMessage,
+                                  cleanSession))
+    {
+        this->wifiMqtt.stop();
+        return false;
+    }
+    return true;
+};
+
+/**
+ * Closes the connection to the broker
+ */
+void PubSubMqttClient::Disconnect()
+{
+    this->mqttClient.disconnect();
+};
+
+/**
+ * The connect returns with the result => Never in progress
+ */
+bool PubSubMqttClient::isConnecting()
+{
+    return false;
+};
+
+/**
+ * Returns if the client is connected to the broker
+ */
+bool PubSubMqttClient::isConnected()
+{
+    return this->mqttClient.connected();
+};
+
+/**
+ * Returns the PubSubClient state
+ */
+int PubSubMqttClient::getState()
+{
+    return this->mqttClient.state();
+};
+
+/**
+ * Subscribes to a topic
+ * 
+ * @parameter topic The topic. Wildcards are allowed
+ * @parameter qos   The maximum QoS the broker sends with
+ * 
+ * @return True if the subscribe was sent
+ */
+bool PubSubMqttClient::Subscribe(const char *topic, uint8_t qos)
+{
+    return this->mqttClient.subscribe(topic, qos);
+};
+
+/**
+ * Unsubscribes from a topic
+ * 
+ * @parameter topic The subscribed topic
+ * 
+ * @return True if the unsubscribe was sent
+ */
+bool PubSubMqttClient::Unsubscribe(const char *topic)
+{
+    return this->mqttClient.unsubscribe(topic);
+};
+
+/**
+ * Publishes a message
+ * 
+ * @parameter topic     The topic
+ * @parameter payload   The null terminated message
+ * @parameter retained  True to let the broker keep the message
+ * 
+ * @return True if the publish was sent
+ */
+bool PubSubMqttClient::Publish(const char *topic, const char *payload, bool retained)
+{
+    return this->mqttClient.publish(topic, payload, retained);
+};
+
+/**
+ * Reads the received packets and sends the keep alive
+ */
+void PubSubMqttClient::Loop()
+{
+    this->mqttClient.loop();
+};
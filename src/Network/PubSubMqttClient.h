@@ -0,0 +1,53 @@
+#pragma once
+
+// Includes
+#include <PubSubClient.h> // @installed via Arduino Library Manger    GitHub => https://github.com/knolleary/pubsubclient
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include "../Constants/Constants.h"
+
+// Interface
+#include "../Interface/IMqttClient.h"
+
+// Classes
+/**
+ * @brief The PubSubMqttClient Class connects the network component to the broker with PubSubClient.
+ * The connect blocks the loop until the broker answered or the timeouts elapsed
+ * 
+ */
+class PubSubMqttClient : public IMqttClient
+{
+    // ## Constructor / Important ## //
+public:
+    PubSubMqttClient();
+
+    // ## Interface ## //
+private:
+public:
+    virtual void Begin(std::function<void(char *, uint8_t *, unsigned int)> callback);
+    virtual bool Connect(IPAddress brokerIpAddress,
+                         uint16_t brokerPort,
+                         const char *clientName,
+                         const char *username,
+                         const char *password,
+                         const char *willTopic,
+                         uint8_t willQos,
+                         bool willRetain,
+                         const char *willMessage,
+                         bool cleanSession);
+    virtual void Disconnect();
+    virtual bool isConnecting();
+    virtual bool isConnected();
+    virtual int getState();
+    virtual bool Subscribe(const char *topic, uint8_t qos);
+    virtual bool Unsubscribe(const char *topic);
+    virtual bool Publish(const char *topic, const char *payload, bool retained);
+    virtual void Loop();
+
+    // ## Data ## //
+private:
+    PubSubClient mqttClient;
+    WiFiClient wifiMqtt;
+    const uint16_t MQTT_CONNECT_TIMEOUT = 200;   // ms => TCP handshake
+    const uint16_t MQTT_ACKNOWLEDGE_TIMEOUT = 1; // sec => Broker acknowledge. Smallest value PubSubClient supports
+};
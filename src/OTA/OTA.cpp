@@ -100,3 +100,23 @@ void OTA::Run()
     }
     ArduinoOTA.handle();
 };
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority OTA::getRunPriority()
+{
+    return SchedulerPriority::Low;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t OTA::getRunBudget()
+{
+    return 1000;
+};
@@ -28,6 +28,8 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
 
     // ## Data ## //
 private:
@@ -45,6 +45,16 @@ void Parameterhandler::Run()
     }
 };
 
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool Parameterhandler::isRunRequested()
+{
+    return !init; // Only retries the initialization
+};
+
 // ================================================================ Motion ================================================================ //
 MotionParameter Parameterhandler::getMotionParameter()
 {
@@ -118,6 +128,8 @@ LEDStripParameter Parameterhandler::getLEDStripParameter(uint8_t stripID)
     {
         return this->ledStripParameter[stripID];
     }
+
+    return {};
 }
 
 void Parameterhandler::updateLEDStripParameter(uint8_t stripID, LEDStripParameter data)
@@ -125,6 +137,7 @@ void Parameterhandler::updateLEDStripParameter(uint8_t stripID, LEDStripParamete
     if (stripID >= 0 && stripID < STRIP_COUNT)
     {
         this->ledStripParameter[stripID] = data;
+        this->ledStripRevision[stripID]++;
 
         FilesystemLEDStripData filesystemLEDStripData = this->filesystem->getLEDStripData(stripID);
 
@@ -148,7 +161,8 @@ void Parameterhandler::updateLEDStripParameter(uint8_t stripID, LEDStripParamete
 
         this->filesystem->saveLEDStripData(stripID, filesystemLEDStripData);
 
-        NetworkLEDStripData networkLEDStripData = this->network->getNetworkLEDStripData(stripID);
+        // Network strip ID's start at 1
+        NetworkLEDStripData networkLEDStripData = this->network->getNetworkLEDStripData(stripID + 1);
 
         networkLEDStripData.Power = data.Power;
         networkLEDStripData.Red = data.Red;
@@ -167,7 +181,7 @@ void Parameterhandler::updateLEDStripParameter(uint8_t stripID, LEDStripParamete
         networkLEDStripData.WhiteTemperatureBrightnessFadeCurve = data.WhiteTemperatureBrightnessFadeCurve;
         networkLEDStripData.Effect = data.Effect;
 
-        this->network->UpdateNetworkLEDStripData(stripID, networkLEDStripData);
+        this->network->UpdateNetworkLEDStripData(stripID + 1, networkLEDStripData);
     }
 }
 
@@ -187,6 +201,66 @@ void Parameterhandler::updateLEDStripParameter(uint8_t stripID, NetworkLEDStripD
     }
 }
 
+/**
+ * @brief Returns the revision of the strip parameters. Changes with every update
+ * 
+ * @param stripID   The strip starting with 0
+ * @return The revision
+ */
+uint32_t Parameterhandler::getLEDStripRevision(uint8_t stripID)
+{
+    if (stripID >= 0 && stripID < STRIP_COUNT)
+    {
+        return this->ledStripRevision[stripID];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Remembers the ingress time of a strip command until the LedDriver shows it. Gets called after the update of the parameters
+ * => The stamp holds the revision with the command. The oldest pending command is kept => Commands in a burst are measured worst case
+ * 
+ * @param stripID       The strip starting with 0
+ * @param path          The ingress path of the command
+ * @param ingressMicros The time the command arrived
+ */
+void Parameterhandler::stampLEDStripCommand(uint8_t stripID, ProfilerComponent path, unsigned long ingressMicros)
+{
+    if (stripID >= 0 && stripID < STRIP_COUNT)
+    {
+        CommandStamp &stamp = this->ledStripCommandStamp[stripID];
+        if (!stamp.pending || ingressMicros - stamp.ingressMicros >= COMMAND_LATENCY_TIMEOUT)
+        {
+            stamp.pending = true;
+            stamp.path = path;
+            stamp.ingressMicros = ingressMicros;
+            stamp.revision = this->ledStripRevision[stripID];
+        }
+    }
+}
+
+/**
+ * @brief Returns and clears the pending command stamp of a strip once the led output comes from parameters that hold the command
+ * 
+ * @param stripID   The strip starting with 0
+ * @param revision  The revision of the parameters the led output is derived from
+ * @param stamp     The pending stamp
+ * @return True if a command was pending and the revision holds it
+ */
+bool Parameterhandler::takeLEDStripCommandStamp(uint8_t stripID, uint32_t revision, CommandStamp &stamp)
+{
+    if (stripID >= 0 && stripID < STRIP_COUNT && this->ledStripCommandStamp[stripID].pending &&
+        (int32_t)(revision - this->ledStripCommandStamp[stripID].revision) >= 0)
+    {
+        stamp = this->ledStripCommandStamp[stripID];
+        this->ledStripCommandStamp[stripID].pending = false;
+        return true;
+    }
+
+    return false;
+}
+
 // ================================================================ Settings ================================================================ //
 SettingsStripParameter Parameterhandler::getSettingsStripParameter(uint8_t stripID)
 {
@@ -194,6 +268,8 @@ SettingsStripParameter Parameterhandler::getSettingsStripParameter(uint8_t strip
     {
         return this->settingsStripParameter[stripID];
     }
+
+    return {};
 }
 
 void Parameterhandler::updateSettingsStripParameter(uint8_t stripID, SettingsStripParameter data)
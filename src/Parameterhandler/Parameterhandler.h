@@ -33,6 +33,7 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual bool isRunRequested();
 
     // ================ Data ================ //
 private:
@@ -43,6 +44,8 @@ private:
     MotionParameter motionParameter = {};
     // ==== LED Strip
     LEDStripParameter ledStripParameter[STRIP_COUNT]{};
+    uint32_t ledStripRevision[STRIP_COUNT]{0};        // Counts the updates => The LedDriver knows which parameters it shows
+    CommandStamp ledStripCommandStamp[STRIP_COUNT]{}; // Command to photon latency. Taken by the LedDriver
     // ==== Settings
     SettingsStripParameter settingsStripParameter[STRIP_COUNT]{};
     // ==== Configuration
@@ -62,6 +65,9 @@ public:
     void updateLEDStripParameter(uint8_t stripID, LEDStripParameter data);
     void updateLEDStripParameter(uint8_t stripID, FilesystemLEDStripData data);
     void updateLEDStripParameter(uint8_t stripID, NetworkLEDStripData data);
+    uint32_t getLEDStripRevision(uint8_t stripID);
+    void stampLEDStripCommand(uint8_t stripID, ProfilerComponent path, unsigned long ingressMicros);
+    bool takeLEDStripCommandStamp(uint8_t stripID, uint32_t revision, CommandStamp &stamp);
     // ==== Settings
     SettingsStripParameter getSettingsStripParameter(uint8_t stripID);
     void updateSettingsStripParameter(uint8_t stripID, SettingsStripParameter data);
@@ -18,11 +18,13 @@ PirReader::PirReader(uint8_t pinPirSensor1,
  */
 void PirReader::setReference(Network *network,
                              Information *information,
-                             Helper *helper)
+                             Helper *helper,
+                             ITimeSource *clock)
 {
     this->network = network;
     this->information = information;
     this->helper = helper;
+    this->clock = clock;
 };
 
 /**
@@ -59,28 +61,15 @@ void PirReader::Run()
     }
 
     // Check Physical Motion Sensor 1
-    if (digitalRead(this->pinPirSensor1) == HIGH)
-    {
-        this->sensor1Triggered = true;
-    }
-    else
-    {
-        this->sensor1Triggered = false;
-    }
+    this->sensor1Triggered = this->ReadDebouncedSensor(this->pinPirSensor1, this->sensor1Triggered, this->prevMillisSensor1Change);
 
     // Check Physical Motion Sensor 2
-    if (digitalRead(this->pinPirSensor2) == HIGH)
-    {
-        this->sensor2Triggered = true;
-    }
-    else
-    {
-        this->sensor2Triggered = false;
-    }
+    this->sensor2Triggered = this->ReadDebouncedSensor(this->pinPirSensor2, this->sensor2Triggered, this->prevMillisSensor2Change);
 
     // Check Virtual Motion Sensor
     if (this->network->isVirtualPIRSensorTriggered())
     {
+        this->network->resetVirtualPIRSensor(); // Consumed => Acts like a single trigger of a physical sensor
         this->virtualSensorTriggered = true;
     }
     else
@@ -93,7 +82,7 @@ void PirReader::Run()
     {
         this->sensorTriggered = true;
         this->motionDetected = true;
-        prevMillisMotion = millis();
+        prevMillisMotion = this->clock->Millis();
     }
     if (!this->sensor1Triggered && !this->sensor2Triggered && !this->virtualSensorTriggered)
     {
@@ -101,7 +90,7 @@ void PirReader::Run()
     }
 
     // Update motionDetected based on timeout
-    if (millis() - prevMillisMotion >= (network->getNetworkMotionData().MotionDetectionTimeout * 1000))
+    if (this->clock->Millis() - prevMillisMotion >= (network->getNetworkMotionData().MotionDetectionTimeout * 1000))
     {
         motionDetected = false;
     }
@@ -116,7 +105,59 @@ void PirReader::Run()
         this->memSensorTriggered = this->sensorTriggered;
         this->memMotionDetected = this->motionDetected;
     }
-}
+
+    // Every change gets queued for the network => Published on the edge instead of the next periodic republish
+    PIRReaderData data = this->getPIRReaderData();
+    if (data.motionDetected != this->memEventData.motionDetected ||
+        data.sensorTriggered != this->memEventData.sensorTriggered ||
+        data.sensor1Triggered != this->memEventData.sensor1Triggered ||
+        data.sensor2Triggered != this->memEventData.sensor2Triggered ||
+        data.virtualSensorTriggered != this->memEventData.virtualSensorTriggered)
+    {
+        this->PushEvent(data);
+        this->memEventData = data;
+    }
+};
+
+/**
+ * @brief Returns the time between two Run calls
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t PirReader::getRunPeriod()
+{
+    return 20000; // 50 Hz
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority PirReader::getRunPriority()
+{
+    return SchedulerPriority::Normal;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t PirReader::getRunBudget()
+{
+    return 200;
+};
+
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool PirReader::isRunRequested()
+{
+    return init;
+};
 
 /**
  * @brief Indicates if motion is detected
@@ -144,4 +185,83 @@ PIRReaderData PirReader::getPIRReaderData()
     data.virtualSensorTriggered = this->virtualSensorTriggered;
 
     return data;
-}
\ No newline at end of file
+}
+/**
+ * @brief Reads a physical sensor with a leading edge debounce. A new level is taken at once => No added latency.
+ * Changes within the debounce time after it get ignored
+ * 
+ * @param pin              The digital pin of the sensor
+ * @param level            The current debounced level
+ * @param prevMillisChange The time of the last taken change. Gets updated on a change
+ * @return The debounced level
+ */
+bool PirReader::ReadDebouncedSensor(uint8_t pin, bool level, unsigned long &prevMillisChange)
+{
+    bool newLevel = digitalRead(pin) == HIGH;
+    unsigned long curMillis = this->clock->Millis();
+    if (newLevel != level && curMillis - prevMillisChange >= this->TimeOut_Debounce)
+    {
+        prevMillisChange = curMillis;
+        return newLevel;
+    }
+    return level;
+};
+
+/**
+ * @brief Adds a change of the pir reader data to the event queue. A full queue drops the oldest event
+ * 
+ * @param data The new pir reader data
+ */
+void PirReader::PushEvent(PIRReaderData data)
+{
+    if (this->eventQueueCount >= PIR_EVENT_QUEUE_SIZE)
+    {
+        this->eventQueueHead = (this->eventQueueHead + 1) % PIR_EVENT_QUEUE_SIZE;
+        this->eventQueueCount--;
+        this->droppedEventCount++;
+    }
+
+    uint8_t tail = (this->eventQueueHead + this->eventQueueCount) % PIR_EVENT_QUEUE_SIZE;
+    this->eventQueue[tail].data = data;
+    this->eventQueue[tail].timestamp = this->clock->Micros();
+    this->eventQueueCount++;
+};
+
+/**
+ * @brief Indicates if a change of the pir reader data is queued
+ * 
+ * @return True if at least one event is queued
+ */
+bool PirReader::hasEvent()
+{
+    return this->eventQueueCount > 0;
+};
+
+/**
+ * @brief Takes the oldest change of the pir reader data from the event queue
+ * 
+ * @param event Gets the oldest event
+ * @return True if an event was queued
+ */
+bool PirReader::PopEvent(PIRReaderEvent &event)
+{
+    if (this->eventQueueCount == 0)
+    {
+        return false;
+    }
+
+    event = this->eventQueue[this->eventQueueHead];
+    this->eventQueueHead = (this->eventQueueHead + 1) % PIR_EVENT_QUEUE_SIZE;
+    this->eventQueueCount--;
+    return true;
+};
+
+/**
+ * @brief Returns the number of events that got dropped because the queue was full
+ * 
+ * @return The dropped event count
+ */
+uint32_t PirReader::getDroppedEventCount()
+{
+    return this->droppedEventCount;
+};
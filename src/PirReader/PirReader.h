@@ -10,6 +10,7 @@
 
 // ================================ INTERFACES ================================ //
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
 
 // Blueprint for compiler. Problem => circular dependency
 class Network;
@@ -29,7 +30,8 @@ public:
               uint8_t pinPirSensor2);
     void setReference(Network *network,
                       Information *information,
-                      Helper *helper);
+                      Helper *helper,
+                      ITimeSource *clock);
     bool init = false;
 
     // ================ Interface ================ //
@@ -37,13 +39,21 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+    virtual bool isRunRequested();
 
     // ================ Data ================ //
 private:
     Network *network;
     Information *information;
     Helper *helper;
+    ITimeSource *clock;
     unsigned long prevMillisMotion = 0;
+    unsigned long prevMillisSensor1Change = 0;
+    unsigned long prevMillisSensor2Change = 0;
+    const unsigned long TimeOut_Debounce = 100; // 100 ms. A new sensor level is taken at once, changes right after it get ignored
     uint8_t pinPirSensor1 = 0;
     uint8_t pinPirSensor2 = 0;
     bool motionDetected = false; // Indicates if motion is detected
@@ -54,10 +64,24 @@ private:
     bool sensor2Triggered = false;       // Indicates if sensor 2 got triggered
     bool virtualSensorTriggered = false; // Indicates if the virtual sensor got triggered
 
+    // ======== Events ======== //
+    PIRReaderData memEventData = {};
+    PIRReaderEvent eventQueue[PIR_EVENT_QUEUE_SIZE] = {};
+    uint8_t eventQueueHead = 0;
+    uint8_t eventQueueCount = 0;
+    uint32_t droppedEventCount = 0;
+
 public:
     // ================ Methods ================ //
 private:
+    bool ReadDebouncedSensor(uint8_t pin, bool level, unsigned long &prevMillisChange);
+    void PushEvent(PIRReaderData data);
+
 public:
     bool MotionDetected();
     PIRReaderData getPIRReaderData();
+
+    bool hasEvent();
+    bool PopEvent(PIRReaderEvent &event);
+    uint32_t getDroppedEventCount();
 };
\ No newline at end of file
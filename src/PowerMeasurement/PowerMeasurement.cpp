@@ -1,16 +1,12 @@
 #include "PowerMeasurement.h"
 
 /**
- * Constructor for the PowerMeasurement class
+ * Constructor for the PowerMeasurement class. The i2c address of the power messurement ic gets discovered by the I2C component
  * 
- * @parameter i2cAddress    The i2c address of the power messurement ic
- * @parameter *i2c          Pointer to the used instance of the I2C class
- * @parameter *network      Pointer to the used instace of the Network class
+ * @parameter shuntResistorOhm  The value of the shunt resistor in Ohm
  */
-PowerMeasurement::PowerMeasurement(uint8_t i2cAddress,
-                                   double shuntResistorOhm)
+PowerMeasurement::PowerMeasurement(double shuntResistorOhm)
 {
-    this->i2cAddress = i2cAddress;
     this->shuntResistorOhm = shuntResistorOhm;
 };
 
@@ -18,10 +14,12 @@ PowerMeasurement::PowerMeasurement(uint8_t i2cAddress,
  * Sets reference to external components
  */
 void PowerMeasurement::setReference(I2C *i2c,
-                                    Network *network)
+                                    Network *network,
+                                    ITimeSource *clock)
 {
     this->i2c = i2c;
     this->network = network;
+    this->clock = clock;
 };
 
 /**
@@ -35,6 +33,14 @@ bool PowerMeasurement::Init()
     {
         i2c->Init();
 
+        // Only enable the power messurement if a power messurement ic was found on the bus
+        if (!i2c->isPowerMeasurementPresent())
+        {
+            Serial.println(F("No INA219 found => Power Measurement disabled"));
+            return init;
+        }
+        i2cAddress = i2c->getPowerMeasurementAddress();
+
         /*
             Calculations INA219
             Datasheet: https://datasheet.lcsc.com/szlcsc/1810181516_Texas-Instruments-INA219AIDR_C138706.pdf
@@ -137,7 +143,7 @@ void PowerMeasurement::Run()
         return;
     }
 
-    unsigned long CurMillis_PowerMessurmentUpdateRate = millis();
+    unsigned long CurMillis_PowerMessurmentUpdateRate = this->clock->Millis();
     if (CurMillis_PowerMessurmentUpdateRate - PrevMillis_PowerMessurmentUpdateRate >= TimeOut_PowerMessurmentUpdateRate)
     {
         PrevMillis_PowerMessurmentUpdateRate = CurMillis_PowerMessurmentUpdateRate;
@@ -8,6 +8,7 @@
 
 // Interface
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
 
 // Blueprint for compiler. Problem => circular dependency
 class I2C;
@@ -18,10 +19,10 @@ class PowerMeasurement : public IBaseClass
 {
     // ## Constructor / Important ## //
 public:
-    PowerMeasurement(uint8_t i2cAddress,
-                     double shuntResistorOhm);
+    PowerMeasurement(double shuntResistorOhm);
     void setReference(I2C *i2c,
-                      Network *network);
+                      Network *network,
+                      ITimeSource *clock);
     bool init = false;
 
     // ## Interface ## //
@@ -32,9 +33,10 @@ public:
 
     // ## Data ## //
 private:
-    uint8_t i2cAddress;
+    uint8_t i2cAddress = 0;
     I2C *i2c;
     Network *network;
+    ITimeSource *clock;
 
     double shuntResistorOhm = 0.02; // Ohm
     int calibrationValue = 0;
@@ -0,0 +1,316 @@
+#include "Profiler.h"
+
+/**
+ * @brief Construct a new Profiler:: Profiler object
+ * 
+ */
+Profiler::Profiler(){
+
+};
+
+/**
+ * @brief Sets the needed refernce for the profiler
+ */
+void Profiler::setReference(Helper *helper,
+                            ITimeSource *clock)
+{
+    this->helper = helper;
+    this->clock = clock;
+};
+
+/**
+ * @brief Initializes the profiler component
+ * 
+ * @return True if the initialization was successful
+ */
+bool Profiler::Init()
+{
+    if (!init)
+    {
+        this->Reset();
+
+        Serial.println(F("Profiler initialized"));
+        init = true;
+    }
+    return init;
+};
+
+/**
+ * @brief Runs the profiler component. Prints the report periodically while the profiler is enabled
+ * 
+ */
+void Profiler::Run()
+{
+    if (!init)
+    {
+        return;
+    }
+
+    if (!this->enabled)
+    {
+        return;
+    }
+
+    unsigned long curMillis = this->clock->Millis();
+    if (curMillis - this->prevMillisPrint >= this->TimeOut_Print)
+    {
+        this->prevMillisPrint = curMillis;
+        this->PrintReport();
+    }
+};
+
+/**
+ * @brief Returns the time between two Run calls
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t Profiler::getRunPeriod()
+{
+    return 1000000; // 1 sec
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority Profiler::getRunPriority()
+{
+    return SchedulerPriority::Low;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t Profiler::getRunBudget()
+{
+    return 5000; // Report print
+};
+
+/**
+ * @brief Returns if the component has work for the scheduler
+ * 
+ * @return True if Run should be called
+ */
+bool Profiler::isRunRequested()
+{
+    return this->enabled;
+};
+
+/**
+ * @brief Enables or disables the recording. Enabling starts with empty histograms
+ * 
+ * @param enabled True to record the run times of the components
+ */
+void Profiler::setEnabled(bool enabled)
+{
+    if (enabled && !this->enabled)
+    {
+        this->Reset();
+        this->prevMillisPrint = this->clock->Millis();
+    }
+    this->enabled = enabled;
+};
+
+/**
+ * @brief Returns if the profiler is recording
+ * 
+ * @return True if enabled
+ */
+bool Profiler::isEnabled()
+{
+    return this->enabled;
+};
+
+/**
+ * @brief Clears all histograms
+ * 
+ */
+void Profiler::Reset()
+{
+    for (uint8_t i = 0; i < PROFILER_COMPONENT_COUNT; i++)
+    {
+        this->histogram[i] = {};
+    }
+};
+
+/**
+ * @brief Returns the histogram bucket of the given duration
+ * 
+ * @param duration The duration in micro seconds
+ * @return The bucket index. 0 for 0 us, n for [2^(n-1), 2^n) us
+ */
+uint8_t Profiler::getBucket(uint32_t duration)
+{
+    if (duration == 0)
+    {
+        return 0;
+    }
+
+    uint8_t bucket = 32 - __builtin_clz(duration);
+    if (bucket >= PROFILER_BUCKET_COUNT)
+    {
+        bucket = PROFILER_BUCKET_COUNT - 1;
+    }
+    return bucket;
+};
+
+/**
+ * @brief Adds the run time of a component to its histogram. Does nothing while the profiler is disabled
+ * 
+ * @param component The profiled component
+ * @param duration  The run time in micro seconds
+ */
+void Profiler::Record(ProfilerComponent component, uint32_t duration)
+{
+    if (!this->enabled)
+    {
+        return;
+    }
+
+    ProfilerHistogram &data = this->histogram[static_cast<uint8_t>(component)];
+    data.bucket[this->getBucket(duration)]++;
+    if (data.count == 0 || duration < data.min)
+    {
+        data.min = duration;
+    }
+    data.count++;
+    if (duration > data.max)
+    {
+        data.max = duration;
+    }
+};
+
+/**
+ * @brief Returns the given percentile of the run time of a component
+ * 
+ * @param component The profiled component
+ * @param percent   The percentile from 1 to 100
+ * @return The upper bound of the bucket holding the percentile in micro seconds. Never above the maximum
+ */
+uint32_t Profiler::getPercentile(ProfilerComponent component, uint8_t percent)
+{
+    ProfilerHistogram &data = this->histogram[static_cast<uint8_t>(component)];
+    if (data.count == 0)
+    {
+        return 0;
+    }
+
+    // Rank of the sample we are looking for, rounded up
+    uint32_t rank = (uint32_t)(((uint64_t)data.count * percent + 99) / 100);
+    if (rank == 0)
+    {
+        rank = 1;
+    }
+
+    uint32_t cumulative = 0;
+    for (uint8_t i = 0; i < PROFILER_BUCKET_COUNT; i++)
+    {
+        cumulative += data.bucket[i];
+        if (cumulative >= rank)
+        {
+            uint32_t upperBound = (i == 0) ? 0 : (1UL << i) - 1;
+            return (upperBound < data.max) ? upperBound : data.max;
+        }
+    }
+    return data.max;
+};
+
+/**
+ * @brief Returns the shortest run time of a component
+ * 
+ * @param component The profiled component
+ * @return The minimum in micro seconds
+ */
+uint32_t Profiler::getMin(ProfilerComponent component)
+{
+    return this->histogram[static_cast<uint8_t>(component)].min;
+};
+
+/**
+ * @brief Returns the longest run time of a component
+ * 
+ * @param component The profiled component
+ * @return The maximum in micro seconds
+ */
+uint32_t Profiler::getMax(ProfilerComponent component)
+{
+    return this->histogram[static_cast<uint8_t>(component)].max;
+};
+
+/**
+ * @brief Returns the number of recorded runs of a component
+ * 
+ * @param component The profiled component
+ * @return The sample count
+ */
+uint32_t Profiler::getCount(ProfilerComponent component)
+{
+    return this->histogram[static_cast<uint8_t>(component)].count;
+};
+
+/**
+ * @brief Builds the report of one component as JSON
+ * {"min":..,"p50":..,"p99":..,"max":..,"count":..}
+ * 
+ * @param component The profiled component
+ * @return The report as JSON string
+ */
+String Profiler::getComponentJson(ProfilerComponent component)
+{
+    String json = "{\"min\":" + String(this->getMin(component));
+    json += ",\"p50\":" + String(this->getPercentile(component, 50));
+    json += ",\"p99\":" + String(this->getPercentile(component, 99));
+    json += ",\"max\":" + String(this->getMax(component));
+    json += ",\"count\":" + String(this->getCount(component));
+    json += "}";
+    return json;
+};
+
+/**
+ * @brief Builds the report of all components as JSON
+ * {"enabled":1,"components":{"Network":{"min":..,"p50":..,"p99":..,"max":..,"count":..},...}}
+ * 
+ * @return The report as JSON string
+ */
+String Profiler::getReportJson()
+{
+    String json = "{\"enabled\":" + String(this->enabled) + ",\"components\":{";
+    for (uint8_t i = 0; i < PROFILER_COMPONENT_COUNT; i++)
+    {
+        ProfilerComponent component = static_cast<ProfilerComponent>(i);
+        if (i > 0)
+        {
+            json += ",";
+        }
+        json += "\"" + this->helper->ProfilerComponentToString(component) + "\":" + this->getComponentJson(component);
+    }
+    json += "}}";
+    return json;
+};
+
+/**
+ * @brief Prints min / p50 / p99 / max of all components in micro seconds to serial
+ * 
+ */
+void Profiler::PrintReport()
+{
+    this->helper->TopSpacerPrint();
+    for (uint8_t i = 0; i < PROFILER_COMPONENT_COUNT; i++)
+    {
+        ProfilerComponent component = static_cast<ProfilerComponent>(i);
+        this->helper->InsertPrint();
+        Serial.print(this->helper->ProfilerComponentToString(component));
+        Serial.print(F(" min/p50/p99/max [us] : "));
+        Serial.print(this->getMin(component));
+        Serial.print(F(" / "));
+        Serial.print(this->getPercentile(component, 50));
+        Serial.print(F(" / "));
+        Serial.print(this->getPercentile(component, 99));
+        Serial.print(F(" / "));
+        Serial.println(this->getMax(component));
+    }
+    this->helper->BottomSpacerPrint();
+};
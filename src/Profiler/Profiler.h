@@ -0,0 +1,72 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+#include "../Helper/Helper.h"
+#include "../Enums/Enums.h"
+#include "../Structs/Structs.h"
+#include "../Constants/Constants.h"
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+
+// Blueprint for compiler. Problem => circular dependency
+class Helper;
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The Profiler Class keeps a latency histogram of the run time of every component in the main loop.
+ * The histograms use power of two buckets, so p50 / p99 are reported as the upper bound of their bucket
+ */
+class Profiler : public IBaseClass
+{
+    // ================ Constructor / Reference ================ //
+public:
+    Profiler();
+    void setReference(Helper *helper,
+                      ITimeSource *clock);
+    bool init = false;
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual bool Init();
+    virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+    virtual bool isRunRequested();
+
+    // ================ Data ================ //
+private:
+    Helper *helper;
+    ITimeSource *clock;
+
+    bool enabled = false; // Toggled at runtime over mqtt or the webserver
+    ProfilerHistogram histogram[PROFILER_COMPONENT_COUNT] = {};
+
+    // ======== Print ======== //
+    unsigned long prevMillisPrint = 0;
+    const unsigned long TimeOut_Print = 60000; // 1 min
+
+public:
+    // ================ Methods ================ //
+private:
+    uint8_t getBucket(uint32_t duration);
+    void PrintReport();
+
+public:
+    void setEnabled(bool enabled);
+    bool isEnabled();
+    void Reset();
+
+    void Record(ProfilerComponent component, uint32_t duration);
+    uint32_t getPercentile(ProfilerComponent component, uint8_t percent);
+    uint32_t getMin(ProfilerComponent component);
+    uint32_t getMax(ProfilerComponent component);
+    uint32_t getCount(ProfilerComponent component);
+
+    String getComponentJson(ProfilerComponent component);
+    String getReportJson();
+};
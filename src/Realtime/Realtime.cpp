@@ -0,0 +1,549 @@
+#include "Realtime.h"
+
+/**
+ * @brief Construct a new Realtime:: Realtime object
+ * 
+ * @param jitterBufferDelay ms a frame stays in the jitter buffer. 0 shows every frame at once
+ */
+Realtime::Realtime(uint16_t jitterBufferDelay)
+{
+    this->jitterBufferDelay = (unsigned long)jitterBufferDelay * 1000;
+};
+
+/**
+ * @brief Sets the needed refernce for the realtime class
+ */
+void Realtime::setReference(Network *network,
+                            Information *information,
+                            Helper *helper,
+                            ITimeSource *clock)
+{
+    this->network = network;
+    this->information = information;
+    this->helper = helper;
+    this->clock = clock;
+};
+
+/**
+ * @brief Initializes the realtime component. The sockets get opened once the WiFi is connected
+ * 
+ * @return True if the initialization was successful
+ */
+bool Realtime::Init()
+{
+    if (!init)
+    {
+        Serial.println(F("Realtime initialized"));
+        init = true;
+    }
+
+    return init;
+};
+
+/**
+ * @brief Runs the realtime component
+ * 
+ */
+void Realtime::Run()
+{
+    if (!init)
+    {
+        return;
+    }
+
+    HandleListener();
+    if (!this->listening)
+    {
+        return;
+    }
+
+    // Only the newest frame is of interest => Older packets in the socket just get overwritten
+    for (uint8_t i = 0; i < REALTIME_PACKET_BUDGET; i++)
+    {
+        bool received = false;
+
+        int packetSize = this->ddpUDP.parsePacket();
+        if (packetSize > 0)
+        {
+            received = true;
+            if (this->ReadDDPPacket(packetSize))
+            {
+                this->PushFrame();
+                this->Activate(RealtimeProtocol::DDP);
+            }
+            this->ddpUDP.flush();
+        }
+
+        packetSize = this->e131UDP.parsePacket();
+        if (packetSize > 0)
+        {
+            received = true;
+            if (this->ReadE131Packet(packetSize))
+            {
+                this->PushFrame();
+                this->Activate(RealtimeProtocol::E131);
+            }
+            this->e131UDP.flush();
+        }
+
+        if (!received)
+        {
+            break;
+        }
+    }
+
+    // Sequencer stopped sending => Effects take over again
+    if (this->protocol != RealtimeProtocol::None && this->clock->Millis() - this->prevMillisFrame >= REALTIME_TIMEOUT)
+    {
+        this->Deactivate();
+    }
+};
+
+/**
+ * @brief Returns the time between two runs
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t Realtime::getRunPeriod()
+{
+    // One led frame at 90 Hz => Runs right before the led driver and adds no deadline of its own for the other tasks.
+    // The arrival jitter of up to one led frame gets absorbed by the jitter buffer
+    return 11111;
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority Realtime::getRunPriority()
+{
+    return SchedulerPriority::High; // Frames wait in the socket until read
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t Realtime::getRunBudget()
+{
+    return 300;
+};
+
+/**
+ * @brief Opens the sockets while the WiFi is connected and closes them on a disconnect
+ * 
+ */
+void Realtime::HandleListener()
+{
+    bool wiFiConnected = this->network->isWiFiConnected();
+    if (wiFiConnected && !this->listening)
+    {
+        this->ddpUDP.begin(REALTIME_DDP_PORT);
+        // Joins the multicast group of the universe. Unicast packets to the port get received too
+        this->e131UDP.beginMulticast(WiFi.localIP(),
+                                     IPAddress(239, 255, highByte(REALTIME_E131_UNIVERSE), lowByte(REALTIME_E131_UNIVERSE)),
+                                     REALTIME_E131_PORT);
+        this->e131SequenceValid = false;
+        this->listening = true;
+    }
+    else if (!wiFiConnected && this->listening)
+    {
+        this->ddpUDP.stop();
+        this->e131UDP.stop();
+        this->listening = false;
+        this->Deactivate();
+    }
+};
+
+/**
+ * @brief Reads a DDP packet. The header fields get checked in the receive buffer and the channel data gets read
+ * straight into the frame
+ * 
+ * @param packetSize The size of the received packet
+ * @return True if the packet was valid
+ */
+bool Realtime::ReadDDPPacket(int packetSize)
+{
+    const uint8_t DDP_BASE_HEADER_LENGTH = 10;
+    const uint8_t DDP_VERSION_MASK = 0xC0;
+    const uint8_t DDP_VERSION_1 = 0x40;
+    const uint8_t DDP_FLAG_TIMECODE = 0x10;
+    const uint8_t DDP_FLAG_QUERY = 0x02;
+    const uint8_t DDP_ID_DISPLAY = 1;
+
+    if (packetSize < DDP_BASE_HEADER_LENGTH)
+    {
+        this->invalidPacketCount++;
+        return false;
+    }
+    this->ddpUDP.read(this->header, DDP_BASE_HEADER_LENGTH);
+
+    uint8_t flags = this->header[0];
+    uint8_t dataType = this->header[2];
+    uint8_t id = this->header[3];
+    uint32_t offset = ((uint32_t)this->header[4] << 24) | ((uint32_t)this->header[5] << 16) | ((uint32_t)this->header[6] << 8) | this->header[7];
+    uint16_t length = ((uint16_t)this->header[8] << 8) | this->header[9];
+
+    // Timecode is only used for synchronized displays => Skipped
+    uint8_t headerLength = DDP_BASE_HEADER_LENGTH;
+    if ((flags & DDP_FLAG_TIMECODE) != 0)
+    {
+        headerLength = REALTIME_DDP_HEADER_LENGTH;
+        if (packetSize < headerLength)
+        {
+            this->invalidPacketCount++;
+            return false;
+        }
+        this->ddpUDP.read(this->header + DDP_BASE_HEADER_LENGTH, REALTIME_DDP_HEADER_LENGTH - DDP_BASE_HEADER_LENGTH);
+    }
+
+    // Only 8 bit data (or undefined) written to the default output. Queries get no reply
+    if ((flags & DDP_VERSION_MASK) != DDP_VERSION_1 ||
+        (flags & DDP_FLAG_QUERY) != 0 ||
+        id != DDP_ID_DISPLAY ||
+        ((dataType & 0x07) != 0 && (dataType & 0x07) != 3) ||
+        length > packetSize - headerLength)
+    {
+        this->invalidPacketCount++;
+        return false;
+    }
+
+    // Part of the data that falls into our channels
+    if (offset < REALTIME_CHANNEL_COUNT)
+    {
+        uint16_t count = length;
+        if (count > REALTIME_CHANNEL_COUNT - offset)
+        {
+            count = REALTIME_CHANNEL_COUNT - offset;
+        }
+        this->ddpUDP.read(this->getReceiveFrame() + offset, count);
+    }
+    return true;
+};
+
+/**
+ * @brief Reads an E1.31 data packet. The header fields get checked in the receive buffer and the channel data
+ * gets read straight into the frame
+ * 
+ * @param packetSize The size of the received packet
+ * @return True if the packet was valid and for our universe
+ */
+bool Realtime::ReadE131Packet(int packetSize)
+{
+    const uint8_t ACN_PACKET_IDENTIFIER[12] = {0x41, 0x53, 0x43, 0x2d, 0x45, 0x31, 0x2e, 0x31, 0x37, 0x00, 0x00, 0x00}; // "ASC-E1.17"
+    const uint8_t E131_OPTION_PREVIEW = 0x80;
+    const uint8_t E131_OPTION_TERMINATED = 0x40;
+
+    if (packetSize < REALTIME_E131_HEADER_LENGTH)
+    {
+        this->invalidPacketCount++;
+        return false;
+    }
+    this->e131UDP.read(this->header, REALTIME_E131_HEADER_LENGTH);
+
+    uint32_t rootVector = ((uint32_t)this->header[18] << 24) | ((uint32_t)this->header[19] << 16) | ((uint32_t)this->header[20] << 8) | this->header[21];
+    uint32_t framingVector = ((uint32_t)this->header[40] << 24) | ((uint32_t)this->header[41] << 16) | ((uint32_t)this->header[42] << 8) | this->header[43];
+    uint8_t sequence = this->header[111];
+    uint8_t options = this->header[112];
+    uint16_t universe = ((uint16_t)this->header[113] << 8) | this->header[114];
+    uint16_t propertyCount = ((uint16_t)this->header[123] << 8) | this->header[124];
+
+    // Root layer, data packet framing layer and DMP layer with the DMX start code
+    if (this->header[0] != 0x00 || this->header[1] != 0x10 ||
+        memcmp(this->header + 4, ACN_PACKET_IDENTIFIER, sizeof(ACN_PACKET_IDENTIFIER)) != 0 ||
+        rootVector != 0x00000004 ||
+        framingVector != 0x00000002 ||
+        this->header[117] != 0x02 ||
+        this->header[118] != 0xa1 ||
+        propertyCount == 0 ||
+        propertyCount - 1 > packetSize - REALTIME_E131_HEADER_LENGTH ||
+        this->header[125] != 0x00)
+    {
+        this->invalidPacketCount++;
+        return false;
+    }
+
+    // Other universes and previews are valid, but not for our output
+    if (universe != REALTIME_E131_UNIVERSE || (options & E131_OPTION_PREVIEW) != 0)
+    {
+        return false;
+    }
+
+    // Source stopped the stream => No need to wait for the timeout
+    if ((options & E131_OPTION_TERMINATED) != 0)
+    {
+        this->Deactivate();
+        return false;
+    }
+
+    // Out of order packet => Older than the shown frame. A big jump is a restarted source
+    int8_t sequenceDifference = (int8_t)(sequence - this->e131Sequence);
+    if (this->e131SequenceValid && sequenceDifference <= 0 && sequenceDifference > -20)
+    {
+        return false;
+    }
+    this->e131Sequence = sequence;
+    this->e131SequenceValid = true;
+
+    uint16_t count = propertyCount - 1; // Without the start code
+    if (count > REALTIME_CHANNEL_COUNT)
+    {
+        count = REALTIME_CHANNEL_COUNT;
+    }
+    this->e131UDP.read(this->getReceiveFrame(), count);
+    return true;
+};
+
+/**
+ * @brief Returns the free slot of the jitter buffer the channel data gets read into. Starts with the newest frame,
+ * so a packet with only a part of the channels keeps the other channels
+ * 
+ * @return REALTIME_CHANNEL_COUNT channel values
+ */
+uint8_t *Realtime::getReceiveFrame()
+{
+    RealtimeFrame &slot = this->jitterBuffer[(this->jitterBufferHead + this->jitterBufferCount) % (REALTIME_JITTER_BUFFER_SIZE + 1)];
+    if (this->jitterBufferCount > 0)
+    {
+        uint8_t newest = (this->jitterBufferHead + this->jitterBufferCount - 1) % (REALTIME_JITTER_BUFFER_SIZE + 1);
+        memcpy(slot.channel, this->jitterBuffer[newest].channel, REALTIME_CHANNEL_COUNT);
+    }
+    else
+    {
+        memcpy(slot.channel, this->frame, REALTIME_CHANNEL_COUNT);
+    }
+    return slot.channel;
+};
+
+/**
+ * @brief Adds the received frame to the jitter buffer. The presentation time follows the average frame interval
+ * of the source and only slowly the arrival time => The packet jitter does not reach the playout
+ * 
+ */
+void Realtime::PushFrame()
+{
+    unsigned long arrivalMicros = this->clock->Micros();
+    unsigned long presentationMicros = arrivalMicros;
+
+    if (this->jitterBufferCount > 0 || this->playoutStarted)
+    {
+        long measuredInterval = (long)(arrivalMicros - this->prevArrivalMicros);
+        if (this->frameInterval == 0)
+        {
+            this->frameInterval = measuredInterval;
+        }
+        else
+        {
+            this->frameInterval += (measuredInterval - (long)this->frameInterval) / 8;
+        }
+
+        presentationMicros = this->prevPresentationMicros + this->frameInterval;
+        long drift = (long)(arrivalMicros - presentationMicros);
+        if ((unsigned long)abs(drift) > this->jitterBufferDelay)
+        {
+            presentationMicros = arrivalMicros; // More jitter than the buffer can hide, e.g. a paused source => Resync
+        }
+        else
+        {
+            presentationMicros += drift / 8;
+        }
+    }
+    this->prevArrivalMicros = arrivalMicros;
+    this->prevPresentationMicros = presentationMicros;
+
+    // Playout already passed the frame
+    if (this->jitterBufferDelay > 0 && this->playoutStarted && (long)(presentationMicros - this->lastPlayoutMicros) <= 0)
+    {
+        this->lateDropCount++;
+        return;
+    }
+
+    if (this->jitterBufferCount >= REALTIME_JITTER_BUFFER_SIZE)
+    {
+        this->jitterBufferHead = (this->jitterBufferHead + 1) % (REALTIME_JITTER_BUFFER_SIZE + 1);
+        this->jitterBufferCount--;
+        this->overflowCount++;
+    }
+    this->jitterBuffer[(this->jitterBufferHead + this->jitterBufferCount) % (REALTIME_JITTER_BUFFER_SIZE + 1)].presentationMicros = presentationMicros;
+    this->jitterBufferCount++;
+};
+
+/**
+ * @brief Marks a valid frame. The first frame after the normal mode switches the led driver to the realtime frames
+ * 
+ * @param protocol The protocol of the frame
+ */
+void Realtime::Activate(RealtimeProtocol protocol)
+{
+    this->prevMillisFrame = this->clock->Millis();
+    this->frameCount++;
+
+    if (this->protocol != protocol)
+    {
+        this->protocol = protocol;
+        this->information->FormatPrintSingle("Realtime", this->helper->RealtimeProtocolToString(protocol));
+    }
+};
+
+/**
+ * @brief Falls back to the normal mode. The led driver fades from the last frame to the current effect
+ * 
+ */
+void Realtime::Deactivate()
+{
+    this->e131SequenceValid = false;
+    this->jitterBufferHead = 0;
+    this->jitterBufferCount = 0;
+    this->frameInterval = 0;
+    this->playoutStarted = false;
+    this->underrun = false;
+    if (this->protocol != RealtimeProtocol::None)
+    {
+        this->protocol = RealtimeProtocol::None;
+        this->information->FormatPrintSingle("Realtime", this->helper->RealtimeProtocolToString(this->protocol));
+    }
+};
+
+/**
+ * @brief Returns if realtime frames drive the led strips
+ * 
+ * @return True if a valid frame arrived within the timeout and the first frame got played out
+ */
+bool Realtime::isActive()
+{
+    return this->protocol != RealtimeProtocol::None && this->playoutStarted;
+};
+
+/**
+ * @brief Plays out the frame of the current led frame. Called by the led driver once per led frame.
+ * The frames are shown jitterBufferDelay after their presentation time and get interpolated linearly in between
+ * 
+ * @param currentMicros The time of the led frame
+ */
+void Realtime::Playout(unsigned long currentMicros)
+{
+    if (this->jitterBufferCount == 0)
+    {
+        return; // Keeps the last frame
+    }
+
+    // No jitter buffer => Newest frame at once
+    if (this->jitterBufferDelay == 0)
+    {
+        uint8_t newest = (this->jitterBufferHead + this->jitterBufferCount - 1) % (REALTIME_JITTER_BUFFER_SIZE + 1);
+        memcpy(this->frame, this->jitterBuffer[newest].channel, REALTIME_CHANNEL_COUNT);
+        this->jitterBufferHead = newest;
+        this->jitterBufferCount = 1;
+        this->playoutStarted = true;
+        return;
+    }
+
+    unsigned long playoutMicros = currentMicros - this->jitterBufferDelay;
+
+    // A frame is done once the next frame is due
+    while (this->jitterBufferCount >= 2)
+    {
+        const RealtimeFrame &next = this->jitterBuffer[(this->jitterBufferHead + 1) % (REALTIME_JITTER_BUFFER_SIZE + 1)];
+        if ((long)(playoutMicros - next.presentationMicros) < 0)
+        {
+            break;
+        }
+        this->jitterBufferHead = (this->jitterBufferHead + 1) % (REALTIME_JITTER_BUFFER_SIZE + 1);
+        this->jitterBufferCount--;
+    }
+
+    const RealtimeFrame &from = this->jitterBuffer[this->jitterBufferHead];
+    long sinceFrom = (long)(playoutMicros - from.presentationMicros);
+    if (sinceFrom < 0)
+    {
+        // First frame is not due yet
+        return;
+    }
+
+    if (this->jitterBufferCount == 1)
+    {
+        // Next frame is missing => Hold the last one
+        memcpy(this->frame, from.channel, REALTIME_CHANNEL_COUNT);
+        if (!this->underrun)
+        {
+            this->underrun = true;
+            this->underrunCount++;
+        }
+    }
+    else
+    {
+        const RealtimeFrame &to = this->jitterBuffer[(this->jitterBufferHead + 1) % (REALTIME_JITTER_BUFFER_SIZE + 1)];
+        unsigned long span = to.presentationMicros - from.presentationMicros;
+        uint16_t weight = span > 0 ? (uint16_t)(((uint64_t)sinceFrom << 8) / span) : 256; // 0 - 256
+        for (uint8_t i = 0; i < REALTIME_CHANNEL_COUNT; i++)
+        {
+            this->frame[i] = from.channel[i] + (((int16_t)to.channel[i] - (int16_t)from.channel[i]) * weight) / 256;
+        }
+        this->underrun = false;
+    }
+
+    this->lastPlayoutMicros = playoutMicros;
+    this->playoutStarted = true;
+};
+
+/**
+ * @brief Returns the played out frame
+ * 
+ * @return REALTIME_CHANNEL_COUNT channel values. R, G, B, CW, WW of strip 1 then strip 2
+ */
+const uint8_t *Realtime::getFrame()
+{
+    return this->frame;
+};
+
+/**
+ * @brief Returns the valid frames since the start
+ * 
+ * @return The number of frames
+ */
+uint32_t Realtime::getFrameCount()
+{
+    return this->frameCount;
+};
+
+/**
+ * @brief Returns the packets on the realtime ports that were no valid DDP or E1.31 packets
+ * 
+ * @return The number of packets
+ */
+uint32_t Realtime::getInvalidPacketCount()
+{
+    return this->invalidPacketCount;
+};
+
+/**
+ * @brief Returns the frames that arrived after their playout time. Many late frames need a bigger jitter buffer delay
+ * 
+ * @return The number of frames
+ */
+uint32_t Realtime::getLateDropCount()
+{
+    return this->lateDropCount;
+};
+
+/**
+ * @brief Returns the times the playout ran out of frames and held the last one
+ * 
+ * @return The number of underruns
+ */
+uint32_t Realtime::getUnderrunCount()
+{
+    return this->underrunCount;
+};
+
+/**
+ * @brief Returns the frames dropped by the full jitter buffer. Happens if the delay is longer than the buffer holds
+ * 
+ * @return The number of frames
+ */
+uint32_t Realtime::getOverflowCount()
+{
+    return this->overflowCount;
+};
@@ -0,0 +1,107 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+#include <ESP8266WiFi.h>
+#include <WiFiUdp.h>
+#include "../Network/Network.h"
+#include "../Information/Information.h"
+#include "../Helper/Helper.h"
+#include "../Constants/Constants.h"
+#include "../Enums/Enums.h"
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+
+// Blueprint for compiler. Problem => circular dependency
+class Network;
+class Information;
+class Helper;
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The Realtime Class receives the channel intensities of an external sequencer over DDP or E1.31 (sACN).
+ * While frames arrive the led driver shows them without the effects and fades. Without a frame for
+ * REALTIME_TIMEOUT the led driver falls back to the normal mode.
+ * The frames go through a jitter buffer. The led driver plays them out on its frame clock with a fixed delay
+ * and interpolates between two frames, so a 30 fps source gets shown smoothly at 90 Hz
+ * 
+ */
+class Realtime : public IBaseClass
+{
+    // ================ Constructor / Reference ================ //
+public:
+    Realtime(uint16_t jitterBufferDelay);
+    void setReference(Network *network,
+                      Information *information,
+                      Helper *helper,
+                      ITimeSource *clock);
+    bool init = false;
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual bool Init();
+    virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
+
+    // ================ Data ================ //
+private:
+    Network *network;
+    Information *information;
+    Helper *helper;
+    ITimeSource *clock;
+
+    // ======== UDP ======== //
+    WiFiUDP ddpUDP;
+    WiFiUDP e131UDP;
+    bool listening = false;
+    uint8_t header[REALTIME_E131_HEADER_LENGTH]{0}; // Header of the current packet. The channel data gets read into the jitter buffer
+
+    // ======== Jitter buffer ======== //
+    RealtimeFrame jitterBuffer[REALTIME_JITTER_BUFFER_SIZE + 1] = {}; // One more than the depth => The receive slot is always free
+    uint8_t jitterBufferHead = 0;
+    uint8_t jitterBufferCount = 0;
+    unsigned long jitterBufferDelay = 0; // us from the presentation time of a frame to its playout. 0 => Newest frame at once
+    unsigned long prevArrivalMicros = 0;
+    unsigned long prevPresentationMicros = 0;
+    unsigned long frameInterval = 0; // us. Average time between two frames of the source
+    unsigned long lastPlayoutMicros = 0;
+    bool playoutStarted = false;
+    bool underrun = false;
+    uint32_t lateDropCount = 0;  // Frames that arrived after their playout time
+    uint32_t underrunCount = 0;  // Times the playout ran out of frames
+    uint32_t overflowCount = 0;  // Frames dropped by the full jitter buffer
+
+    // ======== Frame ======== //
+    uint8_t frame[REALTIME_CHANNEL_COUNT]{0}; // Played out frame
+    RealtimeProtocol protocol = RealtimeProtocol::None;
+    unsigned long prevMillisFrame = 0;
+    uint8_t e131Sequence = 0;
+    bool e131SequenceValid = false;
+    uint32_t frameCount = 0;
+    uint32_t invalidPacketCount = 0;
+
+    // ================ Methods ================ //
+private:
+    void HandleListener();
+    bool ReadDDPPacket(int packetSize);
+    bool ReadE131Packet(int packetSize);
+    uint8_t *getReceiveFrame();
+    void PushFrame();
+    void Activate(RealtimeProtocol protocol);
+    void Deactivate();
+
+public:
+    bool isActive();
+    void Playout(unsigned long currentMicros);
+    const uint8_t *getFrame();
+    uint32_t getFrameCount();
+    uint32_t getInvalidPacketCount();
+    uint32_t getLateDropCount();
+    uint32_t getUnderrunCount();
+    uint32_t getOverflowCount();
+};
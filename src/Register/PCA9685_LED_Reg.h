@@ -10,6 +10,9 @@
 // MODE 2
 #define MODE2 0x01
 
+// ALL CALL ADDRESS
+#define ALLCALLADR 0x05
+
 // LED 0
 #define LED0_ON_L 0x06
 #define LED0_ON_H 0x07
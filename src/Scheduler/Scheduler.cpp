@@ -0,0 +1,261 @@
+#include "Scheduler.h"
+
+/**
+ * @brief Construct a new Scheduler:: Scheduler object
+ * 
+ */
+Scheduler::Scheduler(){
+
+};
+
+/**
+ * @brief Sets the needed refernce for the scheduler
+ */
+void Scheduler::setReference(Profiler *profiler,
+                             ITimeSource *clock)
+{
+    this->profiler = profiler;
+    this->clock = clock;
+};
+
+/**
+ * @brief Initializes the scheduler component. All periodic tasks are due right away
+ * 
+ * @return True if the initialization was successful
+ */
+bool Scheduler::Init()
+{
+    if (!init)
+    {
+        unsigned long curMicros = this->clock->Micros();
+        for (uint8_t i = 0; i < this->taskCount; i++)
+        {
+            this->tasks[i].nextRunMicros = curMicros;
+            this->tasks[i].deferCount = 0;
+        }
+
+        Serial.print(F("Scheduler initialized with '"));
+        Serial.print(this->taskCount);
+        Serial.println(F("' tasks"));
+        init = true;
+    }
+    return init;
+};
+
+/**
+ * @brief Runs one scheduling cycle. Every due task runs at most once, high priority tasks get checked before every other task
+ * 
+ */
+void Scheduler::Run()
+{
+    if (!init)
+    {
+        return;
+    }
+
+    for (uint8_t i = this->highPriorityTaskCount; i < this->taskCount; i++)
+    {
+        this->RunHighPriorityTasks();
+
+        SchedulerTask &task = this->tasks[i];
+        unsigned long curMicros = this->clock->Micros();
+        if (!this->isDue(task, curMicros))
+        {
+            continue;
+        }
+
+        // Starving a task forever is worse than one late frame => Budget is configured too large
+        if (!this->fitsBeforeDeadline(task, curMicros) && task.deferCount < SCHEDULER_MAX_DEFER_COUNT)
+        {
+            task.deferCount++;
+            continue;
+        }
+
+        this->RunTask(task);
+    }
+    this->RunHighPriorityTasks();
+
+    // ======== Overrun print ======== //
+    if (this->unprintedOverrunCount > 0)
+    {
+        unsigned long curMillis = this->clock->Millis();
+        if (curMillis - this->prevMillisOverrunPrint >= this->TimeOut_OverrunPrint)
+        {
+            this->prevMillisOverrunPrint = curMillis;
+            Serial.print(F("Scheduler budget overruns: "));
+            Serial.println(this->unprintedOverrunCount);
+            this->unprintedOverrunCount = 0;
+        }
+    }
+};
+
+/**
+ * @brief Adds a component to the scheduler. The period, priority and budget get read from the component once
+ * 
+ * @param component The component to run
+ * @param id        The id the run time gets profiled with
+ * @return True if the task was added
+ */
+bool Scheduler::AddTask(IBaseClass *component, ProfilerComponent id)
+{
+    if (this->taskCount >= SCHEDULER_TASK_COUNT)
+    {
+        Serial.println(F("Scheduler task list is full!"));
+        return false;
+    }
+
+    SchedulerTask task = {};
+    task.component = component;
+    task.id = id;
+    task.period = component->getRunPeriod();
+    task.priority = component->getRunPriority();
+    task.budget = component->getRunBudget();
+
+    // Keep the list sorted by priority. Tasks with the same priority keep the order they were added in
+    uint8_t position = this->taskCount;
+    while (position > 0 && this->tasks[position - 1].priority > task.priority)
+    {
+        this->tasks[position] = this->tasks[position - 1];
+        position--;
+    }
+    this->tasks[position] = task;
+    this->taskCount++;
+
+    if (task.priority == SchedulerPriority::High)
+    {
+        this->highPriorityTaskCount++;
+    }
+    return true;
+};
+
+/**
+ * @brief Returns the number of runs that took longer than the budget of the component
+ * 
+ * @param id The id the component was added with
+ * @return The overrun count
+ */
+uint32_t Scheduler::getOverrunCount(ProfilerComponent id)
+{
+    for (uint8_t i = 0; i < this->taskCount; i++)
+    {
+        if (this->tasks[i].id == id)
+        {
+            return this->tasks[i].overrunCount;
+        }
+    }
+    return 0;
+};
+
+/**
+ * @brief Runs all due high priority tasks
+ * 
+ */
+void Scheduler::RunHighPriorityTasks()
+{
+    for (uint8_t i = 0; i < this->highPriorityTaskCount; i++)
+    {
+        SchedulerTask &task = this->tasks[i];
+        unsigned long curMicros = this->clock->Micros();
+        if (task.period > 0 && (long)(curMicros - task.nextRunMicros) < 0)
+        {
+            continue;
+        }
+
+        if (task.component->isRunRequested())
+        {
+            this->RunTask(task);
+        }
+        else
+        {
+            // An idle high priority task must not block the others with a deadline in the past
+            this->ScheduleNextRun(task, curMicros);
+        }
+    }
+};
+
+/**
+ * @brief Runs a task, profiles its run time and calculates the next time it is due
+ * 
+ * @param task The task to run
+ */
+void Scheduler::RunTask(SchedulerTask &task)
+{
+    unsigned long startMicros = this->clock->Micros();
+    task.component->Run();
+    yield();
+    unsigned long endMicros = this->clock->Micros();
+
+    uint32_t duration = endMicros - startMicros;
+    this->profiler->Record(task.id, duration);
+    if (duration > task.budget)
+    {
+        task.overrunCount++;
+        this->unprintedOverrunCount++;
+    }
+    task.deferCount = 0;
+
+    this->ScheduleNextRun(task, endMicros);
+};
+
+/**
+ * @brief Calculates the next time a periodic task is due
+ * 
+ * @param task      The task to schedule
+ * @param curMicros The current time in micro seconds
+ */
+void Scheduler::ScheduleNextRun(SchedulerTask &task, unsigned long curMicros)
+{
+    if (task.period == 0)
+    {
+        return;
+    }
+
+    // Keep the phase of the period. Skip missed periods instead of running them back to back
+    task.nextRunMicros += task.period;
+    if ((long)(curMicros - task.nextRunMicros) >= 0)
+    {
+        task.nextRunMicros = curMicros + task.period;
+    }
+};
+
+/**
+ * @brief Checks if a task has work and its period elapsed
+ * 
+ * @param task      The task to check
+ * @param curMicros The current time in micro seconds
+ * @return True if the task should run
+ */
+bool Scheduler::isDue(SchedulerTask &task, unsigned long curMicros)
+{
+    if (task.period > 0 && (long)(curMicros - task.nextRunMicros) < 0)
+    {
+        return false;
+    }
+    return task.component->isRunRequested();
+};
+
+/**
+ * @brief Checks if the budget of a task ends before the next high priority task is due
+ * 
+ * @param task      The task to check
+ * @param curMicros The current time in micro seconds
+ * @return True if the task can run without delaying a high priority task
+ */
+bool Scheduler::fitsBeforeDeadline(SchedulerTask &task, unsigned long curMicros)
+{
+    for (uint8_t i = 0; i < this->highPriorityTaskCount; i++)
+    {
+        SchedulerTask &highPriorityTask = this->tasks[i];
+        if (highPriorityTask.period == 0)
+        {
+            continue;
+        }
+
+        long timeToDeadline = (long)(highPriorityTask.nextRunMicros - curMicros);
+        if (timeToDeadline < (long)task.budget)
+        {
+            return false;
+        }
+    }
+    return true;
+};
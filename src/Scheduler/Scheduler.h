@@ -0,0 +1,64 @@
+#pragma once
+
+// ================================ INCLUDES ================================ //
+#include <Arduino.h>
+#include "../Profiler/Profiler.h"
+#include "../Enums/Enums.h"
+#include "../Structs/Structs.h"
+#include "../Constants/Constants.h"
+
+// ================================ INTERFACES ================================ //
+#include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
+
+// Blueprint for compiler. Problem => circular dependency
+class Profiler;
+
+// ================================ CLASS ================================ //
+/**
+ * @brief The Scheduler Class runs the components cooperatively based on the period, priority and budget they declare.
+ * High priority components run as soon as they are due. Other components only run when their budget fits
+ * before the next high priority deadline, so a long running component can not delay a led frame
+ */
+class Scheduler : public IBaseClass
+{
+    // ================ Constructor / Reference ================ //
+public:
+    Scheduler();
+    void setReference(Profiler *profiler,
+                      ITimeSource *clock);
+    bool init = false;
+
+    // ================ Interface ================ //
+private:
+public:
+    virtual bool Init();
+    virtual void Run();
+
+    // ================ Data ================ //
+private:
+    Profiler *profiler;
+    ITimeSource *clock;
+
+    SchedulerTask tasks[SCHEDULER_TASK_COUNT] = {};
+    uint8_t taskCount = 0;
+    uint8_t highPriorityTaskCount = 0; // High priority tasks are kept at the start of the list
+
+    // ======== Overrun print ======== //
+    unsigned long prevMillisOverrunPrint = 0;
+    const unsigned long TimeOut_OverrunPrint = 10000; // 10 sec
+    uint32_t unprintedOverrunCount = 0;
+
+public:
+    // ================ Methods ================ //
+private:
+    void RunHighPriorityTasks();
+    void RunTask(SchedulerTask &task);
+    void ScheduleNextRun(SchedulerTask &task, unsigned long curMicros);
+    bool isDue(SchedulerTask &task, unsigned long curMicros);
+    bool fitsBeforeDeadline(SchedulerTask &task, unsigned long curMicros);
+
+public:
+    bool AddTask(IBaseClass *component, ProfilerComponent id);
+    uint32_t getOverrunCount(ProfilerComponent id);
+};
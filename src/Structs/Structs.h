@@ -3,6 +3,9 @@
 #include "../Enums/Enums.h"
 #include "../Constants/Constants.h"
 
+// Blueprint for compiler
+class IBaseClass;
+
 /**
  * Holds the data for the current time
  */
@@ -280,6 +283,16 @@ struct PIRReaderData
     bool virtualSensorTriggered = false;
 };
 
+/**
+ * @brief A change of the PIR Reader data
+ * 
+ */
+struct PIRReaderEvent
+{
+    PIRReaderData data = {};
+    unsigned long timestamp = 0; // Micro seconds when the change got detected
+};
+
 // ================================================ Settings ================================================ //
 struct SettingsStripParameter
 {
@@ -382,4 +395,145 @@ struct NetworkLEDStripData : public LEDStripParameter
 {
     bool MasterPresent = false;
     bool AlarmActive = false;
-};
\ No newline at end of file
+};
+
+// ================================================ I2C ================================================ //
+/**
+ * @brief The devices found on the bus
+ * 
+ */
+struct I2CLayoutParameter
+{
+    uint8_t PwmAddress[I2C_MAX_PWM_DEVICE_COUNT]{0};
+    uint8_t PwmDeviceCount = 0;
+    uint8_t PowerMeasurementAddress = 0;
+    bool PowerMeasurementPresent = false;
+    uint8_t IgnoredAddress[I2C_IGNORED_ADDRESS_BYTES]{0}; // Devices in the probed range the layout does not use => No rescan on every boot
+};
+
+struct FilesystemI2CLayoutData : public I2CLayoutParameter
+{
+    bool isConfigured = false;
+};
+
+/**
+ * @brief The groups the controller is member of. A command to "LEDController/Group/<name>/..." acts like a
+ * command to "LEDController/<client name>/..." on every member
+ * 
+ */
+struct GroupParameter
+{
+    char Name[MQTT_GROUP_COUNT][MQTT_GROUP_NAME_LENGTH + 1]{}; // Empty => Unused
+};
+
+struct FilesystemGroupData : public GroupParameter
+{
+    bool isConfigured = false;
+};
+
+/**
+ * @brief Latency histogram of one profiled component. Bucket 0 holds 0 us, bucket n holds [2^(n-1), 2^n) us
+ * 
+ */
+struct ProfilerHistogram
+{
+    uint32_t bucket[PROFILER_BUCKET_COUNT]{0};
+    uint32_t count = 0;
+    uint32_t min = 0; // Shortest run time in micro seconds
+    uint32_t max = 0; // Longest run time in micro seconds
+};
+
+/**
+ * @brief A component run by the scheduler
+ * 
+ */
+struct SchedulerTask
+{
+    IBaseClass *component = nullptr;
+    ProfilerComponent id = ProfilerComponent::Loop;
+    uint32_t period = 0; // Micro seconds. 0 => Every loop cycle
+    SchedulerPriority priority = SchedulerPriority::Normal;
+    uint32_t budget = 0;             // Micro seconds
+    unsigned long nextRunMicros = 0; // Only used with a period
+    uint8_t deferCount = 0;          // Times deferred in a row
+    uint32_t overrunCount = 0;       // Runs that took longer than the budget
+};
+
+/**
+ * @brief A mqtt topic the network component reacts on
+ * The suffix is relative to "LEDController/Global/" or "LEDController/<client name>/"
+ * 
+ */
+struct NetworkTopicDefinition
+{
+    NetworkTopic topic;
+    bool isGlobal;
+    const char *suffix;
+};
+
+/**
+ * @brief A slot of the mqtt topic lookup table
+ * 
+ */
+struct NetworkTopicTableEntry
+{
+    uint32_t hash = 0;
+    uint8_t definition = MQTT_TOPIC_TABLE_EMPTY; // Index into the topic definitions
+};
+
+/**
+ * @brief A state waiting in the outbound mqtt queue
+ * 
+ */
+struct NetworkPublishEntry
+{
+    uint32_t hash = 0;                              // Hash of the suffix => Fast compare when coalescing
+    char suffix[MQTT_PUBLISH_SUFFIX_LENGTH] = "";   // Topic without "LEDController/<client name>/"
+    char payload[MQTT_PAYLOAD_LENGTH] = "";
+    bool republish = false; // Republish or keep-alive => Gets evicted first when the queue is full
+};
+
+/**
+ * @brief A Home Assistant entity announced over mqtt discovery
+ * 
+ */
+struct NetworkDiscoveryDefinition
+{
+    const char *component; // Home Assistant platform e.g. "light"
+    const char *objectId;  // Unique below the client name
+    const char *base;      // Base topic "~" behind "LEDController/<client name>"
+    const char *config;    // Entity specific part of the config. Stored in PROGMEM
+};
+
+/**
+ * @brief Ingress time of the oldest strip command that is not visible on the led strip yet
+ * 
+ */
+struct CommandStamp
+{
+    bool pending = false;
+    ProfilerComponent path = ProfilerComponent::CommandMQTT; // The ingress path the latency gets recorded for
+    unsigned long ingressMicros = 0;
+    uint32_t revision = 0; // Revision of the strip parameters that holds the command
+};
+
+/**
+ * @brief One offset measurement of the clock sync
+ * 
+ */
+struct ClockSyncSample
+{
+    int64_t offset = 0;        // us from the local to the shared time
+    uint32_t roundTrip = 0;    // us from the request to the response
+    uint64_t localMicros = 0;  // Local time of the response
+};
+
+/**
+ * @brief One received realtime frame in the jitter buffer
+ * 
+ */
+struct RealtimeFrame
+{
+    unsigned long presentationMicros = 0;          // Arrival time with the packet jitter smoothed out
+    uint8_t channel[REALTIME_CHANNEL_COUNT]{0}; // R, G, B, CW, WW of strip 1 then strip 2
+};
@@ -15,12 +15,16 @@ Webserver::Webserver(){
 void Webserver::setReference(Filesystem *filesystem,
                              Helper *helper,
                              Network *network,
-                             Parameterhandler *parameterhandler)
+                             Parameterhandler *parameterhandler,
+                             Profiler *profiler,
+                             ITimeSource *clock)
 {
     this->filesystem = filesystem;
     this->helper = helper;
     this->network = network;
     this->parameterhandler = parameterhandler;
+    this->profiler = profiler;
+    this->clock = clock;
 };
 
 /**
@@ -51,7 +55,7 @@ void Webserver::Run()
         return;
     }
 
-    unsigned long curMillis = millis();
+    unsigned long curMillis = this->clock->Millis();
 
     // MDNS update
     MDNS.update();
@@ -151,6 +155,36 @@ void Webserver::Run()
     HandleMDNS();
 };
 
+/**
+ * @brief Returns the time between two Run calls
+ * 
+ * @return The period in micro seconds
+ */
+uint32_t Webserver::getRunPeriod()
+{
+    return 10000; // 100 Hz => mDNS and flash button
+};
+
+/**
+ * @brief Returns the priority the component gets scheduled with
+ * 
+ * @return The priority
+ */
+SchedulerPriority Webserver::getRunPriority()
+{
+    return SchedulerPriority::Low;
+};
+
+/**
+ * @brief Returns the expected worst case run time
+ * 
+ * @return The budget in micro seconds
+ */
+uint32_t Webserver::getRunBudget()
+{
+    return 2000;
+};
+
 void Webserver::HandleMDNS()
 {
     // Inital Checks
@@ -419,6 +453,7 @@ void Webserver::NormalModeHandler(bool shutdown)
                     {
                         this->indexHandle = &this->asyncWebServer.on("/", HTTP_ANY, std::bind(&Webserver::NormalMainWebpage, this, std::placeholders::_1));
                         this->settingsHandle = &this->asyncWebServer.on("/settings", HTTP_ANY, std::bind(&Webserver::NormalSettingsWebpage, this, std::placeholders::_1));
+                        this->profilerHandle = &this->asyncWebServer.on("/profiler", HTTP_ANY, std::bind(&Webserver::NormalProfilerWebpage, this, std::placeholders::_1));
                         this->asyncWebServer.onNotFound(std::bind(&Webserver::NormalNotFoundWebpage, this, std::placeholders::_1));
 
                         this->asyncWebSocketMain.onEvent(std::bind(&Webserver::WebSocketEventMain, this, std::placeholders::_1, std::placeholders::_2, std::placeholders::_3, std::placeholders::_4, std::placeholders::_5, std::placeholders::_6));
@@ -468,10 +503,16 @@ void Webserver::NormalModeHandler(bool shutdown)
                     }
                     break;
                 case 4:
+                    if (this->asyncWebServer.removeHandler(this->profilerHandle))
+                    {
+                        this->webserverResetState++;
+                    }
+                    break;
+                case 5:
                     this->asyncWebServer.onNotFound(NULL);
                     this->webserverResetState++;
                     break;
-                case 5:
+                case 6:
                     //this->asyncWebServer.end();
                     this->webserverResetState++;
                 default:
@@ -639,6 +680,25 @@ void Webserver::NormalSettingsWebpage(AsyncWebServerRequest *request)
     request->send_P(200, "text/html", SettingsPage);
 };
 
+/**
+ * @brief Sends the loop time report of the profiler as JSON in normal mode.
+ * "/profiler?enabled=1" enables, "/profiler?enabled=0" disables and "/profiler?reset" clears the histograms before the report is sent
+ * 
+ */
+void Webserver::NormalProfilerWebpage(AsyncWebServerRequest *request)
+{
+    if (request->hasArg("enabled"))
+    {
+        this->profiler->setEnabled(request->arg("enabled").toInt() == 1);
+    }
+    if (request->hasArg("reset"))
+    {
+        this->profiler->Reset();
+    }
+
+    request->send(200, "application/json", this->profiler->getReportJson());
+};
+
 /**
  * @brief Sends a 404 error message to the client with a "Normal page not found" message
  * 
@@ -729,6 +789,8 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
     // ================================ WS_EVT_DATA ================================ //
     case AwsEventType::WS_EVT_DATA:
     {
+        // Ingress time of the command => Command to photon latency
+        unsigned long ingressMicros = this->clock->Micros();
         AwsFrameInfo *info = (AwsFrameInfo *)arg;
         if (info->final && info->index == 0 && info->len == len)
         {
@@ -782,6 +844,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ RedValue ================================ //
@@ -798,6 +861,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ GreenValue ================================ //
@@ -814,6 +878,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ BlueValue ================================ //
@@ -830,6 +895,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ WhiteTemperature ================================ //
@@ -846,6 +912,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ ColorBrightness ================================ //
@@ -862,6 +929,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ WhiteTemperatureBrightness ================================ //
@@ -878,6 +946,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
             // ================================ EffectValue ================================ //
@@ -894,6 +963,7 @@ void Webserver::WebSocketEventMain(AsyncWebSocket *server, AsyncWebSocketClient
                     // We Broadcast the new data to all connected clients
                     server->textAll(msg);
                     this->parameterhandler->updateLEDStripParameter(stripNumber - 1, ledStripParameter);
+                    this->parameterhandler->stampLEDStripCommand(stripNumber - 1, ProfilerComponent::CommandWebSocket, ingressMicros);
                 }
             }
         }
@@ -14,6 +14,7 @@
 #include "../Helper/Helper.h"
 #include "../Network/Network.h"
 #include "../Parameterhandler/Parameterhandler.h"
+#include "../Profiler/Profiler.h"
 #include "../Constants/Constants.h"
 #include "../src/Webpage/transformed_to_c/ConfigurationPage.h"
 #include "../src/Webpage/transformed_to_c/SubmittedConfigurationPage.h"
@@ -22,12 +23,14 @@
 
 // ================================ INTERFACES ================================ //
 #include "../Interface/IBaseClass.h"
+#include "../Interface/ITimeSource.h"
 
 // Blueprint for compiler. Problem => circular dependency
 class Filesystem;
 class Helper;
 class Network;
 class Parameterhandler;
+class Profiler;
 
 // ================================ CLASS ================================ //
 /**
@@ -44,7 +47,9 @@ public:
     void setReference(Filesystem *filesystem,
                       Helper *helper,
                       Network *network,
-                      Parameterhandler *parameterhandler);
+                      Parameterhandler *parameterhandler,
+                      Profiler *profiler,
+                      ITimeSource *clock);
     bool init = false;
 
     // ================ Interface ================ //
@@ -52,6 +57,9 @@ private:
 public:
     virtual bool Init();
     virtual void Run();
+    virtual uint32_t getRunPeriod();
+    virtual SchedulerPriority getRunPriority();
+    virtual uint32_t getRunBudget();
 
     // ================ Data ================ //
 private:
@@ -59,6 +67,8 @@ private:
     Helper *helper;
     Network *network;
     Parameterhandler *parameterhandler;
+    Profiler *profiler;
+    ITimeSource *clock;
 
     // ======== Webserver / Websocket ======== //
     AsyncWebServer asyncWebServer = AsyncWebServer(80);
@@ -69,6 +79,7 @@ private:
     AsyncWebHandler *indexHandle;
     AsyncWebHandler *submittedHandle;
     AsyncWebHandler *settingsHandle;
+    AsyncWebHandler *profilerHandle;
     uint8_t webserverResetState = 0;
 
     // ======== Configuration Mode ======== //
@@ -110,6 +121,7 @@ private:
     // ==== Webpages
     void NormalMainWebpage(AsyncWebServerRequest *request);
     void NormalSettingsWebpage(AsyncWebServerRequest *request);
+    void NormalProfilerWebpage(AsyncWebServerRequest *request);
     void NormalNotFoundWebpage(AsyncWebServerRequest *request);
 
     // ================ Websocket ================ //